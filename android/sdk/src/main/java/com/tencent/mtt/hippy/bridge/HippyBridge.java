@@ -28,6 +28,11 @@ public interface HippyBridge {
 
     String URI_SCHEME_ASSETS = "asset:";
     String URI_SCHEME_FILE = "file:";
+    int MEMORY_PRESSURE_MODERATE = 0;
+    int MEMORY_PRESSURE_CRITICAL = 1;
+    // lanes of the JS thread, see Task::Priority in core
+    int PRIORITY_INPUT = 0;
+    int PRIORITY_NORMAL = 1;
 
     void initJSBridge(String globalConfig, NativeCallback callback, int groupId);
 
@@ -35,6 +40,13 @@ public interface HippyBridge {
 
     void runInJsThread(Callback<Void> callback);
 
+    /**
+     * Lets the engine release its native caches and collect garbage, e.g. from onTrimMemory.
+     *
+     * @param level {@link #MEMORY_PRESSURE_MODERATE} or {@link #MEMORY_PRESSURE_CRITICAL}
+     */
+    void onMemoryPressure(int level);
+
     boolean runScriptFromUri(String uri, AssetManager assetManager, boolean canUseCodeCache,
             String codeCacheTag, NativeCallback callback);
 
@@ -49,6 +61,11 @@ public interface HippyBridge {
     void callFunction(String action, NativeCallback callback, byte[] buffer, int offset,
             int length);
 
+    void callFunction(String action, NativeCallback callback, ByteBuffer buffer, int priority);
+
+    void callFunction(String action, NativeCallback callback, byte[] buffer, int offset,
+            int length, int priority);
+
     long getV8RuntimeId();
 
     interface BridgeCallback {
@@ -242,6 +242,12 @@ public class HippyBridgeImpl implements HippyBridge, DevRemoteDebugProxy.OnRecei
 
     @Override
     public void callFunction(String action, NativeCallback callback, ByteBuffer buffer) {
+        callFunction(action, callback, buffer, PRIORITY_NORMAL);
+    }
+
+    @Override
+    public void callFunction(String action, NativeCallback callback, ByteBuffer buffer,
+            int priority) {
         if (!mInit || TextUtils.isEmpty(action) || buffer == null || buffer.limit() == 0) {
             return;
         }
@@ -249,7 +255,7 @@ public class HippyBridgeImpl implements HippyBridge, DevRemoteDebugProxy.OnRecei
         int offset = buffer.position();
         int length = buffer.limit() - buffer.position();
         if (buffer.isDirect()) {
-            callFunction(action, mV8RuntimeId, callback, buffer, offset, length);
+            callFunction(action, mV8RuntimeId, callback, buffer, offset, length, priority);
         } else {
             /*
              * In Android's DirectByteBuffer implementation.
@@ -266,7 +272,7 @@ public class HippyBridgeImpl implements HippyBridge, DevRemoteDebugProxy.OnRecei
              * {@link ByteBuffer#arrayOffset} will be ignored, treated as 0.
              */
             offset += buffer.arrayOffset();
-            callFunction(action, mV8RuntimeId, callback, buffer.array(), offset, length);
+            callFunction(action, mV8RuntimeId, callback, buffer.array(), offset, length, priority);
         }
     }
 
@@ -278,12 +284,18 @@ public class HippyBridgeImpl implements HippyBridge, DevRemoteDebugProxy.OnRecei
     @Override
     public void callFunction(String action, NativeCallback callback, byte[] buffer, int offset,
             int length) {
+        callFunction(action, callback, buffer, offset, length, PRIORITY_NORMAL);
+    }
+
+    @Override
+    public void callFunction(String action, NativeCallback callback, byte[] buffer, int offset,
+            int length, int priority) {
         if (!mInit || TextUtils.isEmpty(action) || buffer == null || offset < 0 || length < 0
                 || offset + length > buffer.length) {
             return;
         }
 
-        callFunction(action, mV8RuntimeId, callback, buffer, offset, length);
+        callFunction(action, mV8RuntimeId, callback, buffer, offset, length, priority);
     }
 
     @Override
@@ -327,8 +339,32 @@ public class HippyBridgeImpl implements HippyBridge, DevRemoteDebugProxy.OnRecei
       runInJsThread(mV8RuntimeId, callback);
     }
 
+    @Override
+    public void onMemoryPressure(int level) {
+        onMemoryPressure(mV8RuntimeId, level);
+    }
+
     public static native int createSnapshot(String[] script, String path, String uri, String config);
 
+    /**
+     * Records engine, scope, script loading and bridge phases as trace events, process wide.
+     * Only samplingRate (0 to 1) of the sessions record, the method returns whether this one does.
+     * A non-positive capacity keeps the default of 8192 events per thread, the oldest are dropped beyond it.
+     */
+    public static native boolean startTracing(int capacity, double samplingRate);
+
+    /**
+     * Stops recording and writes the events to filePath as Chrome trace JSON, when it is not null.
+     */
+    public static native boolean stopTracing(String filePath);
+
+    /**
+     * Keeps capacity engines with their VM and context created ahead of initJSFramework, which takes
+     * one of them when it is called without V8InitParams. 0 disables the pool and releases its engines.
+     * A positive memoryBudgetInBytes bounds the heap held by the idle engines.
+     */
+    public static native void setEnginePool(int capacity, long memoryBudgetInBytes);
+
     public native long initJSFramework(byte[] globalConfig, boolean useLowMemoryMode,
             boolean enableV8Serialization, boolean isDevModule, NativeCallback callback,
             long groupId, V8InitParams v8InitParams);
@@ -341,15 +377,17 @@ public class HippyBridgeImpl implements HippyBridge, DevRemoteDebugProxy.OnRecei
     public native void destroy(long runtimeId, boolean useLowMemoryMode, boolean isReload, NativeCallback callback);
 
     public native void callFunction(String action, long runtimeId, NativeCallback callback,
-            ByteBuffer buffer, int offset, int length);
+            ByteBuffer buffer, int offset, int length, int priority);
 
     public native void callFunction(String action, long runtimeId, NativeCallback callback,
-            byte[] buffer, int offset, int length);
+            byte[] buffer, int offset, int length, int priority);
 
     public native void onResourceReady(ByteBuffer output, long runtimeId, long resId);
 
     private native void runInJsThread(long runtimeId, Callback<Void> callback);
 
+    private native void onMemoryPressure(long runtimeId, int level);
+
     public void callNatives(String moduleName, String moduleFunc, String callId, byte[] buffer) {
         callNatives(moduleName, moduleFunc, callId, ByteBuffer.wrap(buffer));
     }
@@ -72,6 +72,7 @@ public class HippyBridgeManagerImpl implements HippyBridgeManager, HippyBridge.B
     static final int FUNCTION_ACTION_DESTROY_INSTANCE = 4;
     static final int FUNCTION_ACTION_CALLBACK = 5;
     static final int FUNCTION_ACTION_CALL_JSMODULE = 6;
+    static final String EVENT_DISPATCHER_MODULE_NAME = "EventDispatcher";
 
     public static final long V8_RUNTIME_ID_EMPTY = -1;
 
@@ -152,6 +153,7 @@ public class HippyBridgeManagerImpl implements HippyBridgeManager, HippyBridge.B
         }
 
         String action = null;
+        int priority = HippyBridge.PRIORITY_NORMAL;
         switch (msg.arg2) {
             case FUNCTION_ACTION_LOAD_INSTANCE: {
                 HippyRootView rootView = mContext.getInstance();
@@ -180,6 +182,11 @@ public class HippyBridgeManagerImpl implements HippyBridgeManager, HippyBridge.B
             }
             case FUNCTION_ACTION_CALL_JSMODULE: {
                 action = "callJsModule";
+                // events of the views and gestures are dispatched ahead of the queued work
+                if (msg.obj instanceof HippyMap && EVENT_DISPATCHER_MODULE_NAME.equals(
+                        ((HippyMap) msg.obj).getString("moduleName"))) {
+                    priority = HippyBridge.PRIORITY_INPUT;
+                }
                 break;
             }
         }
@@ -208,7 +215,7 @@ public class HippyBridgeManagerImpl implements HippyBridgeManager, HippyBridge.B
                 buffer.put(bytes);
             }
 
-            mHippyBridge.callFunction(action, mCallFunctionCallback, buffer);
+            mHippyBridge.callFunction(action, mCallFunctionCallback, buffer, priority);
         } else {
             if (enableV8Serialization) {
                 if (safeHeapWriter == null) {
@@ -223,12 +230,14 @@ public class HippyBridgeManagerImpl implements HippyBridgeManager, HippyBridge.B
                 ByteBuffer buffer = safeHeapWriter.chunked();
                 int offset = buffer.arrayOffset() + buffer.position();
                 int length = buffer.limit() - buffer.position();
-                mHippyBridge.callFunction(action, mCallFunctionCallback, buffer.array(), offset, length);
+                mHippyBridge.callFunction(action, mCallFunctionCallback, buffer.array(), offset, length,
+                        priority);
             } else {
                 mStringBuilder.setLength(0);
                 byte[] bytes = ArgumentUtils.objectToJsonOpt(msg.obj, mStringBuilder).getBytes(
                         StandardCharsets.UTF_16LE);
-                mHippyBridge.callFunction(action, mCallFunctionCallback, bytes);
+                mHippyBridge.callFunction(action, mCallFunctionCallback, bytes, 0, bytes.length,
+                        priority);
             }
         }
     }
@@ -39,6 +39,12 @@ public class V8 implements V8Memory {
     long callback(long currentHeapLimit, long initialHeapLimit);
   }
 
+  // priorities of requestInterrupt, the same values as Task::Priority on the native side
+  public static final int INTERRUPT_PRIORITY_INPUT = 0;
+  public static final int INTERRUPT_PRIORITY_NORMAL = 1;
+  public static final int INTERRUPT_PRIORITY_TIMER = 2;
+  public static final int INTERRUPT_PRIORITY_IDLE = 3;
+
   private final long mV8RuntimeId;
 
   public V8(long mV8RuntimeId) {
@@ -66,7 +72,15 @@ public class V8 implements V8Memory {
   // The method must be called in the js thread
   @Override
   public boolean writeHeapSnapshot(@NonNull String filePath, @NonNull Callback<Integer> callback) throws NoSuchMethodException {
-    return writeHeapSnapshot(mV8RuntimeId, filePath, callback);
+    return writeHeapSnapshot(mV8RuntimeId, filePath, false, 0, callback);
+  }
+
+  // The method must be called in the js thread
+  // compress: gzip the snapshot, readable by DevTools after gunzip
+  // maxSize: bytes allowed on disk, 0 means no limit; the write is aborted and the file removed once exceeded
+  public boolean writeHeapSnapshot(@NonNull String filePath, boolean compress, long maxSize,
+      @NonNull Callback<Integer> callback) throws NoSuchMethodException {
+    return writeHeapSnapshot(mV8RuntimeId, filePath, compress, maxSize, callback);
   }
 
   // The method must be called in the js thread
@@ -81,7 +95,53 @@ public class V8 implements V8Memory {
 
   // the method can be called from any thread
   public void requestInterrupt(Callback<Void> callback) {
-    requestInterrupt(mV8RuntimeId, callback);
+    requestInterrupt(callback, INTERRUPT_PRIORITY_NORMAL);
+  }
+
+  /**
+   * Runs the callback on the js thread, interrupting running js if needed.
+   * Callbacks of a lower priority value run first, see the INTERRUPT_PRIORITY constants.
+   * The method can be called from any thread.
+   */
+  public void requestInterrupt(Callback<Void> callback, int priority) {
+    requestInterrupt(mV8RuntimeId, priority, callback);
+  }
+
+  /**
+   * Samples heap statistics, GC pauses and external memory on the js thread into a ring buffer.
+   * A non-positive intervalMs or capacity keeps the default of 1000ms and 300 samples.
+   * The method can be called from any thread.
+   */
+  public void startHeapSampler(int intervalMs, int capacity) {
+    startHeapSampler(mV8RuntimeId, intervalMs, capacity);
+  }
+
+  // the method can be called from any thread
+  public void stopHeapSampler() {
+    stopHeapSampler(mV8RuntimeId);
+  }
+
+  // the method can be called from any thread, the samples are passed as a json time series
+  public void getHeapSamples(Callback<String> callback) {
+    getHeapSamples(mV8RuntimeId, callback);
+  }
+
+  /**
+   * Starts V8's sampling CPU profiler, it does not need the inspector.
+   * A non-positive samplingIntervalUs keeps the default of 1000us.
+   * The method can be called from any thread.
+   */
+  public void startCpuProfiling(int samplingIntervalUs) {
+    startCpuProfiling(mV8RuntimeId, samplingIntervalUs);
+  }
+
+  /**
+   * Stops the profiler and saves the profile to filePath as a Chrome .cpuprofile, which DevTools can load.
+   * The callback runs on the worker thread with whether the file was saved.
+   * The method can be called from any thread.
+   */
+  public void stopCpuProfiling(@NonNull String filePath, @NonNull Callback<Boolean> callback) {
+    stopCpuProfiling(mV8RuntimeId, filePath, callback);
   }
 
   // [memory]
@@ -91,12 +151,22 @@ public class V8 implements V8Memory {
 
   private native boolean getHeapSpaceStatistics(long runtimeId, Callback<ArrayList<V8HeapSpaceStatistics>> callback) throws NoSuchMethodException;
 
-  private native boolean writeHeapSnapshot(long runtimeId, String filePath, Callback<Integer> callback) throws NoSuchMethodException;
+  private native boolean writeHeapSnapshot(long runtimeId, String filePath, boolean compress, long maxSize, Callback<Integer> callback) throws NoSuchMethodException;
 
   private native void addNearHeapLimitCallback(long runtimeId, NearHeapLimitCallback callback);
 
   private native void printCurrentStackTrace(long runtimeId, Callback<String> callback);
 
-  private native void requestInterrupt(long runtimeId, Callback<Void> callback);
+  private native void requestInterrupt(long runtimeId, int priority, Callback<Void> callback);
+
+  private native void startHeapSampler(long runtimeId, int intervalMs, int capacity);
+
+  private native void stopHeapSampler(long runtimeId);
+
+  private native void getHeapSamples(long runtimeId, Callback<String> callback);
+
+  private native void startCpuProfiling(long runtimeId, int samplingIntervalUs);
+
+  private native void stopCpuProfiling(long runtimeId, String filePath, Callback<Boolean> callback);
 
 }
@@ -0,0 +1,194 @@
+/*
+ *
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2022 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <gtest.h>
+#include <unistd.h>
+#include <zlib.h>
+
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+#include "performance/heap_snapshot_writer.h"
+
+using HeapSnapshotWriter = hippy::bridge::HeapSnapshotWriter;
+
+namespace {
+
+std::string MakeTempPath(const std::string& name) {
+  return "/tmp/hippy_heap_snapshot_writer_" + std::to_string(getpid()) + "_" + name;
+}
+
+bool FileExists(const std::string& path) {
+  return access(path.c_str(), F_OK) == 0;
+}
+
+std::string ReadFile(const std::string& path) {
+  std::ifstream file(path, std::ios::in | std::ios::binary);
+  return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+std::string ReadGzipFile(const std::string& path) {
+  std::string result;
+  gzFile file = gzopen(path.c_str(), "rb");
+  if (!file) {
+    return result;
+  }
+  char buffer[4096];
+  int size;
+  while ((size = gzread(file, buffer, sizeof(buffer))) > 0) {
+    result.append(buffer, static_cast<size_t>(size));
+  }
+  gzclose(file);
+  return result;
+}
+
+// snapshot-like text, compresses well but is not trivially repetitive
+std::string MakeContent(size_t size) {
+  std::string content;
+  uint32_t seed = 1;
+  while (content.size() < size) {
+    seed = seed * 1103515245 + 12345;
+    content += "{\"node\":" + std::to_string(seed % 100000) + "},";
+  }
+  content.resize(size);
+  return content;
+}
+
+void WriteInPieces(HeapSnapshotWriter& writer, const std::string& content, size_t piece) {
+  for (size_t i = 0; i < content.size(); i += piece) {
+    writer.Write(content.data() + i, std::min(piece, content.size() - i));
+  }
+}
+
+}  // namespace
+
+TEST(HeapSnapshotWriterTest, WritesPlainContent) {
+  auto path = MakeTempPath("plain");
+  auto content = MakeContent(300 * 1024);
+  HeapSnapshotWriter::Options options;
+  options.chunk_size = 16 * 1024;
+  HeapSnapshotWriter writer(options);
+  ASSERT_TRUE(writer.Open(path));
+  WriteInPieces(writer, content, 1000);
+  EXPECT_EQ(writer.Close(), HeapSnapshotWriter::Status::kOk);
+  EXPECT_EQ(ReadFile(path), content);
+  std::remove(path.c_str());
+}
+
+TEST(HeapSnapshotWriterTest, WritesGzipContent) {
+  auto path = MakeTempPath("gzip");
+  auto content = MakeContent(300 * 1024);
+  HeapSnapshotWriter::Options options;
+  options.compress = true;
+  options.chunk_size = 16 * 1024;
+  HeapSnapshotWriter writer(options);
+  ASSERT_TRUE(writer.Open(path));
+  WriteInPieces(writer, content, 1000);
+  EXPECT_EQ(writer.Close(), HeapSnapshotWriter::Status::kOk);
+  auto raw = ReadFile(path);
+  ASSERT_GE(raw.size(), 2u);
+  // gzip magic
+  EXPECT_EQ(static_cast<unsigned char>(raw[0]), 0x1f);
+  EXPECT_EQ(static_cast<unsigned char>(raw[1]), 0x8b);
+  EXPECT_LT(raw.size(), content.size());
+  EXPECT_EQ(ReadGzipFile(path), content);
+  std::remove(path.c_str());
+}
+
+TEST(HeapSnapshotWriterTest, WritesEmptyContent) {
+  auto path = MakeTempPath("empty");
+  HeapSnapshotWriter writer(HeapSnapshotWriter::Options{});
+  ASSERT_TRUE(writer.Open(path));
+  EXPECT_EQ(writer.Close(), HeapSnapshotWriter::Status::kOk);
+  EXPECT_TRUE(FileExists(path));
+  EXPECT_TRUE(ReadFile(path).empty());
+  std::remove(path.c_str());
+}
+
+TEST(HeapSnapshotWriterTest, SmallQueueKeepsOrder) {
+  auto path = MakeTempPath("queue");
+  auto content = MakeContent(256 * 1024);
+  HeapSnapshotWriter::Options options;
+  options.chunk_size = 128;
+  options.queue_capacity = 1;
+  HeapSnapshotWriter writer(options);
+  ASSERT_TRUE(writer.Open(path));
+  WriteInPieces(writer, content, 37);
+  EXPECT_EQ(writer.Close(), HeapSnapshotWriter::Status::kOk);
+  EXPECT_EQ(ReadFile(path), content);
+  std::remove(path.c_str());
+}
+
+TEST(HeapSnapshotWriterTest, PlainSizeExceededRemovesFile) {
+  auto path = MakeTempPath("plain_limit");
+  auto content = MakeContent(64 * 1024);
+  HeapSnapshotWriter::Options options;
+  options.chunk_size = 4 * 1024;
+  options.max_size = 10 * 1024;
+  HeapSnapshotWriter writer(options);
+  ASSERT_TRUE(writer.Open(path));
+  bool is_ok = true;
+  for (size_t i = 0; i < content.size() && is_ok; i += 1024) {
+    is_ok = writer.Write(content.data() + i, 1024);
+  }
+  EXPECT_FALSE(is_ok);
+  // later writes are refused
+  EXPECT_FALSE(writer.Write(content.data(), 1));
+  EXPECT_EQ(writer.Close(), HeapSnapshotWriter::Status::kSizeExceeded);
+  EXPECT_FALSE(FileExists(path));
+}
+
+TEST(HeapSnapshotWriterTest, GzipSizeExceededRemovesFile) {
+  auto path = MakeTempPath("gzip_limit");
+  auto content = MakeContent(1024 * 1024);
+  HeapSnapshotWriter::Options options;
+  options.compress = true;
+  options.chunk_size = 4 * 1024;
+  options.max_size = 8 * 1024;
+  HeapSnapshotWriter writer(options);
+  ASSERT_TRUE(writer.Open(path));
+  WriteInPieces(writer, content, 4096);
+  EXPECT_EQ(writer.Close(), HeapSnapshotWriter::Status::kSizeExceeded);
+  EXPECT_FALSE(FileExists(path));
+}
+
+TEST(HeapSnapshotWriterTest, OpenFailureReportsFileError) {
+  HeapSnapshotWriter writer(HeapSnapshotWriter::Options{});
+  EXPECT_FALSE(writer.Open("/nonexistent_hippy_dir/snapshot.heapsnapshot"));
+  const char data[] = "x";
+  EXPECT_FALSE(writer.Write(data, 1));
+  EXPECT_EQ(writer.Close(), HeapSnapshotWriter::Status::kFileError);
+}
+
+TEST(HeapSnapshotWriterTest, DestructorFlushes) {
+  auto path = MakeTempPath("destructor");
+  auto content = MakeContent(10 * 1024);
+  {
+    HeapSnapshotWriter writer(HeapSnapshotWriter::Options{});
+    ASSERT_TRUE(writer.Open(path));
+    WriteInPieces(writer, content, 512);
+  }
+  EXPECT_EQ(ReadFile(path), content);
+  std::remove(path.c_str());
+}
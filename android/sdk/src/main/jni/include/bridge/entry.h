@@ -46,6 +46,13 @@ jlong InitInstance(JNIEnv* j_env,
                    jlong j_group_id,
                    jobject j_vm_init_param);
 
+// Keeps j_capacity engines warmed for the InitInstance calls without VM parameters, 0 disables
+// the pool. A positive j_memory_budget_in_bytes bounds the heap held by the idle engines.
+void SetEnginePool(JNIEnv* j_env,
+                   jobject j_object,
+                   jint j_capacity,
+                   jlong j_memory_budget_in_bytes);
+
 void DestroyInstance(JNIEnv* j_env,
                      jobject j_object,
                      jlong j_runtime_id,
@@ -69,6 +76,22 @@ void RunInJsThread(JNIEnv *j_env,
                    jlong j_runtime_id,
                    jobject j_callback);
 
+void OnMemoryPressure(JNIEnv* j_env,
+                      jobject j_object,
+                      jlong j_runtime_id,
+                      jint j_level);
+
+// Records the startup path as Chrome trace events. Only the given share of the sessions record.
+jboolean StartTracing(JNIEnv* j_env,
+                      jobject j_object,
+                      jint j_capacity,
+                      jdouble j_sampling_rate);
+
+// Stops recording and writes the events as Chrome trace JSON, when j_file_path is not null.
+jboolean StopTracing(JNIEnv* j_env,
+                     jobject j_object,
+                     jstring j_file_path);
+
 
 }  // namespace bridge
 }  // namespace hippy
@@ -26,9 +26,13 @@
 #include <stdint.h>
 
 #include <any>
+#include <atomic>
 #include <memory>
+#include <mutex>
+#include <optional>
 
 #include "core/core.h"
+#include "core/task/task_future.h"
 #include "jni/java_turbo_module.h"
 #include "jni/scoped_java_ref.h"
 #include "v8/interrupt_queue.h"
@@ -37,6 +41,7 @@ class Runtime {
  public:
   using Bridge = hippy::Bridge;
   using CtxValue = hippy::napi::CtxValue;
+  using Task = hippy::base::Task;
 #ifndef V8_WITHOUT_INSPECTOR
   using V8InspectorContext = hippy::inspector::V8InspectorContext;
 #endif
@@ -95,10 +100,35 @@ class Runtime {
   inline void SetNearHeapLimitCallback(std::function<size_t(void*, size_t, size_t)> cb) {
     near_heap_limit_cb_ = cb;
   }
+  // when InitInstance was called, in ms of hippy::base::MonotonicallyIncreasingTime, and whether
+  // it took its engine from the EnginePool
+  inline void SetInitInfo(uint64_t init_time, bool is_pooled) {
+    init_time_ = init_time;
+    is_pooled_ = is_pooled;
+  }
+  inline uint64_t GetInitTime() { return init_time_; }
+  inline bool IsPooled() { return is_pooled_; }
+  // true for the first script run of the runtime only
+  inline bool MarkScriptRun() { return !has_run_script_.exchange(true); }
+
+  // Bundles of RunScriptFromUri are loaded off the JS thread and evaluated when loaded. Bridge
+  // calls posted meanwhile wait for them with PostTaskAfterBundles.
+  //
+  // Makes the later calls wait for `evaluated` and returns what the bundle itself waits for, the
+  // bundle posted before it if that is not evaluated yet. `gate_id` is for ResetBundleGate.
+  std::optional<TaskFuture<void>> SetBundleGate(TaskFuture<void> evaluated, uint64_t& gate_id);
+  // Called by the bundle once evaluated, calls posted from then on no longer wait.
+  void ResetBundleGate(uint64_t gate_id);
+  // Posts the task to the JS runner once the pending bundles were evaluated, right away if none is.
+  void PostTaskAfterBundles(std::shared_ptr<Task> task, Task::Priority priority = Task::Priority::kNormal);
 
   static void Insert(const std::shared_ptr<Runtime>& runtime);
   static std::shared_ptr<Runtime> Find(int32_t id);
   static std::shared_ptr<Runtime> Find(v8::Isolate* isolate);
+  // Records the runtime id in its v8 context so that Find(v8::Isolate*) resolves it directly
+  // when several runtimes share one isolate. Must run on the JS thread after context creation.
+  static void BindContext(const std::shared_ptr<Runtime>& runtime,
+                          const std::shared_ptr<hippy::napi::Ctx>& ctx);
   static bool Erase(int32_t id);
   static bool Erase(const std::shared_ptr<Runtime>& runtime);
 
@@ -115,6 +145,13 @@ class Runtime {
   std::unordered_map<uint32_t, std::any> slot_;
   std::shared_ptr<hippy::InterruptQueue> interrupt_queue_;
   std::function<size_t(void*, size_t, size_t)> near_heap_limit_cb_;
+  uint64_t init_time_;
+  bool is_pooled_;
+  std::atomic<bool> has_run_script_;
+  std::mutex bundle_gate_mutex_;
+  // the last link of the chain of pending bundles and the calls waiting for them
+  std::optional<TaskFuture<void>> bundle_gate_;
+  uint64_t bundle_gate_id_;
 #ifndef V8_WITHOUT_INSPECTOR
   std::shared_ptr<V8InspectorContext> inspector_context_;
 #endif
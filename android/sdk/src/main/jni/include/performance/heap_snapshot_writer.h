@@ -0,0 +1,99 @@
+/*
+ *
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2022 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <zlib.h>
+
+namespace hippy {
+namespace bridge {
+
+// Writes a stream of chunks to a file on a thread of its own, optionally gzip compressed.
+// The producer only copies data into large buffers; a full queue blocks it until the writer
+// catches up, which bounds the memory held by pending chunks.
+class HeapSnapshotWriter {
+ public:
+  struct Options {
+    // gzip the output, the file can be read by any tool after gunzip
+    bool compress = false;
+    // bytes allowed on disk, 0 means no limit. Exceeding it aborts the write and removes the file
+    size_t max_size = 0;
+    size_t chunk_size = 64 * 1024;
+    // buffers waiting for the writer thread
+    size_t queue_capacity = 8;
+  };
+
+  enum class Status : int8_t {
+    kOk = 0,
+    kFileError = 1,
+    kWriteError = 2,
+    kSizeExceeded = 3
+  };
+
+  explicit HeapSnapshotWriter(Options options);
+  ~HeapSnapshotWriter();
+  HeapSnapshotWriter(const HeapSnapshotWriter&) = delete;
+  HeapSnapshotWriter& operator=(const HeapSnapshotWriter&) = delete;
+
+  bool Open(const std::string& path);
+  // Returns false once the write failed, the producer should stop.
+  bool Write(const char* data, size_t size);
+  // Flushes pending data and waits for the writer thread. A failed file is removed.
+  Status Close();
+
+  inline size_t GetChunkSize() const { return options_.chunk_size; }
+
+ private:
+  void ThreadMain();
+  void Enqueue(std::vector<char> buffer, bool is_last);
+  bool Output(const char* data, size_t size, bool is_last);
+  bool Emit(const char* data, size_t size);
+  void SetStatus(Status status);
+
+  Options options_;
+  std::string path_;
+  std::ofstream file_;
+  z_stream stream_;
+  bool has_stream_;
+  std::vector<char> buffer_;
+  std::vector<char> out_buffer_;
+  size_t input_size_;
+  size_t output_size_;
+  std::deque<std::vector<char>> queue_;
+  bool is_closing_;
+  std::atomic<Status> status_;
+  std::mutex mutex_;
+  std::condition_variable not_empty_;
+  std::condition_variable not_full_;
+  std::thread thread_;
+};
+
+}  // namespace bridge
+}  // namespace hippy
@@ -54,10 +54,14 @@ jboolean GetHeapSpaceStatistics(JNIEnv *j_env,
 // [Heap] WriteHeapSnapshot
 // Creating a heap snapshot requires memory about twice the size of the heap at the time the snapshot is created.
 // This results in the risk of OOM killers terminating the process.
+// With j_compress the file is gzip compressed. A positive j_max_size caps the file size,
+// the write is aborted and the file removed once it is exceeded.
 jboolean WriteHeapSnapshot(JNIEnv *j_env,
                            jobject j_object,
                            jlong j_runtime_id,
                            jstring j_heap_snapshot_path,
+                           jboolean j_compress,
+                           jlong j_max_size,
                            jobject j_callback);
 
 }  // namespace bridge
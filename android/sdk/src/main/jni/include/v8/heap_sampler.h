@@ -0,0 +1,50 @@
+/*
+ *
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2022 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include <jni.h>
+
+#include "jni/jni_register.h"
+
+namespace hippy {
+inline namespace driver {
+inline namespace v8_engine {
+
+void StartHeapSampler(JNIEnv *j_env,
+                      jobject j_object,
+                      jlong j_runtime_id,
+                      jint j_interval_in_ms,
+                      jint j_capacity);
+
+void StopHeapSampler(JNIEnv *j_env,
+                     jobject j_object,
+                     jlong j_runtime_id);
+
+void GetHeapSamples(JNIEnv *j_env,
+                    jobject j_object,
+                    jlong j_runtime_id,
+                    jobject j_callback);
+
+}
+}
+}
@@ -22,10 +22,11 @@
 
 #pragma once
 
+#include <array>
 #include <atomic>
+#include <deque>
 #include <memory>
 #include <mutex>
-#include <queue>
 
 #include "core/base/task.h"
 #include "core/base/task_runner.h"
@@ -40,12 +41,26 @@ namespace hippy {
 inline namespace driver {
 inline namespace runtime {
 
+// Runs tasks on the JS thread as soon as possible, interrupting running JS if needed.
+// A burst of posts is served by a single wakeup, which is one task runner task plus one isolate
+// interrupt, whichever comes first drains the queue. Tasks run in the order of the priority lanes the
+// callers post them to. A drain stops after kBudgetInUs, leaving the rest to the task runner so that
+// the interrupted JS can go on.
 class InterruptQueue: public std::enable_shared_from_this<InterruptQueue> {
  public:
   using Task = base::Task;
   using TaskRunner = base::TaskRunner;
   using PersistentObjectMap = footstone::PersistentObjectMap<uint32_t, std::shared_ptr<InterruptQueue>>;
 
+  static constexpr uint64_t kBudgetInUs = 2000;
+
+  struct Stats {
+    uint64_t task_count = 0;
+    // from PostTask to the start of the task
+    uint64_t total_latency_in_us = 0;
+    uint64_t max_latency_in_us = 0;
+  };
+
   InterruptQueue(v8::Isolate* isolate_);
   ~InterruptQueue() = default;
 
@@ -55,19 +70,37 @@ class InterruptQueue: public std::enable_shared_from_this<InterruptQueue> {
     task_runner_ = task_runner;
   }
 
-  void PostTask(std::unique_ptr<Task> task);
-  void Run();
+  void PostTask(std::unique_ptr<Task> task, Task::Priority priority = Task::Priority::kNormal);
+  Stats GetStats();
 
   static inline PersistentObjectMap& GetPersistentMap() {
     return persistent_map_;
   }
 
  private:
+  struct Entry {
+    std::unique_ptr<Task> task;
+    uint64_t post_time_in_us;
+  };
+
+  static void OnInterrupt(v8::Isolate* isolate, void* data);
+
+  void Run();
+  void PostRunnerTask();
+
   uint32_t id_;
   v8::Isolate* isolate_;
-  std::queue<std::unique_ptr<Task>> task_queue_;
+  std::array<std::deque<Entry>, Task::kPriorityCount> task_lanes_;
   std::mutex queue_mutex_;
+  std::atomic<size_t> task_count_;
+  // Each half of a wakeup has its own flag, cleared when that half runs. A post only issues the
+  // halves that are not pending, so after a drain handed its rest to the task runner alone, the
+  // next post still requests an interrupt.
+  std::atomic<bool> is_interrupt_pending_;
+  std::atomic<bool> is_runner_task_pending_;
   std::shared_ptr<TaskRunner> task_runner_;
+  // guarded by queue_mutex_
+  Stats stats_;
 
   static std::atomic<uint32_t> g_id;
   static PersistentObjectMap persistent_map_;
@@ -76,4 +109,3 @@ class InterruptQueue: public std::enable_shared_from_this<InterruptQueue> {
 } // namespace runtime
 } // namespace driver
 } // namespace hippy
-
@@ -33,6 +33,7 @@ inline namespace v8_engine {
 void RequestInterrupt(JNIEnv *j_env,
                       jobject j_object,
                       jlong j_runtime_id,
+                      jint j_priority,
                       jobject j_callback);
 
 }
@@ -26,7 +26,7 @@
 #include <android/asset_manager_jni.h>
 #include <sys/stat.h>
 
-#include <future>
+#include <cstdio>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -35,11 +35,14 @@
 #include "bridge/adr_bridge.h"
 #include "bridge/java2js.h"
 #include "bridge/js2java.h"
+#include "base/async_logger.h"
 #include "bridge/runtime.h"
+#include "core/base/trace_event.h"
 #include "core/core.h"
 #include "core/napi/v8/v8_ctx.h"
 #include "core/napi/v8/v8_ctx_value.h"
 #include "core/vm/v8/v8_vm.h"
+#include "core/vm/v8/snapshot_builder.h"
 #include "core/vm/v8/snapshot_data.h"
 #include "jni/turbo_module_manager.h"
 #include "jni/exception_handler.h"
@@ -60,7 +63,6 @@ using StringViewUtils = hippy::base::StringViewUtils;
 using HippyFile = hippy::base::HippyFile;
 using VM = hippy::vm::VM;
 using V8VM = hippy::vm::V8VM;
-using V8SnapshotVM = hippy::vm::V8SnapshotVM;
 using V8VMInitParam = hippy::vm::V8VMInitParam;
 #ifndef V8_WITHOUT_INSPECTOR
 using V8InspectorClientImpl = hippy::inspector::V8InspectorClientImpl;
@@ -71,7 +73,9 @@ constexpr char kGlobalKey[] = "global";
 constexpr char kNativeGlobalKey[] = "__HIPPYNATIVEGLOBAL__";
 constexpr char kCallNativesKey[] = "hippyCallNatives";
 constexpr char kCurDir[] = "__HIPPYCURDIR__";
+constexpr char kDefaultSnapshotContext[] = "default";
 constexpr char kCodeCacheFailCountFilePostfix[] = "_fail_count";
+constexpr uint64_t kWarmCodeCacheDelayInMs = 5000;
 const uint8_t kCodeCacheMaxFailCount = 3;
 
 std::vector<intptr_t> external_references{};
@@ -128,6 +132,21 @@ REGISTER_STATIC_JNI("com/tencent/mtt/hippy/bridge/HippyBridgeImpl", // NOLINT(ce
                     "([Ljava/lang/String;Ljava/lang/String;Ljava/lang/String;Ljava/lang/String;)I",
                     CreateSnapshot)
 
+REGISTER_STATIC_JNI("com/tencent/mtt/hippy/bridge/HippyBridgeImpl", // NOLINT(cert-err58-cpp)
+                    "startTracing",
+                    "(ID)Z",
+                    StartTracing)
+
+REGISTER_STATIC_JNI("com/tencent/mtt/hippy/bridge/HippyBridgeImpl", // NOLINT(cert-err58-cpp)
+                    "stopTracing",
+                    "(Ljava/lang/String;)Z",
+                    StopTracing)
+
+REGISTER_STATIC_JNI("com/tencent/mtt/hippy/bridge/HippyBridgeImpl", // NOLINT(cert-err58-cpp)
+                    "setEnginePool",
+                    "(IJ)V",
+                    SetEnginePool)
+
 REGISTER_JNI("com/tencent/mtt/hippy/bridge/HippyBridgeImpl", // NOLINT(cert-err58-cpp)
              "initJSFramework",
              "([BZZZLcom/tencent/mtt/hippy/bridge/NativeCallback;"
@@ -155,6 +174,11 @@ REGISTER_JNI("com/tencent/mtt/hippy/bridge/HippyBridgeImpl", // NOLINT(cert-err5
              "(JLcom/tencent/mtt/hippy/common/Callback;)V",
              RunInJsThread)
 
+REGISTER_JNI("com/tencent/mtt/hippy/bridge/HippyBridgeImpl", // NOLINT(cert-err58-cpp)
+             "onMemoryPressure",
+             "(JI)V",
+             OnMemoryPressure)
+
 
 static std::unordered_map<int64_t, std::pair<std::shared_ptr<Engine>, uint32_t>>
     reuse_engine_map;
@@ -162,6 +186,8 @@ static std::mutex engine_mutex;
 static std::mutex log_mutex;
 static std::mutex code_cache_file_mutex;
 static bool is_inited = false;
+// engines warmed ahead of InitInstance, null unless enabled by setEnginePool. Guarded by engine_mutex
+static std::shared_ptr<EnginePool> engine_pool;
 
 constexpr int64_t kDefaultEngineId = -1;
 constexpr int64_t kDebuggerEngineId = -9999;
@@ -219,11 +245,29 @@ void setNativeLogHandler(JNIEnv* j_env, __unused jobject j_object, jobject j_log
         j_env->DeleteLocalRef(j_tag_str);
         j_env->DeleteLocalRef(j_logger_str);
       });
+      // the Java logger is called from a background thread from now on
+      tdf::base::AsyncLogger::Start();
       is_inited = true;
     }
   }
 }
 
+// Logs the time from InitInstance to the first script run, which compares the instances that
+// took a pooled engine with the ones that created theirs. Runs on the JS thread.
+static void ReportFirstScriptRun(const std::shared_ptr<Runtime>& runtime) {
+  if (!runtime->MarkScriptRun()) {
+    return;
+  }
+  auto cost = hippy::base::MonotonicallyIncreasingTime() - runtime->GetInitTime();
+  TDF_BASE_LOG(INFO) << "first RunScript " << cost << "ms after InitInstance, runtime_id = "
+                     << runtime->GetId() << ", is_pooled = " << runtime->IsPooled();
+  if (runtime->IsPooled()) {
+    HIPPY_TRACE_COUNTER("startup", "InitToFirstRunScriptInMs.Pooled", static_cast<int64_t>(cost));
+  } else {
+    HIPPY_TRACE_COUNTER("startup", "InitToFirstRunScriptInMs.Created", static_cast<int64_t>(cost));
+  }
+}
+
 void RunScript(JNIEnv* j_env, __unused jobject, jlong j_runtime_id, jstring j_script) {
   TDF_BASE_DLOG(INFO) << "RunScript, j_runtime_id = " << j_runtime_id;
   auto runtime = Runtime::Find(hippy::base::checked_numeric_cast<jlong, int32_t>(j_runtime_id));
@@ -233,13 +277,13 @@ void RunScript(JNIEnv* j_env, __unused jobject, jlong j_runtime_id, jstring j_sc
   }
   const unicode_string_view script = JniUtils::ToStrView(j_env, j_script);
   TDF_BASE_DLOG(INFO) << "RunScript, script = " << script;
-  auto runner = runtime->GetEngine()->GetJSRunner();
   std::shared_ptr<JavaScriptTask> task = std::make_shared<JavaScriptTask>();
   task->callback = [runtime, script{std::move(script)}] () mutable {
+    ReportFirstScriptRun(runtime);
     auto context = std::static_pointer_cast<hippy::napi::V8Ctx>(runtime->GetScope()->GetContext());
     auto ret = context->RunScript(script, "");
   };
-  runner->PostTask(task);
+  runtime->PostTaskAfterBundles(task);
 }
 
 // Code cache file corruption prevention strategy:
@@ -274,82 +318,158 @@ void CheckUseCodeCacheAfterRunScript(const unicode_string_view& code_cache_path)
   HippyFile::RmFile(fail_count_path);
 }
 
-bool RunScriptInternal(const std::shared_ptr<Runtime>& runtime,
-                       const unicode_string_view& file_name,
-                       bool is_use_code_cache,
-                       const unicode_string_view& code_cache_dir,
-                       const unicode_string_view& uri,
-                       AAssetManager* asset_manager,
-                       std::chrono::time_point<std::chrono::system_clock> &load_start,
-                       std::chrono::time_point<std::chrono::system_clock> &load_end) {
-  TDF_BASE_LOG(INFO) << "RunScriptInternal begin, file_name = " << file_name
+static void SaveCodeCache(const unicode_string_view& code_cache_path,
+                          const unicode_string_view& code_cache_dir,
+                          const unicode_string_view& code_cache_content) {
+  std::lock_guard<std::mutex> lock(code_cache_file_mutex);
+  int check_dir_ret = HippyFile::CheckDir(code_cache_dir, F_OK);
+  TDF_BASE_DLOG(INFO) << "check_parent_dir_ret = " << check_dir_ret;
+  if (check_dir_ret) {
+    HippyFile::CreateDir(code_cache_dir, S_IRWXU);
+  }
+
+  size_t pos = StringViewUtils::FindLastOf(code_cache_path, EXTEND_LITERAL('/'));
+  unicode_string_view code_cache_parent_dir = StringViewUtils::SubStr(code_cache_path, 0, pos);
+  int check_parent_dir_ret =
+      HippyFile::CheckDir(code_cache_parent_dir, F_OK);
+  TDF_BASE_DLOG(INFO)
+      << "check_parent_dir_ret = " << check_parent_dir_ret;
+  if (check_parent_dir_ret) {
+    HippyFile::CreateDir(code_cache_parent_dir, S_IRWXU);
+  }
+
+  std::string u8_code_cache_content =
+      StringViewUtils::ToU8StdStr(code_cache_content);
+  bool save_file_ret = HippyFile::SaveFile(code_cache_path, u8_code_cache_content);
+  TDF_BASE_LOG(INFO) << "code cache save_file_ret = " << save_file_ret;
+  HIPPY_USE(save_file_ret);
+
+  CheckUseCodeCacheAfterRunScript(code_cache_path);
+}
+
+// The code cache created right after compiling only holds the top-level code. Once the page has
+// settled it is created again, so that the functions compiled lazily during startup are included.
+static void ScheduleWarmCodeCache(const std::shared_ptr<Runtime>& runtime,
+                                  const unicode_string_view& file_name,
+                                  const unicode_string_view& code_cache_path,
+                                  const unicode_string_view& code_cache_dir) {
+  std::weak_ptr<Scope> weak_scope = runtime->GetScope();
+  std::weak_ptr<WorkerTaskRunner> weak_runner = runtime->GetEngine()->GetWorkerTaskRunner();
+  auto task = std::make_shared<JavaScriptTask>();
+  task->callback = [weak_scope, weak_runner, file_name, code_cache_path, code_cache_dir] {
+    auto scope = weak_scope.lock();
+    auto runner = weak_runner.lock();
+    if (!scope || !runner) {
+      return;
+    }
+    auto ctx = std::static_pointer_cast<hippy::napi::V8Ctx>(scope->GetContext());
+    unicode_string_view code_cache_content;
+    if (!ctx->CreateWarmCodeCache(file_name, &code_cache_content)) {
+      return;
+    }
+    hippy::napi::V8Ctx::CodeCacheInfo info;
+    ctx->GetCodeCacheInfo(file_name, info);
+    TDF_BASE_LOG(INFO) << "warm code cache, file_name = " << file_name
+                       << ", cache_size = " << info.cache_size
+                       << ", warm_cache_size = " << info.warm_cache_size;
+    auto save_task = std::make_unique<CommonTask>();
+    save_task->func_ = [code_cache_path, code_cache_dir, code_cache_content] {
+      SaveCodeCache(code_cache_path, code_cache_dir, code_cache_content);
+    };
+    runner->PostTask(std::move(save_task));
+  };
+  task->priority_ = hippy::base::Task::Priority::kIdle;
+  runtime->GetEngine()->GetJSRunner()->PostDelayedTask(task, kWarmCodeCacheDelayInMs);
+}
+
+struct ScriptSource {
+  bool is_loaded = false;
+  unicode_string_view script_content;
+  unicode_string_view code_cache_content;
+  unicode_string_view code_cache_path;
+  std::chrono::time_point<std::chrono::system_clock> load_start;
+  std::chrono::time_point<std::chrono::system_clock> load_end;
+  // connects the load on the worker thread with the run on the JS thread in a trace
+  uint64_t flow_id = 0;
+};
+
+// Reads the script and its code cache, runs on the worker thread.
+static ScriptSource LoadScript(const std::shared_ptr<Runtime>& runtime,
+                               const unicode_string_view& file_name,
+                               bool is_use_code_cache,
+                               const unicode_string_view& code_cache_dir,
+                               const unicode_string_view& uri,
+                               AAssetManager* asset_manager) {
+  TDF_BASE_LOG(INFO) << "LoadScript begin, file_name = " << file_name
                      << ", is_use_code_cache = " << is_use_code_cache
                      << ", code_cache_dir = " << code_cache_dir
                      << ", uri = " << uri
                      << ", asset_manager = " << asset_manager;
-  unicode_string_view script_content;
-  bool read_script_flag;
-  unicode_string_view code_cache_content;
-  uint64_t modify_time = 0;
-
-  load_start = std::chrono::system_clock::now();
-  auto engine = runtime->GetEngine();
-  auto task_runner = engine->GetWorkerTaskRunner();
-  unicode_string_view code_cache_path;
+  HIPPY_TRACE_EVENT("loader", "LoadScript");
+  ScriptSource source;
+  source.load_start = std::chrono::system_clock::now();
   if (is_use_code_cache) {
+    HIPPY_TRACE_EVENT("loader", "ReadCodeCache");
+    uint64_t modify_time = 0;
     if (!asset_manager) {
       modify_time = HippyFile::GetFileModifytime(uri);
     }
 
-    code_cache_path = code_cache_dir + file_name + unicode_string_view("_") +
-                      unicode_string_view(std::to_string(modify_time));
+    source.code_cache_path = code_cache_dir + file_name + unicode_string_view("_") +
+                             unicode_string_view(std::to_string(modify_time));
 
-    std::promise<u8string> read_file_promise;
-    auto read_file_future = read_file_promise.get_future();
-    auto task = std::make_unique<CommonTask>();
-    task->func_ = hippy::base::MakeCopyable([p = std::move(read_file_promise),
-                                             code_cache_path, code_cache_dir]() mutable {
-      std::lock_guard<std::mutex> lock(code_cache_file_mutex);
-      u8string content;
-      HippyFile::ReadFile(code_cache_path, content, true);
-      if (content.empty()) {
-        TDF_BASE_DLOG(INFO) << "Read code cache failed";
+    std::lock_guard<std::mutex> lock(code_cache_file_mutex);
+    u8string content;
+    HippyFile::ReadFile(source.code_cache_path, content, true);
+    if (content.empty()) {
+      TDF_BASE_DLOG(INFO) << "Read code cache failed";
+      int ret = HippyFile::RmFullPath(code_cache_dir);
+      TDF_BASE_DLOG(INFO) << "RmFullPath ret = " << ret;
+      HIPPY_USE(ret);
+    } else {
+      TDF_BASE_DLOG(INFO) << "Read code cache succ";
+      if (!CheckUseCodeCacheBeforeRunScript(source.code_cache_path)) {
         int ret = HippyFile::RmFullPath(code_cache_dir);
-        TDF_BASE_DLOG(INFO) << "RmFullPath ret = " << ret;
+        TDF_BASE_DLOG(INFO) << "RmFullPath on check, ret = " << ret;
         HIPPY_USE(ret);
-      } else {
-        TDF_BASE_DLOG(INFO) << "Read code cache succ";
-        if (!CheckUseCodeCacheBeforeRunScript(code_cache_path)) {
-          int ret = HippyFile::RmFullPath(code_cache_dir);
-          TDF_BASE_DLOG(INFO) << "RmFullPath on check, ret = " << ret;
-          HIPPY_USE(ret);
-          content.clear();
-        }
+        content.clear();
       }
-      p.set_value(std::move(content));
-    });
-    task_runner->PostPromiseTask(std::move(task));
-    u8string content;
-    read_script_flag = runtime->GetScope()->GetUriLoader()->RequestUntrustedContent(uri, content);
-    if (read_script_flag) {
-      script_content = unicode_string_view(std::move(content));
-    }
-    code_cache_content = read_file_future.get();
-  } else {
-    u8string content;
-    read_script_flag = runtime->GetScope()->GetUriLoader()->RequestUntrustedContent(uri, content);
-    if (read_script_flag) {
-      script_content = unicode_string_view(std::move(content));
     }
+    source.code_cache_content = unicode_string_view(std::move(content));
   }
-  load_end = std::chrono::system_clock::now();
+  u8string content;
+  source.is_loaded = runtime->GetScope()->GetUriLoader()->RequestUntrustedContent(uri, content);
+  if (source.is_loaded) {
+    source.script_content = unicode_string_view(std::move(content));
+  }
+  source.load_end = std::chrono::system_clock::now();
+  auto& trace_log = hippy::base::TraceLog::GetInstance();
+  if (trace_log.IsEnabled()) {
+    source.flow_id = trace_log.NewFlowId();
+    HIPPY_TRACE_FLOW_BEGIN("loader", "RunScriptFromUri", source.flow_id);
+  }
+  return source;
+}
 
+// Compiles and runs a loaded script, runs on the JS thread.
+static bool RunLoadedScript(const std::shared_ptr<Runtime>& runtime,
+                            const unicode_string_view& file_name,
+                            bool is_use_code_cache,
+                            const unicode_string_view& code_cache_dir,
+                            const unicode_string_view& uri,
+                            ScriptSource& source) {
+  HIPPY_TRACE_EVENT("loader", "RunLoadedScript");
+  ReportFirstScriptRun(runtime);
+  if (source.flow_id) {
+    HIPPY_TRACE_FLOW_END("loader", "RunScriptFromUri", source.flow_id);
+  }
   TDF_BASE_DLOG(INFO) << "uri = " << uri
-                      << "read_script_flag = " << read_script_flag
-                      << ", script content = " << script_content;
+                      << "read_script_flag = " << source.is_loaded
+                      << ", script content = " << source.script_content;
 
-  if (!read_script_flag || StringViewUtils::IsEmpty(script_content)) {
-    TDF_BASE_LOG(WARNING) << "read_script_flag = " << read_script_flag
+  const unicode_string_view& code_cache_path = source.code_cache_path;
+  if (!source.is_loaded || StringViewUtils::IsEmpty(source.script_content)) {
+    TDF_BASE_LOG(WARNING) << "read_script_flag = " << source.is_loaded
                           << ", script content empty, uri = " << uri;
     if (is_use_code_cache) {
       std::lock_guard<std::mutex> lock(code_cache_file_mutex);
@@ -358,40 +478,40 @@ bool RunScriptInternal(const std::shared_ptr<Runtime>& runtime,
     return false;
   }
 
+  if (is_use_code_cache) {
+    // the chunks this bundle loads use a code cache as well
+    auto contextify = std::static_pointer_cast<ContextifyModule>(
+        runtime->GetScope()->GetModuleObject("ContextifyModule"));
+    if (contextify) {
+      contextify->SetCodeCacheEnabled(true);
+    }
+  }
+
+  auto task_runner = runtime->GetEngine()->GetWorkerTaskRunner();
+  unicode_string_view& code_cache_content = source.code_cache_content;
   auto ret = std::static_pointer_cast<hippy::napi::V8Ctx>(
       runtime->GetScope()->GetContext())->RunScript(
-          script_content, file_name, is_use_code_cache,&code_cache_content, true);
+          source.script_content, file_name, is_use_code_cache, &code_cache_content, true);
   if (is_use_code_cache) {
     if (!StringViewUtils::IsEmpty(code_cache_content)) {
       std::unique_ptr<CommonTask> task = std::make_unique<CommonTask>();
       task->func_ = [code_cache_path, code_cache_dir, code_cache_content] {
-        std::lock_guard<std::mutex> lock(code_cache_file_mutex);
-        int check_dir_ret = HippyFile::CheckDir(code_cache_dir, F_OK);
-        TDF_BASE_DLOG(INFO) << "check_parent_dir_ret = " << check_dir_ret;
-        if (check_dir_ret) {
-          HippyFile::CreateDir(code_cache_dir, S_IRWXU);
-        }
-
-        size_t pos = StringViewUtils::FindLastOf(code_cache_path, EXTEND_LITERAL('/'));
-        unicode_string_view code_cache_parent_dir = StringViewUtils::SubStr(code_cache_path, 0, pos);
-        int check_parent_dir_ret =
-            HippyFile::CheckDir(code_cache_parent_dir, F_OK);
-        TDF_BASE_DLOG(INFO)
-            << "check_parent_dir_ret = " << check_parent_dir_ret;
-        if (check_parent_dir_ret) {
-          HippyFile::CreateDir(code_cache_parent_dir, S_IRWXU);
-        }
-
-        std::string u8_code_cache_content =
-            StringViewUtils::ToU8StdStr(code_cache_content);
-        bool save_file_ret = HippyFile::SaveFile(code_cache_path, u8_code_cache_content);
-        TDF_BASE_LOG(INFO) << "code cache save_file_ret = " << save_file_ret;
-        HIPPY_USE(save_file_ret);
-
-        CheckUseCodeCacheAfterRunScript(code_cache_path);
+        SaveCodeCache(code_cache_path, code_cache_dir, code_cache_content);
       };
       task_runner->PostTask(std::move(task));
     }
+    hippy::napi::V8Ctx::CodeCacheInfo info;
+    if (ret && std::static_pointer_cast<hippy::napi::V8Ctx>(runtime->GetScope()->GetContext())->GetCodeCacheInfo(
+        file_name, info)) {
+      // compare compile_time between launches with and without a consumed cache for the savings
+      TDF_BASE_LOG(INFO) << "code cache, file_name = " << file_name
+                         << ", is_cache_consumed = " << info.is_cache_consumed
+                         << ", cache_size = " << info.cache_size
+                         << ", compile_time = " << info.compile_time_in_us << "us";
+      if (!info.is_cache_consumed) {
+        ScheduleWarmCodeCache(runtime, file_name, code_cache_path, code_cache_dir);
+      }
+    }
   }
 
   bool flag = (ret != nullptr);
@@ -413,10 +533,6 @@ jint CreateSnapshot(JNIEnv* j_env,
       std::chrono::system_clock::now())
       .time_since_epoch()
       .count();
-  auto vm = std::make_shared<V8SnapshotVM>();
-  auto engine = std::make_shared<Engine>();
-  engine->SyncInit(vm);
-
   auto base_path = JniUtils::ToStrView(j_env, j_base_path);
   auto global_config = JniUtils::ToStrView(j_env, j_config);
   TDF_BASE_LOG(INFO) << "CreateSnapshot global_config = " << global_config;
@@ -428,52 +544,45 @@ jint CreateSnapshot(JNIEnv* j_env,
     TDF_BASE_CHECK(scope);
     auto ctx = scope->GetContext();
     auto global_object = ctx->GetGlobalObject();
-    auto user_global_object_key = ctx->CreateString(kGlobalKey);
+    auto user_global_object_key = ctx->GetPropertyKey(kGlobalKey);
     ctx->SetProperty(global_object, user_global_object_key, global_object);
-    auto native_global_key = ctx->CreateString(kNativeGlobalKey);
+    auto native_global_key = ctx->GetPropertyKey(kNativeGlobalKey);
     auto global_config_object = V8VM::ParseJson(ctx, global_config);
     ctx->SetProperty(global_object, native_global_key, global_config_object);
-    auto key = ctx->CreateString(kCurDir);
+    auto key = ctx->GetPropertyKey(kCurDir);
     auto value = ctx->CreateString(base_path);
     ctx->SetProperty(global_object, key, value);
   };
-  std::unique_ptr<RegisterMap> scope_cb_map = std::make_unique<RegisterMap>();
-  scope_cb_map->insert({hippy::base::kContextCreatedCBKey, context_cb});
-  auto scope = engine->SyncCreateScope(std::move(scope_cb_map));
-  auto v8_ctx = std::static_pointer_cast<hippy::napi::V8Ctx>(scope->GetContext());
+  SnapshotBuilder::ContextConfig config;
+  config.name = kDefaultSnapshotContext;
   auto cnt = j_env->GetArrayLength(j_script_array);
   for (auto i = 0; i < cnt; ++i) {
     auto j_script = reinterpret_cast<jstring>(j_env->GetObjectArrayElement(j_script_array, i));
-    auto script = JniUtils::ToStrView(j_env, j_script);
-    hippy::napi::V8TryCatch try_catch(true, v8_ctx);
-    auto result = v8_ctx->RunScript(script, "");
-    if (try_catch.HasCaught()) {
-      TDF_BASE_LOG(ERROR) << "RunScript error, error = " << try_catch.GetExceptionMsg();
-      return static_cast<jint>(CreateSnapshotResult::kRunScriptError);
-    }
+    config.scripts.push_back({"", JniUtils::ToStrView(j_env, j_script)});
   }
-  auto creator = vm->snapshot_creator_;
-  v8_ctx->SetDefaultContext(creator);
-  TDF_BASE_LOG(INFO) << "CreateBlob";
-  v8_ctx = nullptr;
-  scope = nullptr;
-  auto blob = creator->CreateBlob(v8::SnapshotCreator::FunctionCodeHandling::kKeep);
-#if (V8_MAJOR_VERSION >= 9)
-  if (!blob.IsValid()) {
+  SnapshotBuilder builder(context_cb);
+  SnapshotData snapshot_data;
+  auto result = builder.Build({config}, snapshot_data);
+  if (result == SnapshotBuilder::Result::kRunScriptError) {
+    return static_cast<jint>(CreateSnapshotResult::kRunScriptError);
+  } else if (result == SnapshotBuilder::Result::kSnapshotBlobInvalid) {
     return static_cast<jint>(CreateSnapshotResult::kSnapshotBlobInvalid);
   }
-#endif
-  SnapshotData snapshot_data;
-  snapshot_data.WriteMetaData(blob);
   auto time_end = std::chrono::time_point_cast<std::chrono::microseconds>(
       std::chrono::system_clock::now())
       .time_since_epoch()
       .count();
-  TDF_BASE_LOG(INFO) << "blob size = " << blob.raw_size << ", buffer size = " << snapshot_data.buffer_holder.size()
+  TDF_BASE_LOG(INFO) << "blob size = " << snapshot_data.startup_data.raw_size << ", buffer size = " << snapshot_data.buffer_holder.size()
     << ", cost = " << (time_end - time_begin);
   auto snapshot_uri = JniUtils::ToStrView(j_env, j_snapshot_uri);
-  bool save_file_ret = HippyFile::SaveFile(snapshot_uri, snapshot_data.buffer_holder);
-  if (!save_file_ret) {
+  // running instances may have the old file mapped, replace it instead of writing into it
+  auto snapshot_path = StringViewUtils::ToU8StdStr(snapshot_uri);
+  auto tmp_path = snapshot_path + ".tmp";
+  bool save_file_ret = HippyFile::SaveFile(StringViewUtils::ConstCharPointerToStrView(tmp_path.c_str(),
+                                                                                    tmp_path.length()),
+                                           snapshot_data.buffer_holder);
+  if (!save_file_ret || std::rename(tmp_path.c_str(), snapshot_path.c_str()) != 0) {
+    std::remove(tmp_path.c_str());
     return static_cast<jint>(CreateSnapshotResult::kSaveSnapshotFailed);
   }
   return static_cast<jint>(CreateSnapshotResult::kSuccess);
@@ -515,32 +624,32 @@ jboolean RunScriptFromUri(JNIEnv* j_env,
                       << ", base_path = " << base_path
                       << ", code_cache_dir = " << code_cache_dir;
 
-  auto runner = runtime->GetEngine()->GetJSRunner();
-  std::shared_ptr<Ctx> ctx = runtime->GetScope()->GetContext();
-  std::shared_ptr<JavaScriptTask> task = std::make_shared<JavaScriptTask>();
-  task->callback = [ctx, base_path] {
-    auto key = ctx->CreateString(kCurDir);
-    auto value = ctx->CreateString(base_path);
-    auto global = ctx->GetGlobalObject();
-    ctx->SetProperty(global, key, value);
-  };
-  runner->PostTask(task);
-
   AAssetManager* aasset_manager = nullptr;
   if (j_aasset_manager) {
     aasset_manager = AAssetManager_fromJava(j_env, j_aasset_manager);
   }
 
+  // the script and its code cache are read on the worker thread at once, meanwhile the JS thread
+  // keeps running the tasks queued before this one. The bundle is evaluated once it is loaded and
+  // the bundles posted before it were evaluated. The bridge calls posted after it, e.g.
+  // loadInstance, wait for it with PostTaskAfterBundles.
+  bool is_use_code_cache = j_can_use_code_cache;
+  TaskPromise<void> evaluated;
+  uint64_t gate_id;
+  auto previous = runtime->SetBundleGate(evaluated.GetFuture(), gate_id);
+  auto runner = runtime->GetEngine()->GetJSRunner();
   std::shared_ptr<JavaRef> save_object = std::make_shared<JavaRef>(j_env, j_cb);
-  task = std::make_shared<JavaScriptTask>();
-  task->callback = [runtime, save_object_ = std::move(save_object), script_name,
-                    j_can_use_code_cache, code_cache_dir, uri, aasset_manager,
-                    time_begin] {
-    TDF_BASE_DLOG(INFO) << "runScriptFromUri enter";
-    std::chrono::time_point<std::chrono::system_clock> load_start;
-    std::chrono::time_point<std::chrono::system_clock> load_end;
-    bool flag = RunScriptInternal(runtime, script_name, j_can_use_code_cache,
-                                  code_cache_dir, uri, aasset_manager, load_start, load_end);
+  auto run = [runtime, save_object_ = std::move(save_object), script_name, base_path, is_use_code_cache,
+              code_cache_dir, uri, time_begin, gate_id,
+              evaluated = std::move(evaluated)](ScriptSource source) mutable {
+    std::shared_ptr<Ctx> ctx = runtime->GetScope()->GetContext();
+    auto key = ctx->GetPropertyKey(kCurDir);
+    ctx->SetProperty(ctx->GetGlobalObject(), key, ctx->CreateString(base_path));
+
+    bool flag = RunLoadedScript(runtime, script_name, is_use_code_cache, code_cache_dir, uri, source);
+    // a failed bundle releases the calls as well, they report their own errors
+    runtime->ResetBundleGate(gate_id);
+    evaluated.SetValue();
     auto time_end = std::chrono::time_point_cast<std::chrono::microseconds>(
                         std::chrono::system_clock::now())
                         .time_since_epoch()
@@ -549,10 +658,10 @@ jboolean RunScriptFromUri(JNIEnv* j_env,
     TDF_BASE_DLOG(INFO) << "runScriptFromUri = " << (time_end - time_begin) << ", uri = " << uri;
 
     JNIEnv* j_env = JNIEnvironment::GetInstance()->AttachCurrentThread();
-    auto load_start_millis = std::chrono::time_point_cast<std::chrono::milliseconds>(load_start)
+    auto load_start_millis = std::chrono::time_point_cast<std::chrono::milliseconds>(source.load_start)
         .time_since_epoch()
         .count();
-    auto load_end_millis = std::chrono::time_point_cast<std::chrono::milliseconds>(load_end)
+    auto load_end_millis = std::chrono::time_point_cast<std::chrono::milliseconds>(source.load_end)
         .time_since_epoch()
         .count();
     std::string payload = "{\"load_start_millis\":" + std::to_string(load_start_millis)
@@ -566,10 +675,21 @@ jboolean RunScriptFromUri(JNIEnv* j_env,
       j_env->DeleteLocalRef(j_msg);
     }
     j_env->DeleteLocalRef(j_payload);
-    return flag;
   };
-
-  runner->PostTask(task);
+  RunAsync(runtime->GetEngine()->GetWorkerTaskRunner(),
+           [runtime, script_name, is_use_code_cache, code_cache_dir, uri, aasset_manager] {
+    TDF_BASE_DLOG(INFO) << "runScriptFromUri enter";
+    return LoadScript(runtime, script_name, is_use_code_cache, code_cache_dir, uri, aasset_manager);
+  }).Then(runner, [runner, previous = std::move(previous), run = std::move(run)](ScriptSource source) mutable {
+    if (!previous) {
+      run(std::move(source));
+      return;
+    }
+    // the bundle before this one is still loading or waiting, run right behind it
+    previous->Then(runner, [run = std::move(run), source = std::move(source)]() mutable {
+      run(std::move(source));
+    });
+  });
 
   return JNI_TRUE;
 }
@@ -590,6 +710,7 @@ jlong InitInstance(JNIEnv* j_env,
                      << ", j_is_dev_module = "
                      << static_cast<uint32_t>(j_is_dev_module)
                      << ", j_group_id = " << j_group_id;
+  auto init_time = hippy::base::MonotonicallyIncreasingTime();
   auto bridge = std::make_shared<ADRBridge>(j_env, j_object);
   auto runtime = std::make_shared<Runtime>(std::move(bridge), j_enable_v8_serialization, j_is_dev_module);
   int32_t runtime_id = runtime->GetId();
@@ -626,12 +747,8 @@ jlong InitInstance(JNIEnv* j_env,
             is_valid = false;
             break;
           }
-          auto path = uri_obj->GetPath();
-          is_valid = HippyFile::ReadFile(uri, param->snapshot_data.buffer_holder, false);
-          if (!is_valid) {
-            break;
-          }
-          is_valid = param->snapshot_data.ReadMetadata();
+          // mapped read-only and shared with the other instances loading the same file
+          is_valid = param->snapshot_data.MapFile(uri);
         } else {
           auto j_blob_field = j_env->GetFieldID(cls, "blob", "Ljava/nio/ByteBuffer;");
           auto j_buffer = j_env->GetObjectField(j_vm_init_param, j_blob_field);
@@ -716,17 +833,18 @@ jlong InitInstance(JNIEnv* j_env,
       }
 #endif
     auto ctx = scope->GetContext();
+    Runtime::BindContext(runtime, ctx);
     auto global_object = ctx->GetGlobalObject();
-    auto user_global_object_key = ctx->CreateString(kGlobalKey);
+    auto user_global_object_key = ctx->GetPropertyKey(kGlobalKey);
     ctx->SetProperty(global_object, user_global_object_key, global_object);
     TDF_BASE_DLOG(INFO) << "bridge bind runtime_id = " << runtime_id;
     auto func_wrapper = std::make_unique<hippy::napi::FuncWrapper>(NativeCallback,
                                                                    reinterpret_cast<void*>(runtime_id));
     auto native_func_cb = ctx->CreateFunction(func_wrapper);
     scope->SaveFuncWrapper(std::move(func_wrapper));
-    auto call_natives_key = ctx->CreateString(kCallNativesKey);
+    auto call_natives_key = ctx->GetPropertyKey(kCallNativesKey);
     ctx->SetProperty(global_object, call_natives_key, native_func_cb, hippy::napi::PropertyAttribute::ReadOnly);
-    auto native_global_key = ctx->CreateString(kNativeGlobalKey);
+    auto native_global_key = ctx->GetPropertyKey(kNativeGlobalKey);
     auto global_config_object = VM::ParseJson(ctx, global_config);
     ctx->SetProperty(global_object, native_global_key, global_config_object);
 
@@ -741,10 +859,21 @@ jlong InitInstance(JNIEnv* j_env,
     TDF_BASE_LOG(INFO) << "run scope cb";
     hippy::bridge::CallJavaMethod(save_object_->GetObj(),INIT_CB_STATE::SUCCESS);
   };
-  std::unique_ptr<RegisterMap> scope_cb_map = std::make_unique<RegisterMap>();
-  scope_cb_map->insert({hippy::base::kContextCreatedCBKey, context_cb});
-  scope_cb_map->insert({hippy::base::KScopeInitializedCBKey, scope_cb});
+  auto make_scope_cb_map = [context_cb, scope_cb] {
+    auto map = std::make_unique<RegisterMap>();
+    map->insert({hippy::base::kContextCreatedCBKey, context_cb});
+    map->insert({hippy::base::KScopeInitializedCBKey, scope_cb});
+    return map;
+  };
   std::shared_ptr<Engine> engine;
+  bool is_pooled = false;
+  auto async_init = [&param, &engine_cb_map, use_snapshot](const std::shared_ptr<Engine>& new_engine) {
+    if (use_snapshot) {
+      // the VM takes the snapshot data over on the JS thread, read it before that
+      param->snapshot_data.AsyncVerifyChecksum(new_engine->GetWorkerTaskRunner());
+    }
+    new_engine->AsyncInit(param, std::move(engine_cb_map));
+  };
   if (j_is_dev_module) {
     std::lock_guard<std::mutex> lock(engine_mutex);
     TDF_BASE_DLOG(INFO) << "debug mode";
@@ -761,7 +890,7 @@ jlong InitInstance(JNIEnv* j_env,
       engine = std::make_shared<Engine>();
       reuse_engine_map[group] = std::make_pair(engine, 1);
       runtime->SetEngine(engine);
-      engine->AsyncInit(param, std::move(engine_cb_map));
+      async_init(engine);
     }
   } else if (group != kDefaultEngineId) {
     std::lock_guard<std::mutex> lock(engine_mutex);
@@ -778,24 +907,71 @@ jlong InitInstance(JNIEnv* j_env,
       engine = std::make_shared<Engine>();
       runtime->SetEngine(engine);
       reuse_engine_map[group] = std::make_pair(engine, 1);
-      engine->AsyncInit(param, std::move(engine_cb_map));
+      async_init(engine);
     }
   } else {  // kDefaultEngineId
-    TDF_BASE_DLOG(INFO) << "default create engine";
-    engine = std::make_shared<Engine>();
-    runtime->SetEngine(engine);
-    engine->AsyncInit(param, std::move(engine_cb_map));
+    std::shared_ptr<EnginePool> pool;
+    // pooled engines are created with the default VM parameters
+    if (!param) {
+      std::lock_guard<std::mutex> lock(engine_mutex);
+      pool = engine_pool;
+    }
+    if (pool) {
+      // the VM exists already, the pool runs vm_cb when it activates the scope
+      auto scope_cb_map = make_scope_cb_map();
+      scope_cb_map->insert({hippy::base::kVMCreateCBKey, vm_cb});
+      auto instance = pool->Acquire(std::move(scope_cb_map), [&runtime](const EnginePool::Instance& instance) {
+        runtime->SetEngine(instance.engine);
+        runtime->SetScope(instance.scope);
+      });
+      engine = instance.engine;
+      is_pooled = static_cast<bool>(engine);
+    }
+    if (!is_pooled) {
+      TDF_BASE_DLOG(INFO) << "default create engine";
+      engine = std::make_shared<Engine>();
+      runtime->SetEngine(engine);
+      async_init(engine);
+    }
   }
-  std::unordered_map<std::string, std::string> init_param = {
-      { hippy::base::kUseSnapshot,  use_snapshot ? "1" : "0" }
-  };
-  runtime->SetScope(engine->AsyncCreateScope("", std::move(init_param), std::move(scope_cb_map)));
+  if (!is_pooled) {
+    std::unordered_map<std::string, std::string> init_param = {
+        { hippy::base::kUseSnapshot,  use_snapshot ? "1" : "0" }
+    };
+    runtime->SetScope(engine->AsyncCreateScope("", std::move(init_param), make_scope_cb_map()));
+  }
+  runtime->SetInitInfo(init_time, is_pooled);
   TDF_BASE_DLOG(INFO) << "group = " << group;
   runtime->SetGroupId(group);
-  TDF_BASE_LOG(INFO) << "InitInstance end, runtime_id = " << runtime_id;
+  TDF_BASE_LOG(INFO) << "InitInstance end, runtime_id = " << runtime_id << ", is_pooled = " << is_pooled;
   return runtime_id;
 }
 
+void SetEnginePool(__unused JNIEnv* j_env,
+                   __unused jobject j_object,
+                   jint j_capacity,
+                   jlong j_memory_budget_in_bytes) {
+  TDF_BASE_LOG(INFO) << "SetEnginePool capacity = " << j_capacity
+                     << ", memory_budget_in_bytes = " << j_memory_budget_in_bytes;
+  std::shared_ptr<EnginePool> old_pool;
+  {
+    std::lock_guard<std::mutex> lock(engine_mutex);
+    old_pool = std::move(engine_pool);
+    if (j_capacity > 0) {
+      EnginePool::Options options;
+      options.capacity = hippy::base::checked_numeric_cast<jint, size_t>(j_capacity);
+      if (j_memory_budget_in_bytes > 0) {
+        options.memory_budget_in_bytes = hippy::base::checked_numeric_cast<jlong, size_t>(j_memory_budget_in_bytes);
+      }
+      engine_pool = std::make_shared<EnginePool>(std::move(options));
+      engine_pool->Start();
+    }
+  }
+  if (old_pool) {
+    old_pool->Clear();
+  }
+}
+
 void DestroyInstance(__unused JNIEnv* j_env,
                      __unused jobject j_object,
                      jlong j_runtime_id,
@@ -842,13 +1018,15 @@ void DestroyInstance(__unused JNIEnv* j_env,
   };
   int64_t group = runtime->GetGroupId();
   if (group == kDebuggerEngineId) {
-    runtime->GetScope()->WillExit();
+    runtime->GetScope()->AsyncWillExit();
   }
   runtime->GetEngine()->GetJSRunner()->PostTask(task);
   TDF_BASE_DLOG(INFO) << "destroy, group = " << group;
   if (group == kDebuggerEngineId) {
   } else if (group == kDefaultEngineId) {
-    runtime->GetEngine()->TerminateRunner();
+    runtime->GetEngine()->AsyncTerminateRunner([runtime_id] {
+      TDF_BASE_LOG(INFO) << "engine teardown end, runtime_id = " << runtime_id;
+    });
   } else {
     std::lock_guard<std::mutex> lock(engine_mutex);
     auto it = reuse_engine_map.find(group);
@@ -858,7 +1036,9 @@ void DestroyInstance(__unused JNIEnv* j_env,
       TDF_BASE_DLOG(INFO) << "reuse_engine_map cnt = " << cnt;
       if (cnt == 1) {
         reuse_engine_map.erase(it);
-        engine->TerminateRunner();
+        engine->AsyncTerminateRunner([group] {
+          TDF_BASE_LOG(INFO) << "engine teardown end, group = " << group;
+        });
       } else {
         std::get<uint32_t>(it->second) = cnt - 1;
       }
@@ -891,6 +1071,46 @@ void RunInJsThread(JNIEnv *j_env,
   task_runner->PostTask(std::move(task));
 }
 
+jboolean StartTracing(__unused JNIEnv* j_env,
+                      __unused jobject j_object,
+                      jint j_capacity,
+                      jdouble j_sampling_rate) {
+  hippy::base::TraceLog::Options options;
+  if (j_capacity > 0) {
+    options.capacity = hippy::base::checked_numeric_cast<jint, size_t>(j_capacity);
+  }
+  options.sampling_rate = j_sampling_rate;
+  bool is_started = hippy::base::TraceLog::GetInstance().Start(options);
+  TDF_BASE_LOG(INFO) << "StartTracing is_started = " << is_started;
+  return is_started ? JNI_TRUE : JNI_FALSE;
+}
+
+jboolean StopTracing(JNIEnv* j_env,
+                     __unused jobject j_object,
+                     jstring j_file_path) {
+  auto& trace_log = hippy::base::TraceLog::GetInstance();
+  trace_log.Stop();
+  if (!j_file_path) {
+    return JNI_FALSE;
+  }
+  auto file_path = StringViewUtils::ToU8StdStr(JniUtils::ToStrView(j_env, j_file_path));
+  return trace_log.Dump(file_path) ? JNI_TRUE : JNI_FALSE;
+}
+
+void OnMemoryPressure(JNIEnv* j_env,
+                      __unused jobject j_object,
+                      jlong j_runtime_id,
+                      jint j_level) {
+  auto runtime = Runtime::Find(hippy::base::checked_numeric_cast<jlong, int32_t>(j_runtime_id));
+  if (!runtime) {
+    TDF_BASE_DLOG(WARNING) << "OnMemoryPressure, j_runtime_id invalid";
+    return;
+  }
+  // the values of HippyBridge.MEMORY_PRESSURE_*
+  auto level = j_level > 0 ? Engine::MemoryPressureLevel::kCritical : Engine::MemoryPressureLevel::kModerate;
+  runtime->GetEngine()->NotifyMemoryPressure(level);
+}
+
 }  // namespace bridge
 }  // namespace hippy
 
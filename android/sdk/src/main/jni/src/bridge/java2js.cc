@@ -24,6 +24,7 @@
 
 #include "bridge/js2java.h"
 #include "bridge/runtime.h"
+#include "core/base/trace_event.h"
 #include "core/vm/v8/v8_vm.h"
 #include "jni/jni_register.h"
 #include "jni/jni_utils.h"
@@ -41,14 +42,14 @@ enum CALLFUNCTION_CB_STATE {
 REGISTER_JNI( // NOLINT(cert-err58-cpp)
         "com/tencent/mtt/hippy/bridge/HippyBridgeImpl",
         "callFunction",
-        "(Ljava/lang/String;JLcom/tencent/mtt/hippy/bridge/NativeCallback;[BII)V",
+        "(Ljava/lang/String;JLcom/tencent/mtt/hippy/bridge/NativeCallback;[BIII)V",
         CallFunctionByHeapBuffer)
 
 REGISTER_JNI( // NOLINT(cert-err58-cpp)
         "com/tencent/mtt/hippy/bridge/HippyBridgeImpl",
         "callFunction",
         "(Ljava/lang/String;JLcom/tencent/mtt/hippy/bridge/"
-        "NativeCallback;Ljava/nio/ByteBuffer;II)V",
+        "NativeCallback;Ljava/nio/ByteBuffer;III)V",
         CallFunctionByDirectBuffer)
 
 using unicode_string_view = tdf::base::unicode_string_view;
@@ -62,12 +63,15 @@ using VM = hippy::vm::VM;
 using V8VM = hippy::vm::V8VM;
 
 const char kHippyBridgeName[] = "hippyBridge";
+// bridge calls never stop, tracing all of them would overwrite the startup events of the JS thread
+constexpr uint32_t kMaxTracedCallFunctionCount = 256;
 
 void CallFunction(JNIEnv* j_env,
                   __unused jobject j_obj,
                   jstring j_action,
                   jlong j_runtime_id,
                   jobject j_callback,
+                  jint j_priority,
                   bytes buffer_data,
                   std::shared_ptr<JavaRef> buffer_owner) {
   TDF_BASE_DLOG(INFO) << "CallFunction j_runtime_id = " << j_runtime_id;
@@ -84,10 +88,11 @@ void CallFunction(JNIEnv* j_env,
   unicode_string_view action_name = JniUtils::ToStrView(j_env, j_action);
   TDF_BASE_DLOG(INFO) << "CallFunction action_name = " << action_name;
   std::shared_ptr<JavaRef> cb = std::make_shared<JavaRef>(j_env, j_callback);
-  std::shared_ptr<JavaScriptTask> task = std::make_shared<JavaScriptTask>();
+  std::shared_ptr<JavaScriptTask> task = runner->NewTask<JavaScriptTask>();
   task->callback = [runtime, cb_ = std::move(cb), action_name,
                     buffer_data_ = std::move(buffer_data),
                     buffer_owner_ = std::move(buffer_owner)] {
+    HIPPY_TRACE_EVENT_FIRST_N("bridge", "CallFunction", kMaxTracedCallFunctionCount);
     JNIEnv* j_env = JNIEnvironment::GetInstance()->AttachCurrentThread();
     std::shared_ptr<Scope> scope = runtime->GetScope();
     if (!scope) {
@@ -96,8 +101,9 @@ void CallFunction(JNIEnv* j_env,
     }
     auto context = scope->GetContext();
     if (!runtime->GetBridgeFunc()) {
+      HIPPY_TRACE_EVENT_INSTANT("bridge", "FirstBridgeCall");
       TDF_BASE_DLOG(INFO) << "init bridge func";
-      auto func_name = context->CreateString(kHippyBridgeName);
+      auto func_name = context->GetPropertyKey(kHippyBridgeName);
       auto global_object = context->GetGlobalObject();
       auto fn = context->GetProperty(global_object, func_name);
       bool is_fn = context->IsFunction(fn);
@@ -132,6 +138,7 @@ void CallFunction(JNIEnv* j_env,
       return;
     }
 
+    // action_name comes from the caller, don't intern it
     std::shared_ptr<CtxValue> action = context->CreateString(action_name);
     std::shared_ptr<CtxValue> params;
     if (runtime->IsEnableV8Serialization()) {
@@ -182,7 +189,12 @@ void CallFunction(JNIEnv* j_env,
     j_env->DeleteLocalRef(j_action);
   };
 
-  runner->PostTask(task);
+  auto priority = hippy::base::Task::Priority::kNormal;
+  if (j_priority >= 0 && static_cast<size_t>(j_priority) < hippy::base::Task::kPriorityCount) {
+    priority = static_cast<hippy::base::Task::Priority>(j_priority);
+  }
+  // loadInstance and the calls after it run once the bundles posted before them were evaluated
+  runtime->PostTaskAfterBundles(task, priority);
 }
 
 void CallFunctionByHeapBuffer(JNIEnv* j_env,
@@ -192,8 +204,9 @@ void CallFunctionByHeapBuffer(JNIEnv* j_env,
                               jobject j_callback,
                               jbyteArray j_byte_array,
                               jint j_offset,
-                              jint j_length) {
-  CallFunction(j_env, j_obj, j_action, j_runtime_id, j_callback,
+                              jint j_length,
+                              jint j_priority) {
+  CallFunction(j_env, j_obj, j_action, j_runtime_id, j_callback, j_priority,
                JniUtils::AppendJavaByteArrayToBytes(j_env, j_byte_array,
                                                     j_offset, j_length),
                nullptr);
@@ -206,10 +219,11 @@ void CallFunctionByDirectBuffer(JNIEnv* j_env,
                                 jobject j_callback,
                                 jobject j_buffer,
                                 jint j_offset,
-                                jint j_length) {
+                                jint j_length,
+                                jint j_priority) {
   char* buffer_address = static_cast<char*>(j_env->GetDirectBufferAddress(j_buffer));
   TDF_BASE_CHECK(buffer_address != nullptr);
-  CallFunction(j_env, j_obj, j_action, j_runtime_id, j_callback,
+  CallFunction(j_env, j_obj, j_action, j_runtime_id, j_callback, j_priority,
                bytes(buffer_address + j_offset,
                      hippy::base::checked_numeric_cast<jint, size_t>(j_length)),
                std::make_shared<JavaRef>(j_env, j_buffer));
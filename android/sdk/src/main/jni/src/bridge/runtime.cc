@@ -22,33 +22,78 @@
 
 #include "bridge/runtime.h"
 
+#include <atomic>
 #include <mutex>
 #include <unordered_map>
 
 constexpr int32_t kReuseRuntimeId = -1;
+// index 5 is used by the core for the ScopeWrapper
+constexpr int kRuntimeIdEmbedderIndex = 6;
 
 using V8Ctx = hippy::napi::V8Ctx;
+using RuntimeMap = std::unordered_map<int32_t, std::shared_ptr<Runtime>>;
 
-static std::unordered_map<int32_t, std::shared_ptr<Runtime>> RuntimeMap;
+// Lookups happen on every exception, interrupt and native callback while runtimes are only
+// added or removed on instance init/destroy. Readers therefore load an immutable snapshot of
+// the map without taking the mutex; writers copy the snapshot under the mutex and publish it.
+static std::shared_ptr<const RuntimeMap> runtime_map = std::make_shared<const RuntimeMap>();
 static std::mutex mutex;
 
 static std::atomic<int32_t> global_runtime_key{0};
 
 Runtime::Runtime(std::shared_ptr<Bridge> bridge, bool enable_v8_serialization, bool is_dev)
     : enable_v8_serialization_(enable_v8_serialization), is_debug_(is_dev), group_id_(0),
-    bridge_(std::move(bridge)), interrupt_queue_(nullptr) {
+    bridge_(std::move(bridge)), interrupt_queue_(nullptr), init_time_(0), is_pooled_(false),
+    has_run_script_(false), bundle_gate_id_(0) {
   id_ = global_runtime_key.fetch_add(1);
 }
 
+std::optional<TaskFuture<void>> Runtime::SetBundleGate(TaskFuture<void> evaluated, uint64_t& gate_id) {
+  std::lock_guard<std::mutex> lock(bundle_gate_mutex_);
+  auto previous = std::move(bundle_gate_);
+  bundle_gate_ = std::move(evaluated);
+  gate_id = ++bundle_gate_id_;
+  return previous;
+}
+
+void Runtime::ResetBundleGate(uint64_t gate_id) {
+  std::lock_guard<std::mutex> lock(bundle_gate_mutex_);
+  // a later bundle or call chained behind it and resets the gate itself
+  if (gate_id == bundle_gate_id_) {
+    bundle_gate_.reset();
+  }
+}
+
+void Runtime::PostTaskAfterBundles(std::shared_ptr<Task> task, Task::Priority priority) {
+  auto runner = engine_->GetJSRunner();
+  std::lock_guard<std::mutex> lock(bundle_gate_mutex_);
+  if (!bundle_gate_) {
+    runner->PostTask(std::move(task), priority);
+    return;
+  }
+  // the link only posts the task, so that it still runs in its priority lane
+  auto gate_id = ++bundle_gate_id_;
+  auto runtime_id = id_;
+  bundle_gate_ = bundle_gate_->Then(runner, [runner, task = std::move(task), priority, runtime_id, gate_id]() {
+    runner->PostTask(task, priority);
+    auto runtime = Runtime::Find(runtime_id);
+    if (runtime) {
+      runtime->ResetBundleGate(gate_id);
+    }
+  });
+}
+
 void Runtime::Insert(const std::shared_ptr<Runtime>& runtime) {
   std::lock_guard<std::mutex> lock(mutex);
-  RuntimeMap[runtime->id_] = runtime;
+  auto map = std::make_shared<RuntimeMap>(*std::atomic_load(&runtime_map));
+  (*map)[runtime->id_] = runtime;
+  std::atomic_store(&runtime_map, std::shared_ptr<const RuntimeMap>(std::move(map)));
 }
 
 std::shared_ptr<Runtime> Runtime::Find(int32_t id) {
-  std::lock_guard<std::mutex> lock(mutex);
-  const auto it = RuntimeMap.find(id);
-  if (it == RuntimeMap.end()) {
+  auto map = std::atomic_load(&runtime_map);
+  const auto it = map->find(id);
+  if (it == map->end()) {
     return nullptr;
   }
 
@@ -62,37 +107,38 @@ std::shared_ptr<Runtime> Runtime::Find(v8::Isolate *isolate) {
   }
   auto runtime_id =
       static_cast<int32_t>(reinterpret_cast<int64_t>(isolate->GetData(kRuntimeSlotIndex)));
-  TDF_BASE_LOG(INFO) << "Runtime::Find runtime_id = " << runtime_id;
   if (runtime_id == kReuseRuntimeId) {// -1 means single isolate multi context mode
+    v8::HandleScope handle_scope(isolate);
     v8::Local<v8::Context> context = isolate->GetCurrentContext();
-    std::lock_guard<std::mutex> lock(mutex);
-    for (const auto& p: RuntimeMap) {
-      auto scope = p.second->GetScope();
-      if (!scope) {
-        continue;
-      }
-      std::shared_ptr<V8Ctx> ctx = std::static_pointer_cast<V8Ctx>(scope->GetContext());
-      if (!ctx) {
-        continue;
-      }
-      if (ctx->context_persistent_ == context) {
-        return p.second;
-      }
+    if (context.IsEmpty() || context->GetNumberOfEmbedderDataFields() <= kRuntimeIdEmbedderIndex) {
+      return nullptr;
     }
-  } else {
-    return Runtime::Find(runtime_id);
+    auto address = reinterpret_cast<intptr_t>(
+        context->GetAlignedPointerFromEmbedderData(kRuntimeIdEmbedderIndex));
+    runtime_id = static_cast<int32_t>(address >> 1);
   }
-  return nullptr;
+  return Runtime::Find(runtime_id);
+}
+
+void Runtime::BindContext(const std::shared_ptr<Runtime>& runtime,
+                          const std::shared_ptr<hippy::napi::Ctx>& ctx) {
+  TDF_BASE_CHECK(runtime && ctx);
+  auto v8_ctx = std::static_pointer_cast<V8Ctx>(ctx);
+  // embedder data only accepts aligned pointers, keep the lowest bit clear
+  v8_ctx->SetAlignedPointerInEmbedderData(kRuntimeIdEmbedderIndex,
+                                          static_cast<intptr_t>(runtime->id_) << 1);
 }
 
 bool Runtime::Erase(int32_t id) {
   std::lock_guard<std::mutex> lock(mutex);
-  const auto it = RuntimeMap.find(id);
-  if (it == RuntimeMap.end()) {
+  auto current = std::atomic_load(&runtime_map);
+  if (current->find(id) == current->end()) {
     return false;
   }
 
-  RuntimeMap.erase(it);
+  auto map = std::make_shared<RuntimeMap>(*current);
+  map->erase(id);
+  std::atomic_store(&runtime_map, std::shared_ptr<const RuntimeMap>(std::move(map)));
   return true;
 }
 
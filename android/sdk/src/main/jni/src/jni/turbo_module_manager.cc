@@ -175,7 +175,7 @@ int Install(JNIEnv* j_env, jobject j_obj, jlong j_runtime_id) {
     auto func = context->CreateFunction(wrapper);
     scope->SaveFuncWrapper(std::move(wrapper));
     auto global_object = context->GetGlobalObject();
-    auto key = context->CreateString(kTurboKey);
+    auto key = context->GetPropertyKey(kTurboKey);
     context->SetProperty(global_object, key, func);
   };
   runner->PostTask(task);
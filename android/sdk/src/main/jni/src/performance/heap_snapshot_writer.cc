@@ -0,0 +1,215 @@
+/*
+ *
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2022 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#include "performance/heap_snapshot_writer.h"
+
+#include <cstdio>
+#include <utility>
+
+#include "base/logging.h"
+
+namespace hippy {
+namespace bridge {
+
+// favor throughput, the snapshot JSON still shrinks by about an order of magnitude
+constexpr int kCompressionLevel = Z_BEST_SPEED;
+// 15 window bits plus 16 selects the gzip wrapper
+constexpr int kGzipWindowBits = 15 + 16;
+constexpr int kMemLevel = 8;
+
+HeapSnapshotWriter::HeapSnapshotWriter(Options options)
+    : options_(options),
+      stream_(),
+      has_stream_(false),
+      input_size_(0),
+      output_size_(0),
+      is_closing_(false),
+      status_(Status::kOk) {
+  if (!options_.chunk_size) {
+    options_.chunk_size = Options().chunk_size;
+  }
+  if (!options_.queue_capacity) {
+    options_.queue_capacity = 1;
+  }
+}
+
+HeapSnapshotWriter::~HeapSnapshotWriter() {
+  Close();
+}
+
+bool HeapSnapshotWriter::Open(const std::string& path) {
+  TDF_BASE_DCHECK(!thread_.joinable());
+  path_ = path;
+  file_.open(path_, std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!file_.is_open()) {
+    TDF_BASE_DLOG(WARNING) << "HeapSnapshotWriter open failed, path = " << path_;
+    SetStatus(Status::kFileError);
+    return false;
+  }
+  if (options_.compress) {
+    if (deflateInit2(&stream_, kCompressionLevel, Z_DEFLATED, kGzipWindowBits, kMemLevel,
+                     Z_DEFAULT_STRATEGY) != Z_OK) {
+      TDF_BASE_DLOG(WARNING) << "HeapSnapshotWriter deflateInit2 failed";
+      file_.close();
+      std::remove(path_.c_str());
+      SetStatus(Status::kWriteError);
+      return false;
+    }
+    has_stream_ = true;
+    out_buffer_.resize(options_.chunk_size);
+  }
+  buffer_.reserve(options_.chunk_size);
+  thread_ = std::thread(&HeapSnapshotWriter::ThreadMain, this);
+  return true;
+}
+
+bool HeapSnapshotWriter::Write(const char* data, size_t size) {
+  if (status_ != Status::kOk || !thread_.joinable()) {
+    return false;
+  }
+  // without compression the output size is known up front, fail before queueing anything
+  if (!options_.compress && options_.max_size && input_size_ + size > options_.max_size) {
+    SetStatus(Status::kSizeExceeded);
+    return false;
+  }
+  input_size_ += size;
+  buffer_.insert(buffer_.end(), data, data + size);
+  if (buffer_.size() >= options_.chunk_size) {
+    Enqueue(std::exchange(buffer_, {}), false);
+    buffer_.reserve(options_.chunk_size);
+  }
+  return status_ == Status::kOk;
+}
+
+HeapSnapshotWriter::Status HeapSnapshotWriter::Close() {
+  if (!thread_.joinable()) {
+    return status_;
+  }
+  Enqueue(std::exchange(buffer_, {}), true);
+  thread_.join();
+  file_.close();
+  if (has_stream_) {
+    deflateEnd(&stream_);
+    has_stream_ = false;
+  }
+  if (status_ != Status::kOk) {
+    TDF_BASE_DLOG(WARNING) << "HeapSnapshotWriter failed, status = " << static_cast<int>(status_.load())
+                           << ", remove " << path_;
+    std::remove(path_.c_str());
+  } else {
+    TDF_BASE_DLOG(INFO) << "HeapSnapshotWriter done, input = " << input_size_
+                        << ", output = " << output_size_;
+  }
+  return status_;
+}
+
+void HeapSnapshotWriter::Enqueue(std::vector<char> buffer, bool is_last) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  not_full_.wait(lock, [this] {
+    return queue_.size() < options_.queue_capacity || status_ != Status::kOk;
+  });
+  if (!buffer.empty() && status_ == Status::kOk) {
+    queue_.push_back(std::move(buffer));
+  }
+  if (is_last) {
+    is_closing_ = true;
+  }
+  not_empty_.notify_one();
+}
+
+void HeapSnapshotWriter::ThreadMain() {
+  while (true) {
+    std::vector<char> buffer;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      not_empty_.wait(lock, [this] { return !queue_.empty() || is_closing_; });
+      if (queue_.empty()) {
+        break;
+      }
+      buffer = std::move(queue_.front());
+      queue_.pop_front();
+    }
+    not_full_.notify_one();
+    if (status_ == Status::kOk) {
+      Output(buffer.data(), buffer.size(), false);
+    }
+  }
+  if (status_ == Status::kOk) {
+    Output(nullptr, 0, true);
+  }
+  if (status_ == Status::kOk) {
+    file_.flush();
+    if (!file_) {
+      SetStatus(Status::kWriteError);
+    }
+  }
+}
+
+bool HeapSnapshotWriter::Output(const char* data, size_t size, bool is_last) {
+  if (!has_stream_) {
+    return !size || Emit(data, size);
+  }
+  stream_.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data));
+  stream_.avail_in = static_cast<uInt>(size);
+  int flush = is_last ? Z_FINISH : Z_NO_FLUSH;
+  int ret;
+  do {
+    stream_.next_out = reinterpret_cast<Bytef*>(out_buffer_.data());
+    stream_.avail_out = static_cast<uInt>(out_buffer_.size());
+    ret = deflate(&stream_, flush);
+    if (ret == Z_STREAM_ERROR) {
+      SetStatus(Status::kWriteError);
+      return false;
+    }
+    size_t produced = out_buffer_.size() - stream_.avail_out;
+    if (produced && !Emit(out_buffer_.data(), produced)) {
+      return false;
+    }
+  } while (stream_.avail_out == 0 || (is_last && ret != Z_STREAM_END));
+  return true;
+}
+
+bool HeapSnapshotWriter::Emit(const char* data, size_t size) {
+  if (options_.max_size && output_size_ + size > options_.max_size) {
+    SetStatus(Status::kSizeExceeded);
+    return false;
+  }
+  file_.write(data, static_cast<std::streamsize>(size));
+  if (!file_) {
+    SetStatus(Status::kWriteError);
+    return false;
+  }
+  output_size_ += size;
+  return true;
+}
+
+void HeapSnapshotWriter::SetStatus(Status status) {
+  Status expected = Status::kOk;
+  // the first failure wins
+  if (status_.compare_exchange_strong(expected, status)) {
+    // wake a producer blocked on a full queue
+    std::lock_guard<std::mutex> lock(mutex_);
+    not_full_.notify_all();
+  }
+}
+
+}  // namespace bridge
+}  // namespace hippy
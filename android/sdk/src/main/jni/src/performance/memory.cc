@@ -26,6 +26,7 @@
 #include "jni/jni_env.h"
 #include "jni/jni_register.h"
 #include "jni/jni_utils.h"
+#include "performance/heap_snapshot_writer.h"
 
 namespace hippy {
 namespace bridge {
@@ -45,7 +46,7 @@ REGISTER_JNI("com/tencent/mtt/hippy/v8/V8", // NOLINT(cert-err58-cpp)
              GetHeapSpaceStatistics)
 REGISTER_JNI("com/tencent/mtt/hippy/v8/V8", // NOLINT(cert-err58-cpp)
              "writeHeapSnapshot",
-             "(JLjava/lang/String;Lcom/tencent/mtt/hippy/common/Callback;)Z",
+             "(JLjava/lang/String;ZJLcom/tencent/mtt/hippy/common/Callback;)Z",
              WriteHeapSnapshot)
 
 jint ThrowNoSuchMethodError(JNIEnv* j_env, const char* msg){
@@ -64,39 +65,60 @@ enum HEAP_WRITE : int8_t {
   HEAP_WRITE_OK = 0,
   HEAP_WRITE_ERR_RUN = -1,
   HEAP_WRITE_ERR_FILE = -2,
-  HEAP_WRITE_ERR_SAVE = -3
+  HEAP_WRITE_ERR_SAVE = -3,
+  HEAP_WRITE_ERR_SIZE = -4
 };
 
 // [Heap] HeapSnapshot OutputStream
+// V8 serializes on the JS thread, compression and file IO happen on the writer's own thread.
 class HeapSnapshotOutputStreamAdapter : public v8::OutputStream {
  private:
-  std::ofstream file_;
+  HeapSnapshotWriter writer_;
  public:
-  static constexpr uint16_t kChunkSize = 1024;
   enum SaveResult : int8_t {
     kInit = 0,
     kOk = 1,
-    kError = 2
+    kError = 2,
+    kSizeExceeded = 3
   };
   SaveResult save_res_ = kInit;
+
+  explicit HeapSnapshotOutputStreamAdapter(HeapSnapshotWriter::Options options)
+      : writer_(options) {}
+
   void EndOfStream() override {
-    save_res_ = kOk;
-    file_.close();
+    Finish();
   }
   int GetChunkSize() override {
-    return kChunkSize;
+    return static_cast<int>(writer_.GetChunkSize());
   }
   WriteResult WriteAsciiChunk(char *data, int size) override {
-    if (file_.is_open()) {
-      file_.write(data, size);
+    if (!writer_.Write(data, static_cast<size_t>(size))) {
+      Finish();
+      return kAbort;
     }
     return kContinue;
   }
   WriteResult WriteHeapStatsChunk(v8::HeapStatsUpdate *data, int count) override {
     save_res_ = kError;
+    writer_.Close();
     return kAbort;
   }
 
+  void Finish() {
+    if (save_res_ != kInit) {
+      return;
+    }
+    auto status = writer_.Close();
+    if (status == HeapSnapshotWriter::Status::kOk) {
+      save_res_ = kOk;
+    } else if (status == HeapSnapshotWriter::Status::kSizeExceeded) {
+      save_res_ = kSizeExceeded;
+    } else {
+      save_res_ = kError;
+    }
+  }
+
   int SetFilePath(const tdf::base::unicode_string_view &snapshot_file_path) {
     TDF_BASE_DLOG(INFO) << "HeapSnapshotOutputStreamAdapter SetFilePath heap_snapshot_file_path = "
                         << snapshot_file_path;
@@ -112,15 +134,15 @@ class HeapSnapshotOutputStreamAdapter : public v8::OutputStream {
       << check_parent_dir_code;
       result_code = base::HippyFile::CreateDir(snapshot_parent_dir, S_IRWXU);
     }
-    if (result_code) {
-      save_res_ = kError;
-    } else {
-      save_res_ = kInit;
+    if (!result_code) {
       TDF_BASE_DLOG(INFO) << "HeapSnapshotOutputStreamAdapter open file " << snapshot_file_path;
       tdf::base::unicode_string_view owner(""_u8s);
       const char *path = base::StringViewUtils::ToConstCharPointer(snapshot_file_path, owner);
-      file_.open(path, std::ios::out | std::ios::ate | std::ios::binary);
+      if (!writer_.Open(path)) {
+        result_code = -1;
+      }
     }
+    save_res_ = result_code ? kError : kInit;
     TDF_BASE_DLOG(INFO) << "HeapSnapshotOutputStreamAdapter SetFilePath result " << result_code;
     return result_code;
   }
@@ -312,6 +334,8 @@ jboolean WriteHeapSnapshot(__unused JNIEnv *j_env,
                            __unused jobject j_object,
                            jlong j_runtime_id,
                            jstring j_heap_snapshot_path,
+                           jboolean j_compress,
+                           jlong j_max_size,
                            jobject j_callback) {
 #ifndef V8_X5_LITE
   TDF_BASE_DLOG(INFO) << "WriteHeapSnapshot begin, j_runtime_id = " << j_runtime_id;
@@ -342,7 +366,10 @@ jboolean WriteHeapSnapshot(__unused JNIEnv *j_env,
   }
   const unicode_string_view heap_snapshot_path = JniUtils::ToStrView(j_env, j_heap_snapshot_path);
   TDF_BASE_DLOG(INFO) << "WriteHeapSnapshot thread start";
-  auto heap_snapshot_stream = std::make_shared<HeapSnapshotOutputStreamAdapter>();
+  HeapSnapshotWriter::Options options;
+  options.compress = j_compress;
+  options.max_size = j_max_size > 0 ? static_cast<size_t>(j_max_size) : 0;
+  auto heap_snapshot_stream = std::make_shared<HeapSnapshotOutputStreamAdapter>(options);
   int set_file_err = heap_snapshot_stream->SetFilePath(heap_snapshot_path);
   // error: file_path invalid
   if (set_file_err) {
@@ -361,13 +388,16 @@ jboolean WriteHeapSnapshot(__unused JNIEnv *j_env,
   auto heap_snapshot = isolate->GetHeapProfiler()->TakeHeapSnapshot();
   heap_snapshot->Serialize(heap_snapshot_stream.get());
   const_cast<v8::HeapSnapshot *>(heap_snapshot)->Delete();
+  heap_snapshot_stream->Finish();
   // error: save heapSnapshots error
   if (heap_snapshot_stream->save_res_ != HeapSnapshotOutputStreamAdapter::kOk) {
     TDF_BASE_DLOG(WARNING) << "WriteHeapSnapshot RequestInterrupt, save heapSnapshots = "
                            << heap_snapshot_stream->save_res_;
+    auto ret_code = heap_snapshot_stream->save_res_ == HeapSnapshotOutputStreamAdapter::kSizeExceeded
+                    ? HEAP_WRITE_ERR_SIZE : HEAP_WRITE_ERR_SAVE;
     j_env->CallVoidMethod(ret_code_obj->GetObj(),
                           j_int_constructor,
-                          static_cast<jint>(HEAP_WRITE_ERR_SAVE));
+                          static_cast<jint>(ret_code));
     JNIEnvironment::ClearJEnvException(j_env);
     j_env->CallVoidMethod(cb->GetObj(), j_cb_method, ret_code_obj->GetObj(), nullptr);
     JNIEnvironment::ClearJEnvException(j_env);
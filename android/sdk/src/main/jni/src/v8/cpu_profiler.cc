@@ -0,0 +1,99 @@
+/*
+ *
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2022 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#include "v8/cpu_profiler.h"
+
+#include "bridge/runtime.h"
+#include "jni/jni_env.h"
+#include "jni/jni_utils.h"
+
+namespace hippy {
+inline namespace driver {
+inline namespace v8_engine {
+
+REGISTER_JNI("com/tencent/mtt/hippy/v8/V8", // NOLINT(cert-err58-cpp)
+             "startCpuProfiling",
+             "(JI)V",
+             StartCpuProfiling)
+
+REGISTER_JNI("com/tencent/mtt/hippy/v8/V8", // NOLINT(cert-err58-cpp)
+             "stopCpuProfiling",
+             "(JLjava/lang/String;Lcom/tencent/mtt/hippy/common/Callback;)V",
+             StopCpuProfiling)
+
+static void CallBooleanCallback(JNIEnv *j_env, jobject j_callback, bool value) {
+  auto j_boolean_class = j_env->FindClass("java/lang/Boolean");
+  auto j_value_of = j_env->GetStaticMethodID(j_boolean_class, "valueOf", "(Z)Ljava/lang/Boolean;");
+  auto j_result = j_env->CallStaticObjectMethod(j_boolean_class, j_value_of,
+                                                static_cast<jboolean>(value));
+  auto j_cb_class = j_env->GetObjectClass(j_callback);
+  auto j_cb_method_id = j_env->GetMethodID(j_cb_class, "callback",
+                                           "(Ljava/lang/Object;Ljava/lang/Throwable;)V");
+  j_env->CallVoidMethod(j_callback, j_cb_method_id, j_result, nullptr);
+  JNIEnvironment::ClearJEnvException(j_env);
+  j_env->DeleteLocalRef(j_result);
+  j_env->DeleteLocalRef(j_cb_class);
+  j_env->DeleteLocalRef(j_boolean_class);
+}
+
+void StartCpuProfiling(JNIEnv *j_env,
+                       jobject j_object,
+                       jlong j_runtime_id,
+                       jint j_sampling_interval_in_us) {
+  auto runtime = Runtime::Find(hippy::base::checked_numeric_cast<jlong, int32_t>(j_runtime_id));
+  if (!runtime) {
+    TDF_BASE_DLOG(WARNING) << "StartCpuProfiling, j_runtime_id invalid";
+    return;
+  }
+  uint32_t sampling_interval_in_us = Engine::kDefaultCpuSamplingIntervalInUs;
+  if (j_sampling_interval_in_us > 0) {
+    sampling_interval_in_us = hippy::base::checked_numeric_cast<jint, uint32_t>(j_sampling_interval_in_us);
+  }
+  runtime->GetEngine()->StartCpuProfiling(sampling_interval_in_us);
+}
+
+void StopCpuProfiling(JNIEnv *j_env,
+                      jobject j_object,
+                      jlong j_runtime_id,
+                      jstring j_file_path,
+                      jobject j_callback) {
+  auto runtime = Runtime::Find(hippy::base::checked_numeric_cast<jlong, int32_t>(j_runtime_id));
+  if (!runtime) {
+    TDF_BASE_DLOG(WARNING) << "StopCpuProfiling, j_runtime_id invalid";
+    // the Java side waits for the callback, which is non-null
+    CallBooleanCallback(j_env, j_callback, false);
+    return;
+  }
+  auto file_path = JniUtils::ToStrView(j_env, j_file_path);
+  auto path = hippy::base::StringViewUtils::Convert(
+      file_path, tdf::base::unicode_string_view::Encoding::Utf8).utf8_value();
+  auto cb = std::make_shared<JavaRef>(j_env, j_callback);
+  runtime->GetEngine()->StopCpuProfiling(
+      std::string(reinterpret_cast<const char *>(path.c_str()), path.length()),
+      [cb](bool is_saved) {
+        auto j_env = JNIEnvironment::GetInstance()->AttachCurrentThread();
+        CallBooleanCallback(j_env, cb->GetObj(), is_saved);
+      });
+}
+
+}
+}
+}
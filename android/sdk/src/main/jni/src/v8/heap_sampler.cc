@@ -0,0 +1,143 @@
+/*
+ *
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2022 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "v8/heap_sampler.h"
+
+#include "bridge/runtime.h"
+#include "jni/jni_env.h"
+#include "jni/jni_utils.h"
+#include "v8/v8.h"
+
+namespace hippy {
+inline namespace driver {
+inline namespace v8_engine {
+
+using V8VM = hippy::vm::V8VM;
+using HeapSampler = hippy::vm::HeapSampler;
+
+REGISTER_JNI("com/tencent/mtt/hippy/v8/V8", // NOLINT(cert-err58-cpp)
+             "startHeapSampler",
+             "(JII)V",
+             StartHeapSampler)
+
+REGISTER_JNI("com/tencent/mtt/hippy/v8/V8", // NOLINT(cert-err58-cpp)
+             "stopHeapSampler",
+             "(J)V",
+             StopHeapSampler)
+
+REGISTER_JNI("com/tencent/mtt/hippy/v8/V8", // NOLINT(cert-err58-cpp)
+             "getHeapSamples",
+             "(JLcom/tencent/mtt/hippy/common/Callback;)V",
+             GetHeapSamples)
+
+void StartHeapSampler(JNIEnv *j_env,
+                      jobject j_object,
+                      jlong j_runtime_id,
+                      jint j_interval_in_ms,
+                      jint j_capacity) {
+  auto runtime = Runtime::Find(hippy::base::checked_numeric_cast<jlong, int32_t>(j_runtime_id));
+  if (!runtime) {
+    TDF_BASE_DLOG(WARNING) << "StartHeapSampler, j_runtime_id invalid";
+    return;
+  }
+  HeapSampler::Options options;
+  if (j_interval_in_ms > 0) {
+    options.interval_in_ms = hippy::base::checked_numeric_cast<jint, uint32_t>(j_interval_in_ms);
+  }
+  if (j_capacity > 0) {
+    options.capacity = hippy::base::checked_numeric_cast<jint, size_t>(j_capacity);
+  }
+  std::weak_ptr<Engine> weak_engine = runtime->GetEngine();
+  auto task = std::make_shared<JavaScriptTask>();
+  task->callback = [weak_engine, options] {
+    auto engine = weak_engine.lock();
+    if (!engine) {
+      return;
+    }
+    auto vm = std::static_pointer_cast<V8VM>(engine->GetVM());
+    if (vm->heap_sampler_) {
+      vm->heap_sampler_->Stop();
+    }
+    vm->heap_sampler_ = std::make_shared<HeapSampler>(vm->isolate_, engine->GetJSRunner(), options);
+    vm->heap_sampler_->Start();
+  };
+  runtime->GetEngine()->GetJSRunner()->PostTask(std::move(task));
+}
+
+void StopHeapSampler(JNIEnv *j_env,
+                     jobject j_object,
+                     jlong j_runtime_id) {
+  auto runtime = Runtime::Find(hippy::base::checked_numeric_cast<jlong, int32_t>(j_runtime_id));
+  if (!runtime) {
+    TDF_BASE_DLOG(WARNING) << "StopHeapSampler, j_runtime_id invalid";
+    return;
+  }
+  std::weak_ptr<Engine> weak_engine = runtime->GetEngine();
+  auto task = std::make_shared<JavaScriptTask>();
+  task->callback = [weak_engine] {
+    auto engine = weak_engine.lock();
+    if (!engine) {
+      return;
+    }
+    // the samples stay readable until the next start
+    auto vm = std::static_pointer_cast<V8VM>(engine->GetVM());
+    if (vm->heap_sampler_) {
+      vm->heap_sampler_->Stop();
+    }
+  };
+  runtime->GetEngine()->GetJSRunner()->PostTask(std::move(task));
+}
+
+void GetHeapSamples(JNIEnv *j_env,
+                    jobject j_object,
+                    jlong j_runtime_id,
+                    jobject j_callback) {
+  auto runtime = Runtime::Find(hippy::base::checked_numeric_cast<jlong, int32_t>(j_runtime_id));
+  TDF_BASE_CHECK(runtime);
+  auto cb = std::make_shared<JavaRef>(j_env, j_callback);
+  std::weak_ptr<Engine> weak_engine = runtime->GetEngine();
+  auto task = std::make_shared<JavaScriptTask>();
+  task->callback = [weak_engine, cb] {
+    auto engine = weak_engine.lock();
+    if (!engine) {
+      return;
+    }
+    auto vm = std::static_pointer_cast<V8VM>(engine->GetVM());
+    std::string samples = vm->heap_sampler_ ? vm->heap_sampler_->Export() : "";
+    auto j_env = JNIEnvironment::GetInstance()->AttachCurrentThread();
+    auto j_callback = cb->GetObj();
+    auto j_cb_class = j_env->GetObjectClass(j_callback);
+    auto j_cb_method_id = j_env->GetMethodID(j_cb_class, "callback",
+                                             "(Ljava/lang/Object;Ljava/lang/Throwable;)V");
+    auto j_samples = JniUtils::StrViewToJString(
+        j_env, tdf::base::unicode_string_view::new_from_utf8(samples.c_str(), samples.length()));
+    j_env->CallVoidMethod(j_callback, j_cb_method_id, j_samples, nullptr);
+    JNIEnvironment::ClearJEnvException(j_env);
+    j_env->DeleteLocalRef(j_samples);
+    j_env->DeleteLocalRef(j_cb_class);
+  };
+  runtime->GetEngine()->GetJSRunner()->PostTask(std::move(task));
+}
+
+}
+}
+}
@@ -21,6 +21,12 @@
  */
 
 #include "v8/interrupt_queue.h"
+
+#include <algorithm>
+#include <chrono>
+
+#include "base/logging.h"
+#include "core/base/trace_event.h"
 #include "core/task/javascript_task.h"
 
 namespace hippy {
@@ -31,56 +37,107 @@ std::atomic<uint32_t> InterruptQueue::g_id = 1;
 
 InterruptQueue::PersistentObjectMap InterruptQueue::persistent_map_;
 
-InterruptQueue::InterruptQueue(v8::Isolate* isolate): isolate_(isolate), task_queue_(), queue_mutex_() {
+static uint64_t NowInUs() {
+  return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+InterruptQueue::InterruptQueue(v8::Isolate* isolate)
+    : isolate_(isolate),
+      task_lanes_(),
+      queue_mutex_(),
+      task_count_(0),
+      is_interrupt_pending_(false),
+      is_runner_task_pending_(false) {
   id_ = g_id.fetch_add(1);
 }
 
-void InterruptQueue::PostTask(std::unique_ptr<Task> task) {
+void InterruptQueue::PostTask(std::unique_ptr<Task> task, Task::Priority priority) {
+  auto lane = static_cast<size_t>(priority);
+  TDF_BASE_DCHECK(lane < Task::kPriorityCount);
   {
     std::lock_guard<std::mutex> lock_guard(queue_mutex_);
-    task_queue_.push(std::move(task));
+    task_lanes_[lane].push_back({std::move(task), NowInUs()});
+    task_count_.fetch_add(1);
   }
-
-  if (task_runner_) {
-    auto weak_self = weak_from_this();
-    auto js_task = std::make_unique<JavaScriptTask>();
-    js_task->callback = [weak_self]() {
-      auto self = weak_self.lock();
-      if (self) {
-        self->Run();
-      }
-    };
-    task_runner_->PostTask(std::move(js_task));
+  // the flags are set after the task is counted, a drain that resets one first still finds the task
+  PostRunnerTask();
+  if (!is_interrupt_pending_.exchange(true)) {
+    isolate_->RequestInterrupt(OnInterrupt, reinterpret_cast<void*>(id_));
   }
-
-  isolate_->RequestInterrupt([](v8::Isolate* isolate, void* data) {
-    auto& map = InterruptQueue::GetPersistentMap();
-    auto index = static_cast<uint32_t>(reinterpret_cast<size_t>(data));
-    std::shared_ptr<InterruptQueue> queue;
-    auto flag = map.Find(index, queue);
-    if (flag && queue) {
-      queue->Run();
-    }
-  }, reinterpret_cast<void*>(id_));
 }
 
 void InterruptQueue::Run() {
-  std::queue<std::unique_ptr<Task>> queue;
-  {
-    std::lock_guard<std::mutex> lock_guard(queue_mutex_);
-
-    if (task_queue_.empty()) {
+  // the other half of a wakeup usually finds the queue drained
+  if (!task_count_.load()) {
+    return;
+  }
+  HIPPY_TRACE_EVENT("interrupt", "InterruptQueue::Run");
+  auto begin = NowInUs();
+  while (true) {
+    Entry entry;
+    uint64_t latency_in_us;
+    {
+      std::lock_guard<std::mutex> lock_guard(queue_mutex_);
+      auto it = std::find_if(task_lanes_.begin(), task_lanes_.end(), [](const std::deque<Entry>& lane) {
+        return !lane.empty();
+      });
+      if (it == task_lanes_.end()) {
+        return;
+      }
+      entry = std::move(it->front());
+      it->pop_front();
+      task_count_.fetch_sub(1);
+      auto now = NowInUs();
+      latency_in_us = now > entry.post_time_in_us ? now - entry.post_time_in_us : 0;
+      ++stats_.task_count;
+      stats_.total_latency_in_us += latency_in_us;
+      stats_.max_latency_in_us = std::max(stats_.max_latency_in_us, latency_in_us);
+    }
+    HIPPY_TRACE_COUNTER("interrupt", "InterruptQueue::LatencyInUs", static_cast<int64_t>(latency_in_us));
+    entry.task->Run();
+    if (task_count_.load() && NowInUs() - begin >= kBudgetInUs) {
+      // let the interrupted JS go on, the task runner picks up the rest
+      PostRunnerTask();
       return;
     }
-    std::swap(queue, task_queue_);
   }
-  while (!queue.empty()) {
-    auto task = std::move(queue.front());
-    queue.pop();
-    task->Run();
+}
+
+InterruptQueue::Stats InterruptQueue::GetStats() {
+  std::lock_guard<std::mutex> lock_guard(queue_mutex_);
+  return stats_;
+}
+
+void InterruptQueue::OnInterrupt(v8::Isolate* isolate, void* data) {
+  auto& map = InterruptQueue::GetPersistentMap();
+  auto index = static_cast<uint32_t>(reinterpret_cast<size_t>(data));
+  std::shared_ptr<InterruptQueue> queue;
+  auto flag = map.Find(index, queue);
+  if (flag && queue) {
+    // every wakeup resets its flag, so that a post racing with a drain is never left without one
+    queue->is_interrupt_pending_.store(false);
+    queue->Run();
   }
 }
 
+void InterruptQueue::PostRunnerTask() {
+  if (!task_runner_ || is_runner_task_pending_.exchange(true)) {
+    return;
+  }
+  auto weak_self = weak_from_this();
+  auto js_task = std::make_unique<JavaScriptTask>();
+  js_task->callback = [weak_self]() {
+    auto self = weak_self.lock();
+    if (self) {
+      self->is_runner_task_pending_.store(false);
+      self->Run();
+    }
+  };
+  // interrupts are latency critical, run them ahead of queued bridge and timer work
+  task_runner_->PostTask(std::move(js_task), Task::Priority::kInput);
+}
+
 }
 }
 }
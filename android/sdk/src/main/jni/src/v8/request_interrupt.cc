@@ -30,17 +30,19 @@ namespace hippy {
 inline namespace driver {
 inline namespace v8_engine {
 
+using Task = hippy::base::Task;
 using V8VM = hippy::vm::V8VM;
 
 REGISTER_JNI("com/tencent/mtt/hippy/v8/V8", // NOLINT(cert-err58-cpp)
              "requestInterrupt",
-             "(JLcom/tencent/mtt/hippy/common/Callback;)V",
+             "(JILcom/tencent/mtt/hippy/common/Callback;)V",
              RequestInterrupt)
 
 
 void RequestInterrupt(JNIEnv *j_env,
                       jobject j_object,
                       jlong j_runtime_id,
+                      jint j_priority,
                       jobject j_callback) {
   auto runtime = Runtime::Find(hippy::base::checked_numeric_cast<jlong, int32_t>(j_runtime_id));
   TDF_BASE_CHECK(runtime);
@@ -56,7 +58,13 @@ void RequestInterrupt(JNIEnv *j_env,
     j_env->CallVoidMethod(cb->GetObj(), j_cb_method_id, nullptr, nullptr);
     JNIEnvironment::ClearJEnvException(j_env);
   };
-  interrupt_queue->PostTask(std::move(task));
+  auto priority = Task::Priority::kNormal;
+  if (j_priority >= 0 && static_cast<size_t>(j_priority) < Task::kPriorityCount) {
+    priority = static_cast<Task::Priority>(j_priority);
+  } else {
+    TDF_BASE_DLOG(WARNING) << "RequestInterrupt unknown priority = " << j_priority;
+  }
+  interrupt_queue->PostTask(std::move(task), priority);
 }
 
 
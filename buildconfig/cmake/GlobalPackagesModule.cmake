@@ -22,7 +22,36 @@ cmake_minimum_required(VERSION 3.14)
 
 include("${CMAKE_CURRENT_LIST_DIR}/InfraPackagesModule.cmake")
 
+# A V8 built by the user replaces the package registry, e.g. for host tools on Linux, which has
+# no published package. V8_ROOT holds include/ and the static libv8_monolith (in lib/ or obj/).
+set(V8_ROOT "" CACHE PATH "Prebuilt V8 to use instead of the package registry")
+# must match the args.gn of that build, e.g. V8_COMPRESS_POINTERS;V8_31BIT_SMIS_ON_64BIT_ARCH
+set(V8_ROOT_DEFINITIONS "" CACHE STRING "Compile definitions required by the headers of V8_ROOT")
+option(V8_ROOT_WITHOUT_INSPECTOR "The V8 in V8_ROOT is built without the inspector" ON)
+
+function(GlobalPackages_Add_v8_from_root)
+  find_library(V8_ROOT_LIBRARY
+      NAMES v8_monolith
+      PATHS "${V8_ROOT}"
+      PATH_SUFFIXES lib obj
+      NO_DEFAULT_PATH)
+  if (NOT V8_ROOT_LIBRARY)
+    message(FATAL_ERROR "No libv8_monolith in ${V8_ROOT}/lib or ${V8_ROOT}/obj")
+  endif ()
+  find_package(Threads REQUIRED)
+  add_library(v8 STATIC IMPORTED GLOBAL)
+  set_target_properties(v8 PROPERTIES
+      IMPORTED_LOCATION "${V8_ROOT_LIBRARY}"
+      INTERFACE_INCLUDE_DIRECTORIES "${V8_ROOT}/include"
+      INTERFACE_COMPILE_DEFINITIONS "${V8_ROOT_DEFINITIONS}"
+      INTERFACE_LINK_LIBRARIES "Threads::Threads;${CMAKE_DL_LIBS}"
+      INTERFACE_V8_WITHOUT_INSPECTOR "${V8_ROOT_WITHOUT_INSPECTOR}")
+endfunction()
+
 function(GlobalPackages_Add_v8)
+  if (NOT TARGET v8 AND V8_ROOT)
+    GlobalPackages_Add_v8_from_root()
+  endif ()
   if (NOT TARGET v8)
     if (NOT V8_COMPONENT)
       message(FATAL_ERROR "The V8_COMPONENT variable must be set")
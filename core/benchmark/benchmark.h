@@ -0,0 +1,55 @@
+/*
+ *
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2022 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include <vector>
+
+namespace hippy {
+namespace benchmark {
+
+struct Benchmark {
+  const char* name;
+  uint32_t repetition_count;
+  void (*func)();
+};
+
+std::vector<Benchmark>& GetBenchmarks();
+
+class BenchmarkRegistrar {
+ public:
+  BenchmarkRegistrar(const char* name, uint32_t repetition_count, void (*func)()) {
+    GetBenchmarks().push_back({name, repetition_count, func});
+  }
+};
+
+}  // namespace benchmark
+}  // namespace hippy
+
+// Defines a benchmark whose body runs `REPETITIONS` times, the median and the standard deviation
+// of the wall time of a run are printed.
+#define HIPPY_BENCHMARK(NAME, REPETITIONS)                                                        \
+  static void NAME##Benchmark();                                                                  \
+  static ::hippy::benchmark::BenchmarkRegistrar NAME##Registrar(#NAME, REPETITIONS, NAME##Benchmark); \
+  static void NAME##Benchmark()
@@ -0,0 +1,69 @@
+/*
+ *
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2022 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <math.h>
+#include <stdio.h>
+
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+#include "benchmark.h"
+
+namespace hippy {
+namespace benchmark {
+
+std::vector<Benchmark>& GetBenchmarks() {
+  static std::vector<Benchmark> benchmarks;
+  return benchmarks;
+}
+
+static void PrintBenchmarkResult(const char* name, std::vector<double>& times_in_ms) {
+  double mean = 0;
+  for (double time : times_in_ms) {
+    mean += time;
+  }
+  mean /= static_cast<double>(times_in_ms.size());
+  double variance = 0;
+  for (double time : times_in_ms) {
+    variance += pow(time - mean, 2);
+  }
+  variance /= static_cast<double>(times_in_ms.size());
+  std::sort(times_in_ms.begin(), times_in_ms.end());
+  printf("%s: median: %lf ms, stddev: %lf ms\n", name, times_in_ms[times_in_ms.size() / 2], sqrt(variance));
+}
+
+}  // namespace benchmark
+}  // namespace hippy
+
+int main(int argc, char const* argv[]) {
+  for (const auto& benchmark : hippy::benchmark::GetBenchmarks()) {
+    std::vector<double> times_in_ms;
+    for (uint32_t i = 0; i < benchmark.repetition_count; ++i) {
+      auto start = std::chrono::steady_clock::now();
+      benchmark.func();
+      times_in_ms.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+    }
+    hippy::benchmark::PrintBenchmarkResult(benchmark.name, times_in_ms);
+  }
+  return 0;
+}
@@ -0,0 +1,78 @@
+/*
+ *
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2022 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <atomic>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include "base/async_logger.h"
+#include "base/logging.h"
+#include "benchmark.h"
+
+namespace {
+
+constexpr int kThreadCount = 4;
+constexpr int kMessageCountPerThread = 1000;
+
+std::mutex sink_mutex;
+size_t sink_size = 0;
+
+// stands for the platform sink, which serializes its writers
+void InitializeSink() {
+  static std::once_flag flag;
+  std::call_once(flag, [] {
+    tdf::base::LogMessage::InitializeDelegate([](const std::ostringstream& stream, tdf::base::LogSeverity) {
+      std::lock_guard<std::mutex> lock(sink_mutex);
+      sink_size += stream.str().length();
+    });
+  });
+}
+
+void LogFromThreads() {
+  std::vector<std::thread> threads;
+  for (int i = 0; i < kThreadCount; ++i) {
+    threads.emplace_back([i] {
+      for (int j = 0; j < kMessageCountPerThread; ++j) {
+        TDF_BASE_LOG(INFO) << "benchmark thread " << i << " message " << j;
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+
+}  // namespace
+
+HIPPY_BENCHMARK(SyncLoggerContended, 20) {
+  InitializeSink();
+  LogFromThreads();
+}
+
+// the time of the callers, the backlog is delivered by the drainer meanwhile
+HIPPY_BENCHMARK(AsyncLoggerContended, 20) {
+  InitializeSink();
+  tdf::base::AsyncLogger::Start();
+  LogFromThreads();
+}
@@ -0,0 +1,108 @@
+/*
+ *
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2022 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "base/persistent_object_map.h"
+#include "benchmark.h"
+
+namespace {
+
+constexpr int kReaderCount = 4;
+constexpr int kReadCountPerReader = 20000;
+constexpr uint32_t kKeyCount = 32;
+
+using Value = std::shared_ptr<uint32_t>;
+
+// the map as it was before it was sharded, one mutex for every access
+class LockedMap {
+ public:
+  bool Insert(uint32_t key, const Value& value) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return map_.insert({key, value}).second;
+  }
+  bool Find(uint32_t key, Value& value) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = map_.find(key);
+    if (it == map_.end()) {
+      return false;
+    }
+    value = it->second;
+    return true;
+  }
+  bool Erase(uint32_t key) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return map_.erase(key) > 0;
+  }
+
+ private:
+  std::unordered_map<uint32_t, Value> map_;
+  std::mutex mutex_;
+};
+
+// readers look every key up while one writer replaces entries
+template <typename Map>
+void ReadWhileWriting(Map& map) {
+  for (uint32_t key = 0; key < kKeyCount; ++key) {
+    map.Insert(key, std::make_shared<uint32_t>(key));
+  }
+  std::atomic<bool> is_stopping{false};
+  std::thread writer([&map, &is_stopping] {
+    uint32_t key = 0;
+    while (!is_stopping.load(std::memory_order_relaxed)) {
+      map.Erase(key);
+      map.Insert(key, std::make_shared<uint32_t>(key));
+      key = (key + 1) % kKeyCount;
+    }
+  });
+  std::vector<std::thread> readers;
+  for (int i = 0; i < kReaderCount; ++i) {
+    readers.emplace_back([&map] {
+      Value value;
+      for (int j = 0; j < kReadCountPerReader; ++j) {
+        map.Find(static_cast<uint32_t>(j) % kKeyCount, value);
+      }
+    });
+  }
+  for (auto& reader : readers) {
+    reader.join();
+  }
+  is_stopping.store(true, std::memory_order_relaxed);
+  writer.join();
+}
+
+}  // namespace
+
+HIPPY_BENCHMARK(LockedMapReadWhileWriting, 20) {
+  LockedMap map;
+  ReadWhileWriting(map);
+}
+
+HIPPY_BENCHMARK(PersistentObjectMapReadWhileWriting, 20) {
+  footstone::PersistentObjectMap<uint32_t, Value> map;
+  ReadWhileWriting(map);
+}
@@ -0,0 +1,91 @@
+/*
+ *
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2022 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <atomic>
+#include <future>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "benchmark.h"
+#include "core/base/task_runner.h"
+#include "core/task/common_task.h"
+
+namespace {
+
+using TaskRunner = hippy::base::TaskRunner;
+
+constexpr int kRoundTripCount = 50;
+constexpr int kNicePriority = -10;
+
+// Keeps every CPU busy with threads of the default priority while it is alive.
+class CpuHog {
+ public:
+  CpuHog() : is_stopping_(false) {
+    unsigned count = std::max(2u, std::thread::hardware_concurrency() * 2);
+    for (unsigned i = 0; i < count; ++i) {
+      threads_.emplace_back([this] {
+        while (!is_stopping_.load(std::memory_order_relaxed)) {
+        }
+      });
+    }
+  }
+
+  ~CpuHog() {
+    is_stopping_.store(true, std::memory_order_relaxed);
+    for (auto& thread : threads_) {
+      thread.join();
+    }
+  }
+
+ private:
+  std::atomic<bool> is_stopping_;
+  std::vector<std::thread> threads_;
+};
+
+// posts the tasks one at a time, each waits for the previous one to run
+void RunRoundTrips(const TaskRunner::Options& options) {
+  auto runner = std::make_shared<TaskRunner>(options);
+  runner->Start();
+  {
+    CpuHog hog;
+    for (int i = 0; i < kRoundTripCount; ++i) {
+      std::promise<void> promise;
+      auto task = std::make_shared<CommonTask>();
+      task->func_ = [&promise] { promise.set_value(); };
+      runner->PostTask(std::move(task));
+      promise.get_future().wait();
+    }
+  }
+  runner->Terminate();
+}
+
+}  // namespace
+
+HIPPY_BENCHMARK(TaskRunnerLatencyUnderContention, 10) {
+  RunRoundTrips(TaskRunner::Options("bench default"));
+}
+
+// raising the priority needs CAP_SYS_NICE on Linux, without it the runner keeps the default one
+HIPPY_BENCHMARK(TaskRunnerLatencyUnderContentionWithPriority, 10) {
+  RunRoundTrips(TaskRunner::Options("bench nice").set_priority(kNicePriority));
+}
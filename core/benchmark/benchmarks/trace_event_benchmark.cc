@@ -0,0 +1,91 @@
+/*
+ *
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2022 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "benchmark.h"
+#include "core/base/trace_event.h"
+
+namespace {
+
+constexpr int kThreadCount = 4;
+constexpr int kEventCountPerThread = 50000;
+constexpr size_t kCapacity = 8192;
+
+using Event = hippy::base::TraceLog::Event;
+using Phase = hippy::base::TraceLog::Phase;
+
+// the log as it was before the buffers were split by thread, one ring behind one mutex
+class SharedRingLog {
+ public:
+  SharedRingLog() : events_(kCapacity), next_index_(0) {}
+
+  void AddEvent(uint64_t timestamp_in_us, uint64_t duration_in_us) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    events_[next_index_] = {Phase::kComplete, "benchmark", "Event", timestamp_in_us, duration_in_us, 0, 0, 0};
+    next_index_ = (next_index_ + 1) % events_.size();
+  }
+
+ private:
+  std::vector<Event> events_;
+  size_t next_index_;
+  std::mutex mutex_;
+};
+
+template <typename Func>
+void RunOnThreads(Func func) {
+  std::vector<std::thread> threads;
+  for (int i = 0; i < kThreadCount; ++i) {
+    threads.emplace_back([&func] {
+      for (int j = 0; j < kEventCountPerThread; ++j) {
+        func();
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+
+}  // namespace
+
+HIPPY_BENCHMARK(SharedRingLogContended, 20) {
+  SharedRingLog log;
+  // timed like a span
+  RunOnThreads([&log] {
+    auto begin_time_in_us = hippy::base::TraceLog::NowInUs();
+    log.AddEvent(begin_time_in_us, hippy::base::TraceLog::NowInUs() - begin_time_in_us);
+  });
+}
+
+HIPPY_BENCHMARK(TraceLogContended, 20) {
+  hippy::base::TraceLog::GetInstance().Start();
+  RunOnThreads([] { HIPPY_TRACE_EVENT("benchmark", "Event"); });
+  hippy::base::TraceLog::GetInstance().Stop();
+}
+
+HIPPY_BENCHMARK(TraceLogDisabled, 20) {
+  hippy::base::TraceLog::GetInstance().Stop();
+  RunOnThreads([] { HIPPY_TRACE_EVENT("benchmark", "Event"); });
+}
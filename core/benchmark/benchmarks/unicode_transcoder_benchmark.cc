@@ -0,0 +1,81 @@
+/*
+ *
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2022 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <string>
+
+#include "base/unicode_transcoder.h"
+#include "benchmark.h"
+
+namespace {
+
+using UnicodeTranscoder = tdf::base::UnicodeTranscoder;
+
+constexpr size_t kTextSize = 1024 * 1024;
+
+// ASCII source text with a few CJK comments, about what a bundle looks like
+const std::string& GetMixedUtf8() {
+  static const std::string text = [] {
+    std::string line = "function render(props) { return props.title; } // \xE6\xA0\x87\xE9\xA2\x98\n";
+    std::string result;
+    while (result.length() < kTextSize) {
+      result += line;
+    }
+    return result;
+  }();
+  return text;
+}
+
+const std::string& GetAsciiUtf8() {
+  static const std::string text(kTextSize, 'a');
+  return text;
+}
+
+const std::u16string& GetMixedUtf16() {
+  static const std::u16string text = [] {
+    std::u16string result;
+    UnicodeTranscoder::Utf8ToUtf16(GetMixedUtf8(), result);
+    return result;
+  }();
+  return text;
+}
+
+}  // namespace
+
+HIPPY_BENCHMARK(TranscodeAsciiUtf8ToUtf16, 50) {
+  std::u16string out;
+  UnicodeTranscoder::Utf8ToUtf16(GetAsciiUtf8(), out);
+}
+
+HIPPY_BENCHMARK(TranscodeMixedUtf8ToUtf16, 50) {
+  std::u16string out;
+  UnicodeTranscoder::Utf8ToUtf16(GetMixedUtf8(), out);
+}
+
+HIPPY_BENCHMARK(TranscodeMixedUtf16ToUtf8, 50) {
+  std::string out;
+  UnicodeTranscoder::Utf16ToUtf8(GetMixedUtf16(), out);
+}
+
+HIPPY_BENCHMARK(ValidateMixedUtf8, 50) {
+  const auto& text = GetMixedUtf8();
+  UnicodeTranscoder::ValidateUtf8(reinterpret_cast<const uint8_t*>(text.data()), text.length());
+}
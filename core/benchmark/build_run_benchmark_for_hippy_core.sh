@@ -0,0 +1,23 @@
+#! /bin/bash
+
+CMAKE=`which cmake`
+MAKE=`which make`
+
+BASH_SOURCE_DIR=$(cd `dirname "${BASH_SOURCE[0]}"` && pwd)
+BUILD_DIR="${BASH_SOURCE_DIR}"/../out
+
+rm -rf "${BUILD_DIR}"/benchmark
+mkdir -p "${BUILD_DIR}"/benchmark
+cd "${BUILD_DIR}"/benchmark
+
+#cmake generate make file
+"${CMAKE}" ../../benchmark/
+
+echo "Start build in directory: `pwd`"
+${MAKE}
+
+#run benchmark_hippy_core
+BENCHMARK_RUN_PATH="${BUILD_DIR}"/benchmark/benchmark_hippy_core
+if [ -x "${BENCHMARK_RUN_PATH}" ];then
+${BENCHMARK_RUN_PATH}
+fi
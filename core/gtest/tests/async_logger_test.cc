@@ -0,0 +1,140 @@
+/*
+ *
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2022 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <gtest.h>
+
+#include <functional>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "base/async_logger.h"
+#include "base/logging.h"
+
+namespace {
+
+using AsyncLogger = tdf::base::AsyncLogger;
+
+std::mutex capture_mutex;
+std::vector<std::string> captured;
+std::function<void(const std::string&)> on_delivered;
+
+// the delegate can only be initialized once per process
+void InitializeCapture() {
+  static std::once_flag flag;
+  std::call_once(flag, [] {
+    tdf::base::LogMessage::InitializeDelegate([](const std::ostringstream& stream, tdf::base::LogSeverity) {
+      std::string text = stream.str();
+      std::function<void(const std::string&)> cb;
+      {
+        std::lock_guard<std::mutex> lock(capture_mutex);
+        captured.push_back(text);
+        cb = on_delivered;
+      }
+      if (cb) {
+        cb(text);
+      }
+    });
+  });
+}
+
+void SetOnDelivered(std::function<void(const std::string&)> cb) {
+  std::lock_guard<std::mutex> lock(capture_mutex);
+  on_delivered = std::move(cb);
+}
+
+std::vector<std::string> GetCaptured(const std::string& marker) {
+  std::lock_guard<std::mutex> lock(capture_mutex);
+  std::vector<std::string> result;
+  for (const auto& text : captured) {
+    if (text.find(marker) != std::string::npos) {
+      result.push_back(text);
+    }
+  }
+  return result;
+}
+
+class AsyncLoggerTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    InitializeCapture();
+    AsyncLogger::Start();
+  }
+
+  void TearDown() override {
+    AsyncLogger::Stop();
+    SetOnDelivered(nullptr);
+  }
+};
+
+}  // namespace
+
+TEST_F(AsyncLoggerTest, DeliversEveryThreadInOrder) {
+  constexpr int kThreadCount = 3;
+  constexpr int kMessageCount = 100;
+  std::vector<std::thread> threads;
+  for (int i = 0; i < kThreadCount; ++i) {
+    threads.emplace_back([i] {
+      for (int j = 0; j < kMessageCount; ++j) {
+        TDF_BASE_LOG(INFO) << "order " << i << " " << j << ";";
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  AsyncLogger::Flush();
+  auto messages = GetCaptured("order ");
+  ASSERT_EQ(messages.size(), static_cast<size_t>(kThreadCount * kMessageCount));
+  std::vector<int> next(kThreadCount, 0);
+  for (const auto& message : messages) {
+    std::istringstream stream(message.substr(message.find("order ") + 6));
+    int thread_index;
+    int message_index;
+    stream >> thread_index >> message_index;
+    ASSERT_EQ(message_index, next[thread_index]);
+    ++next[thread_index];
+  }
+}
+
+TEST_F(AsyncLoggerTest, PostsTheWholeText) {
+  std::string long_text(1000, 'x');
+  TDF_BASE_LOG(INFO) << "whole " << long_text;
+  AsyncLogger::Flush();
+  auto messages = GetCaptured("whole ");
+  ASSERT_EQ(messages.size(), 1u);
+  EXPECT_NE(messages[0].find("whole " + long_text + "\n"), std::string::npos);
+}
+
+// a FATAL logged by the delegate flushes before aborting
+TEST_F(AsyncLoggerTest, FlushWhileDeliveringReturns) {
+  SetOnDelivered([](const std::string& text) {
+    if (text.find("reenter") != std::string::npos) {
+      AsyncLogger::Flush();
+    }
+  });
+  TDF_BASE_LOG(INFO) << "reenter";
+  AsyncLogger::Flush();
+  EXPECT_EQ(GetCaptured("reenter").size(), 1u);
+}
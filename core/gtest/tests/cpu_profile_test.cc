@@ -0,0 +1,83 @@
+/*
+ *
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2022 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <gtest.h>
+
+#include <string>
+
+#include "core/vm/cpu_profile.h"
+
+using CpuProfile = hippy::vm::CpuProfile;
+
+TEST(CpuProfileTest, EmptyProfile) {
+  CpuProfile profile;
+  EXPECT_EQ(profile.ToJson(),
+            "{\"nodes\":[],\"startTime\":0,\"endTime\":0,\"samples\":[],\"timeDeltas\":[]}");
+}
+
+TEST(CpuProfileTest, NodesAndSamples) {
+  CpuProfile profile;
+  CpuProfile::Node root;
+  root.id = 1;
+  root.function_name = "(root)";
+  root.children = {2, 3};
+  CpuProfile::Node foo;
+  foo.id = 2;
+  foo.function_name = "foo";
+  foo.url = "asset:/index.bundle";
+  foo.script_id = 7;
+  foo.line_number = 10;
+  foo.column_number = 4;
+  foo.hit_count = 2;
+  CpuProfile::Node idle;
+  idle.id = 3;
+  idle.function_name = "(idle)";
+  idle.hit_count = 1;
+  profile.nodes = {root, foo, idle};
+  profile.samples = {2, 3, 2};
+  profile.timestamps = {1100, 1250, 1300};
+  profile.start_time = 1000;
+  profile.end_time = 1400;
+  EXPECT_EQ(profile.ToJson(),
+            "{\"nodes\":["
+            "{\"id\":1,\"callFrame\":{\"functionName\":\"(root)\",\"scriptId\":\"0\",\"url\":\"\","
+            "\"lineNumber\":-1,\"columnNumber\":-1},\"hitCount\":0,\"children\":[2,3]},"
+            "{\"id\":2,\"callFrame\":{\"functionName\":\"foo\",\"scriptId\":\"7\","
+            "\"url\":\"asset:/index.bundle\",\"lineNumber\":10,\"columnNumber\":4},\"hitCount\":2},"
+            "{\"id\":3,\"callFrame\":{\"functionName\":\"(idle)\",\"scriptId\":\"0\",\"url\":\"\","
+            "\"lineNumber\":-1,\"columnNumber\":-1},\"hitCount\":1}"
+            "],\"startTime\":1000,\"endTime\":1400,"
+            "\"samples\":[2,3,2],\"timeDeltas\":[100,150,50]}");
+}
+
+TEST(CpuProfileTest, EscapesStrings) {
+  CpuProfile profile;
+  CpuProfile::Node node;
+  node.id = 1;
+  node.function_name = "a\"b\\c\nd\te\x01";
+  node.url = "\xe4\xb8\xad.js";
+  profile.nodes = {node};
+  auto json = profile.ToJson();
+  EXPECT_NE(json.find("\"functionName\":\"a\\\"b\\\\c\\nd\\te\\u0001\""), std::string::npos);
+  // non-ASCII UTF-8 is kept as is
+  EXPECT_NE(json.find("\"url\":\"\xe4\xb8\xad.js\""), std::string::npos);
+}
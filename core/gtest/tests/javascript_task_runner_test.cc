@@ -0,0 +1,130 @@
+/*
+ *
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2022 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+
+#include "core/base/task.h"
+#include "core/task/javascript_task.h"
+#include "core/task/javascript_task_runner.h"
+
+using Task = hippy::base::Task;
+
+namespace {
+
+constexpr uint64_t kIdleWindowInMs = 100;
+// shorter than the idle window, like a heap sampler tick or a JS setInterval
+constexpr uint64_t kTimerPeriodInMs = 20;
+
+bool WaitFor(const std::atomic<bool>& flag, std::chrono::milliseconds timeout) {
+  auto deadline = std::chrono::steady_clock::now() + timeout;
+  while (!flag && std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  }
+  return flag;
+}
+
+// reposts itself on the timer lane until the runner stops
+void PostPeriodicTimer(const std::shared_ptr<JavaScriptTaskRunner>& runner,
+                       const std::shared_ptr<std::atomic<uint32_t>>& tick_count) {
+  std::weak_ptr<JavaScriptTaskRunner> weak_runner = runner;
+  auto task = std::make_shared<JavaScriptTask>();
+  task->priority_ = Task::Priority::kTimer;
+  task->callback = [weak_runner, tick_count] {
+    ++*tick_count;
+    auto runner = weak_runner.lock();
+    if (runner) {
+      PostPeriodicTimer(runner, tick_count);
+    }
+  };
+  runner->PostDelayedTask(task, kTimerPeriodInMs);
+}
+
+}  // namespace
+
+class JavaScriptTaskRunnerIdleTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    runner_ = std::make_shared<JavaScriptTaskRunner>();
+    runner_->Start();
+  }
+
+  void TearDown() override { runner_->Terminate(); }
+
+  void SetIdleHandler(const std::shared_ptr<std::atomic<bool>>& has_run) {
+    auto task = std::make_shared<JavaScriptTask>();
+    std::weak_ptr<JavaScriptTaskRunner> weak_runner = runner_;
+    task->callback = [weak_runner, has_run] {
+      auto runner = weak_runner.lock();
+      runner->SetIdleHandler([has_run](uint64_t) {
+        *has_run = true;
+        return true;
+      }, kIdleWindowInMs);
+    };
+    runner_->PostTask(task);
+  }
+
+  std::shared_ptr<JavaScriptTaskRunner> runner_;
+};
+
+TEST_F(JavaScriptTaskRunnerIdleTest, RunsWhenQueueIsEmpty) {
+  auto has_run = std::make_shared<std::atomic<bool>>(false);
+  SetIdleHandler(has_run);
+  EXPECT_TRUE(WaitFor(*has_run, std::chrono::milliseconds(2000)));
+  EXPECT_EQ(runner_->GetIdleStats().idle_count, 1u);
+}
+
+TEST_F(JavaScriptTaskRunnerIdleTest, RunsDespitePeriodicTimer) {
+  auto has_run = std::make_shared<std::atomic<bool>>(false);
+  auto tick_count = std::make_shared<std::atomic<uint32_t>>(0);
+  SetIdleHandler(has_run);
+  PostPeriodicTimer(runner_, tick_count);
+  EXPECT_TRUE(WaitFor(*has_run, std::chrono::milliseconds(2000)));
+  // the timer kept firing the whole time
+  EXPECT_GT(tick_count->load(), 1u);
+}
+
+TEST_F(JavaScriptTaskRunnerIdleTest, NormalTaskRearmsIdleWork) {
+  auto has_run = std::make_shared<std::atomic<bool>>(false);
+  SetIdleHandler(has_run);
+  ASSERT_TRUE(WaitFor(*has_run, std::chrono::milliseconds(2000)));
+  *has_run = false;
+  auto task = std::make_shared<JavaScriptTask>();
+  task->callback = [] {};
+  runner_->PostTask(task);
+  EXPECT_TRUE(WaitFor(*has_run, std::chrono::milliseconds(2000)));
+  EXPECT_EQ(runner_->GetIdleStats().idle_count, 2u);
+}
+
+TEST_F(JavaScriptTaskRunnerIdleTest, TimerTaskDoesNotRearmIdleWork) {
+  auto has_run = std::make_shared<std::atomic<bool>>(false);
+  SetIdleHandler(has_run);
+  ASSERT_TRUE(WaitFor(*has_run, std::chrono::milliseconds(2000)));
+  auto tick_count = std::make_shared<std::atomic<uint32_t>>(0);
+  PostPeriodicTimer(runner_, tick_count);
+  std::this_thread::sleep_for(std::chrono::milliseconds(3 * kIdleWindowInMs));
+  EXPECT_EQ(runner_->GetIdleStats().idle_count, 1u);
+}
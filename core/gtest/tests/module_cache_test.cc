@@ -0,0 +1,204 @@
+/*
+ *
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2022 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <gtest.h>
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "core/base/uri_loader.h"
+#include "core/modules/module_cache.h"
+
+namespace {
+
+using unicode_string_view = tdf::base::unicode_string_view;
+using u8string = unicode_string_view::u8string;
+
+u8string ToU8(const std::string& str) {
+  return u8string(reinterpret_cast<const u8string::value_type*>(str.c_str()), str.length());
+}
+
+// Serves the contents set by the test, answers at once unless `is_deferred`.
+class FakeLoader : public hippy::base::UriLoader {
+ public:
+  bool RequestUntrustedContent(const unicode_string_view& uri, std::function<void(u8string)> cb) override {
+    ++request_count;
+    u8string content = contents[uri.utf8_value()];
+    if (is_deferred) {
+      deferred.push_back([cb, content] { cb(content); });
+    } else {
+      cb(content);
+    }
+    return true;
+  }
+
+  bool RequestUntrustedContent(const unicode_string_view& uri, u8string& content) override {
+    content = contents[uri.utf8_value()];
+    return true;
+  }
+
+  std::unordered_map<u8string, u8string> contents;
+  bool is_deferred = false;
+  std::vector<std::function<void()>> deferred;
+  int request_count = 0;
+};
+
+class ModuleCacheTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    ModuleCache::GetInstance().Clear();
+    ModuleCache::GetInstance().SetCapacity(ModuleCache::kDefaultCapacityInBytes);
+    loader_ = std::make_shared<FakeLoader>();
+    // the cache is process-wide, its counters keep the counts of the previous tests
+    base_stats_ = ModuleCache::GetInstance().GetStats();
+  }
+
+  ModuleCache::Stats GetStats() {
+    auto stats = ModuleCache::GetInstance().GetStats();
+    stats.hit_count -= base_stats_.hit_count;
+    stats.miss_count -= base_stats_.miss_count;
+    stats.coalesced_count -= base_stats_.coalesced_count;
+    stats.eviction_count -= base_stats_.eviction_count;
+    stats.code_cache_hit_count -= base_stats_.code_cache_hit_count;
+    return stats;
+  }
+
+  ModuleCache::Module Load(const std::string& uri) {
+    ModuleCache::Module result;
+    ModuleCache::GetInstance().Load(unicode_string_view(ToU8(uri)), loader_, [&result](ModuleCache::Module module) {
+      result = std::move(module);
+    });
+    return result;
+  }
+
+  std::shared_ptr<FakeLoader> loader_;
+  ModuleCache::Stats base_stats_;
+};
+
+}  // namespace
+
+TEST_F(ModuleCacheTest, SameContentSharesEntry) {
+  loader_->contents[ToU8("asset:/a.js")] = ToU8("var a = 1;");
+  auto first = Load("asset:/a.js");
+  auto second = Load("asset:/a.js");
+  ASSERT_TRUE(first.source);
+  EXPECT_EQ(first.source, second.source);
+  EXPECT_EQ(loader_->request_count, 2);
+  auto stats = GetStats();
+  EXPECT_EQ(stats.miss_count, 1u);
+  EXPECT_EQ(stats.hit_count, 1u);
+}
+
+TEST_F(ModuleCacheTest, ChangedContentIsRevalidated) {
+  unicode_string_view uri(ToU8("asset:/a.js"));
+  loader_->contents[ToU8("asset:/a.js")] = ToU8("var a = 1;");
+  auto first = Load("asset:/a.js");
+  ModuleCache::GetInstance().PutCodeCache(uri, first.hash, ToU8("cache of a1"));
+
+  loader_->contents[ToU8("asset:/a.js")] = ToU8("var a = 2;");
+  auto second = Load("asset:/a.js");
+  ASSERT_TRUE(second.source);
+  EXPECT_EQ(*second.source, ToU8("var a = 2;"));
+  EXPECT_NE(second.hash, first.hash);
+  // the code cache of the previous content is never handed out with the new one
+  EXPECT_FALSE(second.code_cache);
+}
+
+TEST_F(ModuleCacheTest, CodeCacheFollowsHash) {
+  unicode_string_view uri(ToU8("asset:/a.js"));
+  loader_->contents[ToU8("asset:/a.js")] = ToU8("var a = 1;");
+  auto first = Load("asset:/a.js");
+  ModuleCache::GetInstance().PutCodeCache(uri, first.hash + 1, ToU8("wrong"));
+  EXPECT_FALSE(Load("asset:/a.js").code_cache);
+
+  ModuleCache::GetInstance().PutCodeCache(uri, first.hash, ToU8("cache of a"));
+  auto second = Load("asset:/a.js");
+  ASSERT_TRUE(second.code_cache);
+  EXPECT_EQ(*second.code_cache, ToU8("cache of a"));
+  EXPECT_EQ(GetStats().code_cache_hit_count, 1u);
+}
+
+TEST_F(ModuleCacheTest, ConcurrentLoadsAreCoalesced) {
+  loader_->contents[ToU8("asset:/a.js")] = ToU8("var a = 1;");
+  loader_->is_deferred = true;
+  int count = 0;
+  for (int i = 0; i < 3; ++i) {
+    ModuleCache::GetInstance().Load(unicode_string_view(ToU8("asset:/a.js")), loader_,
+                                    [&count](ModuleCache::Module module) {
+                                      EXPECT_TRUE(module.source);
+                                      ++count;
+                                    });
+  }
+  EXPECT_EQ(loader_->request_count, 1);
+  ASSERT_EQ(loader_->deferred.size(), 1u);
+  loader_->deferred[0]();
+  EXPECT_EQ(count, 3);
+  EXPECT_EQ(GetStats().coalesced_count, 2u);
+}
+
+TEST_F(ModuleCacheTest, EmptyContentIsNotCached) {
+  auto module = Load("asset:/missing.js");
+  EXPECT_FALSE(module.source);
+  EXPECT_EQ(GetStats().entry_count, 0u);
+}
+
+TEST_F(ModuleCacheTest, EvictsLeastRecentlyUsed) {
+  loader_->contents[ToU8("asset:/a.js")] = ToU8("aaaaaaaaaa");
+  loader_->contents[ToU8("asset:/b.js")] = ToU8("bbbbbbbbbb");
+  loader_->contents[ToU8("asset:/c.js")] = ToU8("cccccccccc");
+  ModuleCache::GetInstance().SetCapacity(20);
+  Load("asset:/a.js");
+  Load("asset:/b.js");
+  Load("asset:/a.js");
+  Load("asset:/c.js");
+  auto stats = GetStats();
+  EXPECT_EQ(stats.entry_count, 2u);
+  EXPECT_EQ(stats.size_in_bytes, 20u);
+  EXPECT_EQ(stats.eviction_count, 1u);
+  // b was the least recently used
+  Load("asset:/b.js");
+  EXPECT_EQ(GetStats().miss_count, 4u);
+}
+
+TEST_F(ModuleCacheTest, TrimFreesBytes) {
+  loader_->contents[ToU8("asset:/a.js")] = ToU8("aaaaaaaaaa");
+  loader_->contents[ToU8("asset:/b.js")] = ToU8("bbbbbbbbbb");
+  Load("asset:/a.js");
+  Load("asset:/b.js");
+  EXPECT_EQ(ModuleCache::GetInstance().Trim(10), 10u);
+  EXPECT_EQ(GetStats().entry_count, 1u);
+}
+
+TEST_F(ModuleCacheTest, TrimToCapacityShareIsIdempotent) {
+  loader_->contents[ToU8("asset:/a.js")] = ToU8("aaaaaaaaaa");
+  loader_->contents[ToU8("asset:/b.js")] = ToU8("bbbbbbbbbb");
+  ModuleCache::GetInstance().SetCapacity(20);
+  Load("asset:/a.js");
+  Load("asset:/b.js");
+  auto& cache = ModuleCache::GetInstance();
+  EXPECT_EQ(cache.Trim(cache.GetCapacity() / 2), 10u);
+  EXPECT_EQ(cache.Trim(cache.GetCapacity() / 2), 0u);
+  EXPECT_EQ(GetStats().size_in_bytes, 10u);
+}
@@ -0,0 +1,112 @@
+/*
+ *
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2022 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <gtest.h>
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "base/persistent_object_map.h"
+
+namespace {
+
+using ObjectMap = footstone::PersistentObjectMap<uint32_t, std::shared_ptr<std::string>>;
+
+// looks its key up in `map` when destroyed, which blocks if the shard is still locked
+struct Reentrant {
+  footstone::PersistentObjectMap<uint32_t, std::shared_ptr<Reentrant>>* map;
+  uint32_t key;
+  bool* is_destroyed;
+  ~Reentrant() {
+    std::shared_ptr<Reentrant> value;
+    *is_destroyed = !map->Find(key, value);
+  }
+};
+
+}  // namespace
+
+TEST(PersistentObjectMapTest, InsertFindErase) {
+  ObjectMap map;
+  auto value = std::make_shared<std::string>("a");
+  EXPECT_TRUE(map.Insert(1, value));
+  EXPECT_FALSE(map.Insert(1, std::make_shared<std::string>("b")));
+  EXPECT_FALSE(map.Emplace(1, std::make_shared<std::string>("b")));
+  EXPECT_TRUE(map.Emplace(2, std::make_shared<std::string>("c")));
+
+  std::shared_ptr<std::string> found;
+  ASSERT_TRUE(map.Find(1, found));
+  EXPECT_EQ(found, value);
+  EXPECT_TRUE(map.Erase(1));
+  EXPECT_FALSE(map.Erase(1));
+  EXPECT_FALSE(map.Find(1, found));
+  map.Clear();
+  EXPECT_FALSE(map.Find(2, found));
+}
+
+TEST(PersistentObjectMapTest, EraseReleasesTheValueUnlocked) {
+  footstone::PersistentObjectMap<uint32_t, std::shared_ptr<Reentrant>> map;
+  bool is_destroyed = false;
+  map.Insert(7, std::shared_ptr<Reentrant>(new Reentrant{&map, 7, &is_destroyed}));
+  EXPECT_TRUE(map.Erase(7));
+  EXPECT_TRUE(is_destroyed);
+}
+
+TEST(PersistentObjectMapTest, ReadersSeeWholeValuesWhileWritersChurn) {
+  constexpr uint32_t kKeyCount = 64;
+  constexpr int kRoundCount = 2000;
+  ObjectMap map;
+  for (uint32_t key = 0; key < kKeyCount; ++key) {
+    map.Insert(key, std::make_shared<std::string>(std::to_string(key)));
+  }
+  std::atomic<bool> is_stopping{false};
+  std::atomic<int> mismatch_count{0};
+  std::vector<std::thread> readers;
+  for (int i = 0; i < 3; ++i) {
+    readers.emplace_back([&] {
+      while (!is_stopping.load()) {
+        for (uint32_t key = 0; key < kKeyCount; ++key) {
+          std::shared_ptr<std::string> value;
+          if (map.Find(key, value) && *value != std::to_string(key)) {
+            ++mismatch_count;
+          }
+        }
+      }
+    });
+  }
+  for (int round = 0; round < kRoundCount; ++round) {
+    uint32_t key = static_cast<uint32_t>(round) % kKeyCount;
+    map.Erase(key);
+    map.Insert(key, std::make_shared<std::string>(std::to_string(key)));
+  }
+  is_stopping.store(true);
+  for (auto& reader : readers) {
+    reader.join();
+  }
+  EXPECT_EQ(mismatch_count.load(), 0);
+  for (uint32_t key = 0; key < kKeyCount; ++key) {
+    std::shared_ptr<std::string> value;
+    EXPECT_TRUE(map.Find(key, value));
+  }
+}
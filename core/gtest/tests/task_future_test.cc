@@ -0,0 +1,101 @@
+/*
+ *
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2022 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <gtest.h>
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "core/task/task_future.h"
+
+namespace {
+
+class TaskFutureTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    js_runner_ = std::make_shared<JavaScriptTaskRunner>();
+    js_runner_->Start();
+    worker_runner_ = std::make_shared<WorkerTaskRunner>(1);
+  }
+
+  void TearDown() override {
+    worker_runner_->Terminate();
+    js_runner_->Terminate();
+  }
+
+  std::shared_ptr<JavaScriptTaskRunner> js_runner_;
+  std::shared_ptr<WorkerTaskRunner> worker_runner_;
+};
+
+}  // namespace
+
+TEST_F(TaskFutureTest, ChainsAcrossRunners) {
+  auto js_runner = js_runner_;
+  auto result = RunAsync(worker_runner_, [] { return std::string("bundle"); })
+      .Then(js_runner_, [js_runner](std::string content) {
+        return js_runner->IsJsThread() ? content + " ran" : std::string("wrong thread");
+      })
+      .Get();
+  ASSERT_TRUE(result);
+  EXPECT_EQ(*result, "bundle ran");
+}
+
+TEST_F(TaskFutureTest, StepsOfARunnerKeepItsOrder) {
+  std::vector<int> order;
+  auto first = RunAsync(js_runner_, [&order] { order.push_back(1); });
+  auto second = RunAsync(js_runner_, [&order] { order.push_back(2); });
+  EXPECT_TRUE(second.Get());
+  EXPECT_TRUE(first.Get());
+  EXPECT_EQ(order, (std::vector<int>{1, 2}));
+}
+
+TEST_F(TaskFutureTest, ValueSetBeforeGetIsKept) {
+  TaskPromise<int> promise;
+  auto future = promise.GetFuture();
+  promise.SetValue(7);
+  auto value = future.Get();
+  ASSERT_TRUE(value);
+  EXPECT_EQ(*value, 7);
+}
+
+TEST_F(TaskFutureTest, DroppedPromiseBreaksGet) {
+  std::optional<TaskPromise<int>> promise;
+  promise.emplace();
+  auto future = promise->GetFuture();
+  promise.reset();
+  EXPECT_FALSE(future.Get());
+}
+
+TEST_F(TaskFutureTest, TerminatedRunnerBreaksTheChain) {
+  worker_runner_->Terminate();
+  bool is_run = false;
+  auto result = RunAsync(worker_runner_, [] { return 1; })
+      .Then(js_runner_, [&is_run](int value) {
+        is_run = true;
+        return value;
+      })
+      .Get();
+  EXPECT_FALSE(result);
+  EXPECT_FALSE(is_run);
+}
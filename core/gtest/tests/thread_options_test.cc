@@ -0,0 +1,97 @@
+/*
+ *
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2022 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <gtest.h>
+
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <future>
+#include <memory>
+#include <thread>
+
+#include "core/base/task_runner.h"
+#include "core/task/common_task.h"
+
+namespace {
+
+using TaskRunner = hippy::base::TaskRunner;
+
+// runs `func` on `runner` and waits for it
+void RunOn(TaskRunner& runner, std::function<void()> func) {
+  std::promise<void> promise;
+  auto task = std::make_shared<CommonTask>();
+  task->func_ = [&promise, &func] {
+    func();
+    promise.set_value();
+  };
+  runner.PostTask(std::move(task));
+  promise.get_future().wait();
+}
+
+}  // namespace
+
+TEST(ThreadOptionsTest, InitCallbackRunsOnTheThreadFirst) {
+  std::thread::id init_thread_id;
+  std::thread::id task_thread_id;
+  bool is_inited_before_task = false;
+  TaskRunner runner(TaskRunner::Options("test init").set_init_callback([&init_thread_id] {
+    init_thread_id = std::this_thread::get_id();
+  }));
+  runner.Start();
+  RunOn(runner, [&] {
+    task_thread_id = std::this_thread::get_id();
+    is_inited_before_task = init_thread_id == task_thread_id;
+  });
+  runner.Terminate();
+  EXPECT_TRUE(is_inited_before_task);
+  EXPECT_NE(task_thread_id, std::this_thread::get_id());
+}
+
+#if defined(__linux__)
+// lowering the priority needs no privilege
+TEST(ThreadOptionsTest, PriorityAppliesToTheThreadOnly) {
+  int caller_priority = getpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid)));
+  int runner_priority = 0;
+  TaskRunner runner(TaskRunner::Options("test nice").set_priority(caller_priority + 1));
+  runner.Start();
+  RunOn(runner, [&runner_priority] {
+    runner_priority = getpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid)));
+  });
+  runner.Terminate();
+  EXPECT_EQ(runner_priority, caller_priority + 1);
+  EXPECT_EQ(getpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid))), caller_priority);
+}
+#endif
+
+TEST(ThreadOptionsTest, DefaultsKeepTheCallerPriority) {
+  int caller_priority = getpriority(PRIO_PROCESS, 0);
+  int runner_priority = 0;
+  TaskRunner runner(TaskRunner::Options("test default"));
+  runner.Start();
+  RunOn(runner, [&runner_priority] {
+    runner_priority = getpriority(PRIO_PROCESS, 0);
+  });
+  runner.Terminate();
+  EXPECT_EQ(runner_priority, caller_priority);
+}
@@ -0,0 +1,168 @@
+/*
+ *
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2022 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <gtest.h>
+
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "core/base/trace_event.h"
+
+using TraceLog = hippy::base::TraceLog;
+
+namespace {
+
+constexpr char kCategory[] = "test";
+constexpr char kStartup[] = "Startup";
+constexpr char kHot[] = "Hot";
+
+size_t CountEvents(const std::vector<TraceLog::Event>& events, const char* name) {
+  size_t count = 0;
+  for (const auto& event : events) {
+    count += event.name == name ? 1 : 0;
+  }
+  return count;
+}
+
+void RunHotPath(uint32_t count) {
+  for (uint32_t i = 0; i < count; ++i) {
+    HIPPY_TRACE_EVENT_FIRST_N(kCategory, kHot, 3);
+  }
+}
+
+}  // namespace
+
+class TraceEventTest : public testing::Test {
+ protected:
+  void TearDown() override { TraceLog::GetInstance().Stop(); }
+};
+
+TEST_F(TraceEventTest, DisabledRecordsNothing) {
+  auto& trace_log = TraceLog::GetInstance();
+  ASSERT_TRUE(trace_log.Start());
+  trace_log.Stop();
+  { HIPPY_TRACE_EVENT(kCategory, kStartup); }
+  HIPPY_TRACE_EVENT_INSTANT(kCategory, kStartup);
+  EXPECT_TRUE(trace_log.GetEvents().empty());
+}
+
+TEST_F(TraceEventTest, NotSampledRecordsNothing) {
+  auto& trace_log = TraceLog::GetInstance();
+  TraceLog::Options options;
+  options.sampling_rate = 0;
+  EXPECT_FALSE(trace_log.Start(options));
+  EXPECT_FALSE(trace_log.IsEnabled());
+  { HIPPY_TRACE_EVENT(kCategory, kStartup); }
+  EXPECT_TRUE(trace_log.GetEvents().empty());
+}
+
+TEST_F(TraceEventTest, StartDropsPreviousSession) {
+  auto& trace_log = TraceLog::GetInstance();
+  ASSERT_TRUE(trace_log.Start());
+  HIPPY_TRACE_EVENT_INSTANT(kCategory, kStartup);
+  EXPECT_EQ(trace_log.GetEvents().size(), 1u);
+  ASSERT_TRUE(trace_log.Start());
+  EXPECT_TRUE(trace_log.GetEvents().empty());
+}
+
+TEST_F(TraceEventTest, ThreadsKeepTheirOwnEvents) {
+  auto& trace_log = TraceLog::GetInstance();
+  TraceLog::Options options;
+  options.capacity = 16;
+  ASSERT_TRUE(trace_log.Start(options));
+  HIPPY_TRACE_EVENT_INSTANT(kCategory, kStartup);
+  // a busy thread wraps its own ring only
+  std::thread busy([] {
+    for (int i = 0; i < 1000; ++i) {
+      HIPPY_TRACE_EVENT_INSTANT(kCategory, kHot);
+    }
+  });
+  busy.join();
+  auto events = trace_log.GetEvents();
+  EXPECT_EQ(CountEvents(events, kStartup), 1u);
+  EXPECT_EQ(CountEvents(events, kHot), 16u);
+  for (size_t i = 1; i < events.size(); ++i) {
+    EXPECT_LE(events[i - 1].timestamp_in_us, events[i].timestamp_in_us);
+  }
+  std::set<uint32_t> thread_ids;
+  for (const auto& event : events) {
+    thread_ids.insert(event.thread_id);
+  }
+  EXPECT_EQ(thread_ids.size(), 2u);
+}
+
+TEST_F(TraceEventTest, ExitedThreadEventsAreExported) {
+  auto& trace_log = TraceLog::GetInstance();
+  ASSERT_TRUE(trace_log.Start());
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; ++i) {
+    threads.emplace_back([] {
+      HIPPY_TRACE_EVENT(kCategory, kStartup);
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(CountEvents(trace_log.GetEvents(), kStartup), 4u);
+  auto json = trace_log.ExportJson();
+  EXPECT_EQ(json.find("{\"traceEvents\":["), 0u);
+  EXPECT_NE(json.find("\"name\":\"thread_name\""), std::string::npos);
+  EXPECT_NE(json.find("\"ph\":\"X\",\"cat\":\"test\",\"name\":\"Startup\""), std::string::npos);
+  // the buffers of exited threads are released by the next session
+  ASSERT_TRUE(trace_log.Start());
+  EXPECT_TRUE(trace_log.GetEvents().empty());
+}
+
+TEST_F(TraceEventTest, FirstNRecordsLimitPerSession) {
+  auto& trace_log = TraceLog::GetInstance();
+  ASSERT_TRUE(trace_log.Start());
+  RunHotPath(10);
+  EXPECT_EQ(CountEvents(trace_log.GetEvents(), kHot), 3u);
+  RunHotPath(10);
+  EXPECT_EQ(CountEvents(trace_log.GetEvents(), kHot), 3u);
+  // a new session starts counting again
+  ASSERT_TRUE(trace_log.Start());
+  RunHotPath(2);
+  EXPECT_EQ(CountEvents(trace_log.GetEvents(), kHot), 2u);
+}
+
+TEST_F(TraceEventTest, FirstNCountsAcrossThreads) {
+  auto& trace_log = TraceLog::GetInstance();
+  ASSERT_TRUE(trace_log.Start());
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; ++i) {
+    threads.emplace_back([] { RunHotPath(100); });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(CountEvents(trace_log.GetEvents(), kHot), 3u);
+}
+
+TEST(TraceEventLimitTest, ZeroLimitNeverAcquires) {
+  ASSERT_TRUE(TraceLog::GetInstance().Start());
+  hippy::base::TraceEventLimit limit(0);
+  EXPECT_FALSE(limit.Acquire());
+  TraceLog::GetInstance().Stop();
+}
@@ -0,0 +1,231 @@
+/*
+ *
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2022 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <gtest.h>
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "base/unicode_transcoder.h"
+
+namespace {
+
+using UnicodeTranscoder = tdf::base::UnicodeTranscoder;
+
+constexpr int kIterationCount = 2000;
+// long enough to cover the vector loops and their tails
+constexpr size_t kMaxLength = 80;
+
+void AppendUtf8(char32_t c, std::string& out) {
+  if (c < 0x80) {
+    out += static_cast<char>(c);
+  } else if (c < 0x800) {
+    out += static_cast<char>(0xC0 | (c >> 6));
+    out += static_cast<char>(0x80 | (c & 0x3F));
+  } else if (c < 0x10000) {
+    out += static_cast<char>(0xE0 | (c >> 12));
+    out += static_cast<char>(0x80 | ((c >> 6) & 0x3F));
+    out += static_cast<char>(0x80 | (c & 0x3F));
+  } else {
+    out += static_cast<char>(0xF0 | (c >> 18));
+    out += static_cast<char>(0x80 | ((c >> 12) & 0x3F));
+    out += static_cast<char>(0x80 | ((c >> 6) & 0x3F));
+    out += static_cast<char>(0x80 | (c & 0x3F));
+  }
+}
+
+void AppendUtf16(char32_t c, std::u16string& out) {
+  if (c < 0x10000) {
+    out += static_cast<char16_t>(c);
+  } else {
+    out += static_cast<char16_t>(0xD800 + ((c - 0x10000) >> 10));
+    out += static_cast<char16_t>(0xDC00 + ((c - 0x10000) & 0x3FF));
+  }
+}
+
+// mostly ASCII runs, as in real scripts, mixed with every other encoded length
+std::u32string RandomCodePoints(std::mt19937& rng) {
+  std::uniform_int_distribution<size_t> length_dist(0, kMaxLength);
+  std::uniform_int_distribution<int> kind_dist(0, 9);
+  std::u32string result;
+  size_t length = length_dist(rng);
+  for (size_t i = 0; i < length; ++i) {
+    char32_t c;
+    switch (kind_dist(rng)) {
+      case 0:
+        c = std::uniform_int_distribution<char32_t>(0x80, 0x7FF)(rng);
+        break;
+      case 1:
+        c = std::uniform_int_distribution<char32_t>(0x800, 0xD7FF)(rng);
+        break;
+      case 2:
+        c = std::uniform_int_distribution<char32_t>(0xE000, 0xFFFF)(rng);
+        break;
+      case 3:
+        c = std::uniform_int_distribution<char32_t>(0x10000, 0x10FFFF)(rng);
+        break;
+      default:
+        c = std::uniform_int_distribution<char32_t>(0, 0x7F)(rng);
+        break;
+    }
+    result += c;
+  }
+  return result;
+}
+
+// RFC 3629
+bool IsValidUtf8(const std::string& str) {
+  size_t i = 0;
+  while (i < str.length()) {
+    auto byte = static_cast<uint8_t>(str[i]);
+    size_t count;
+    char32_t c;
+    if (byte < 0x80) {
+      ++i;
+      continue;
+    } else if ((byte & 0xE0) == 0xC0) {
+      count = 1;
+      c = byte & 0x1F;
+    } else if ((byte & 0xF0) == 0xE0) {
+      count = 2;
+      c = byte & 0x0F;
+    } else if ((byte & 0xF8) == 0xF0) {
+      count = 3;
+      c = byte & 0x07;
+    } else {
+      return false;
+    }
+    if (i + count >= str.length()) {
+      return false;
+    }
+    for (size_t j = 1; j <= count; ++j) {
+      auto next = static_cast<uint8_t>(str[i + j]);
+      if ((next & 0xC0) != 0x80) {
+        return false;
+      }
+      c = (c << 6) | (next & 0x3F);
+    }
+    static const char32_t kMin[] = {0, 0x80, 0x800, 0x10000};
+    if (c < kMin[count] || c > 0x10FFFF || (c >= 0xD800 && c <= 0xDFFF)) {
+      return false;
+    }
+    i += count + 1;
+  }
+  return true;
+}
+
+}  // namespace
+
+TEST(UnicodeTranscoderTest, RoundTripsRandomText) {
+  std::mt19937 rng(20221019);
+  for (int i = 0; i < kIterationCount; ++i) {
+    std::u32string utf32 = RandomCodePoints(rng);
+    std::string utf8;
+    std::u16string utf16;
+    for (char32_t c : utf32) {
+      AppendUtf8(c, utf8);
+      AppendUtf16(c, utf16);
+    }
+
+    std::string utf8_out;
+    std::u16string utf16_out;
+    std::u32string utf32_out;
+    ASSERT_TRUE(UnicodeTranscoder::Utf8ToUtf16(utf8, utf16_out));
+    EXPECT_EQ(utf16_out, utf16);
+    ASSERT_TRUE(UnicodeTranscoder::Utf16ToUtf8(utf16_out, utf8_out));
+    EXPECT_EQ(utf8_out, utf8);
+    ASSERT_TRUE(UnicodeTranscoder::Utf8ToUtf32(utf8, utf32_out));
+    EXPECT_EQ(utf32_out, utf32);
+    ASSERT_TRUE(UnicodeTranscoder::Utf32ToUtf8(utf32_out, utf8_out));
+    EXPECT_EQ(utf8_out, utf8);
+    ASSERT_TRUE(UnicodeTranscoder::Utf32ToUtf16(utf32, utf16_out));
+    EXPECT_EQ(utf16_out, utf16);
+    ASSERT_TRUE(UnicodeTranscoder::Utf16ToUtf32(utf16, utf32_out));
+    EXPECT_EQ(utf32_out, utf32);
+  }
+}
+
+TEST(UnicodeTranscoderTest, Latin1MatchesCodePoints) {
+  std::mt19937 rng(1);
+  for (int i = 0; i < kIterationCount; ++i) {
+    std::string latin1(std::uniform_int_distribution<size_t>(0, kMaxLength)(rng), '\0');
+    for (auto& c : latin1) {
+      c = static_cast<char>(std::uniform_int_distribution<int>(1, 0xFF)(rng));
+    }
+    std::string utf8;
+    std::u16string utf16;
+    for (char c : latin1) {
+      AppendUtf8(static_cast<uint8_t>(c), utf8);
+      AppendUtf16(static_cast<uint8_t>(c), utf16);
+    }
+    std::string utf8_out;
+    UnicodeTranscoder::Latin1ToUtf8(latin1, utf8_out);
+    EXPECT_EQ(utf8_out, utf8);
+    EXPECT_EQ(UnicodeTranscoder::Latin1ToUtf16(latin1), utf16);
+  }
+}
+
+TEST(UnicodeTranscoderTest, ValidatesRandomBytesLikeTheReference) {
+  std::mt19937 rng(2);
+  for (int i = 0; i < kIterationCount * 10; ++i) {
+    std::u32string code_points = RandomCodePoints(rng);
+    std::string bytes;
+    for (char32_t c : code_points) {
+      AppendUtf8(c, bytes);
+    }
+    // corrupt a few bytes of otherwise valid text
+    if (!bytes.empty()) {
+      int count = std::uniform_int_distribution<int>(0, 2)(rng);
+      for (int j = 0; j < count; ++j) {
+        size_t pos = std::uniform_int_distribution<size_t>(0, bytes.length() - 1)(rng);
+        bytes[pos] = static_cast<char>(std::uniform_int_distribution<int>(0, 0xFF)(rng));
+      }
+    }
+    bool is_valid = IsValidUtf8(bytes);
+    ASSERT_EQ(UnicodeTranscoder::ValidateUtf8(reinterpret_cast<const uint8_t*>(bytes.data()), bytes.length()),
+              is_valid);
+    std::u16string utf16_out = u"untouched";
+    ASSERT_EQ(UnicodeTranscoder::Utf8ToUtf16(bytes, utf16_out), is_valid);
+    if (!is_valid) {
+      EXPECT_EQ(utf16_out, u"untouched");
+    }
+  }
+}
+
+TEST(UnicodeTranscoderTest, RejectsLoneSurrogates) {
+  std::string out;
+  EXPECT_FALSE(UnicodeTranscoder::Utf16ToUtf8(std::u16string(u"ab") + char16_t(0xD800), out));
+  EXPECT_FALSE(UnicodeTranscoder::Utf16ToUtf8(std::u16string(1, char16_t(0xDC00)) + u"ab", out));
+  EXPECT_FALSE(UnicodeTranscoder::Utf32ToUtf8(std::u32string(1, char32_t(0xDFFF)), out));
+  EXPECT_FALSE(UnicodeTranscoder::Utf32ToUtf8(std::u32string(1, char32_t(0x110000)), out));
+  EXPECT_TRUE(out.empty());
+}
+
+TEST(UnicodeTranscoderTest, RejectsOverlongUtf8) {
+  std::u16string out;
+  EXPECT_FALSE(UnicodeTranscoder::Utf8ToUtf16(std::string("\xC0\xAF"), out));
+  EXPECT_FALSE(UnicodeTranscoder::Utf8ToUtf16(std::string("\xE0\x80\xAF"), out));
+  EXPECT_FALSE(UnicodeTranscoder::Utf8ToUtf16(std::string("\xF0\x80\x80\xAF"), out));
+  EXPECT_FALSE(UnicodeTranscoder::Utf8ToUtf16(std::string("\xED\xA0\x80"), out));
+  EXPECT_FALSE(UnicodeTranscoder::Utf8ToUtf16(std::string("\xF4\x90\x80\x80"), out));
+}
@@ -35,6 +35,7 @@ constexpr int KB = 1024;
 constexpr int MB = KB * 1024;
 constexpr int GB = MB * 1024;
 constexpr char kUseSnapshot[] = "USE_SNAPSHOT";
+constexpr char kSnapshotContext[] = "SNAPSHOT_CONTEXT";
 constexpr char kVMCreateCBKey[] = "VM_CREATED";
 constexpr char kContextCreatedCBKey[] = "CONTEXT_CREATED";
 constexpr char KScopeInitializedCBKey[] = "SCOPE_INITIALIZED";
@@ -70,7 +71,7 @@ static constexpr bool numeric_cast(const SourceType& source, TargetType& target)
 
 template<typename SourceType, typename TargetType>
 static constexpr TargetType checked_numeric_cast(const SourceType& source) {
-  TargetType target;
+  TargetType target{};
   auto result = numeric_cast<SourceType, TargetType>(source, target);
   TDF_BASE_CHECK(result);
   return target;
@@ -113,5 +113,32 @@ class HippyFile {
     return SaveFile(file_name, content.data(), content.size(), mode);
   }
 };
+
+// A file mapped read-only into memory, the mapping lives as long as the object.
+class MappedFile {
+ public:
+  using unicode_string_view = tdf::base::unicode_string_view;
+
+  static std::shared_ptr<MappedFile> Open(const unicode_string_view& file_path);
+  ~MappedFile();
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  inline const uint8_t* GetData() const { return data_; }
+  inline size_t GetLength() const { return length_; }
+  // identity of the file that was mapped, a replaced file gets a new one
+  inline dev_t GetDevice() const { return device_; }
+  inline ino_t GetInode() const { return inode_; }
+  inline time_t GetModifyTime() const { return modify_time_; }
+
+ private:
+  MappedFile(const uint8_t* data, size_t length, dev_t device, ino_t inode, time_t modify_time);
+
+  const uint8_t* data_;
+  size_t length_;
+  dev_t device_;
+  ino_t inode_;
+  time_t modify_time_;
+};
 }  // namespace base
 }  // namespace hippy
@@ -53,6 +53,7 @@ class JSValueWrapper final {
  public:
   JSValueWrapper() {}
   JSValueWrapper(const JSValueWrapper& source);
+  JSValueWrapper(JSValueWrapper&& source) noexcept;
 
   JSValueWrapper(int32_t int32_value)  // NOLINT
       : type_(Type::Int32), int32_value_(int32_value) {}
@@ -75,13 +76,14 @@ class JSValueWrapper final {
   explicit JSValueWrapper(const JSObjectType& object_value)
       : type_(Type::Object), object_value_(object_value) {}
   explicit JSValueWrapper(JSArrayType&& array_value)
-      : type_(Type::Array), array_value_(array_value) {}
+      : type_(Type::Array), array_value_(std::move(array_value)) {}
   explicit JSValueWrapper(JSArrayType& array_value)
       : type_(Type::Array), array_value_(array_value) {}
   ~JSValueWrapper();
 
  public:
   JSValueWrapper& operator=(const JSValueWrapper& rhs) noexcept;
+  JSValueWrapper& operator=(JSValueWrapper&& rhs) noexcept;
   JSValueWrapper& operator=(const int32_t rhs) noexcept;
   JSValueWrapper& operator=(const uint32_t rhs) noexcept;
   JSValueWrapper& operator=(const double rhs) noexcept;
@@ -22,13 +22,13 @@
 
 #pragma once
 
-#include <codecvt>
-#include <locale>
+#include <cstring>
 #include <string>
 #include <utility>
 
 #include "base/logging.h"
 #include "base/unicode_string_view.h"
+#include "base/unicode_transcoder.h"
 
 #define EXTEND_LITERAL(ch) ch, ch, u##ch, U##ch
 
@@ -42,6 +42,7 @@ constexpr char32_t kU32CharConversionFailedPrompt[] = U"<u32string conversion fa
 class StringViewUtils {
  public:
   using unicode_string_view = tdf::base::unicode_string_view;
+  using UnicodeTranscoder = tdf::base::UnicodeTranscoder;
   using u8string = unicode_string_view::u8string;
   using char8_t_ = unicode_string_view::char8_t_;
 
@@ -94,7 +95,7 @@ class StringViewUtils {
     switch (src_encoding) {
       case unicode_string_view::Encoding::Latin1: {
         return unicode_string_view(
-            CopyChars<char, char16_t>(str_view.latin1_value()));
+            UnicodeTranscoder::Latin1ToUtf16(str_view.latin1_value()));
       }
       case unicode_string_view::Encoding::Utf16: {
         return unicode_string_view(str_view.utf16_value());
@@ -142,15 +143,7 @@ class StringViewUtils {
     switch (src_encoding) {
       case unicode_string_view::Encoding::Latin1: {
         u8string u8;
-        for (const auto& ch : str_view.latin1_value()){
-          auto c = static_cast<uint8_t>(ch);
-          if (c < 0x80) {
-            u8 += c;
-          } else {
-            u8 += (0xc0 | c >> 6);
-            u8 += (0x80 | (c & 0x3f));
-          }
-        }
+        UnicodeTranscoder::Latin1ToUtf8(str_view.latin1_value(), u8);
         return unicode_string_view(std::move(u8));
       }
       case unicode_string_view::Encoding::Utf16: {
@@ -350,55 +343,54 @@ class StringViewUtils {
 
   inline static unicode_string_view::u8string U32ToU8(
       const std::u32string &str) {
-    std::wstring_convert<std::codecvt_utf8<char32_t>, char32_t> convert(
-        kCharConversionFailedPrompt, kU32CharConversionFailedPrompt);
-    std::string bytes = convert.to_bytes(str);
-    const unicode_string_view::char8_t_ *ptr =
-        reinterpret_cast<const unicode_string_view::char8_t_ *>(bytes.data());
-    return unicode_string_view::u8string(ptr, bytes.length());
+    unicode_string_view::u8string u8;
+    if (!UnicodeTranscoder::Utf32ToUtf8(str, u8)) {
+      return unicode_string_view::u8string(ToU8Pointer(kCharConversionFailedPrompt));
+    }
+    return u8;
   }
 
   inline static std::u32string U8ToU32(
       const unicode_string_view::u8string &str) {
-    const char *ptr = reinterpret_cast<const char *>(str.c_str());
-    std::wstring_convert<std::codecvt_utf8<char32_t>, char32_t> convert(
-        kCharConversionFailedPrompt, kU32CharConversionFailedPrompt);
-    return convert.from_bytes(ptr, ptr + str.length());
+    std::u32string u32;
+    if (!UnicodeTranscoder::Utf8ToUtf32(str, u32)) {
+      return kU32CharConversionFailedPrompt;
+    }
+    return u32;
   }
 
   inline static unicode_string_view::u8string U16ToU8(
       const std::u16string &str) {
-    std::wstring_convert<std::codecvt_utf8_utf16<char16_t>, char16_t> convert(
-        kCharConversionFailedPrompt, kU16CharConversionFailedPrompt);
-    std::string bytes = convert.to_bytes(str);
-    const unicode_string_view::char8_t_ *ptr =
-        reinterpret_cast<const unicode_string_view::char8_t_ *>(bytes.data());
-    return unicode_string_view::u8string(ptr, bytes.length());
+    unicode_string_view::u8string u8;
+    if (!UnicodeTranscoder::Utf16ToUtf8(str, u8)) {
+      return unicode_string_view::u8string(ToU8Pointer(kCharConversionFailedPrompt));
+    }
+    return u8;
   }
 
   inline static std::u16string U8ToU16(
       const unicode_string_view::u8string &str) {
-    const char *ptr = reinterpret_cast<const char *>(str.c_str());
-    std::wstring_convert<std::codecvt_utf8_utf16<char16_t>, char16_t> convert(
-        kCharConversionFailedPrompt, kU16CharConversionFailedPrompt);
-    return convert.from_bytes(ptr, ptr + str.length());
+    std::u16string u16;
+    if (!UnicodeTranscoder::Utf8ToUtf16(str, u16)) {
+      return kU16CharConversionFailedPrompt;
+    }
+    return u16;
   }
 
   inline static std::u16string U32ToU16(const std::u32string &str) {
-    std::wstring_convert<std::codecvt_utf16<char32_t>, char32_t> convert(
-        kCharConversionFailedPrompt, kU32CharConversionFailedPrompt);
-    std::string bytes = convert.to_bytes(str);
-    return std::u16string(reinterpret_cast<const char16_t *>(bytes.c_str()),
-                          bytes.length() / sizeof(char16_t));
+    std::u16string u16;
+    if (!UnicodeTranscoder::Utf32ToUtf16(str, u16)) {
+      return kU16CharConversionFailedPrompt;
+    }
+    return u16;
   }
 
   inline static std::u32string U16ToU32(const std::u16string &str) {
-    const char16_t *ptr = str.c_str();
-    std::wstring_convert<std::codecvt_utf16<char32_t>, char32_t>
-        convert(kCharConversionFailedPrompt, kU32CharConversionFailedPrompt);
-    return convert.from_bytes(
-        reinterpret_cast<const char *>(ptr),
-        reinterpret_cast<const char *>(ptr + str.length()));
+    std::u32string u32;
+    if (!UnicodeTranscoder::Utf16ToUtf32(str, u32)) {
+      return kU32CharConversionFailedPrompt;
+    }
+    return u32;
   }
 };
 
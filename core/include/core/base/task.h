@@ -22,6 +22,7 @@
 
 #pragma once
 
+#include <stddef.h>
 #include <stdint.h>
 
 namespace hippy {
@@ -31,6 +32,15 @@ class Task {
  public:
   using TaskId = uint32_t;
 
+  // Lanes of a TaskRunner, served in declaration order.
+  enum class Priority : uint8_t {
+    kInput = 0,  // user input and other latency critical work
+    kNormal,
+    kTimer,
+    kIdle  // background work, runs when the other lanes are empty
+  };
+  static constexpr size_t kPriorityCount = 4;
+
   Task();
   virtual ~Task() = default;
   virtual bool isPriorityTask() = 0;
@@ -38,6 +48,7 @@ class Task {
 
   TaskId id_;
   bool canceled_ = false;
+  Priority priority_ = Priority::kNormal;
 };
 
 }  // namespace base
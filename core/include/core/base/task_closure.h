@@ -0,0 +1,151 @@
+/*
+ *
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2022 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include <stddef.h>
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace hippy {
+namespace base {
+
+// A move-only void() callable for task bodies. Callables up to kInlineSize bytes, which covers a
+// lambda capturing a few shared_ptrs and strings, live inside the closure instead of on the heap.
+// Unlike std::function it also accepts move-only callables.
+class TaskClosure {
+ public:
+  static constexpr size_t kInlineSize = 128;
+
+  TaskClosure() = default;
+  TaskClosure(std::nullptr_t) {}  // NOLINT(runtime/explicit)
+
+  template <typename F, typename = std::enable_if_t<!std::is_same_v<std::decay_t<F>, TaskClosure> &&
+                                                    !std::is_same_v<std::decay_t<F>, std::nullptr_t>>>
+  TaskClosure(F&& func) {  // NOLINT(runtime/explicit)
+    Emplace(std::forward<F>(func));
+  }
+
+  TaskClosure(TaskClosure&& other) noexcept { MoveFrom(other); }
+
+  TaskClosure& operator=(TaskClosure&& other) noexcept {
+    if (this != &other) {
+      Reset();
+      MoveFrom(other);
+    }
+    return *this;
+  }
+
+  TaskClosure& operator=(std::nullptr_t) {
+    Reset();
+    return *this;
+  }
+
+  template <typename F, typename = std::enable_if_t<!std::is_same_v<std::decay_t<F>, TaskClosure> &&
+                                                    !std::is_same_v<std::decay_t<F>, std::nullptr_t>>>
+  TaskClosure& operator=(F&& func) {
+    Reset();
+    Emplace(std::forward<F>(func));
+    return *this;
+  }
+
+  TaskClosure(const TaskClosure&) = delete;
+  TaskClosure& operator=(const TaskClosure&) = delete;
+
+  ~TaskClosure() { Reset(); }
+
+  explicit operator bool() const { return ops_ != nullptr; }
+
+  void operator()() { ops_->invoke(storage_); }
+
+ private:
+  struct Ops {
+    void (*invoke)(void* storage);
+    void (*move)(void* dst, void* src);
+    void (*destroy)(void* storage);
+  };
+
+  template <typename F>
+  static constexpr bool kIsInline = sizeof(F) <= kInlineSize && alignof(F) <= alignof(std::max_align_t) &&
+                                    std::is_nothrow_move_constructible_v<F>;
+
+  template <typename F>
+  struct InlineOps {
+    static void Invoke(void* storage) { (*static_cast<F*>(storage))(); }
+    static void Move(void* dst, void* src) {
+      new (dst) F(std::move(*static_cast<F*>(src)));
+      static_cast<F*>(src)->~F();
+    }
+    static void Destroy(void* storage) { static_cast<F*>(storage)->~F(); }
+    static constexpr Ops kOps = {Invoke, Move, Destroy};
+  };
+
+  template <typename F>
+  struct HeapOps {
+    static void Invoke(void* storage) { (**static_cast<F**>(storage))(); }
+    static void Move(void* dst, void* src) { *static_cast<F**>(dst) = *static_cast<F**>(src); }
+    static void Destroy(void* storage) { delete *static_cast<F**>(storage); }
+    static constexpr Ops kOps = {Invoke, Move, Destroy};
+  };
+
+  template <typename F>
+  void Emplace(F&& func) {
+    using Func = std::decay_t<F>;
+    // keep an empty std::function or a null function pointer empty
+    if constexpr (std::is_constructible_v<bool, const Func&>) {
+      if (!static_cast<bool>(func)) {
+        return;
+      }
+    }
+    if constexpr (kIsInline<Func>) {
+      new (storage_) Func(std::forward<F>(func));
+      ops_ = &InlineOps<Func>::kOps;
+    } else {
+      *reinterpret_cast<Func**>(storage_) = new Func(std::forward<F>(func));
+      ops_ = &HeapOps<Func>::kOps;
+    }
+  }
+
+  void MoveFrom(TaskClosure& other) {
+    if (other.ops_) {
+      other.ops_->move(storage_, other.storage_);
+      ops_ = other.ops_;
+      other.ops_ = nullptr;
+    }
+  }
+
+  void Reset() {
+    if (ops_) {
+      ops_->destroy(storage_);
+      ops_ = nullptr;
+    }
+  }
+
+  alignas(std::max_align_t) unsigned char storage_[kInlineSize];
+  const Ops* ops_ = nullptr;
+};
+
+}  // namespace base
+}  // namespace hippy
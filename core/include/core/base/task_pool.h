@@ -0,0 +1,88 @@
+/*
+ *
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2022 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include <stddef.h>
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace hippy {
+namespace base {
+
+// A freelist of fixed size blocks that task objects are recycled through, so that posting a
+// task does not reach the heap once the pool is warm. Larger requests go to the heap directly.
+// Blocks may be freed on another thread than the one that allocated them.
+class TaskPool {
+ public:
+  static constexpr size_t kBlockSize = 256;
+  static constexpr size_t kMaxCachedBlockCount = 64;
+
+  TaskPool();
+  ~TaskPool();
+  TaskPool(const TaskPool&) = delete;
+  TaskPool& operator=(const TaskPool&) = delete;
+
+  // shared by tasks that are not created through a runner
+  static TaskPool& GetDefault();
+
+  void* Allocate(size_t size);
+  void Deallocate(void* block, size_t size);
+
+ private:
+  std::mutex mutex_;
+  std::vector<void*> free_blocks_;
+};
+
+// Lets std::allocate_shared place a task and its control block in a pool block.
+template <typename T>
+class TaskPoolAllocator {
+ public:
+  using value_type = T;
+
+  explicit TaskPoolAllocator(std::shared_ptr<TaskPool> pool) : pool_(std::move(pool)) {}
+  template <typename U>
+  TaskPoolAllocator(const TaskPoolAllocator<U>& other) : pool_(other.pool_) {}  // NOLINT(runtime/explicit)
+
+  T* allocate(size_t n) { return static_cast<T*>(pool_->Allocate(n * sizeof(T))); }
+  void deallocate(T* p, size_t n) { pool_->Deallocate(p, n * sizeof(T)); }
+
+  template <typename U>
+  bool operator==(const TaskPoolAllocator<U>& other) const {
+    return pool_ == other.pool_;
+  }
+  template <typename U>
+  bool operator!=(const TaskPoolAllocator<U>& other) const {
+    return pool_ != other.pool_;
+  }
+
+ private:
+  template <typename U>
+  friend class TaskPoolAllocator;
+
+  std::shared_ptr<TaskPool> pool_;
+};
+
+}  // namespace base
+}  // namespace hippy
@@ -24,6 +24,7 @@
 
 #include <stdint.h>
 
+#include <array>
 #include <condition_variable>  // NOLINT(build/c++11)
 #include <memory>
 #include <mutex>  // NOLINT(build/c++11)
@@ -31,34 +32,61 @@
 #include <utility>
 #include <vector>
 
+#include "core/base/task.h"
+#include "core/base/task_pool.h"
 #include "core/base/thread.h"
 
 namespace hippy {
 namespace base {
 
-class Task;
 class TaskRunner : public Thread {
  public:
   using DelayedTimeInMs = uint64_t;
 
+  // Time tasks of a lane spent queued before they started to run.
+  struct LaneStats {
+    uint64_t task_count = 0;
+    uint64_t total_wait_in_ms = 0;
+    uint64_t max_wait_in_ms = 0;
+  };
+
   TaskRunner();
+  explicit TaskRunner(const Options& options);
   virtual ~TaskRunner();
 
   void Run() override;
   void Terminate();
   void PostTask(std::shared_ptr<Task> task);
+  void PostTask(std::shared_ptr<Task> task, Task::Priority priority);
   void PostDelayedTask(std::shared_ptr<Task> task,
                        DelayedTimeInMs delay_in_milliseconds);
   void CancelTask(const std::shared_ptr<Task>& task);
+  // Creates a task recycled through the freelist of this runner instead of the heap.
+  template <typename T>
+  std::shared_ptr<T> NewTask() {
+    return std::allocate_shared<T>(TaskPoolAllocator<T>(task_pool_));
+  }
+  LaneStats GetLaneStats(Task::Priority priority);
+  void ResetLaneStats();
 
  protected:
   void PostTaskNoLock(std::shared_ptr<Task> task);
+  std::shared_ptr<Task> PopTaskNoLock(DelayedTimeInMs now);
+  size_t PendingTaskCountNoLock() const;
   std::shared_ptr<Task> popTaskFromDelayedQueueNoLock(DelayedTimeInMs now);
   std::shared_ptr<Task> GetNext();
+  // Gives up and sets `is_timeout` when no task becomes runnable within `timeout_in_ms`.
+  std::shared_ptr<Task> GetNext(DelayedTimeInMs timeout_in_ms, bool& is_timeout);
 
  protected:
   bool is_terminated_;
-  std::queue<std::shared_ptr<Task>> task_queue_;
+
+  // one FIFO per Task::Priority, entries carry the time they were queued
+  using TaskEntry = std::pair<DelayedTimeInMs, std::shared_ptr<Task>>;
+  std::array<std::queue<TaskEntry>, Task::kPriorityCount> task_queue_;
+  // how many times each lane was passed over while it had pending tasks
+  std::array<uint32_t, Task::kPriorityCount> skipped_count_{};
+  std::array<LaneStats, Task::kPriorityCount> lane_stats_;
 
   using DelayedEntry = std::pair<DelayedTimeInMs, std::shared_ptr<Task>>;
   struct DelayedEntryCompare {
@@ -73,6 +101,7 @@ class TaskRunner : public Thread {
 
   std::mutex mutex_;
   std::condition_variable cv_;
+  std::shared_ptr<TaskPool> task_pool_;
 };
 
 }  // namespace base
@@ -23,6 +23,11 @@
 #pragma once
 
 #include <pthread.h>
+#include <stdint.h>
+
+#include <functional>
+#include <optional>
+#include <utility>
 
 #include "core/base/thread_id.h"
 
@@ -40,9 +45,34 @@ class Thread {
     const char* name() const { return name_; }
     size_t stack_size() const { return stack_size_; }
 
+    // Nice value of the thread, -20 (highest) to 19. On Apple platforms it is mapped to the
+    // closest QoS class. The thread inherits the priority of its creator when it is not set.
+    Options& set_priority(int priority) {
+      priority_ = priority;
+      return *this;
+    }
+    const std::optional<int>& priority() const { return priority_; }
+
+    // Bit n allows CPU n, 0 keeps the inherited affinity. Ignored on Apple platforms.
+    Options& set_affinity_mask(uint64_t affinity_mask) {
+      affinity_mask_ = affinity_mask;
+      return *this;
+    }
+    uint64_t affinity_mask() const { return affinity_mask_; }
+
+    // Runs on the new thread before Run(), e.g. to attach it to a VM or a profiler.
+    Options& set_init_callback(std::function<void()> init_callback) {
+      init_callback_ = std::move(init_callback);
+      return *this;
+    }
+    const std::function<void()>& init_callback() const { return init_callback_; }
+
    private:
     const char* name_;
     size_t stack_size_;
+    std::optional<int> priority_;
+    uint64_t affinity_mask_ = 0;
+    std::function<void()> init_callback_;
   };
 
  public:
@@ -58,12 +88,17 @@ class Thread {
   void Join() const;
 
   inline const char* name() const { return name_; }
+  // Applies the priority, affinity and init callback of the options, on the new thread.
+  void ApplyOptions();
 
   static const int kMaxThreadNameLength = 16;
 
  protected:
   char name_[kMaxThreadNameLength]{};
   size_t stack_size_;
+  std::optional<int> priority_;
+  uint64_t affinity_mask_;
+  std::function<void()> init_callback_;
   pthread_t thread_{};
 
   ThreadId thread_id_;
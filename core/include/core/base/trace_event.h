@@ -0,0 +1,183 @@
+/*
+ *
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2022 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#pragma once
+
+#include <stdint.h>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Names and categories must be string literals, only their pointers are recorded.
+#define HIPPY_TRACE_CONCAT_INNER(a, b) a##b
+#define HIPPY_TRACE_CONCAT(a, b) HIPPY_TRACE_CONCAT_INNER(a, b)
+
+// a span from here to the end of the enclosing block
+#define HIPPY_TRACE_EVENT(category, name) \
+  hippy::base::ScopedTraceEvent HIPPY_TRACE_CONCAT(hippy_trace_event_, __LINE__)(category, name)
+// the same span for a hot path, only its first `limit` runs of each session are recorded
+#define HIPPY_TRACE_EVENT_FIRST_N(category, name, limit)                                           \
+  static hippy::base::TraceEventLimit HIPPY_TRACE_CONCAT(hippy_trace_limit_, __LINE__)(limit);    \
+  hippy::base::ScopedTraceEvent HIPPY_TRACE_CONCAT(hippy_trace_event_, __LINE__)(                 \
+      category, name, HIPPY_TRACE_CONCAT(hippy_trace_limit_, __LINE__))
+#define HIPPY_TRACE_EVENT_INSTANT(category, name) \
+  HIPPY_TRACE_ADD(kInstant, category, name, 0, 0)
+#define HIPPY_TRACE_COUNTER(category, name, value) \
+  HIPPY_TRACE_ADD(kCounter, category, name, 0, value)
+// connects the enclosing spans of the begin and the end, which may be on different threads
+#define HIPPY_TRACE_FLOW_BEGIN(category, name, id) \
+  HIPPY_TRACE_ADD(kFlowBegin, category, name, id, 0)
+#define HIPPY_TRACE_FLOW_END(category, name, id) \
+  HIPPY_TRACE_ADD(kFlowEnd, category, name, id, 0)
+
+#define HIPPY_TRACE_ADD(phase, category, name, id, value)                                     \
+  do {                                                                                          \
+    auto& hippy_trace_log = hippy::base::TraceLog::GetInstance();                               \
+    if (hippy_trace_log.IsEnabled()) {                                                          \
+      hippy_trace_log.AddEvent(hippy::base::TraceLog::Phase::phase, category, name,             \
+                               hippy::base::TraceLog::NowInUs(), 0, id, value);                 \
+    }                                                                                           \
+  } while (0)
+
+namespace hippy {
+namespace base {
+
+// Records trace events into fixed-size ring buffers, one per thread, and exports them as Chrome
+// trace JSON, which chrome://tracing and Perfetto load. While tracing is off an event costs one
+// relaxed atomic load. A busy thread only overwrites its own events, and recording takes no lock
+// shared with other threads.
+class TraceLog {
+ public:
+  static constexpr size_t kDefaultCapacity = 8192;
+
+  struct Options {
+    // events kept per thread, the oldest are overwritten when it is full
+    size_t capacity = kDefaultCapacity;
+    // share of the sessions that record, from 0 to 1
+    double sampling_rate = 1.0;
+  };
+
+  enum class Phase : char {
+    kComplete = 'X',
+    kInstant = 'i',
+    kCounter = 'C',
+    kFlowBegin = 's',
+    kFlowEnd = 'f'
+  };
+
+  struct Event {
+    Phase phase;
+    const char* category;
+    const char* name;
+    uint64_t timestamp_in_us;
+    uint64_t duration_in_us;
+    uint64_t id;
+    int64_t value;
+    uint32_t thread_id;
+  };
+
+  static TraceLog& GetInstance();
+  // monotonic clock shared by all the events
+  static uint64_t NowInUs();
+
+  // Starts a session and drops the events of the previous one.
+  // Returns false when the session was not sampled in, nothing is recorded then.
+  bool Start(Options options);
+  bool Start();
+  void Stop();
+  inline bool IsEnabled() const { return is_enabled_.load(std::memory_order_relaxed); }
+  // changes with every Start
+  inline uint32_t GetSessionId() const { return session_id_.load(std::memory_order_relaxed); }
+
+  void AddEvent(Phase phase, const char* category, const char* name, uint64_t timestamp_in_us,
+                uint64_t duration_in_us, uint64_t id, int64_t value);
+  // unique in the process, for the flow events
+  uint64_t NewFlowId();
+
+  // of all the threads, ordered by timestamp
+  std::vector<Event> GetEvents();
+  // {"traceEvents":[...],"displayTimeUnit":"ms"}
+  std::string ExportJson();
+  bool Dump(const std::string& file_path);
+
+ private:
+  struct ThreadBuffer;
+
+  TraceLog();
+
+  ThreadBuffer& GetCurrentThreadBuffer();
+
+  std::atomic<bool> is_enabled_;
+  std::atomic<uint32_t> session_id_;
+  std::atomic<uint64_t> next_flow_id_;
+  std::atomic<uint32_t> next_thread_id_;
+  // guards the buffer list and the capacity, each buffer has a lock of its own
+  std::mutex mutex_;
+  size_t capacity_;
+  std::vector<std::shared_ptr<ThreadBuffer>> buffers_;
+};
+
+// The state of a HIPPY_TRACE_EVENT_FIRST_N call site.
+class TraceEventLimit {
+ public:
+  explicit TraceEventLimit(uint32_t limit) : limit_(limit), state_(0) {}
+
+  // Whether the call site may record once more in the current session.
+  bool Acquire();
+
+ private:
+  const uint32_t limit_;
+  // session id in the high half, events recorded in it in the low half
+  std::atomic<uint64_t> state_;
+};
+
+class ScopedTraceEvent {
+ public:
+  ScopedTraceEvent(const char* category, const char* name)
+      : category_(category),
+        name_(name),
+        begin_time_in_us_(TraceLog::GetInstance().IsEnabled() ? TraceLog::NowInUs() : 0) {}
+  ScopedTraceEvent(const char* category, const char* name, TraceEventLimit& limit)
+      : category_(category),
+        name_(name),
+        begin_time_in_us_(TraceLog::GetInstance().IsEnabled() && limit.Acquire() ? TraceLog::NowInUs()
+                                                                                  : 0) {}
+  ~ScopedTraceEvent() {
+    auto& trace_log = TraceLog::GetInstance();
+    if (begin_time_in_us_ && trace_log.IsEnabled()) {
+      trace_log.AddEvent(TraceLog::Phase::kComplete, category_, name_, begin_time_in_us_,
+                         TraceLog::NowInUs() - begin_time_in_us_, 0, 0);
+    }
+  }
+  ScopedTraceEvent(const ScopedTraceEvent&) = delete;
+  ScopedTraceEvent& operator=(const ScopedTraceEvent&) = delete;
+
+ private:
+  const char* category_;
+  const char* name_;
+  uint64_t begin_time_in_us_;
+};
+
+}  // namespace base
+}  // namespace hippy
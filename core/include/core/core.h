@@ -33,9 +33,12 @@
 #include "core/base/uri_loader.h"
 #include "core/base/string_view_utils.h"
 #include "core/engine.h"
+#include "core/engine_pool.h"
 #include "core/modules/console_module.h"
 #include "core/modules/contextify_module.h"
 #include "core/modules/module_base.h"
+#include "core/modules/module_cache.h"
+#include "core/modules/module_prefetcher.h"
 #include "core/modules/timer_module.h"
 #include "core/napi/callback_info.h"
 #include "core/napi/js_ctx.h"
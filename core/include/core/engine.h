@@ -22,8 +22,11 @@
 
 #pragma once
 
+#include <functional>
 #include <memory>
 #include <mutex>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "base/logging.h"
@@ -44,14 +47,36 @@ class Engine: public std::enable_shared_from_this<Engine> {
   using VM = hippy::vm::VM;
   using VMInitParam = hippy::vm::VMInitParam;
   using RegisterFunction = hippy::base::RegisterFunction;
+  using MemoryPressureLevel = hippy::vm::MemoryPressureLevel;
+  // Releases what the subsystem can rebuild, on the JS thread. Returns the bytes it freed when
+  // they are known, 0 otherwise.
+  using PurgeHandler = std::function<size_t(MemoryPressureLevel)>;
+  // bytes freed by subsystem name, the VM heap is reported as kVMPurgeHandlerName
+  using PurgeResult = std::unordered_map<std::string, size_t>;
+
+  static constexpr char kVMPurgeHandlerName[] = "vm";
+  static constexpr uint32_t kDefaultCpuSamplingIntervalInUs = 1000;
+
+  // Placement of the threads the engine starts in AsyncInit.
+  struct ThreadOptions {
+    hippy::base::Thread::Options js_thread =
+        hippy::base::Thread::Options(JavaScriptTaskRunner::kDefaultThreadName);
+    hippy::base::Thread::Options worker_thread =
+        hippy::base::Thread::Options(WorkerTaskRunner::kDefaultThreadName);
+  };
 
   Engine();
+  explicit Engine(ThreadOptions thread_options);
   virtual ~Engine();
 
   void AsyncInit(const std::shared_ptr<VMInitParam>& param = nullptr,
                  std::unique_ptr<RegisterMap> map = std::make_unique<RegisterMap>());
   int32_t SyncInit(const std::shared_ptr<VM>& vm);
   void TerminateRunner();
+  // Joins the runners and drops this reference to the engine on a shared teardown thread, so the
+  // VM is usually disposed there too. At most kTeardownConcurrency engines are torn down at once.
+  // `cb` runs on the teardown thread when the runners have exited.
+  void AsyncTerminateRunner(std::function<void()> cb = nullptr);
 
   std::shared_ptr<Scope> AsyncCreateScope(
       const std::string& name = "",
@@ -60,11 +85,37 @@ class Engine: public std::enable_shared_from_this<Engine> {
 
   std::shared_ptr<Scope> SyncCreateScope(std::unique_ptr<RegisterMap> map);
 
+  // Creates a scope whose context is created and modules are bound, but which is not
+  // bootstrapped and has no callbacks yet. AsyncActivateScope finishes it for its owner.
+  std::shared_ptr<Scope> AsyncPrepareScope(
+      const std::string& name = "",
+      hippy::base::Task::Priority priority = hippy::base::Task::Priority::kNormal);
+  void AsyncActivateScope(const std::shared_ptr<Scope>& scope,
+                          std::unordered_map<std::string, std::string> init_param = {},
+                          std::unique_ptr<RegisterMap> map = std::unique_ptr<RegisterMap>());
+
   std::shared_ptr<Scope> SyncCreateScope(
       const std::string& name = "",
       std::unordered_map<std::string, std::string> init_param = {},
       std::unique_ptr<RegisterMap> map = std::unique_ptr<RegisterMap>());
 
+  uint32_t AddPurgeHandler(const std::string& name, PurgeHandler handler);
+  void RemovePurgeHandler(uint32_t id);
+  // Runs the purge handlers in the order they were added, then lets the VM collect garbage.
+  // `cb` runs on the JS thread afterwards.
+  void NotifyMemoryPressure(MemoryPressureLevel level,
+                            std::function<void(const PurgeResult&)> cb = nullptr);
+
+  // Starts the VM's sampling CPU profiler on the JS thread. It works without the inspector.
+  // `cb` runs on the JS thread, with false when the VM cannot profile, is profiling already or
+  // the engine is gone.
+  void StartCpuProfiling(uint32_t sampling_interval_in_us = kDefaultCpuSamplingIntervalInUs,
+                         std::function<void(bool)> cb = nullptr);
+  // Stops the profiler and saves the profile to `file_path` as a Chrome .cpuprofile. Serializing
+  // and writing happen on the worker thread, where `cb` runs with the result. It runs with false
+  // on the JS thread when nothing was recorded or the engine is gone.
+  void StopCpuProfiling(const std::string& file_path, std::function<void(bool)> cb = nullptr);
+
   inline std::shared_ptr<VM> GetVM() { return vm_; }
   inline std::shared_ptr<JavaScriptTaskRunner> GetJSRunner() {
     return js_runner_;
@@ -82,16 +133,27 @@ class Engine: public std::enable_shared_from_this<Engine> {
 #endif
 
  private:
+  struct PurgeHandlerEntry {
+    uint32_t id;
+    std::string name;
+    PurgeHandler handler;
+  };
+
   void SetupThreads();
   void CreateVM(const std::shared_ptr<VMInitParam>& param);
 
  private:
   static const uint32_t kDefaultWorkerPoolSize;
+  static const uint32_t kTeardownConcurrency;
 
+  ThreadOptions thread_options_;
   std::shared_ptr<JavaScriptTaskRunner> js_runner_;
   std::shared_ptr<WorkerTaskRunner> worker_task_runner_;
   std::shared_ptr<VM> vm_;
   std::unique_ptr<RegisterMap> map_;
+  std::vector<PurgeHandlerEntry> purge_handlers_;
+  uint32_t next_purge_handler_id_;
+  std::mutex purge_handler_mutex_;
 #if defined(JS_V8) && !defined(V8_WITHOUT_INSPECTOR)
   std::shared_ptr<hippy::inspector::V8InspectorClientImpl> inspector_client_;
 #endif
@@ -0,0 +1,121 @@
+/*
+ *
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2022 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+#include "core/base/common.h"
+#include "core/engine.h"
+#include "core/scope.h"
+#include "core/task/worker_task_runner.h"
+
+// Keeps engines whose threads, VM and context are already created, so that opening a page
+// only has to install its callbacks, bootstrap and run its bundle.
+// Warming runs on the idle lane of each new engine's JS thread. Refilling runs on a worker thread
+// owned by the pool and evicted engines are torn down by Engine::AsyncTerminateRunner, never on
+// the caller's thread.
+// The pool must be owned by a std::shared_ptr.
+class EnginePool : public std::enable_shared_from_this<EnginePool> {
+ public:
+  using VMInitParam = hippy::vm::VMInitParam;
+  using RegisterMap = hippy::base::RegisterMap;
+
+  struct Options {
+    // number of warmed engines to keep
+    size_t capacity = 1;
+    // upper bound of the heap held by idle engines, 0 means no limit
+    size_t memory_budget_in_bytes = 0;
+    // creates the VM parameters of every new engine, may be empty
+    std::function<std::shared_ptr<VMInitParam>()> vm_param_factory;
+    // the VM parameters load a snapshot that already contains the bootstrap
+    bool use_snapshot = false;
+    // placement of the threads of every new engine
+    Engine::ThreadOptions thread_options;
+  };
+
+  struct Stats {
+    uint64_t hit_count = 0;
+    uint64_t miss_count = 0;
+    uint64_t eviction_count = 0;
+    uint64_t warm_count = 0;
+    // time from engine creation to a prepared context
+    uint64_t total_warm_time_in_ms = 0;
+    // heap held by the idle engines that finished warming
+    size_t idle_heap_size_in_bytes = 0;
+  };
+
+  struct Instance {
+    std::shared_ptr<Engine> engine;
+    std::shared_ptr<Scope> scope;
+  };
+
+  explicit EnginePool(Options options);
+  ~EnginePool();
+  EnginePool(const EnginePool&) = delete;
+  EnginePool& operator=(const EnginePool&) = delete;
+
+  // Starts warming engines up to the capacity.
+  void Start();
+  // Hands out the oldest engine that finished warming. Its scope is activated with `map` (the same callbacks as
+  // Engine::AsyncCreateScope, plus the kVMCreateCBKey one of Engine::AsyncInit) on its JS thread.
+  // `on_acquired` runs on the caller's thread before the activation is posted, to bind the
+  // instance to its owner. Returns an empty instance when the pool is empty, the caller then
+  // creates an engine the usual way.
+  Instance Acquire(std::unique_ptr<RegisterMap> map = std::unique_ptr<RegisterMap>(),
+                   const std::function<void(const Instance&)>& on_acquired = nullptr);
+  // Evicts idle engines until at most `count` are kept. Returns the heap they held.
+  size_t Trim(size_t count);
+  // Evicts every idle engine and stops refilling.
+  void Clear();
+  Stats GetStats();
+
+ private:
+  struct Entry {
+    Instance instance;
+    uint64_t create_time;
+    bool warmed = false;
+    size_t heap_size = 0;
+  };
+
+  void PostRefill();
+  void Refill();
+  void OnWarmed(const std::shared_ptr<Engine>& engine, size_t heap_size, uint64_t ready_time);
+  void EnforceBudgetNoLock(std::deque<Entry>& evicted);
+  static void Release(Entry& entry);
+
+  Options options_;
+  std::unique_ptr<WorkerTaskRunner> runner_;
+  std::thread::id runner_thread_id_;
+  bool is_stopped_;
+  std::deque<Entry> entries_;
+  Stats stats_;
+  std::mutex mutex_;
+};
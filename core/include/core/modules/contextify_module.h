@@ -22,8 +22,13 @@
 
 #pragma once
 
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
 #include "core/base/string_view_utils.h"
 #include "core/modules/module_base.h"
+#include "core/modules/module_prefetcher.h"
 #include "core/napi/callback_info.h"
 #include "core/napi/js_ctx_value.h"
 
@@ -34,12 +39,27 @@ class ContextifyModule : public ModuleBase {
   using unicode_string_view = tdf::base::unicode_string_view;
   using CtxValue = hippy::napi::CtxValue;
 
-  ContextifyModule() {}
+  ContextifyModule() : prefetcher_(std::make_shared<ModulePrefetcher>()) {}
   void RunInThisContext(const hippy::napi::CallbackInfo& info, void* data);
   void LoadUntrustedContent(const hippy::napi::CallbackInfo& info, void* data);
+  // Takes the chunk graph of the bundle as [[chunk, [dependency, ...]], ...], e.g.
+  // Object.entries(manifest).
+  void SetChunkManifest(const hippy::napi::CallbackInfo& info, void* data);
   void RemoveCBFunc(const unicode_string_view& uri);
+  inline std::shared_ptr<ModulePrefetcher> GetPrefetcher() { return prefetcher_; }
+  // Chunks are compiled with a code cache only once enabled, e.g. by a bundle run with one.
+  // Must be called on the JS thread.
+  inline void SetCodeCacheEnabled(bool is_enabled) {
+    is_code_cache_enabled_ = is_enabled;
+    prefetcher_->SetPrecompileEnabled(is_enabled);
+  }
 
   virtual std::shared_ptr<CtxValue> BindFunction(std::shared_ptr<Scope> scope, std::shared_ptr<CtxValue> rest_args[]) override;
  private:
-  std::unordered_map<unicode_string_view, std::shared_ptr<CtxValue>> cb_func_map_;
+  // callbacks of the requests in flight, by uri
+  std::unordered_map<unicode_string_view, std::vector<std::shared_ptr<CtxValue>>> cb_func_map_;
+  std::shared_ptr<ModulePrefetcher> prefetcher_;
+  // key of __HIPPYCURDIR__, resolved on the first load
+  std::shared_ptr<CtxValue> cur_dir_key_;
+  bool is_code_cache_enabled_ = false;
 };
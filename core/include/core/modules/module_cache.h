@@ -0,0 +1,116 @@
+/*
+ *
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2022 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "base/unicode_string_view.h"
+#include "core/base/uri_loader.h"
+
+// Process-wide cache of the sources loaded by LoadUntrustedContent, shared by every scope.
+// Every load still goes to the loader, entries are kept by URI and content hash so that a changed
+// source never meets the code cache of its previous content. A hit shares the buffer of the cached
+// source and hands out its code cache, revisions that are no longer loaded age out.
+// Concurrent loads of the same URI share one loader request. Entries are evicted in LRU order
+// once the cached bytes exceed the capacity; a capacity of 0 disables caching but still coalesces
+// concurrent loads.
+class ModuleCache {
+ public:
+  using unicode_string_view = tdf::base::unicode_string_view;
+  using u8string = unicode_string_view::u8string;
+  using UriLoader = hippy::base::UriLoader;
+
+  static constexpr size_t kDefaultCapacityInBytes = 16 * 1024 * 1024;
+
+  struct Module {
+    // empty when the content could not be loaded
+    std::shared_ptr<const u8string> source;
+    uint64_t hash = 0;
+    std::shared_ptr<const u8string> code_cache;
+  };
+
+  struct Stats {
+    // loads whose content matched a cached entry
+    uint64_t hit_count = 0;
+    uint64_t miss_count = 0;
+    // loads that joined a request already in flight
+    uint64_t coalesced_count = 0;
+    uint64_t eviction_count = 0;
+    uint64_t code_cache_hit_count = 0;
+    size_t entry_count = 0;
+    size_t size_in_bytes = 0;
+  };
+
+  using LoadCallback = std::function<void(Module)>;
+
+  static ModuleCache& GetInstance();
+
+  ModuleCache(const ModuleCache&) = delete;
+  ModuleCache& operator=(const ModuleCache&) = delete;
+
+  // `cb` runs on the loader's thread, or synchronously when the loader calls back synchronously.
+  void Load(const unicode_string_view& uri, const std::shared_ptr<UriLoader>& loader, LoadCallback cb);
+  // Ignored when no source of `uri` with `hash` is cached, or it already has a code cache.
+  void PutCodeCache(const unicode_string_view& uri, uint64_t hash, u8string code_cache);
+  void SetCapacity(size_t capacity_in_bytes);
+  size_t GetCapacity();
+  // Evicts the least recently used entries until at most `size_in_bytes` are cached, without
+  // changing the capacity. Returns the bytes freed.
+  size_t Trim(size_t size_in_bytes);
+  void Clear();
+  Stats GetStats();
+
+  static uint64_t ComputeHash(const u8string& content);
+
+ private:
+  struct Entry {
+    Module module;
+    std::list<std::string>::iterator lru_it;
+  };
+
+  ModuleCache();
+
+  void OnLoaded(const std::string& uri, u8string content);
+  void EnforceCapacityNoLock();
+  void EvictNoLock(size_t size_in_bytes);
+  static size_t GetSize(const Module& module);
+  static std::string MakeKey(const std::string& uri, uint64_t hash);
+
+  // by uri and content hash
+  std::unordered_map<std::string, Entry> entries_;
+  // most recently used first
+  std::list<std::string> lru_;
+  // by uri
+  std::unordered_map<std::string, std::vector<LoadCallback>> pending_;
+  size_t capacity_in_bytes_;
+  Stats stats_;
+  std::mutex mutex_;
+};
@@ -0,0 +1,107 @@
+/*
+ *
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2022 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "core/modules/module_cache.h"
+#include "core/task/javascript_task_runner.h"
+#include "core/task/worker_task_runner.h"
+
+class Scope;
+
+// Prefetches the chunks a requested chunk depends on, as described by the bundle manifest, so
+// that a chain of dynamic imports does not wait for one load per level.
+// The manifest maps the URI of a chunk to the URIs of its dependencies, as resolved by
+// global.setChunkManifest. Prefetched sources go to the ModuleCache; on V8, once precompiling is
+// enabled, their code cache is created on the idle lane of the JS thread unless the chunk was
+// requested in the meantime.
+class ModulePrefetcher : public std::enable_shared_from_this<ModulePrefetcher> {
+ public:
+  using Manifest = std::unordered_map<std::string, std::vector<std::string>>;
+
+  static constexpr size_t kDefaultMaxConcurrentPrefetches = 4;
+  // uris remembered as prefetched or requested, the oldest are forgotten first
+  static constexpr size_t kMaxTrackedUriCount = 256;
+
+  struct Stats {
+    uint64_t prefetch_count = 0;
+    // prefetched chunks requested afterwards
+    uint64_t hit_count = 0;
+    uint64_t precompile_count = 0;
+    // prefetched chunks not requested yet
+    uint64_t waste_count = 0;
+  };
+
+  explicit ModulePrefetcher(size_t max_concurrent_prefetches = kDefaultMaxConcurrentPrefetches);
+
+  void SetManifest(Manifest manifest);
+  void SetPrecompileEnabled(bool is_enabled);
+  // Called on the JS thread for every chunk requested by JS.
+  void OnRequested(const std::string& uri, const std::shared_ptr<Scope>& scope);
+  Stats GetStats();
+
+ private:
+  using UriLoader = hippy::base::UriLoader;
+
+  class UriSet {
+   public:
+    explicit UriSet(size_t capacity) : capacity_(capacity) {}
+    // false when `uri` is already in the set
+    bool Insert(const std::string& uri);
+    bool Contains(const std::string& uri) const { return set_.find(uri) != set_.end(); }
+
+   private:
+    size_t capacity_;
+    std::unordered_set<std::string> set_;
+    std::deque<std::string> order_;
+  };
+
+  void Pump();
+  void OnPrefetched(const std::string& uri, ModuleCache::Module module);
+  void Precompile(const std::string& uri, const ModuleCache::Module& module, const std::shared_ptr<Scope>& scope);
+
+  size_t max_concurrent_prefetches_;
+  size_t prefetching_count_;
+  Manifest manifest_;
+  std::deque<std::string> queue_;
+  bool is_precompile_enabled_;
+  // the uris queued for prefetch, and the ones JS requested
+  UriSet prefetched_;
+  UriSet requested_;
+  // taken from the scope on the JS thread, prefetches complete on other threads
+  std::weak_ptr<Scope> weak_scope_;
+  std::shared_ptr<UriLoader> loader_;
+  std::weak_ptr<JavaScriptTaskRunner> js_runner_;
+  std::weak_ptr<WorkerTaskRunner> worker_runner_;
+  Stats stats_;
+  std::mutex mutex_;
+};
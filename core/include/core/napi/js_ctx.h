@@ -62,6 +62,11 @@ class CBTuple {
   void* data_;
 };
 
+// Handle of a property key owned by a context. The same handle is returned for the same name
+// for the whole lifetime of the context, so it can be kept and reused instead of creating a
+// string for every property access.
+using PropertyKey = std::shared_ptr<CtxValue>;
+
 class FuncWrapper {
  public:
   FuncWrapper(JsCallback cb, void* data): cb(cb), data(data) {}
@@ -150,6 +155,7 @@ class Ctx {
   virtual std::shared_ptr<CtxValue> CreateBoolean(bool b) = 0;
   virtual std::shared_ptr<CtxValue> CreateString(
       const unicode_string_view& string) = 0;
+  virtual PropertyKey GetPropertyKey(const unicode_string_view& name) = 0;
   virtual std::shared_ptr<CtxValue> CreateUndefined() = 0;
   virtual std::shared_ptr<CtxValue> CreateNull() = 0;
   virtual std::shared_ptr<CtxValue> CreateFunction(std::unique_ptr<hippy::napi::FuncWrapper>& wrapper) = 0;
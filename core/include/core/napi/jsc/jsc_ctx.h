@@ -68,6 +68,7 @@ class JSCCtx : public Ctx {
 
   ~JSCCtx() {
     exception_ = nullptr;
+    property_key_map_.clear();
 
     JSGlobalContextRelease(context_);
     context_ = nullptr;
@@ -125,6 +126,7 @@ class JSCCtx : public Ctx {
   virtual std::shared_ptr<CtxValue> CreateBoolean(bool b) override;
   virtual std::shared_ptr<CtxValue> CreateString(
       const unicode_string_view& string) override;
+  virtual PropertyKey GetPropertyKey(const unicode_string_view& name) override;
   virtual std::shared_ptr<CtxValue> CreateUndefined() override;
   virtual std::shared_ptr<CtxValue> CreateNull() override;
   virtual std::shared_ptr<CtxValue> CreateObject(const std::unordered_map<
@@ -209,6 +211,7 @@ class JSCCtx : public Ctx {
   bool is_exception_handled_;
   void* external_data_;
   std::vector<std::unique_ptr<FuncData>> func_data_holder_;
+  std::unordered_map<unicode_string_view, PropertyKey> property_key_map_;
 };
 
 inline tdf::base::unicode_string_view ToStrView(JSStringRef str) {
@@ -22,6 +22,8 @@
 
 #pragma once
 
+#include <deque>
+
 #include "base/logging.h"
 #include "base/unicode_string_view.h"
 #include "core/napi/js_ctx.h"
@@ -40,6 +42,20 @@ class V8Ctx : public Ctx {
   using unicode_string_view = tdf::base::unicode_string_view;
   using JSValueWrapper = hippy::base::JSValueWrapper;
 
+  // How a script run with is_use_code_cache was compiled.
+  struct CodeCacheInfo {
+    uint64_t compile_time_in_us = 0;
+    // compiled from a code cache that V8 accepted
+    bool is_cache_consumed = false;
+    // size of the code cache created right after compiling, or of the consumed one
+    size_t cache_size = 0;
+    // size of the code cache created by CreateWarmCodeCache
+    size_t warm_cache_size = 0;
+  };
+
+  // scripts run with is_use_code_cache whose CodeCacheInfo is kept, the oldest are dropped first
+  static constexpr size_t kMaxCodeCacheEntryCount = 32;
+
   explicit V8Ctx(v8::Isolate* isolate) : isolate_(isolate) {
     v8::HandleScope handle_scope(isolate);
     v8::Local<v8::ObjectTemplate> global = v8::ObjectTemplate::New(isolate);
@@ -50,6 +66,15 @@ class V8Ctx : public Ctx {
     context_persistent_.Reset(isolate, context);
   }
 
+  // Deserializes the context added to the startup snapshot at `snapshot_index`.
+  V8Ctx(v8::Isolate* isolate, size_t snapshot_index) : isolate_(isolate) {
+    v8::HandleScope handle_scope(isolate);
+    v8::Local<v8::Context> context = v8::Context::FromSnapshot(isolate, snapshot_index).ToLocalChecked();
+    v8::Context::Scope contextScope(context);
+
+    context_persistent_.Reset(isolate, context);
+  }
+
   ~V8Ctx() {
     context_persistent_.Reset();
     global_persistent_.Reset();
@@ -99,6 +124,7 @@ class V8Ctx : public Ctx {
   virtual std::shared_ptr<CtxValue> CreateBoolean(bool b) override;
   virtual std::shared_ptr<CtxValue> CreateString(
       const unicode_string_view& string) override;
+  virtual PropertyKey GetPropertyKey(const unicode_string_view& name) override;
   virtual std::shared_ptr<CtxValue> CreateUndefined() override;
   virtual std::shared_ptr<CtxValue> CreateNull() override;
   virtual std::shared_ptr<CtxValue> CreateObject(const std::unordered_map<
@@ -169,8 +195,22 @@ class V8Ctx : public Ctx {
       bool is_use_code_cache,
       unicode_string_view* cache,
       bool is_copy);
+  // Creates the code cache of a script run with is_use_code_cache again, once it has run for a
+  // while, so that the functions compiled lazily since then are included. Only scripts that were
+  // not compiled from an accepted code cache qualify, each one once.
+  bool CreateWarmCodeCache(const unicode_string_view& file_name, unicode_string_view* cache);
+  bool GetCodeCacheInfo(const unicode_string_view& file_name, CodeCacheInfo& info);
+  // Drops the scripts kept for CreateWarmCodeCache and, if there were any, collects them
+  // synchronously. Returns the heap bytes freed.
+  size_t PurgeCodeCache();
+  // Compiles a script without running it and creates its code cache.
+  bool CreateCodeCache(const unicode_string_view& data,
+                       const unicode_string_view& file_name,
+                       unicode_string_view* cache);
 
   virtual void SetDefaultContext(const std::shared_ptr<v8::SnapshotCreator>& creator);
+  // Returns the index to pass to the snapshot constructor.
+  virtual size_t AddContext(const std::shared_ptr<v8::SnapshotCreator>& creator);
 
   virtual void ThrowException(const std::shared_ptr<CtxValue>& exception) override;
   virtual void ThrowException(const unicode_string_view& exception) override;
@@ -190,22 +230,41 @@ class V8Ctx : public Ctx {
   unicode_string_view GetStackInfo(v8::Local<v8::Message> message) const;
   unicode_string_view GetStackTrace(v8::Local<v8::StackTrace> trace) const;
   std::shared_ptr<CtxValue> CreateError(v8::Local<v8::Message> message) const;
-  v8::Local<v8::String> CreateV8String(const unicode_string_view& string) const;
+  v8::Local<v8::String> CreateV8String(const unicode_string_view& string,
+                                       v8::NewStringType type = v8::NewStringType::kNormal) const;
   void SetAlignedPointerInEmbedderData(int index, intptr_t address);
 
   v8::Isolate* isolate_;
   v8::Persistent<v8::ObjectTemplate> global_persistent_;
   v8::Persistent<v8::Context> context_persistent_;
   std::unordered_map<void*, void*> func_external_data_map_;
+  // internalized strings used as property keys, see GetPropertyKey
+  std::unordered_map<unicode_string_view, PropertyKey> property_key_map_;
 
  private:
+  struct CodeCacheEntry {
+    // released once the warm code cache has been created
+    v8::Global<v8::UnboundScript> script;
+    CodeCacheInfo info;
+  };
+
   v8::Local<v8::FunctionTemplate> CreateTemplate(const std::unique_ptr<FuncWrapper>& wrapper) const;
+  bool ToJsValueWrapper(const v8::Local<v8::Context>& context,
+                        const v8::Local<v8::Value>& handle_value,
+                        JSValueWrapper& result);
+  v8::Local<v8::Value> CreateV8Value(const v8::Local<v8::Context>& context,
+                                     const JSValueWrapper& wrapper);
+  v8::ScriptOrigin CreateScriptOrigin(const unicode_string_view& file_name);
   std::shared_ptr<CtxValue> InternalRunScript(
       v8::Local<v8::Context> context,
       v8::Local<v8::String> source,
       const unicode_string_view& file_name,
       bool is_use_code_cache,
       unicode_string_view* cache);
+
+  std::unordered_map<unicode_string_view, CodeCacheEntry> code_cache_map_;
+  // keys of code_cache_map_, oldest first
+  std::deque<unicode_string_view> code_cache_order_;
 };
 
 }
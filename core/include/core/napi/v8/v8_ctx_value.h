@@ -22,6 +22,9 @@
 
 #pragma once
 
+#include <memory>
+#include <vector>
+
 #include "core/napi/js_ctx_value.h"
 
 #pragma clang diagnostic push
@@ -34,15 +37,74 @@ namespace napi {
 
 struct V8CtxValue : public CtxValue {
   V8CtxValue(v8::Isolate* isolate, const v8::Local<v8::Value>& value)
-      : global_value_(isolate, value) {}
+      : global_value_(isolate, value), isolate_(isolate) {}
   V8CtxValue(v8::Isolate* isolate, const v8::Persistent<v8::Value>& value)
-      : global_value_(isolate, value) {}
+      : global_value_(isolate, value), isolate_(isolate) {}
   ~V8CtxValue() { global_value_.Reset(); }
   V8CtxValue(const V8CtxValue &) = delete;
   V8CtxValue &operator=(const V8CtxValue &) = delete;
 
+  // The handle must be consumed inside a HandleScope of the calling thread.
+  inline v8::Local<v8::Value> Get(v8::Isolate* isolate) const {
+    if (!local_value_.IsEmpty()) {
+      return local_value_;
+    }
+    return v8::Local<v8::Value>::New(isolate, global_value_);
+  }
+
+  inline bool IsLocal() const { return !local_value_.IsEmpty(); }
+
+  // Turn a callback-local value into a persistent one so that it survives the HandleScope
+  // it was created in.
+  inline void Promote() {
+    if (local_value_.IsEmpty()) {
+      return;
+    }
+    global_value_.Reset(isolate_, local_value_);
+    local_value_.Clear();
+  }
+
   v8::Global<v8::Value> global_value_;
+  v8::Local<v8::Value> local_value_;
+  v8::Isolate* isolate_;
+
+ private:
+  friend class V8LocalValueScope;
+
+  struct LocalTag {};
+  V8CtxValue(v8::Isolate* isolate, const v8::Local<v8::Value>& value, LocalTag)
+      : local_value_(value), isolate_(isolate) {}
+};
+
+// Creates V8CtxValue backed only by a v8::Local, for values that normally live no longer than a
+// native callback (receiver, arguments, property names). No global handle is created for them.
+// When the scope is destroyed, values still referenced elsewhere (stored by a module, captured
+// by a timer, etc.) are promoted to persistent handles; the others are simply dropped.
+// Must be declared after the HandleScope it relies on and before the CallbackInfo it fills.
+class V8LocalValueScope {
+ public:
+  explicit V8LocalValueScope(v8::Isolate* isolate, size_t capacity = 0) : isolate_(isolate) {
+    values_.reserve(capacity);
+  }
+  ~V8LocalValueScope() {
+    for (auto& value : values_) {
+      if (value.use_count() > 1) {
+        value->Promote();
+      }
+    }
+  }
+  V8LocalValueScope(const V8LocalValueScope&) = delete;
+  V8LocalValueScope& operator=(const V8LocalValueScope&) = delete;
+
+  std::shared_ptr<V8CtxValue> Create(const v8::Local<v8::Value>& value) {
+    auto ctx_value = std::shared_ptr<V8CtxValue>(new V8CtxValue(isolate_, value, V8CtxValue::LocalTag{}));
+    values_.push_back(ctx_value);
+    return ctx_value;
+  }
+
+ private:
   v8::Isolate* isolate_;
+  std::vector<std::shared_ptr<V8CtxValue>> values_;
 };
 
 }
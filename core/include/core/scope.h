@@ -23,6 +23,7 @@
 #pragma once
 
 #include <any>
+#include <optional>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -33,6 +34,7 @@
 #include "core/base/uri_loader.h"
 #include "core/engine.h"
 #include "core/napi/js_ctx.h"
+#include "core/task/task_future.h"
 #include "core/task/worker_task_runner.h"
 
 class JavaScriptTaskRunner;
@@ -56,6 +58,7 @@ class Scope {
   using UriLoader = hippy::base::UriLoader;
   using Encoding = hippy::napi::Encoding;
   using FuncWrapper = hippy::napi::FuncWrapper;
+  using u8string = unicode_string_view::u8string;
 
   Scope(std::weak_ptr<Engine> engine,
         std::string name,
@@ -63,6 +66,9 @@ class Scope {
   ~Scope();
 
   void WillExit();
+  // Runs HippyDealloc and the will-exit callbacks on the JS thread without waiting for them.
+  // `cb` runs on the JS thread afterwards.
+  void AsyncWillExit(std::function<void()> cb = nullptr);
   inline std::shared_ptr<Ctx> GetContext() { return context_; }
   inline std::unique_ptr<RegisterMap>& GetRegisterMap() { return map_; }
 
@@ -80,15 +86,29 @@ class Scope {
              const unicode_string_view& name,
              bool is_copy = true);
 
+  // Blocks until the script has run on the JS thread, prefer RunJSAsync.
   std::shared_ptr<CtxValue> RunJSSync(const unicode_string_view& data,
                                       const unicode_string_view& name,
                                       bool is_copy = true);
 
+  // Runs the script on the JS thread, the future is set with its result there.
+  TaskFuture<std::shared_ptr<CtxValue>> RunJSAsync(const unicode_string_view& data,
+                                                   const unicode_string_view& name,
+                                                   bool is_copy = true);
+
+  // Loads `uri` with the UriLoader on the worker thread. The future holds nothing when it fails.
+  TaskFuture<std::optional<u8string>> LoadAsync(const unicode_string_view& uri);
+
   inline std::shared_ptr<JavaScriptTaskRunner> GetTaskRunner() {
     TDF_BASE_CHECK(engine_.lock());
     return engine_.lock()->GetJSRunner();
   }
 
+  inline std::shared_ptr<WorkerTaskRunner> GetWorkerTaskRunner() {
+    TDF_BASE_CHECK(engine_.lock());
+    return engine_.lock()->GetWorkerTaskRunner();
+  }
+
   inline void SetUriLoader(std::shared_ptr<UriLoader> loader) {
     loader_ = loader;
   }
@@ -126,7 +146,13 @@ class Scope {
  private:
   friend class Engine;
   void Init(bool use_snapshot);
+  // Init split in two for pre-warmed scopes (see EnginePool): Prepare creates the context and
+  // binds the modules, Activate runs the VM and context callbacks of the real owner and finishes
+  // the init.
+  void Prepare();
+  void Activate(std::unique_ptr<RegisterMap> map, bool use_snapshot);
   void CreateContext();
+  void InvokeContextCreatedCallback();
   void BindModule();
   void Bootstrap();
   void InvokeCallback();
@@ -136,6 +162,8 @@ class Scope {
   std::weak_ptr<Engine> engine_;
   std::shared_ptr<Ctx> context_;
   std::string name_;
+  // named context of the startup snapshot to create instead of a new one
+  std::string snapshot_context_;
   std::unique_ptr<RegisterMap> map_;
   std::unordered_map<std::string, std::shared_ptr<ModuleBase>> module_object_map_;
   std::vector<std::shared_ptr<CtxValue>> js_module_array;
@@ -145,4 +173,5 @@ class Scope {
   std::unordered_map<std::string, std::shared_ptr<CtxValue>> turbo_instance_map_;
   std::unordered_map<std::string, std::any> turbo_host_object_map_;
   std::vector<std::function<void()>> will_exit_cbs_;
+  std::optional<uint32_t> purge_handler_id_;
 };
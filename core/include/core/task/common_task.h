@@ -22,13 +22,18 @@
 
 #pragma once
 
-#include <functional>
+#include <stddef.h>
 
 #include "core/base/task.h"
+#include "core/base/task_closure.h"
 
 class CommonTask : public hippy::base::Task {
  public:
   void Run() override;
   virtual inline bool isPriorityTask() override { return false; }
-  std::function<void()> func_;
+  hippy::base::TaskClosure func_;
+
+  // owned through std::unique_ptr, recycled through the default TaskPool
+  static void* operator new(size_t size);
+  static void operator delete(void* block, size_t size);
 };
@@ -22,15 +22,14 @@
 
 #pragma once
 
-#include <functional>
-
 #include "core/base/task.h"
+#include "core/base/task_closure.h"
 
 class JavaScriptTask : public hippy::base::Task {
  public:
   bool isPriorityTask() override;
   void Run() override;
 
-  using Function = std::function<void()>;
+  using Function = hippy::base::TaskClosure;
   Function callback = nullptr;
 };
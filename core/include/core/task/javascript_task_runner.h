@@ -24,19 +24,61 @@
 
 #include "core/base/task_runner.h"
 #include <atomic>
+#include <functional>
 
 class JavaScriptTaskRunner : public hippy::base::TaskRunner {
  public:
+  // Runs one slice of idle work that should finish by `deadline_in_ms`
+  // (hippy::base::MonotonicallyIncreasingTime). Returns true when nothing is left to do.
+  using IdleHandler = std::function<bool(DelayedTimeInMs deadline_in_ms)>;
+
+  struct IdleStats {
+    // idle periods in which the handler ran
+    uint64_t idle_count = 0;
+    uint64_t slice_count = 0;
+    uint64_t total_idle_time_in_ms = 0;
+    uint64_t max_slice_time_in_ms = 0;
+    // idle periods cut short by an incoming task
+    uint64_t interrupted_count = 0;
+  };
+
+  static const DelayedTimeInMs kDefaultIdleSliceInMs;
+
+  static constexpr char kDefaultThreadName[] = "hippy.js";
+
   JavaScriptTaskRunner();
+  explicit JavaScriptTaskRunner(const Options& options);
   ~JavaScriptTaskRunner() = default;
 
+  void Run() override;
+
  public:
   bool IsJsThread();
 
+  // Once no input or normal task has run for `idle_window_in_ms`, the handler is called in slices
+  // of `slice_in_ms` whenever the queue is empty, until it is done. Timer and idle tasks neither
+  // restart the window nor stop the idle work for longer than they run. After it is done, it
+  // waits for the next input or normal task before becoming eligible again. Must be called on
+  // the JS thread.
+  void SetIdleHandler(IdleHandler handler,
+                      DelayedTimeInMs idle_window_in_ms,
+                      DelayedTimeInMs slice_in_ms = kDefaultIdleSliceInMs);
+  IdleStats GetIdleStats();
+
  public:
   void PauseThreadForInspector();
   void ResumeThreadForInspector();
 
  private:
+  bool HasRunnableTask();
+  void RunIdleHandler();
+
   std::atomic_bool is_inspector_call_pause_{false};
+  IdleHandler idle_handler_;
+  DelayedTimeInMs idle_window_in_ms_ = 0;
+  DelayedTimeInMs idle_slice_in_ms_ = kDefaultIdleSliceInMs;
+  bool is_idle_work_done_ = false;
+  // end of the last input or normal task
+  DelayedTimeInMs last_busy_time_ = 0;
+  IdleStats idle_stats_;
 };
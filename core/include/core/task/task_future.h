@@ -0,0 +1,271 @@
+/*
+ *
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2022 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+#include "base/logging.h"
+#include "core/base/common.h"
+#include "core/base/task_closure.h"
+#include "core/task/common_task.h"
+#include "core/task/javascript_task.h"
+#include "core/task/javascript_task_runner.h"
+#include "core/task/worker_task_runner.h"
+
+// Continuations that run as tasks of a runner instead of parking the thread that waits.
+//
+//   scope->LoadAsync(uri)
+//       .Then(js_runner, [](std::optional<u8string> content) { ...compile and run...; return ok; })
+//       .Then(js_runner, [](bool ok) { ...callback... });
+//
+// Each continuation is posted to its runner once the previous step has a value. A TaskPromise that
+// is destroyed without a value, e.g. with the queued tasks of a terminated runner, breaks the
+// chain: the following steps never run and Get returns std::nullopt. A TaskFuture has a single
+// consumer: Then or Get may be called once. TaskFuture<void> carries std::monostate.
+
+template <typename T>
+class TaskFuture;
+
+namespace internal {
+
+template <typename T>
+using TaskValue = std::conditional_t<std::is_void_v<T>, std::monostate, T>;
+
+template <typename Value>
+class TaskFutureState {
+ public:
+  using Continuation = std::function<void(Value)>;
+
+  void SetValue(Value value) {
+    Continuation continuation;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      TDF_BASE_DCHECK(!value_ && !is_broken_);
+      if (!continuation_) {
+        value_ = std::move(value);
+        return;
+      }
+      continuation = std::move(continuation_);
+    }
+    continuation(std::move(value));
+  }
+
+  // Destroying the continuation unresolved breaks the rest of the chain in turn.
+  void Break() {
+    Continuation continuation;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      is_broken_ = true;
+      continuation = std::move(continuation_);
+    }
+  }
+
+  void SetContinuation(Continuation continuation) {
+    std::optional<Value> value;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      TDF_BASE_DCHECK(!continuation_) << "TaskFuture has a single consumer";
+      if (!value_ && !is_broken_) {
+        continuation_ = std::move(continuation);
+        return;
+      }
+      value = std::move(value_);
+    }
+    // a broken chain destroys the continuation unresolved
+    if (value) {
+      continuation(std::move(*value));
+    }
+  }
+
+ private:
+  std::mutex mutex_;
+  std::optional<Value> value_;
+  bool is_broken_ = false;
+  Continuation continuation_;
+};
+
+template <typename Value>
+class TaskFutureWaiter {
+ public:
+  void Resolve(std::optional<Value> value) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (is_resolved_) {
+        return;
+      }
+      value_ = std::move(value);
+      is_resolved_ = true;
+    }
+    cv_.notify_all();
+  }
+
+  std::optional<Value> Wait() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_.wait(lock, [this] { return is_resolved_; });
+    return std::move(value_);
+  }
+
+ private:
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::optional<Value> value_;
+  bool is_resolved_ = false;
+};
+
+// Resolves the waiter with the value, or with nothing when it is destroyed first.
+template <typename Value>
+class TaskFutureResolver {
+ public:
+  explicit TaskFutureResolver(std::shared_ptr<TaskFutureWaiter<Value>> waiter) : waiter_(std::move(waiter)) {}
+  TaskFutureResolver(TaskFutureResolver&&) = default;
+  TaskFutureResolver& operator=(TaskFutureResolver&&) = default;
+  ~TaskFutureResolver() {
+    if (waiter_) {
+      waiter_->Resolve(std::nullopt);
+    }
+  }
+
+  void operator()(Value value) {
+    waiter_->Resolve(std::move(value));
+  }
+
+ private:
+  std::shared_ptr<TaskFutureWaiter<Value>> waiter_;
+};
+
+inline void PostContinuation(const std::shared_ptr<JavaScriptTaskRunner>& runner,
+                             hippy::base::TaskClosure closure) {
+  auto task = runner->NewTask<JavaScriptTask>();
+  task->callback = std::move(closure);
+  runner->PostTask(std::move(task));
+}
+
+inline void PostContinuation(const std::shared_ptr<WorkerTaskRunner>& runner,
+                             hippy::base::TaskClosure closure) {
+  auto task = std::make_unique<CommonTask>();
+  task->func_ = std::move(closure);
+  runner->PostTask(std::move(task));
+}
+
+}  // namespace internal
+
+template <typename T>
+class TaskPromise {
+ public:
+  using Value = internal::TaskValue<T>;
+
+  TaskPromise() : state_(std::make_shared<internal::TaskFutureState<Value>>()), is_set_(false) {}
+  TaskPromise(TaskPromise&&) = default;
+  TaskPromise& operator=(TaskPromise&&) = delete;
+  TaskPromise(const TaskPromise&) = delete;
+  TaskPromise& operator=(const TaskPromise&) = delete;
+  ~TaskPromise() {
+    if (state_ && !is_set_) {
+      state_->Break();
+    }
+  }
+
+  TaskFuture<T> GetFuture() { return TaskFuture<T>(state_); }
+
+  void SetValue(Value value) {
+    is_set_ = true;
+    state_->SetValue(std::move(value));
+  }
+
+  template <typename U = T, typename = std::enable_if_t<std::is_void_v<U>>>
+  void SetValue() {
+    SetValue(Value());
+  }
+
+ private:
+  std::shared_ptr<internal::TaskFutureState<Value>> state_;
+  bool is_set_;
+};
+
+template <typename T>
+class TaskFuture {
+ public:
+  using Value = internal::TaskValue<T>;
+
+  // Runs `func` with the value as a task of `runner`. Returns the future of its result.
+  template <typename Runner, typename F>
+  auto Then(const std::shared_ptr<Runner>& runner, F func) {
+    using Result = decltype(Invoke(func, std::declval<Value>()));
+    TaskPromise<Result> promise;
+    auto future = promise.GetFuture();
+    state_->SetContinuation(hippy::base::MakeCopyable(
+        [runner, func = std::move(func), promise = std::move(promise)](Value value) mutable {
+          internal::PostContinuation(runner, [func = std::move(func), promise = std::move(promise),
+                                              value = std::move(value)]() mutable {
+            if constexpr (std::is_void_v<Result>) {
+              Invoke(func, std::move(value));
+              promise.SetValue();
+            } else {
+              promise.SetValue(Invoke(func, std::move(value)));
+            }
+          });
+        }));
+    return future;
+  }
+
+  // Blocks until the value is set, for the synchronous variants of the async APIs. Returns
+  // std::nullopt when the chain is broken.
+  std::optional<Value> Get() {
+    auto waiter = std::make_shared<internal::TaskFutureWaiter<Value>>();
+    state_->SetContinuation(hippy::base::MakeCopyable(internal::TaskFutureResolver<Value>(waiter)));
+    return waiter->Wait();
+  }
+
+ private:
+  template <typename U>
+  friend class TaskPromise;
+
+  explicit TaskFuture(std::shared_ptr<internal::TaskFutureState<Value>> state) : state_(std::move(state)) {}
+
+  template <typename F>
+  static decltype(auto) Invoke(F& func, Value&& value) {
+    if constexpr (std::is_void_v<T>) {
+      return func();
+    } else {
+      return func(std::move(value));
+    }
+  }
+
+  std::shared_ptr<internal::TaskFutureState<Value>> state_;
+};
+
+// Starts a chain with `func` as a task of `runner`.
+template <typename Runner, typename F>
+auto RunAsync(const std::shared_ptr<Runner>& runner, F func) {
+  TaskPromise<void> promise;
+  auto future = promise.GetFuture().Then(runner, std::move(func));
+  promise.SetValue();
+  return future;
+}
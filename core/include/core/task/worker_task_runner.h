@@ -37,7 +37,11 @@
 
 class WorkerTaskRunner {
  public:
-  explicit WorkerTaskRunner(uint32_t pool_size);
+  static constexpr char kDefaultThreadName[] = "Hippy WorkerTaskRunner WorkerThread";
+
+  explicit WorkerTaskRunner(uint32_t pool_size,
+                            const hippy::base::Thread::Options& options =
+                                hippy::base::Thread::Options(kDefaultThreadName));
   ~WorkerTaskRunner() = default;
 
   // std::future cannot be canceled, so it needs to be executed immediately when it cannot be executed in other threads
@@ -51,7 +55,7 @@ class WorkerTaskRunner {
  private:
   class WorkerThread : public hippy::base::Thread {
    public:
-    explicit WorkerThread(WorkerTaskRunner*);
+    WorkerThread(WorkerTaskRunner* runner, const Options& options);
     ~WorkerThread();
     WorkerThread(const WorkerThread &) = delete;
     WorkerThread &operator=(const WorkerThread &) = delete;
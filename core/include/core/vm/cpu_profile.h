@@ -0,0 +1,58 @@
+/*
+ *
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2022 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#pragma once
+
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+namespace hippy {
+namespace vm {
+
+// A sampled CPU profile copied out of the VM, so that it can be serialized away from the JS thread.
+struct CpuProfile {
+  struct Node {
+    uint32_t id = 0;
+    std::string function_name;
+    std::string url;
+    int script_id = 0;
+    // zero-based, -1 when unknown
+    int line_number = -1;
+    int column_number = -1;
+    uint32_t hit_count = 0;
+    std::vector<uint32_t> children;
+  };
+
+  std::vector<Node> nodes;
+  // node id of every sample and its timestamp, in microseconds
+  std::vector<uint32_t> samples;
+  std::vector<int64_t> timestamps;
+  int64_t start_time = 0;
+  int64_t end_time = 0;
+
+  // Chrome DevTools .cpuprofile format
+  std::string ToJson() const;
+};
+
+}  // namespace vm
+}  // namespace hippy
@@ -26,12 +26,15 @@
 
 #include "base/logging.h"
 #include "core/napi/js_ctx.h"
+#include "core/vm/cpu_profile.h"
 
 namespace hippy {
 namespace vm {
 
 struct VMInitParam {};
 
+enum class MemoryPressureLevel { kModerate, kCritical };
+
 class VM {
  public:
   using unicode_string_view = tdf::base::unicode_string_view;
@@ -44,6 +47,19 @@ class VM {
   static std::shared_ptr<CtxValue> ParseJson(const std::shared_ptr<Ctx>& ctx, const unicode_string_view& json);
 
   virtual std::shared_ptr<Ctx> CreateContext() = 0;
+
+  // How long the JS thread has to stay idle before RunIdleTask is called, 0 disables it.
+  virtual uint64_t GetIdleWindow() { return 0; }
+  // Runs garbage collection work until `deadline_in_ms`, on the JS thread.
+  // Returns true when there is nothing left to collect.
+  virtual bool RunIdleTask(uint64_t deadline_in_ms) { return true; }
+  // Lets the VM release memory, on the JS thread. Returns the heap bytes it freed.
+  virtual size_t NotifyMemoryPressure(MemoryPressureLevel level) { return 0; }
+  // Samples the JS stacks every `sampling_interval_in_us`, on the JS thread.
+  // Returns false when the VM cannot profile or is profiling already.
+  virtual bool StartCpuProfiling(uint32_t sampling_interval_in_us) { return false; }
+  // Returns the profile recorded since StartCpuProfiling, nullptr when not profiling. On the JS thread.
+  virtual std::shared_ptr<CpuProfile> StopCpuProfiling() { return nullptr; }
 };
 
 std::shared_ptr<VM> CreateVM(const std::shared_ptr<VMInitParam>& param);
@@ -0,0 +1,112 @@
+/*
+ *
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2022 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include <array>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "core/task/javascript_task_runner.h"
+
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wconversion"
+#include "v8/v8.h"
+#pragma clang diagnostic pop
+
+namespace hippy {
+namespace vm {
+
+// Records heap statistics, GC pauses and external memory of an isolate into a fixed-size ring
+// buffer at a fixed interval, so that jank can be matched with GC afterwards.
+// Start and Stop run on the JS thread, the samples can be read from any thread.
+class HeapSampler : public std::enable_shared_from_this<HeapSampler> {
+ public:
+  static constexpr uint32_t kDefaultIntervalInMs = 1000;
+  static constexpr size_t kDefaultCapacity = 300;
+  static constexpr size_t kMaxSpaceCount = 12;
+  // scavenge, minor mark compact, mark sweep compact, incremental marking, weak callbacks
+  static constexpr size_t kGCTypeCount = 5;
+
+  struct Options {
+    uint32_t interval_in_ms = kDefaultIntervalInMs;
+    size_t capacity = kDefaultCapacity;
+  };
+
+  struct GCStats {
+    uint32_t count = 0;
+    uint64_t total_time_in_us = 0;
+  };
+
+  struct Sample {
+    uint64_t timestamp_in_ms = 0;
+    size_t used_heap_size = 0;
+    size_t total_heap_size = 0;
+    size_t external_memory = 0;
+    size_t malloced_memory = 0;
+    std::array<size_t, kMaxSpaceCount> space_used_size{};
+    // collections finished since the previous sample, by GC type
+    std::array<GCStats, kGCTypeCount> gc_stats{};
+  };
+
+  HeapSampler(v8::Isolate* isolate, std::shared_ptr<JavaScriptTaskRunner> runner, Options options);
+  ~HeapSampler();
+  HeapSampler(const HeapSampler&) = delete;
+  HeapSampler& operator=(const HeapSampler&) = delete;
+
+  void Start();
+  void Stop();
+  // oldest first
+  std::vector<Sample> GetSamples();
+  // {"interval":ms,"spaces":[name,...],"gcTypes":[name,...],"samples":[[timestamp,used,total,
+  // external,malloced,[space used,...],[gc count,gc time in us,...]],...]}
+  std::string Export();
+
+ private:
+  static void OnGCPrologue(v8::Isolate* isolate, v8::GCType type, v8::GCCallbackFlags flags, void* data);
+  static void OnGCEpilogue(v8::Isolate* isolate, v8::GCType type, v8::GCCallbackFlags flags, void* data);
+  static size_t GetGCTypeIndex(v8::GCType type);
+
+  void ScheduleSample();
+  void TakeSample();
+
+  v8::Isolate* isolate_;
+  std::weak_ptr<JavaScriptTaskRunner> runner_;
+  Options options_;
+  bool is_started_;
+  // written on the JS thread only
+  std::vector<std::string> space_names_;
+  // only touched on the JS thread
+  std::array<uint64_t, kGCTypeCount> gc_start_time_in_us_;
+  std::array<GCStats, kGCTypeCount> pending_gc_stats_;
+  std::vector<Sample> samples_;
+  size_t next_index_;
+  size_t sample_count_;
+  std::mutex mutex_;
+};
+
+}  // namespace vm
+}  // namespace hippy
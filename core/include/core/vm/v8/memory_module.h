@@ -33,4 +33,12 @@ class MemoryModule : public ModuleBase {
   void Get(const hippy::napi::CallbackInfo& info, void* data);
 
   virtual std::shared_ptr<CtxValue> BindFunction(std::shared_ptr<Scope> scope, std::shared_ptr<CtxValue> rest_args[]) override;
+
+ private:
+  // keys of the result object, resolved on the first call
+  std::shared_ptr<CtxValue> js_heap_size_limit_key_;
+  std::shared_ptr<CtxValue> total_js_heap_size_key_;
+  std::shared_ptr<CtxValue> used_js_heap_size_key_;
+  std::shared_ptr<CtxValue> js_number_of_native_contexts_key_;
+  std::shared_ptr<CtxValue> js_number_of_detached_contexts_key_;
 };
@@ -0,0 +1,64 @@
+/*
+ *
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2022 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "base/unicode_string_view.h"
+#include "core/base/common.h"
+#include "core/vm/v8/snapshot_data.h"
+
+// Builds a startup snapshot with one context per ContextConfig. Every context is created and
+// bootstrapped like a scope, then runs its scripts. The first context becomes the default one.
+// A builder creates a single snapshot.
+class SnapshotBuilder {
+ public:
+  using unicode_string_view = tdf::base::unicode_string_view;
+  using RegisterFunction = hippy::base::RegisterFunction;
+
+  enum class Result {
+    kSuccess, kRunScriptError, kSnapshotBlobInvalid
+  };
+
+  struct Script {
+    unicode_string_view file_name;
+    unicode_string_view source;
+  };
+
+  struct ContextConfig {
+    std::string name;
+    std::vector<Script> scripts;
+  };
+
+  // `context_created_cb` is called for every context before its bootstrap,
+  // like hippy::base::kContextCreatedCBKey
+  explicit SnapshotBuilder(RegisterFunction context_created_cb = nullptr);
+
+  Result Build(const std::vector<ContextConfig>& configs, SnapshotData& snapshot_data);
+  inline const unicode_string_view& GetErrorMessage() { return error_message_; }
+
+ private:
+  RegisterFunction context_created_cb_;
+  unicode_string_view error_message_;
+};
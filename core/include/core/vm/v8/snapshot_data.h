@@ -23,8 +23,15 @@
 #pragma once
 
 #include <any>
+#include <atomic>
 #include <cstdint>
+#include <memory>
 #include <string>
+#include <vector>
+
+#include "base/unicode_string_view.h"
+#include "core/base/file.h"
+#include "core/task/worker_task_runner.h"
 
 #pragma clang diagnostic push
 #pragma clang diagnostic ignored "-Wconversion"
@@ -32,12 +39,15 @@
 #pragma clang diagnostic pop
 
 // Snapshot file layout:
-// magic number 0x66886688
+// magic number 0x66886688, or 0x66886689 when the blob checksum is present
 // sdk version string "2.15.7"
 // blob length uint32_t
+// blob checksum uint32_t, FNV-1a of the blob raw data (0x66886689 only)
+// context count uint32_t, then one name string per context (0x66886689 only)
 // blob raw data
 
 constexpr uint32_t kMagicNumber = 0x66886688;
+constexpr uint32_t kMagicNumberWithChecksum = 0x66886689;
 
 #define STR(x) #x
 #define VERSION_NAME_STR(x) STR(x)
@@ -46,17 +56,42 @@ constexpr char kSdkVersion[] = VERSION_NAME_STRING;
 #undef VERSION_NAME_STR
 #undef STR
 
+// A snapshot file mapped once per process and shared by every isolate that loads it.
+struct MappedSnapshot {
+  enum class VerifyState : uint8_t { kUnverified, kVerifying, kValid, kInvalid };
+
+  std::shared_ptr<hippy::base::MappedFile> file;
+  std::atomic<VerifyState> verify_state{VerifyState::kUnverified};
+};
+
 struct SnapshotData {
  public:
+  using unicode_string_view = tdf::base::unicode_string_view;
+
   uint32_t magic_number;
   std::string sdk_version;
   v8::StartupData startup_data;
+  bool has_checksum = false;
+  uint32_t checksum = 0;
+  // names of the contexts in the blob, the first one is the default context
+  std::vector<std::string> context_names;
 
   std::vector<uint8_t> buffer_holder; // hold v8::StartupData data
   std::any external_buffer_holder;    // hold DirectBuffer to avoid copying
+  std::shared_ptr<MappedSnapshot> mapped_snapshot; // hold mapped v8::StartupData data
 
-  void WriteMetaData(v8::StartupData data);
+  void WriteMetaData(v8::StartupData data, const std::vector<std::string>& names = {});
   bool ReadMetadata();                // use meta data in buffer_holder
-  bool ReadMetaData(uint8_t* external_buffer_pointer, size_t length);
+  bool ReadMetaData(const uint8_t* external_buffer_pointer, size_t length);
+  // Maps the file read-only, or reuses the mapping of another isolate, and reads its meta data.
+  // Fails for a file whose checksum did not match.
+  bool MapFile(const unicode_string_view& file_path);
+  // Verifies the checksum of a mapped snapshot on `runner`, once per mapping.
+  void AsyncVerifyChecksum(const std::shared_ptr<WorkerTaskRunner>& runner);
+  bool VerifyChecksum() const;
+  // Position of the named context in context_names.
+  bool GetContextIndex(const std::string& name, size_t& index) const;
+
+  static uint32_t ComputeChecksum(const char* data, size_t length);
 };
 
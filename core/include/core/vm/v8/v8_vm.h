@@ -28,11 +28,13 @@
 
 #include "base/unicode_string_view.h"
 #include "core/napi/js_ctx.h"
+#include "core/vm/v8/heap_sampler.h"
 #include "core/vm/v8/snapshot_data.h"
 
 #pragma clang diagnostic push
 #pragma clang diagnostic ignored "-Wconversion"
 #include "v8/v8.h"
+#include "v8/v8-profiler.h"
 #pragma clang diagnostic pop
 
 namespace hippy {
@@ -49,6 +51,10 @@ struct V8VMInitParam : public VMInitParam {
   void* near_heap_limit_callback_data;
   V8VMSnapshotType type;
   SnapshotData snapshot_data;
+  // idle time of the JS thread after which V8 is given idle garbage collection work
+  uint64_t idle_gc_window_in_ms = kDefaultIdleGCWindowInMs;
+
+  static constexpr uint64_t kDefaultIdleGCWindowInMs = 1000;
 
   static size_t HeapLimitSlowGrowthStrategy(void* data, size_t current_heap_limit,
                                             size_t initial_heap_limit) {
@@ -82,12 +88,24 @@ class V8VM : public VM {
  public:
   using unicode_string_view = tdf::base::unicode_string_view;
 
+  // minimal time between two idle collections when they fall back to a pressure notification
+  static constexpr uint64_t kMinIdleGCIntervalInMs = 30 * 1000;
+
   V8VM(const std::shared_ptr<V8VMInitParam>& param);
   ~V8VM();
 
   virtual std::shared_ptr<Ctx> CreateContext();
-
-  static v8::Local<v8::String> CreateV8String(v8::Isolate* isolate, const unicode_string_view& str_view);
+  // Creates the context named `snapshot_context` in the snapshot the isolate was created from.
+  std::shared_ptr<Ctx> CreateContext(const std::string& snapshot_context);
+  virtual uint64_t GetIdleWindow() override { return idle_gc_window_in_ms_; }
+  virtual bool RunIdleTask(uint64_t deadline_in_ms) override;
+  virtual size_t NotifyMemoryPressure(MemoryPressureLevel level) override;
+  virtual bool StartCpuProfiling(uint32_t sampling_interval_in_us) override;
+  virtual std::shared_ptr<CpuProfile> StopCpuProfiling() override;
+
+  static v8::Local<v8::String> CreateV8String(v8::Isolate* isolate,
+                                              const unicode_string_view& str_view,
+                                              v8::NewStringType type = v8::NewStringType::kNormal);
   static unicode_string_view ToStringView(v8::Isolate* isolate, v8::Local<v8::String> str);
 
   static void PlatformDestroy();
@@ -95,6 +113,13 @@ class V8VM : public VM {
   v8::Isolate* isolate_;
   v8::Isolate::CreateParams create_params_;
   SnapshotData snapshot_data_;
+  uint64_t idle_gc_window_in_ms_;
+  // only used on the JS thread
+  uint64_t last_idle_gc_time_in_ms_;
+  // set on the JS thread while sampling
+  std::shared_ptr<HeapSampler> heap_sampler_;
+  // set on the JS thread while profiling
+  v8::CpuProfiler* cpu_profiler_;
 };
 
 class V8SnapshotVM : public VM {
@@ -31,3 +31,12 @@ global.dynamicLoad = (path, encode, cb) => {
   }
   ContextifyModule.LoadUntrustedContent(requestPath, encode, cb);
 };
+
+// manifest maps the path of every chunk to the paths of the chunks it depends on, as they are
+// passed to dynamicLoad, the dependencies are then prefetched together with the chunk
+global.setChunkManifest = (manifest) => {
+  const toUri = (path) => (/^(.+:\/\/)|^(\/\/)/.test(path) ? path : global.__HIPPYCURDIR__ + path);
+  const chunks = manifest || {};
+  ContextifyModule.SetChunkManifest(Object.keys(chunks)
+    .map((chunk) => [toUri(chunk), (chunks[chunk] || []).map(toUri)]));
+};
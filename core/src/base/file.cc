@@ -23,6 +23,8 @@
 #include "core/base/file.h"
 
 #include <dirent.h>
+#include <fcntl.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 
 #include <iostream>
@@ -153,5 +155,38 @@ uint64_t HippyFile::GetFileModifytime(const unicode_string_view& file_path) {
   fclose(fp);
   return modify_time;
 }
+
+std::shared_ptr<MappedFile> MappedFile::Open(const unicode_string_view& file_path) {
+  unicode_string_view owner(u8""_u8s);
+  const char* path = StringViewUtils::ToConstCharPointer(file_path, owner);
+  int fd = open(path, O_RDONLY | O_CLOEXEC);
+  if (fd == -1) {
+    TDF_BASE_DLOG(INFO) << "MappedFile open fail, file_path = " << file_path;
+    return nullptr;
+  }
+  struct stat st{};
+  if (fstat(fd, &st) == -1 || st.st_size <= 0) {
+    close(fd);
+    return nullptr;
+  }
+  auto length = checked_numeric_cast<off_t, size_t>(st.st_size);
+  void* data = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+  // the mapping keeps the file alive
+  close(fd);
+  if (data == MAP_FAILED) {
+    TDF_BASE_LOG(ERROR) << "mmap fail, file_path = " << file_path << ", errno = " << errno;
+    return nullptr;
+  }
+  TDF_BASE_DLOG(INFO) << "MappedFile succ, file_path = " << file_path << ", length = " << length;
+  return std::shared_ptr<MappedFile>(new MappedFile(reinterpret_cast<const uint8_t*>(data), length,
+                                                    st.st_dev, st.st_ino, st.st_mtime));
+}
+
+MappedFile::MappedFile(const uint8_t* data, size_t length, dev_t device, ino_t inode, time_t modify_time)
+    : data_(data), length_(length), device_(device), inode_(inode), modify_time_(modify_time) {}
+
+MappedFile::~MappedFile() {
+  munmap(const_cast<uint8_t*>(data_), length_);
+}
 }  // namespace base
 }  // namespace hippy
@@ -124,6 +124,40 @@ JSValueWrapper& JSValueWrapper::operator=(const JSValueWrapper& rhs) noexcept {
   type_ = rhs.type_;
   return *this;
 }
+JSValueWrapper& JSValueWrapper::operator=(JSValueWrapper&& rhs) noexcept {
+  if (this == &rhs) {
+    return *this;
+  }
+
+  deallocate();
+  switch (rhs.type_) {
+    case Type::Int32:
+      int32_value_ = rhs.int32_value_;
+      break;
+    case Type::UInt32:
+      uint32_value_ = rhs.uint32_value_;
+      break;
+    case Type::Double:
+      double_value_ = rhs.double_value_;
+      break;
+    case Type::Boolean:
+      bool_value_ = rhs.bool_value_;
+      break;
+    case Type::String:
+      new (&string_value_) std::string(std::move(rhs.string_value_));
+      break;
+    case Type::Object:
+      new (&object_value_) JSObjectType(std::move(rhs.object_value_));
+      break;
+    case Type::Array:
+      new (&array_value_) JSArrayType(std::move(rhs.array_value_));
+      break;
+    default:
+      break;
+  }
+  type_ = rhs.type_;
+  return *this;
+}
 JSValueWrapper& JSValueWrapper::operator=(const int32_t rhs) noexcept {
   deallocate();
   type_ = Type::Int32;
@@ -264,6 +298,35 @@ JSValueWrapper::JSValueWrapper(const JSValueWrapper& source)
   }
 }
 
+JSValueWrapper::JSValueWrapper(JSValueWrapper&& source) noexcept
+    : type_(source.type_) {
+  switch (type_) {
+    case Type::Int32:
+      int32_value_ = source.int32_value_;
+      break;
+    case Type::UInt32:
+      uint32_value_ = source.uint32_value_;
+      break;
+    case Type::Double:
+      double_value_ = source.double_value_;
+      break;
+    case Type::Boolean:
+      bool_value_ = source.bool_value_;
+      break;
+    case Type::String:
+      new (&string_value_) std::string(std::move(source.string_value_));
+      break;
+    case Type::Object:
+      new (&object_value_) JSObjectType(std::move(source.object_value_));
+      break;
+    case Type::Array:
+      new (&array_value_) JSArrayType(std::move(source.array_value_));
+      break;
+    default:
+      break;
+  }
+}
+
 inline void JSValueWrapper::deallocate() {
   switch (type_) {
     case Type::String:
@@ -273,7 +336,7 @@ inline void JSValueWrapper::deallocate() {
       array_value_.~vector();
       break;
     case Type::Object:
-      object_value_.clear();
+      object_value_.~JSObjectType();
       break;
     default:
       break;
@@ -0,0 +1,72 @@
+/*
+ *
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2022 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "core/base/task_pool.h"
+
+#include <new>
+
+namespace hippy {
+namespace base {
+
+TaskPool::TaskPool() {
+  free_blocks_.reserve(kMaxCachedBlockCount);
+}
+
+TaskPool::~TaskPool() {
+  for (void* block : free_blocks_) {
+    ::operator delete(block);
+  }
+}
+
+TaskPool& TaskPool::GetDefault() {
+  static auto* pool = new TaskPool();
+  return *pool;
+}
+
+void* TaskPool::Allocate(size_t size) {
+  if (size > kBlockSize) {
+    return ::operator new(size);
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!free_blocks_.empty()) {
+      void* block = free_blocks_.back();
+      free_blocks_.pop_back();
+      return block;
+    }
+  }
+  return ::operator new(kBlockSize);
+}
+
+void TaskPool::Deallocate(void* block, size_t size) {
+  if (size <= kBlockSize) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (free_blocks_.size() < kMaxCachedBlockCount) {
+      free_blocks_.push_back(block);
+      return;
+    }
+  }
+  ::operator delete(block);
+}
+
+}  // namespace base
+}  // namespace hippy
@@ -22,6 +22,9 @@
 
 #include "core/base/task_runner.h"
 
+#include <algorithm>
+#include <limits>
+
 #include "base/logging.h"
 #include "core/base/base_time.h"
 #include "core/base/macros.h"
@@ -31,7 +34,14 @@
 namespace hippy {
 namespace base {
 
-TaskRunner::TaskRunner() : Thread(Options("Task Runner")) {
+// A lane that has been passed over this many times in a row while it had pending tasks gets
+// the next turn, so a flood of higher priority work cannot starve it. kInput is never skipped.
+constexpr static std::array<uint32_t, Task::kPriorityCount> kLaneStarvationLimit = {0, 32, 8, 64};
+
+TaskRunner::TaskRunner() : TaskRunner(Options("Task Runner")) {}
+
+TaskRunner::TaskRunner(const Options& options)
+    : Thread(options), task_pool_(std::make_shared<TaskPool>()) {
   is_terminated_ = false;
 }
 
@@ -61,7 +71,7 @@ void TaskRunner::Run() {
 void TaskRunner::Terminate() {
   {
     std::unique_lock<std::mutex> lock(mutex_);
-    TDF_BASE_DLOG(INFO) << "TaskRunner::Terminate task_queue_ size = " << task_queue_.size();
+    TDF_BASE_DLOG(INFO) << "TaskRunner::Terminate task_queue_ size = " << PendingTaskCountNoLock();
     if (is_terminated_) {
       TDF_BASE_DLOG(INFO) << "TaskRunner has been terminated";
       return;
@@ -79,7 +89,6 @@ void TaskRunner::Terminate() {
 }
 
 void TaskRunner::PostTask(std::shared_ptr<Task> task) {
-  TDF_BASE_DLOG(INFO) << "TaskRunner::PostTask task id = " << task->id_;
   std::lock_guard<std::mutex> lock(mutex_);
 
   PostTaskNoLock(std::move(task));
@@ -87,6 +96,11 @@ void TaskRunner::PostTask(std::shared_ptr<Task> task) {
   cv_.notify_one();
 }
 
+void TaskRunner::PostTask(std::shared_ptr<Task> task, Task::Priority priority) {
+  task->priority_ = priority;
+  PostTask(std::move(task));
+}
+
 void TaskRunner::PostDelayedTask(
     std::shared_ptr<Task> task,
     TaskRunner::DelayedTimeInMs delay_in_milliseconds) {
@@ -111,17 +125,83 @@ void TaskRunner::CancelTask(const std::shared_ptr<Task>& task) {
   task->canceled_ = true;
 }
 
+TaskRunner::LaneStats TaskRunner::GetLaneStats(Task::Priority priority) {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  return lane_stats_[static_cast<size_t>(priority)];
+}
+
+void TaskRunner::ResetLaneStats() {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  lane_stats_.fill(LaneStats());
+}
+
 void TaskRunner::PostTaskNoLock(std::shared_ptr<Task> task) {
   if (is_terminated_) {
     return;
   }
 
-  task_queue_.push(std::move(task));
+  auto lane = static_cast<size_t>(task->priority_);
+  task_queue_[lane].push(std::make_pair(MonotonicallyIncreasingTime(), std::move(task)));
+}
+
+std::shared_ptr<Task> TaskRunner::PopTaskNoLock(DelayedTimeInMs now) {
+  size_t lane = Task::kPriorityCount;
+  for (size_t i = 1; i < Task::kPriorityCount; ++i) {
+    if (!task_queue_[i].empty() && skipped_count_[i] >= kLaneStarvationLimit[i]) {
+      lane = i;
+      break;
+    }
+  }
+  if (lane == Task::kPriorityCount) {
+    for (size_t i = 0; i < Task::kPriorityCount; ++i) {
+      if (!task_queue_[i].empty()) {
+        lane = i;
+        break;
+      }
+    }
+  }
+  if (lane == Task::kPriorityCount) {
+    return nullptr;
+  }
+
+  for (size_t i = lane + 1; i < Task::kPriorityCount; ++i) {
+    if (!task_queue_[i].empty()) {
+      ++skipped_count_[i];
+    }
+  }
+  skipped_count_[lane] = 0;
+
+  TaskEntry entry = std::move(task_queue_[lane].front());
+  task_queue_[lane].pop();
+  DelayedTimeInMs wait_in_ms = now > entry.first ? now - entry.first : 0;
+  LaneStats& stats = lane_stats_[lane];
+  ++stats.task_count;
+  stats.total_wait_in_ms += wait_in_ms;
+  stats.max_wait_in_ms = std::max(stats.max_wait_in_ms, wait_in_ms);
+  return std::move(entry.second);
+}
+
+size_t TaskRunner::PendingTaskCountNoLock() const {
+  size_t count = 0;
+  for (const auto& queue : task_queue_) {
+    count += queue.size();
+  }
+  return count;
 }
 
 std::shared_ptr<Task> TaskRunner::GetNext() {
+  bool is_timeout = false;
+  return GetNext(std::numeric_limits<DelayedTimeInMs>::max(), is_timeout);
+}
+
+std::shared_ptr<Task> TaskRunner::GetNext(DelayedTimeInMs timeout_in_ms, bool& is_timeout) {
   std::unique_lock<std::mutex> lock(mutex_);
 
+  is_timeout = false;
+  bool has_deadline = timeout_in_ms != std::numeric_limits<DelayedTimeInMs>::max();
+  DelayedTimeInMs deadline = has_deadline ? MonotonicallyIncreasingTime() + timeout_in_ms : 0;
   for (;;) {
     DelayedTimeInMs now = MonotonicallyIncreasingTime();
     std::shared_ptr<Task> task = popTaskFromDelayedQueueNoLock(now);
@@ -130,9 +210,8 @@ std::shared_ptr<Task> TaskRunner::GetNext() {
       task = popTaskFromDelayedQueueNoLock(now);
     }
 
-    if (!task_queue_.empty()) {
-      std::shared_ptr<Task> result = std::move(task_queue_.front());
-      task_queue_.pop();
+    std::shared_ptr<Task> result = PopTaskNoLock(now);
+    if (result) {
       return result;
     }
 
@@ -141,9 +220,18 @@ std::shared_ptr<Task> TaskRunner::GetNext() {
       return nullptr;
     }
 
-    if (task_queue_.empty() && !delayed_task_queue_.empty()) {
-      const DelayedEntry& delayed_task = delayed_task_queue_.top();
-      DelayedTimeInMs wait_in_ms = delayed_task.first - now;
+    if (has_deadline && now >= deadline) {
+      is_timeout = true;
+      return nullptr;
+    }
+
+    if (!delayed_task_queue_.empty() || has_deadline) {
+      DelayedTimeInMs wait_in_ms = has_deadline ? deadline - now
+                                                : std::numeric_limits<DelayedTimeInMs>::max();
+      if (!delayed_task_queue_.empty()) {
+        const DelayedEntry& delayed_task = delayed_task_queue_.top();
+        wait_in_ms = std::min(wait_in_ms, delayed_task.first - now);
+      }
       bool notified =
           cv_.wait_for(lock, std::chrono::milliseconds(wait_in_ms)) ==
           std::cv_status::timeout;
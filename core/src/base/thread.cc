@@ -22,10 +22,18 @@
 
 #include "core/base/thread.h"
 
+#include <cerrno>
 #include <climits>
 #include <cstdio>
 #include <cstring>
 
+#if defined(ANDROID) || defined(__linux__)
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
 #include "base/logging.h"
 #include "core/base/macros.h"
 
@@ -34,9 +42,15 @@ namespace base {
 
 static void* ThreadEntry(void* arg);
 
-Thread::Thread(const Options& options) : stack_size_(options.stack_size()) {
-  if (stack_size_ > 0 && static_cast<size_t>(stack_size_) < PTHREAD_STACK_MIN) {
-    stack_size_ = PTHREAD_STACK_MIN;
+Thread::Thread(const Options& options)
+    : stack_size_(options.stack_size()),
+      priority_(options.priority()),
+      affinity_mask_(options.affinity_mask()),
+      init_callback_(options.init_callback()) {
+  // a long on newer glibc
+  auto min_stack_size = static_cast<size_t>(PTHREAD_STACK_MIN);
+  if (stack_size_ > 0 && stack_size_ < min_stack_size) {
+    stack_size_ = min_stack_size;
   }
 
   SetName(options.name());
@@ -78,8 +92,57 @@ void Thread::SetName(const char* name) {
   name_[arraysize(name_) - 1] = '\0';
 }
 
+#ifdef __APPLE__
+static qos_class_t PriorityToQosClass(int priority) {
+  if (priority <= -8) {
+    return QOS_CLASS_USER_INTERACTIVE;
+  } else if (priority < 0) {
+    return QOS_CLASS_USER_INITIATED;
+  } else if (priority == 0) {
+    return QOS_CLASS_DEFAULT;
+  } else if (priority < 10) {
+    return QOS_CLASS_UTILITY;
+  }
+  return QOS_CLASS_BACKGROUND;
+}
+#endif
+
+void Thread::ApplyOptions() {
+  if (priority_) {
+#if defined(ANDROID) || defined(__linux__)
+    // the nice value of a thread is set through its kernel tid
+    auto tid = static_cast<id_t>(syscall(SYS_gettid));
+    if (setpriority(PRIO_PROCESS, tid, *priority_) != 0) {
+      TDF_BASE_DLOG(WARNING) << "Thread " << name_ << " setpriority failed, errno = " << errno;
+    }
+#elif defined(__APPLE__)
+    int result = pthread_set_qos_class_self_np(PriorityToQosClass(*priority_), 0);
+    if (result != 0) {
+      TDF_BASE_DLOG(WARNING) << "Thread " << name_ << " set qos class failed, result = " << result;
+    }
+#endif
+  }
+#if defined(ANDROID) || defined(__linux__)
+  if (affinity_mask_) {
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    for (int cpu = 0; cpu < 64 && cpu < CPU_SETSIZE; ++cpu) {
+      if (affinity_mask_ & (static_cast<uint64_t>(1) << cpu)) {
+        CPU_SET(cpu, &cpu_set);
+      }
+    }
+    if (sched_setaffinity(0, sizeof(cpu_set), &cpu_set) != 0) {
+      TDF_BASE_DLOG(WARNING) << "Thread " << name_ << " sched_setaffinity failed, errno = " << errno;
+    }
+  }
+#endif
+  if (init_callback_) {
+    init_callback_();
+  }
+}
+
 static void SetThreadName(const char* name) {
-#ifdef ANDROID
+#if defined(ANDROID) || defined(__linux__)
   pthread_setname_np(pthread_self(), name);
 #else
   pthread_setname_np(name);
@@ -93,6 +156,7 @@ static void* ThreadEntry(void* arg) {
 
   auto* thread = reinterpret_cast<Thread*>(arg);
   SetThreadName(thread->name());
+  thread->ApplyOptions();
   thread->Run();
 
   return reinterpret_cast<void*>(+true);
@@ -0,0 +1,288 @@
+/*
+ *
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2022 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#include "core/base/trace_event.h"
+
+#include <unistd.h>
+#if defined(ANDROID) || defined(__linux__)
+#include <sys/prctl.h>
+#else
+#include <pthread.h>
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <random>
+
+#include "base/logging.h"
+
+namespace hippy {
+namespace base {
+
+static std::string GetCurrentThreadName() {
+  char name[64] = {0};
+#if defined(ANDROID) || defined(__linux__)
+  prctl(PR_GET_NAME, name);
+#else
+  pthread_getname_np(pthread_self(), name, sizeof(name));
+#endif
+  return name;
+}
+
+static void AppendJsonString(std::string& out, const char* str) {
+  out += '"';
+  for (const char* p = str; *p; ++p) {
+    if (*p == '"' || *p == '\\') {
+      out += '\\';
+    }
+    out += static_cast<unsigned char>(*p) < 0x20 ? ' ' : *p;
+  }
+  out += '"';
+}
+
+struct TraceLog::ThreadBuffer {
+  uint32_t thread_id;
+  std::string thread_name;
+  // cleared when the thread exits, its events are kept until the next session
+  std::atomic<bool> is_alive;
+  // only contended while the events are read or reset
+  std::mutex mutex;
+  std::vector<Event> events;
+  size_t next_index;
+  size_t event_count;
+
+  ThreadBuffer(uint32_t id, std::string name, size_t capacity)
+      : thread_id(id), thread_name(std::move(name)), is_alive(true), events(capacity), next_index(0),
+        event_count(0) {}
+
+  void Reset(size_t capacity) {
+    std::lock_guard<std::mutex> lock(mutex);
+    events.clear();
+    events.resize(capacity);
+    next_index = 0;
+    event_count = 0;
+  }
+};
+
+TraceLog& TraceLog::GetInstance() {
+  static TraceLog instance;
+  return instance;
+}
+
+uint64_t TraceLog::NowInUs() {
+  return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+TraceLog::TraceLog()
+    : is_enabled_(false), session_id_(0), next_flow_id_(1), next_thread_id_(1), capacity_(0) {}
+
+bool TraceLog::Start(Options options) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  is_enabled_ = false;
+  session_id_.fetch_add(1, std::memory_order_relaxed);
+  buffers_.erase(std::remove_if(buffers_.begin(), buffers_.end(),
+                                [](const std::shared_ptr<ThreadBuffer>& buffer) {
+                                  return !buffer->is_alive;
+                                }),
+                 buffers_.end());
+  capacity_ = 0;
+  if (options.sampling_rate < 1.0) {
+    std::random_device device;
+    std::uniform_real_distribution<double> distribution(0.0, 1.0);
+    if (distribution(device) >= options.sampling_rate) {
+      TDF_BASE_DLOG(INFO) << "TraceLog session not sampled";
+      for (auto& buffer : buffers_) {
+        buffer->Reset(0);
+      }
+      return false;
+    }
+  }
+  capacity_ = options.capacity ? options.capacity : 1;
+  for (auto& buffer : buffers_) {
+    buffer->Reset(capacity_);
+  }
+  is_enabled_ = true;
+  return true;
+}
+
+bool TraceLog::Start() {
+  return Start(Options());
+}
+
+void TraceLog::Stop() {
+  is_enabled_ = false;
+}
+
+void TraceLog::AddEvent(Phase phase, const char* category, const char* name, uint64_t timestamp_in_us,
+                        uint64_t duration_in_us, uint64_t id, int64_t value) {
+  auto& buffer = GetCurrentThreadBuffer();
+  std::lock_guard<std::mutex> lock(buffer.mutex);
+  // stopped and restarted since IsEnabled was checked
+  if (buffer.events.empty()) {
+    return;
+  }
+  buffer.events[buffer.next_index] = {phase, category, name, timestamp_in_us, duration_in_us, id, value,
+                                      buffer.thread_id};
+  buffer.next_index = (buffer.next_index + 1) % buffer.events.size();
+  if (buffer.event_count < buffer.events.size()) {
+    ++buffer.event_count;
+  }
+}
+
+uint64_t TraceLog::NewFlowId() {
+  return next_flow_id_.fetch_add(1, std::memory_order_relaxed);
+}
+
+std::vector<TraceLog::Event> TraceLog::GetEvents() {
+  std::vector<Event> events;
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto& buffer : buffers_) {
+    std::lock_guard<std::mutex> buffer_lock(buffer->mutex);
+    if (!buffer->event_count) {
+      continue;
+    }
+    auto size = buffer->events.size();
+    size_t begin = (buffer->next_index + size - buffer->event_count) % size;
+    for (size_t i = 0; i < buffer->event_count; ++i) {
+      events.push_back(buffer->events[(begin + i) % size]);
+    }
+  }
+  std::stable_sort(events.begin(), events.end(), [](const Event& lhs, const Event& rhs) {
+    return lhs.timestamp_in_us < rhs.timestamp_in_us;
+  });
+  return events;
+}
+
+std::string TraceLog::ExportJson() {
+  auto events = GetEvents();
+  std::vector<std::pair<uint32_t, std::string>> thread_names;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto& buffer : buffers_) {
+      thread_names.emplace_back(buffer->thread_id, buffer->thread_name);
+    }
+  }
+  auto pid = std::to_string(getpid());
+  std::string out;
+  out.reserve(events.size() * 96 + thread_names.size() * 80 + 64);
+  out += "{\"traceEvents\":[";
+  bool is_first = true;
+  for (const auto& item : thread_names) {
+    out += is_first ? "" : ",";
+    is_first = false;
+    out += "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":" + pid + ",\"tid\":" + std::to_string(item.first) +
+           ",\"args\":{\"name\":";
+    AppendJsonString(out, item.second.c_str());
+    out += "}}";
+  }
+  for (const auto& event : events) {
+    out += is_first ? "{\"ph\":\"" : ",{\"ph\":\"";
+    is_first = false;
+    out += static_cast<char>(event.phase);
+    out += "\",\"cat\":";
+    AppendJsonString(out, event.category);
+    out += ",\"name\":";
+    AppendJsonString(out, event.name);
+    out += ",\"pid\":" + pid + ",\"tid\":" + std::to_string(event.thread_id) +
+           ",\"ts\":" + std::to_string(event.timestamp_in_us);
+    switch (event.phase) {
+      case Phase::kComplete:
+        out += ",\"dur\":" + std::to_string(event.duration_in_us);
+        break;
+      case Phase::kInstant:
+        out += ",\"s\":\"t\"";
+        break;
+      case Phase::kCounter:
+        out += ",\"args\":{\"value\":" + std::to_string(event.value) + "}";
+        break;
+      case Phase::kFlowBegin:
+        out += ",\"id\":" + std::to_string(event.id);
+        break;
+      case Phase::kFlowEnd:
+        // binds to the enclosing span rather than the next one
+        out += ",\"id\":" + std::to_string(event.id) + ",\"bp\":\"e\"";
+        break;
+    }
+    out += '}';
+  }
+  out += "],\"displayTimeUnit\":\"ms\"}";
+  return out;
+}
+
+bool TraceLog::Dump(const std::string& file_path) {
+  auto json = ExportJson();
+  std::ofstream file(file_path, std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!file.is_open()) {
+    TDF_BASE_DLOG(WARNING) << "TraceLog Dump open failed, file_path = " << file_path;
+    return false;
+  }
+  file.write(json.c_str(), static_cast<std::streamsize>(json.length()));
+  return static_cast<bool>(file);
+}
+
+TraceLog::ThreadBuffer& TraceLog::GetCurrentThreadBuffer() {
+  // marks the buffer when the thread exits
+  struct Holder {
+    std::shared_ptr<ThreadBuffer> buffer;
+    ~Holder() {
+      if (buffer) {
+        buffer->is_alive = false;
+      }
+    }
+  };
+  static thread_local Holder holder;
+  if (!holder.buffer) {
+    auto thread_id = next_thread_id_.fetch_add(1, std::memory_order_relaxed);
+    auto name = GetCurrentThreadName();
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto buffer = std::make_shared<ThreadBuffer>(
+        thread_id, name.empty() ? "thread " + std::to_string(thread_id) : name, capacity_);
+    buffers_.push_back(buffer);
+    holder.buffer = std::move(buffer);
+  }
+  return *holder.buffer;
+}
+
+bool TraceEventLimit::Acquire() {
+  if (!limit_) {
+    return false;
+  }
+  uint64_t session_id = TraceLog::GetInstance().GetSessionId();
+  auto state = state_.load(std::memory_order_relaxed);
+  while (true) {
+    uint64_t next_state;
+    if ((state >> 32) != session_id) {
+      next_state = (session_id << 32) | 1;
+    } else if ((state & 0xffffffff) < limit_) {
+      next_state = state + 1;
+    } else {
+      return false;
+    }
+    if (state_.compare_exchange_weak(state, next_state, std::memory_order_relaxed)) {
+      return true;
+    }
+  }
+}
+
+}  // namespace base
+}  // namespace hippy
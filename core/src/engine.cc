@@ -22,13 +22,26 @@
 
 #include "core/engine.h"
 
+#include <algorithm>
+#include <utility>
+
+#include "core/base/file.h"
+#include "core/base/trace_event.h"
+#include "core/modules/module_cache.h"
 #include "core/scope.h"
+#include "core/task/common_task.h"
 #include "core/task/javascript_task.h"
 
 constexpr uint32_t Engine::kDefaultWorkerPoolSize = 1;
+constexpr uint32_t Engine::kTeardownConcurrency = 2;
 constexpr char kUseSnapshotStringValue[] = "1";
 
-Engine::Engine() : vm_(nullptr) {}
+constexpr char kModuleCachePurgeHandlerName[] = "module_cache";
+
+Engine::Engine() : Engine(ThreadOptions()) {}
+
+Engine::Engine(ThreadOptions thread_options)
+    : thread_options_(std::move(thread_options)), vm_(nullptr), next_purge_handler_id_(0) {}
 
 Engine::~Engine() {
   TDF_BASE_DLOG(INFO) << "~Engine";
@@ -40,6 +53,136 @@ void Engine::TerminateRunner() {
   js_runner_->Terminate();
 }
 
+// The cache is shared by every engine, trimming it to a fixed target keeps the notifications of
+// several engines from trimming it more than once.
+static size_t PurgeModuleCache(Engine::MemoryPressureLevel level) {
+  auto& cache = ModuleCache::GetInstance();
+  return cache.Trim(level == Engine::MemoryPressureLevel::kCritical ? 0 : cache.GetCapacity() / 2);
+}
+
+static WorkerTaskRunner* GetTeardownRunner(uint32_t concurrency) {
+  // never destroyed, teardowns may still be queued when the process exits
+  static auto* runner = new WorkerTaskRunner(concurrency);
+  return runner;
+}
+
+void Engine::AsyncTerminateRunner(std::function<void()> cb) {
+  TDF_BASE_DLOG(INFO) << "AsyncTerminateRunner";
+  auto task = std::make_unique<CommonTask>();
+  task->func_ = [engine = shared_from_this(), cb]() mutable {
+    engine->TerminateRunner();
+    engine = nullptr;
+    if (cb) {
+      cb();
+    }
+  };
+  GetTeardownRunner(kTeardownConcurrency)->PostTask(std::move(task));
+}
+
+uint32_t Engine::AddPurgeHandler(const std::string& name, PurgeHandler handler) {
+  std::lock_guard<std::mutex> lock(purge_handler_mutex_);
+  uint32_t id = next_purge_handler_id_++;
+  purge_handlers_.push_back({id, name, std::move(handler)});
+  return id;
+}
+
+void Engine::RemovePurgeHandler(uint32_t id) {
+  std::lock_guard<std::mutex> lock(purge_handler_mutex_);
+  purge_handlers_.erase(std::remove_if(purge_handlers_.begin(), purge_handlers_.end(),
+                                       [id](const PurgeHandlerEntry& entry) { return entry.id == id; }),
+                        purge_handlers_.end());
+}
+
+void Engine::NotifyMemoryPressure(MemoryPressureLevel level,
+                                  std::function<void(const PurgeResult&)> cb) {
+  TDF_BASE_DLOG(INFO) << "NotifyMemoryPressure level = " << static_cast<int>(level);
+  auto weak_engine = weak_from_this();
+  auto task = std::make_shared<JavaScriptTask>();
+  task->callback = [weak_engine, level, cb] {
+    auto engine = weak_engine.lock();
+    if (!engine) {
+      return;
+    }
+    std::vector<PurgeHandlerEntry> handlers;
+    {
+      std::lock_guard<std::mutex> lock(engine->purge_handler_mutex_);
+      handlers = engine->purge_handlers_;
+    }
+    PurgeResult result;
+    result[kModuleCachePurgeHandlerName] += PurgeModuleCache(level);
+    for (const auto& entry : handlers) {
+      result[entry.name] += entry.handler(level);
+    }
+    // what the handlers released is collected here
+    if (engine->vm_) {
+      result[kVMPurgeHandlerName] += engine->vm_->NotifyMemoryPressure(level);
+    }
+    for (const auto& item : result) {
+      TDF_BASE_LOG(INFO) << "NotifyMemoryPressure " << item.first << " freed = " << item.second;
+    }
+    if (cb) {
+      cb(result);
+    }
+  };
+  // ahead of the queued script work
+  js_runner_->PostTask(std::move(task), hippy::base::Task::Priority::kInput);
+}
+
+void Engine::StartCpuProfiling(uint32_t sampling_interval_in_us, std::function<void(bool)> cb) {
+  auto weak_engine = weak_from_this();
+  auto task = std::make_shared<JavaScriptTask>();
+  task->callback = [weak_engine, sampling_interval_in_us, cb] {
+    auto engine = weak_engine.lock();
+    if (!engine) {
+      if (cb) {
+        cb(false);
+      }
+      return;
+    }
+    bool is_started = engine->vm_ && engine->vm_->StartCpuProfiling(sampling_interval_in_us);
+    if (cb) {
+      cb(is_started);
+    }
+  };
+  js_runner_->PostTask(std::move(task));
+}
+
+void Engine::StopCpuProfiling(const std::string& file_path, std::function<void(bool)> cb) {
+  auto weak_engine = weak_from_this();
+  auto task = std::make_shared<JavaScriptTask>();
+  task->callback = [weak_engine, file_path, cb] {
+    auto engine = weak_engine.lock();
+    if (!engine) {
+      if (cb) {
+        cb(false);
+      }
+      return;
+    }
+    auto profile = engine->vm_ ? engine->vm_->StopCpuProfiling() : nullptr;
+    if (!profile) {
+      TDF_BASE_DLOG(WARNING) << "StopCpuProfiling, not profiling";
+      if (cb) {
+        cb(false);
+      }
+      return;
+    }
+    auto worker_task = std::make_unique<CommonTask>();
+    worker_task->func_ = [profile, file_path, cb] {
+      auto json = profile->ToJson();
+      auto path = tdf::base::unicode_string_view::new_from_utf8(file_path.c_str(), file_path.length());
+      bool is_saved = hippy::base::HippyFile::SaveFile(path, json);
+      TDF_BASE_DLOG(INFO) << "StopCpuProfiling nodes = " << profile->nodes.size()
+                          << ", samples = " << profile->samples.size() << ", size = " << json.length()
+                          << ", is_saved = " << is_saved;
+      if (cb) {
+        cb(is_saved);
+      }
+    };
+    engine->worker_task_runner_->PostTask(std::move(worker_task));
+  };
+  js_runner_->PostTask(std::move(task));
+}
+
 std::shared_ptr<Scope> Engine::AsyncCreateScope(const std::string& name,
                                                 std::unordered_map<std::string, std::string> init_param,
                                                 std::unique_ptr<RegisterMap> map) {
@@ -49,6 +192,7 @@ std::shared_ptr<Scope> Engine::AsyncCreateScope(const std::string& name,
   bool use_snapshot = false;
   if (init_param[hippy::base::kUseSnapshot] == kUseSnapshotStringValue) {
     use_snapshot = true;
+    scope->snapshot_context_ = init_param[hippy::base::kSnapshotContext];
   }
   auto task = std::make_shared<JavaScriptTask>();
   task->callback = [scope, use_snapshot] {
@@ -60,6 +204,35 @@ std::shared_ptr<Scope> Engine::AsyncCreateScope(const std::string& name,
   return scope;
 }
 
+std::shared_ptr<Scope> Engine::AsyncPrepareScope(const std::string& name,
+                                                 hippy::base::Task::Priority priority) {
+  TDF_BASE_DLOG(INFO) << "Engine AsyncPrepareScope";
+  std::shared_ptr<Scope> scope = std::make_shared<Scope>(weak_from_this(), name, nullptr);
+  scope->wrapper_ = std::make_unique<ScopeWrapper>(scope);
+  auto task = std::make_shared<JavaScriptTask>();
+  task->callback = [scope] {
+    scope->Prepare();
+  };
+  js_runner_->PostTask(std::move(task), priority);
+
+  return scope;
+}
+
+void Engine::AsyncActivateScope(const std::shared_ptr<Scope>& scope,
+                                std::unordered_map<std::string, std::string> init_param,
+                                std::unique_ptr<RegisterMap> map) {
+  TDF_BASE_DLOG(INFO) << "Engine AsyncActivateScope";
+  bool use_snapshot = false;
+  if (init_param[hippy::base::kUseSnapshot] == kUseSnapshotStringValue) {
+    use_snapshot = true;
+  }
+  auto task = std::make_shared<JavaScriptTask>();
+  task->callback = hippy::base::MakeCopyable([scope, use_snapshot, map = std::move(map)]() mutable {
+    scope->Activate(std::move(map), use_snapshot);
+  });
+  js_runner_->PostTask(std::move(task));
+}
+
 std::shared_ptr<Scope> Engine::SyncCreateScope(std::unique_ptr<RegisterMap> map) {
   return SyncCreateScope("", {}, std::move(map));
 }
@@ -73,6 +246,7 @@ std::shared_ptr<Scope> Engine::SyncCreateScope(const std::string& name,
   bool use_snapshot = false;
   if (init_param[hippy::base::kUseSnapshot] == kUseSnapshotStringValue) {
     use_snapshot = true;
+    scope->snapshot_context_ = init_param[hippy::base::kSnapshotContext];
   }
   scope->Init(use_snapshot);
   return scope;
@@ -80,15 +254,24 @@ std::shared_ptr<Scope> Engine::SyncCreateScope(const std::string& name,
 
 void Engine::SetupThreads() {
   TDF_BASE_DLOG(INFO) << "Engine SetupThreads";
-  js_runner_ = std::make_shared<JavaScriptTaskRunner>();
+  js_runner_ = std::make_shared<JavaScriptTaskRunner>(thread_options_.js_thread);
   js_runner_->Start();
 
-  worker_task_runner_ = std::make_shared<WorkerTaskRunner>(kDefaultWorkerPoolSize);
+  worker_task_runner_ = std::make_shared<WorkerTaskRunner>(kDefaultWorkerPoolSize, thread_options_.worker_thread);
 }
 
 void Engine::CreateVM(const std::shared_ptr<VMInitParam>& param) {
+  HIPPY_TRACE_EVENT("engine", "Engine::CreateVM");
   TDF_BASE_DLOG(INFO) << "Engine CreateVM";
   vm_ = hippy::vm::CreateVM(param);
+  auto idle_window = vm_->GetIdleWindow();
+  if (idle_window) {
+    std::weak_ptr<VM> weak_vm = vm_;
+    js_runner_->SetIdleHandler([weak_vm](uint64_t deadline_in_ms) {
+      auto vm = weak_vm.lock();
+      return !vm || vm->RunIdleTask(deadline_in_ms);
+    }, idle_window);
+  }
   auto it = map_->find(hippy::base::kVMCreateCBKey);
   if (it != map_->end()) {
     auto f = it->second;
@@ -102,17 +285,28 @@ void Engine::CreateVM(const std::shared_ptr<VMInitParam>& param) {
 }
 
 void Engine::AsyncInit(const std::shared_ptr<VMInitParam>& param, std::unique_ptr<RegisterMap> map) {
+  HIPPY_TRACE_EVENT("engine", "Engine::AsyncInit");
   SetupThreads();
 
   map_ = std::move(map);
   auto weak_engine = weak_from_this();
   auto task = std::make_shared<JavaScriptTask>();
-  task->callback = [weak_engine, param] {
+  auto& trace_log = hippy::base::TraceLog::GetInstance();
+  uint64_t flow_id = 0;
+  if (trace_log.IsEnabled()) {
+    flow_id = trace_log.NewFlowId();
+    HIPPY_TRACE_FLOW_BEGIN("engine", "Engine::Init", flow_id);
+  }
+  task->callback = [weak_engine, param, flow_id] {
     auto engine = weak_engine.lock();
     TDF_BASE_DCHECK(engine);
     if (!engine) {
       return;
     }
+    HIPPY_TRACE_EVENT("engine", "Engine::InitTask");
+    if (flow_id) {
+      HIPPY_TRACE_FLOW_END("engine", "Engine::Init", flow_id);
+    }
     engine->CreateVM(param);
   };
   js_runner_->PostTask(task);
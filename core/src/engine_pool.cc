@@ -0,0 +1,264 @@
+/*
+ *
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2022 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "core/engine_pool.h"
+
+#include <algorithm>
+#include <thread>
+#include <utility>
+
+#include "base/logging.h"
+#include "core/base/base_time.h"
+#include "core/task/common_task.h"
+#include "core/task/javascript_task.h"
+#ifdef JS_V8
+#include "core/vm/v8/v8_vm.h"
+#endif
+
+using Task = hippy::base::Task;
+
+constexpr char kUseSnapshotStringValue[] = "1";
+constexpr char kNotUseSnapshotStringValue[] = "0";
+
+// must run on the JS thread of the engine
+static size_t GetHeapSize(const std::shared_ptr<Engine>& engine) {
+#ifdef JS_V8
+  auto vm = std::static_pointer_cast<hippy::vm::V8VM>(engine->GetVM());
+  if (vm && vm->isolate_) {
+    v8::HeapStatistics heap_statistics;
+    vm->isolate_->GetHeapStatistics(&heap_statistics);
+    return heap_statistics.total_physical_size();
+  }
+#endif
+  return 0;
+}
+
+EnginePool::EnginePool(Options options)
+    : options_(std::move(options)), runner_(std::make_unique<WorkerTaskRunner>(1)), is_stopped_(true) {}
+
+EnginePool::~EnginePool() {
+  Clear();
+  // a refill task may drop the last reference, joining its own thread would deadlock
+  if (std::this_thread::get_id() == runner_thread_id_) {
+    std::thread([runner = std::move(runner_)] {
+      runner->Terminate();
+    }).detach();
+    return;
+  }
+  runner_->Terminate();
+}
+
+void EnginePool::Start() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    is_stopped_ = false;
+  }
+  PostRefill();
+}
+
+EnginePool::Instance EnginePool::Acquire(std::unique_ptr<RegisterMap> map,
+                                         const std::function<void(const Instance&)>& on_acquired) {
+  Entry entry;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    // the scope of an engine still warming is prepared on the idle lane, activating it on the
+    // normal lane could run first
+    auto it = std::find_if(entries_.begin(), entries_.end(), [](const Entry& entry) {
+      return entry.warmed;
+    });
+    if (it == entries_.end()) {
+      ++stats_.miss_count;
+      TDF_BASE_DLOG(INFO) << "EnginePool miss";
+      return Instance();
+    }
+    entry = std::move(*it);
+    entries_.erase(it);
+    ++stats_.hit_count;
+  }
+
+  if (on_acquired) {
+    on_acquired(entry.instance);
+  }
+  auto engine = entry.instance.engine;
+  std::unordered_map<std::string, std::string> init_param = {
+      {hippy::base::kUseSnapshot,
+       options_.use_snapshot ? kUseSnapshotStringValue : kNotUseSnapshotStringValue}
+  };
+  engine->AsyncActivateScope(entry.instance.scope, std::move(init_param), std::move(map));
+
+  // creating the next engine starts threads, keep it off the caller's thread
+  PostRefill();
+
+  return entry.instance;
+}
+
+size_t EnginePool::Trim(size_t count) {
+  std::deque<Entry> evicted;
+  size_t heap_size = 0;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    while (entries_.size() > count) {
+      heap_size += entries_.back().heap_size;
+      evicted.push_back(std::move(entries_.back()));
+      entries_.pop_back();
+      ++stats_.eviction_count;
+    }
+  }
+  for (auto& entry : evicted) {
+    Release(entry);
+  }
+  return heap_size;
+}
+
+void EnginePool::Clear() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    is_stopped_ = true;
+  }
+  Trim(0);
+}
+
+EnginePool::Stats EnginePool::GetStats() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  Stats stats = stats_;
+  stats.idle_heap_size_in_bytes = 0;
+  for (const auto& entry : entries_) {
+    stats.idle_heap_size_in_bytes += entry.heap_size;
+  }
+  return stats;
+}
+
+void EnginePool::PostRefill() {
+  std::weak_ptr<EnginePool> weak_pool = weak_from_this();
+  auto task = std::make_unique<CommonTask>();
+  task->func_ = [weak_pool] {
+    auto pool = weak_pool.lock();
+    if (pool) {
+      pool->runner_thread_id_ = std::this_thread::get_id();
+      pool->Refill();
+    }
+  };
+  runner_->PostTask(std::move(task));
+}
+
+void EnginePool::Refill() {
+  size_t missing;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (is_stopped_ || entries_.size() >= options_.capacity) {
+      return;
+    }
+    missing = options_.capacity - entries_.size();
+  }
+
+  std::weak_ptr<EnginePool> weak_pool = weak_from_this();
+  for (size_t i = 0; i < missing; ++i) {
+    Entry entry;
+    entry.create_time = hippy::base::MonotonicallyIncreasingTime();
+    auto engine = std::make_shared<Engine>(options_.thread_options);
+    engine->AsyncInit(options_.vm_param_factory ? options_.vm_param_factory() : nullptr);
+    entry.instance.engine = engine;
+    entry.instance.scope = engine->AsyncPrepareScope("", Task::Priority::kIdle);
+
+    // an engine handed out before it finished warming may outlive the pool
+    std::weak_ptr<Engine> weak_engine = engine;
+    auto task = std::make_shared<JavaScriptTask>();
+    task->callback = [weak_pool, weak_engine] {
+      auto pool = weak_pool.lock();
+      auto engine = weak_engine.lock();
+      if (pool && engine) {
+        pool->OnWarmed(engine, GetHeapSize(engine), hippy::base::MonotonicallyIncreasingTime());
+      }
+    };
+    engine->GetJSRunner()->PostTask(std::move(task), Task::Priority::kIdle);
+
+    bool is_accepted = false;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (!is_stopped_ && entries_.size() < options_.capacity) {
+        entries_.push_back(std::move(entry));
+        is_accepted = true;
+      }
+    }
+    if (!is_accepted) {
+      Release(entry);
+      return;
+    }
+  }
+}
+
+void EnginePool::OnWarmed(const std::shared_ptr<Engine>& engine, size_t heap_size, uint64_t ready_time) {
+  std::deque<Entry> evicted;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = std::find_if(entries_.begin(), entries_.end(), [&engine](const Entry& entry) {
+      return entry.instance.engine == engine;
+    });
+    if (it == entries_.end()) {  // already handed out or evicted
+      return;
+    }
+    it->warmed = true;
+    it->heap_size = heap_size;
+    ++stats_.warm_count;
+    stats_.total_warm_time_in_ms += ready_time - it->create_time;
+    TDF_BASE_DLOG(INFO) << "EnginePool warmed, heap_size = " << heap_size
+                        << ", cost = " << ready_time - it->create_time << "ms";
+    EnforceBudgetNoLock(evicted);
+  }
+  for (auto& entry : evicted) {
+    Release(entry);
+  }
+}
+
+void EnginePool::EnforceBudgetNoLock(std::deque<Entry>& evicted) {
+  if (!options_.memory_budget_in_bytes) {
+    return;
+  }
+  size_t total = 0;
+  for (const auto& entry : entries_) {
+    total += entry.heap_size;
+  }
+  // the newest engines go first, the oldest ones are the next to be handed out
+  while (total > options_.memory_budget_in_bytes && !entries_.empty()) {
+    total -= entries_.back().heap_size;
+    evicted.push_back(std::move(entries_.back()));
+    entries_.pop_back();
+    ++stats_.eviction_count;
+  }
+}
+
+void EnginePool::Release(Entry& entry) {
+  auto engine = std::move(entry.instance.engine);
+  if (!engine) {
+    return;
+  }
+  // the context has to go away on its own JS thread, before the runner stops
+  auto task = std::make_shared<JavaScriptTask>();
+  auto scope = std::move(entry.instance.scope);
+  task->callback = [scope]() mutable {
+    scope = nullptr;
+  };
+  scope = nullptr;
+  engine->GetJSRunner()->PostTask(std::move(task));
+  // joining the threads blocks, and the caller may be the JS thread of this engine
+  engine->AsyncTerminateRunner();
+}
@@ -102,7 +102,7 @@ std::shared_ptr<CtxValue> ConsoleModule::BindFunction(std::shared_ptr<Scope> sco
   auto context = scope->GetContext();
   auto object = context->CreateObject();
 
-  auto key = context->CreateString("Log");
+  auto key = context->GetPropertyKey("Log");
   auto wrapper = std::make_unique<hippy::napi::FuncWrapper>(
       InvokeConsoleModuleLog,nullptr);
   auto value = context->CreateFunction(wrapper);
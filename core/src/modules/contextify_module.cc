@@ -28,6 +28,7 @@
 
 #include "base/logging.h"
 #include "core/base/uri_loader.h"
+#include "core/modules/module_cache.h"
 #include "core/napi/js_try_catch.h"
 #include "core/task/common_task.h"
 #include "core/task/javascript_task.h"
@@ -38,6 +39,7 @@
 
 GEN_INVOKE_CB(ContextifyModule, RunInThisContext) // NOLINT(cert-err58-cpp)
 GEN_INVOKE_CB(ContextifyModule, LoadUntrustedContent) // NOLINT(cert-err58-cpp)
+GEN_INVOKE_CB(ContextifyModule, SetChunkManifest) // NOLINT(cert-err58-cpp)
 
 using unicode_string_view = tdf::base::unicode_string_view;
 using u8string = unicode_string_view::u8string;
@@ -117,19 +119,24 @@ void ContextifyModule::LoadUntrustedContent(const CallbackInfo& info, void* data
   } else {
     function = info[1];
   }
+  // a request of the same uri in flight in this scope runs the script once for every callback
+  bool is_pending = cb_func_map_.find(uri) != cb_func_map_.end();
+  auto& functions = cb_func_map_[uri];
   if (context->IsFunction(function)) {
-    cb_func_map_[uri] = function;
+    functions.push_back(function);
   } else {
     TDF_BASE_DLOG(INFO) << "cb is not function";
-    function = nullptr;
+  }
+  if (is_pending) {
+    info.GetReturnValue()->SetUndefined();
+    return;
   }
 
   TDF_BASE_DLOG(INFO) << "RequestUntrustedContent uri = " << uri;
 
   std::weak_ptr<Scope> weak_scope = scope;
-  std::weak_ptr<hippy::napi::CtxValue> weak_function = function;
 
-  std::function<void(u8string)> cb = [this, weak_scope, weak_function, encode, uri](u8string code) {
+  ModuleCache::LoadCallback cb = [this, weak_scope, encode, uri](ModuleCache::Module module) {
     auto scope = weak_scope.lock();
     if (!scope) {
       return;
@@ -147,16 +154,15 @@ void ContextifyModule::LoadUntrustedContent(const CallbackInfo& info, void* data
       file_name = uri;
     }
 
-    if (code.empty()) {
+    if (!module.source) {
       TDF_BASE_DLOG(WARNING) << "Load uri = " << uri << ", code empty";
     } else {
-      TDF_BASE_DLOG(INFO) << "Load uri = " << uri << ", len = " << code.length()
+      TDF_BASE_DLOG(INFO) << "Load uri = " << uri << ", len = " << module.source->length()
                           << ", encode = " << encode
-                          << ", code = " << unicode_string_view(code);
+                          << ", code_cache = " << (module.code_cache ? module.code_cache->length() : 0);
     }
     auto js_task = std::make_shared<JavaScriptTask>();
-    js_task->callback = [this, weak_scope, weak_function,
-                         move_code = std::move(code), cur_dir, file_name, uri]() {
+    js_task->callback = [this, weak_scope, module = std::move(module), cur_dir, file_name, uri]() {
       auto scope = weak_scope.lock();
       if (!scope) {
         return;
@@ -164,17 +170,36 @@ void ContextifyModule::LoadUntrustedContent(const CallbackInfo& info, void* data
 
       std::shared_ptr<Ctx> ctx = scope->GetContext();
       std::shared_ptr<CtxValue> error = nullptr;
-      if (!move_code.empty()) {
+      if (module.source) {
         auto global_object = ctx->GetGlobalObject();
-        auto cur_dir_key = ctx->CreateString(kCurDir);
+        if (!cur_dir_key_) {
+          cur_dir_key_ = ctx->GetPropertyKey(kCurDir);
+        }
+        auto cur_dir_key = cur_dir_key_;
         auto last_dir_str_obj = ctx->GetProperty(global_object, cur_dir_key);
         TDF_BASE_DLOG(INFO) << "__HIPPYCURDIR__ cur_dir = " << cur_dir;
         auto cur_dir_value = ctx->CreateString(cur_dir);
         ctx->SetProperty(global_object, cur_dir_key, cur_dir_value);
         std::shared_ptr<TryCatch> try_catch = CreateTryCatchScope(true, scope->GetContext());
         try_catch->SetVerbose(true);
-        unicode_string_view view_code(move_code);
+        unicode_string_view view_code(*module.source);
+#ifdef JS_V8
+        auto v8_ctx = std::static_pointer_cast<hippy::napi::V8Ctx>(ctx);
+        if (is_code_cache_enabled_) {
+          unicode_string_view code_cache;
+          if (module.code_cache) {
+            code_cache = unicode_string_view(*module.code_cache);
+          }
+          v8_ctx->RunScript(view_code, file_name, true, &code_cache, true);
+          if (!module.code_cache && !StringViewUtils::IsEmpty(code_cache)) {
+            ModuleCache::GetInstance().PutCodeCache(uri, module.hash, code_cache.utf8_value());
+          }
+        } else {
+          v8_ctx->RunScript(view_code, file_name, false, nullptr, true);
+        }
+#else
         scope->RunJS(view_code, file_name);
+#endif
         ctx->SetProperty(global_object, cur_dir_key, last_dir_str_obj, hippy::napi::PropertyAttribute::ReadOnly);
         unicode_string_view view_last_dir_str("");
         ctx->GetValueString(last_dir_str_obj, &view_last_dir_str);
@@ -189,15 +214,19 @@ void ContextifyModule::LoadUntrustedContent(const CallbackInfo& info, void* data
         error = ctx->CreateError(unicode_string_view(err_msg));
       }
 
-      std::shared_ptr<CtxValue> function = weak_function.lock();
-      if (function) {
+      auto it = cb_func_map_.find(uri);
+      if (it == cb_func_map_.end()) {
+        return;
+      }
+      auto functions = std::move(it->second);
+      RemoveCBFunc(uri);
+      if (!error) {
+        error = ctx->CreateNull();
+      }
+      for (const auto& function : functions) {
         TDF_BASE_DLOG(INFO) << "run js cb";
-        if (!error) {
-          error = ctx->CreateNull();
-        }
         std::shared_ptr<CtxValue> argv[] = {error};
         ctx->CallFunction(function, 1, argv);
-        RemoveCBFunc(uri);
       }
     };
     auto runner = scope->GetTaskRunner();
@@ -205,7 +234,47 @@ void ContextifyModule::LoadUntrustedContent(const CallbackInfo& info, void* data
       runner->PostTask(js_task);
     }
   };
-  loader->RequestUntrustedContent(uri, cb);
+  ModuleCache::GetInstance().Load(uri, loader, std::move(cb));
+  prefetcher_->OnRequested(StringViewUtils::ToU8StdStr(uri), scope);
+  info.GetReturnValue()->SetUndefined();
+}
+
+void ContextifyModule::SetChunkManifest(const CallbackInfo& info, void* data) {
+  auto scope_wrapper = reinterpret_cast<ScopeWrapper*>(std::any_cast<void*>(info.GetSlot()));
+  auto scope = scope_wrapper->scope.lock();
+  TDF_BASE_CHECK(scope);
+  auto context = scope->GetContext();
+  auto entries = info[0];
+  if (!context->IsArray(entries)) {
+    info.GetExceptionValue()->Set(context, "The first argument must be an array.");
+    return;
+  }
+
+  ModulePrefetcher::Manifest manifest;
+  uint32_t length = context->GetArrayLength(entries);
+  for (uint32_t i = 0; i < length; ++i) {
+    auto entry = context->CopyArrayElement(entries, i);
+    unicode_string_view name;
+    if (!context->IsArray(entry) || context->GetArrayLength(entry) < 2 ||
+        !context->GetValueString(context->CopyArrayElement(entry, 0), &name)) {
+      TDF_BASE_DLOG(WARNING) << "SetChunkManifest invalid entry, index = " << i;
+      continue;
+    }
+    auto deps = context->CopyArrayElement(entry, 1);
+    if (!context->IsArray(deps)) {
+      continue;
+    }
+    auto& dep_names = manifest[StringViewUtils::ToU8StdStr(name)];
+    uint32_t dep_length = context->GetArrayLength(deps);
+    for (uint32_t j = 0; j < dep_length; ++j) {
+      unicode_string_view dep_name;
+      if (context->GetValueString(context->CopyArrayElement(deps, j), &dep_name)) {
+        dep_names.push_back(StringViewUtils::ToU8StdStr(dep_name));
+      }
+    }
+  }
+  TDF_BASE_DLOG(INFO) << "SetChunkManifest size = " << manifest.size();
+  prefetcher_->SetManifest(std::move(manifest));
   info.GetReturnValue()->SetUndefined();
 }
 
@@ -214,17 +283,23 @@ std::shared_ptr<CtxValue> ContextifyModule::BindFunction(std::shared_ptr<Scope>
   auto context = scope->GetContext();
   auto object = context->CreateObject();
 
-  auto key = context->CreateString("RunInThisContext");
+  auto key = context->GetPropertyKey("RunInThisContext");
   auto wrapper = std::make_unique<hippy::napi::FuncWrapper>(InvokeContextifyModuleRunInThisContext, nullptr);
   auto value = context->CreateFunction(wrapper);
   scope->SaveFuncWrapper(std::move(wrapper));
   context->SetProperty(object, key, value);
 
-  key = context->CreateString("LoadUntrustedContent");
+  key = context->GetPropertyKey("LoadUntrustedContent");
   wrapper = std::make_unique<hippy::napi::FuncWrapper>(InvokeContextifyModuleLoadUntrustedContent, nullptr);
   value = context->CreateFunction(wrapper);
   scope->SaveFuncWrapper(std::move(wrapper));
   context->SetProperty(object, key, value);
 
+  key = context->GetPropertyKey("SetChunkManifest");
+  wrapper = std::make_unique<hippy::napi::FuncWrapper>(InvokeContextifyModuleSetChunkManifest, nullptr);
+  value = context->CreateFunction(wrapper);
+  scope->SaveFuncWrapper(std::move(wrapper));
+  context->SetProperty(object, key, value);
+
   return object;
 }
@@ -0,0 +1,194 @@
+/*
+ *
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2022 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "core/modules/module_cache.h"
+
+#include <utility>
+
+#include "base/logging.h"
+#include "core/base/string_view_utils.h"
+
+using StringViewUtils = hippy::base::StringViewUtils;
+
+constexpr uint64_t kFnvOffsetBasis = 14695981039346656037ull;
+constexpr uint64_t kFnvPrime = 1099511628211ull;
+
+ModuleCache& ModuleCache::GetInstance() {
+  // never destroyed, loader callbacks may still arrive while the process exits
+  static ModuleCache* instance = new ModuleCache();
+  return *instance;
+}
+
+ModuleCache::ModuleCache() : capacity_in_bytes_(kDefaultCapacityInBytes) {}
+
+void ModuleCache::Load(const unicode_string_view& uri,
+                       const std::shared_ptr<UriLoader>& loader,
+                       LoadCallback cb) {
+  std::string key = StringViewUtils::ToU8StdStr(uri);
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto pending_it = pending_.find(key);
+    if (pending_it != pending_.end()) {
+      ++stats_.coalesced_count;
+      pending_it->second.push_back(std::move(cb));
+      return;
+    }
+    pending_[key].push_back(std::move(cb));
+  }
+
+  // the loader may call back synchronously
+  loader->RequestUntrustedContent(uri, [this, key](u8string content) {
+    OnLoaded(key, std::move(content));
+  });
+}
+
+void ModuleCache::OnLoaded(const std::string& uri, u8string content) {
+  Module module;
+  uint64_t hash = content.empty() ? 0 : ComputeHash(content);
+  std::vector<LoadCallback> callbacks;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto pending_it = pending_.find(uri);
+    if (pending_it != pending_.end()) {
+      callbacks = std::move(pending_it->second);
+      pending_.erase(pending_it);
+    }
+    if (!content.empty()) {
+      std::string key = MakeKey(uri, hash);
+      auto it = entries_.find(key);
+      if (it != entries_.end()) {
+        ++stats_.hit_count;
+        if (it->second.module.code_cache) {
+          ++stats_.code_cache_hit_count;
+        }
+        lru_.splice(lru_.begin(), lru_, it->second.lru_it);
+        module = it->second.module;
+      } else {
+        ++stats_.miss_count;
+        TDF_BASE_DLOG(INFO) << "ModuleCache miss, uri = " << uri;
+        module.hash = hash;
+        module.source = std::make_shared<const u8string>(std::move(content));
+        if (GetSize(module) <= capacity_in_bytes_) {
+          lru_.push_front(key);
+          auto& entry = entries_[key];
+          entry.module = module;
+          entry.lru_it = lru_.begin();
+          stats_.size_in_bytes += GetSize(module);
+          EnforceCapacityNoLock();
+        }
+      }
+    }
+  }
+  for (auto& cb : callbacks) {
+    cb(module);
+  }
+}
+
+void ModuleCache::PutCodeCache(const unicode_string_view& uri, uint64_t hash, u8string code_cache) {
+  if (code_cache.empty()) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = entries_.find(MakeKey(StringViewUtils::ToU8StdStr(uri), hash));
+  if (it == entries_.end()) {
+    return;
+  }
+  auto& module = it->second.module;
+  if (module.code_cache) {
+    return;
+  }
+  stats_.size_in_bytes += code_cache.length();
+  module.code_cache = std::make_shared<const u8string>(std::move(code_cache));
+  EnforceCapacityNoLock();
+}
+
+void ModuleCache::SetCapacity(size_t capacity_in_bytes) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  capacity_in_bytes_ = capacity_in_bytes;
+  EnforceCapacityNoLock();
+}
+
+size_t ModuleCache::GetCapacity() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return capacity_in_bytes_;
+}
+
+size_t ModuleCache::Trim(size_t size_in_bytes) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  size_t size = stats_.size_in_bytes;
+  EvictNoLock(size_in_bytes);
+  return size - stats_.size_in_bytes;
+}
+
+void ModuleCache::Clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  stats_.eviction_count += entries_.size();
+  entries_.clear();
+  lru_.clear();
+  stats_.size_in_bytes = 0;
+}
+
+ModuleCache::Stats ModuleCache::GetStats() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  Stats stats = stats_;
+  stats.entry_count = entries_.size();
+  return stats;
+}
+
+uint64_t ModuleCache::ComputeHash(const u8string& content) {
+  uint64_t hash = kFnvOffsetBasis;
+  for (auto c : content) {
+    hash ^= static_cast<uint8_t>(c);
+    hash *= kFnvPrime;
+  }
+  return hash;
+}
+
+void ModuleCache::EnforceCapacityNoLock() {
+  EvictNoLock(capacity_in_bytes_);
+}
+
+void ModuleCache::EvictNoLock(size_t size_in_bytes) {
+  while (stats_.size_in_bytes > size_in_bytes && !lru_.empty()) {
+    auto it = entries_.find(lru_.back());
+    TDF_BASE_DCHECK(it != entries_.end());
+    stats_.size_in_bytes -= GetSize(it->second.module);
+    entries_.erase(it);
+    lru_.pop_back();
+    ++stats_.eviction_count;
+  }
+}
+
+std::string ModuleCache::MakeKey(const std::string& uri, uint64_t hash) {
+  return uri + '#' + std::to_string(hash);
+}
+
+size_t ModuleCache::GetSize(const Module& module) {
+  size_t size = 0;
+  if (module.source) {
+    size += module.source->length();
+  }
+  if (module.code_cache) {
+    size += module.code_cache->length();
+  }
+  return size;
+}
@@ -0,0 +1,216 @@
+/*
+ *
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2022 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "core/modules/module_prefetcher.h"
+
+#include <utility>
+
+#include "base/logging.h"
+#include "core/base/string_view_utils.h"
+#include "core/scope.h"
+#include "core/task/common_task.h"
+#include "core/task/javascript_task.h"
+#ifdef JS_V8
+#include "core/napi/v8/v8_ctx.h"
+#endif
+
+using unicode_string_view = tdf::base::unicode_string_view;
+using StringViewUtils = hippy::base::StringViewUtils;
+using Task = hippy::base::Task;
+
+bool ModulePrefetcher::UriSet::Insert(const std::string& uri) {
+  if (!set_.insert(uri).second) {
+    return false;
+  }
+  order_.push_back(uri);
+  if (order_.size() > capacity_) {
+    set_.erase(order_.front());
+    order_.pop_front();
+  }
+  return true;
+}
+
+ModulePrefetcher::ModulePrefetcher(size_t max_concurrent_prefetches)
+    : max_concurrent_prefetches_(max_concurrent_prefetches),
+      prefetching_count_(0),
+      is_precompile_enabled_(false),
+      prefetched_(kMaxTrackedUriCount),
+      requested_(kMaxTrackedUriCount) {}
+
+void ModulePrefetcher::SetManifest(Manifest manifest) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  manifest_ = std::move(manifest);
+}
+
+void ModulePrefetcher::SetPrecompileEnabled(bool is_enabled) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  is_precompile_enabled_ = is_enabled;
+}
+
+void ModulePrefetcher::OnRequested(const std::string& uri, const std::shared_ptr<Scope>& scope) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (requested_.Insert(uri) && prefetched_.Contains(uri)) {
+      ++stats_.hit_count;
+    }
+    if (manifest_.empty()) {
+      return;
+    }
+    weak_scope_ = scope;
+    loader_ = scope->GetUriLoader();
+    js_runner_ = scope->GetTaskRunner();
+    worker_runner_ = scope->GetWorkerTaskRunner();
+
+    // the whole dependency tree is queued at once, breadth first
+    std::deque<std::string> pending = {uri};
+    std::unordered_set<std::string> visited = {uri};
+    while (!pending.empty()) {
+      std::string cur = std::move(pending.front());
+      pending.pop_front();
+      auto it = manifest_.find(cur);
+      if (it == manifest_.end()) {
+        continue;
+      }
+      for (const auto& dep_uri : it->second) {
+        if (!visited.insert(dep_uri).second) {
+          continue;
+        }
+        pending.push_back(dep_uri);
+        if (requested_.Contains(dep_uri) || !prefetched_.Insert(dep_uri)) {
+          continue;
+        }
+        queue_.push_back(dep_uri);
+        ++stats_.prefetch_count;
+      }
+    }
+  }
+  Pump();
+}
+
+ModulePrefetcher::Stats ModulePrefetcher::GetStats() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  Stats stats = stats_;
+  stats.waste_count = stats_.prefetch_count - stats_.hit_count;
+  return stats;
+}
+
+void ModulePrefetcher::Pump() {
+  std::vector<std::string> uris;
+  std::shared_ptr<UriLoader> loader;
+  std::shared_ptr<WorkerTaskRunner> runner;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    runner = worker_runner_.lock();
+    loader = loader_;
+    if (!runner || !loader) {
+      queue_.clear();
+      return;
+    }
+    while (prefetching_count_ < max_concurrent_prefetches_ && !queue_.empty()) {
+      std::string uri = std::move(queue_.front());
+      queue_.pop_front();
+      // requested by JS before its turn came, the request loads it
+      if (requested_.Contains(uri)) {
+        continue;
+      }
+      ++prefetching_count_;
+      uris.push_back(std::move(uri));
+    }
+  }
+
+  std::weak_ptr<ModulePrefetcher> weak_self = weak_from_this();
+  for (auto& uri : uris) {
+    TDF_BASE_DLOG(INFO) << "ModulePrefetcher prefetch uri = " << uri;
+    auto task = std::make_unique<CommonTask>();
+    task->func_ = [weak_self, loader, uri = std::move(uri)] {
+      auto uri_view = StringViewUtils::ConstCharPointerToStrView(uri.c_str(), uri.length());
+      ModuleCache::GetInstance().Load(uri_view, loader, [weak_self, uri](ModuleCache::Module module) {
+        auto self = weak_self.lock();
+        if (self) {
+          self->OnPrefetched(uri, std::move(module));
+        }
+      });
+    };
+    runner->PostTask(std::move(task));
+  }
+}
+
+void ModulePrefetcher::OnPrefetched(const std::string& uri, ModuleCache::Module module) {
+  std::shared_ptr<Scope> scope;
+  std::shared_ptr<JavaScriptTaskRunner> js_runner;
+  bool is_precompile_enabled;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    --prefetching_count_;
+    scope = weak_scope_.lock();
+    js_runner = js_runner_.lock();
+    is_precompile_enabled = is_precompile_enabled_;
+  }
+  Pump();
+#ifdef JS_V8
+  if (!is_precompile_enabled || !module.source || module.code_cache || !scope || !js_runner) {
+    return;
+  }
+  std::weak_ptr<ModulePrefetcher> weak_self = weak_from_this();
+  std::weak_ptr<Scope> weak_scope = scope;
+  auto task = std::make_shared<JavaScriptTask>();
+  task->callback = [weak_self, weak_scope, uri, module = std::move(module)] {
+    auto self = weak_self.lock();
+    auto scope = weak_scope.lock();
+    if (!self || !scope) {
+      return;
+    }
+    self->Precompile(uri, module, scope);
+  };
+  js_runner->PostTask(std::move(task), Task::Priority::kIdle);
+#endif
+}
+
+void ModulePrefetcher::Precompile(const std::string& uri,
+                                  const ModuleCache::Module& module,
+                                  const std::shared_ptr<Scope>& scope) {
+#ifdef JS_V8
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    // running it already created the code cache
+    if (requested_.Contains(uri)) {
+      return;
+    }
+  }
+  auto ctx = std::static_pointer_cast<hippy::napi::V8Ctx>(scope->GetContext());
+  if (!ctx) {
+    return;
+  }
+  size_t pos = uri.find_last_of('/');
+  std::string file_name = pos == std::string::npos ? uri : uri.substr(pos + 1);
+  unicode_string_view cache;
+  if (!ctx->CreateCodeCache(unicode_string_view(*module.source),
+                            StringViewUtils::ConstCharPointerToStrView(file_name.c_str(), file_name.length()),
+                            &cache)) {
+    return;
+  }
+  ModuleCache::GetInstance().PutCodeCache(StringViewUtils::ConstCharPointerToStrView(uri.c_str(), uri.length()),
+                                          module.hash, cache.utf8_value());
+  std::lock_guard<std::mutex> lock(mutex_);
+  ++stats_.precompile_count;
+#endif
+}
@@ -97,7 +97,10 @@ std::shared_ptr<hippy::napi::CtxValue> TimerModule::Start(
       static_cast<hippy::base::TaskRunner::DelayedTimeInMs>(
           std::max(.0, number));
 
-  std::shared_ptr<JavaScriptTask> task = std::make_shared<JavaScriptTask>();
+  std::shared_ptr<JavaScriptTaskRunner> runner = scope->GetTaskRunner();
+  std::shared_ptr<JavaScriptTask> task =
+      runner ? runner->NewTask<JavaScriptTask>() : std::make_shared<JavaScriptTask>();
+  task->priority_ = hippy::base::Task::Priority::kTimer;
   std::weak_ptr<JavaScriptTask> weak_task = task;
   std::weak_ptr<Scope> weak_scope = scope;
   std::shared_ptr<TaskEntry> entry = std::make_shared<TaskEntry>(function, task);
@@ -138,7 +141,6 @@ std::shared_ptr<hippy::napi::CtxValue> TimerModule::Start(
     }
   };
 
-  std::shared_ptr<JavaScriptTaskRunner> runner = scope->GetTaskRunner();
   if (runner) {
     runner->PostDelayedTask(task, interval);
   }
@@ -173,25 +175,25 @@ std::shared_ptr<CtxValue> TimerModule::BindFunction(std::shared_ptr<Scope> scope
   auto context = scope->GetContext();
   auto object = context->CreateObject();
 
-  auto key = context->CreateString("SetTimeout");
+  auto key = context->GetPropertyKey("SetTimeout");
   auto wrapper = std::make_unique<hippy::napi::FuncWrapper>(InvokeTimerModuleSetTimeout,nullptr);
   auto value = context->CreateFunction(wrapper);
   scope->SaveFuncWrapper(std::move(wrapper));
   context->SetProperty(object, key, value);
 
-  key = context->CreateString("ClearTimeout");
+  key = context->GetPropertyKey("ClearTimeout");
   wrapper = std::make_unique<hippy::napi::FuncWrapper>(InvokeTimerModuleClearTimeout,nullptr);
   value = context->CreateFunction(wrapper);
   scope->SaveFuncWrapper(std::move(wrapper));
   context->SetProperty(object, key, value);
 
-  key = context->CreateString("SetInterval");
+  key = context->GetPropertyKey("SetInterval");
   wrapper = std::make_unique<hippy::napi::FuncWrapper>(InvokeTimerModuleSetInterval,nullptr);
   value = context->CreateFunction(wrapper);
   scope->SaveFuncWrapper(std::move(wrapper));
   context->SetProperty(object, key, value);
 
-  key = context->CreateString("ClearInterval");
+  key = context->GetPropertyKey("ClearInterval");
   wrapper = std::make_unique<hippy::napi::FuncWrapper>(InvokeTimerModuleClearInterval,nullptr);
   value = context->CreateFunction(wrapper);
   scope->SaveFuncWrapper(std::move(wrapper));
@@ -412,6 +412,16 @@ std::shared_ptr<CtxValue> JSCCtx::CreateString(
   return std::make_shared<JSCCtxValue>(context_, value);
 }
 
+PropertyKey JSCCtx::GetPropertyKey(const unicode_string_view& name) {
+  auto it = property_key_map_.find(name);
+  if (it != property_key_map_.end()) {
+    return it->second;
+  }
+  auto key = CreateString(name);
+  property_key_map_[name] = key;
+  return key;
+}
+
 std::shared_ptr<CtxValue> JSCCtx::CreateUndefined() {
   JSValueRef value = JSValueMakeUndefined(context_);
   return std::make_shared<JSCCtxValue>(context_, value);
@@ -833,7 +843,7 @@ std::shared_ptr<JSValueWrapper> JSCCtx::ToJsValueWrapper(
           JSObjectGetPropertyAtIndex(context_, array_ref, i, nullptr);
       std::shared_ptr<JSValueWrapper> value_obj =
           ToJsValueWrapper(std::make_shared<JSCCtxValue>(context_, element));
-      ret.push_back(*value_obj);
+      ret.push_back(std::move(*value_obj));
     }
     return std::make_shared<JSValueWrapper>(std::move(ret));
   } else if (JSValueIsObject(context_, value_ref)) {
@@ -854,10 +864,10 @@ std::shared_ptr<JSValueWrapper> JSCCtx::ToJsValueWrapper(
           std::make_shared<JSCCtxValue>(context_, props_value);
       std::shared_ptr<JSValueWrapper> value_obj =
           ToJsValueWrapper(props_value_obj);
-      ret[key_obj] = *value_obj;
+      ret[key_obj] = std::move(*value_obj);
     }
     JSPropertyNameArrayRelease(name_arry);
-    return std::make_shared<JSValueWrapper>(ret);
+    return std::make_shared<JSValueWrapper>(std::move(ret));
   }
 
   TDF_BASE_UNIMPLEMENTED();
@@ -882,7 +892,7 @@ std::shared_ptr<CtxValue> JSCCtx::CreateCtxValue(
   } else if (wrapper->IsBoolean()) {
     return CreateBoolean(wrapper->DoubleValue());
   } else if (wrapper->IsArray()) {
-    auto arr = wrapper->ArrayValue();
+    const auto& arr = wrapper->ArrayValue();
     std::shared_ptr<CtxValue> args[arr.size()];
     for (auto i = 0; i < arr.size(); ++i) {
       args[i] = CreateCtxValue(std::make_shared<JSValueWrapper>(arr[i]));
@@ -894,10 +904,10 @@ std::shared_ptr<CtxValue> JSCCtx::CreateCtxValue(
     JSObjectRef obj_ref = JSObjectMake(context_, cls_ref, nullptr);
     JSClassRelease(cls_ref);
 
-    auto obj = wrapper->ObjectValue();
+    const auto& obj = wrapper->ObjectValue();
     for (const auto& p : obj) {
-      auto obj_key = p.first;
-      auto obj_value = p.second;
+      const auto& obj_key = p.first;
+      const auto& obj_value = p.second;
       JSStringRef prop_key = JSStringCreateWithUTF8CString(obj_key.c_str());
       std::shared_ptr<JSCCtxValue> ctx_value =
           std::static_pointer_cast<JSCCtxValue>(
@@ -22,8 +22,11 @@
 
 #include "core/napi/v8/v8_ctx.h"
 
+#include <chrono>
+
 #include "base/unicode_string_view.h"
 #include "core/base/string_view_utils.h"
+#include "core/base/trace_event.h"
 #include "core/napi/v8/v8_ctx_value.h"
 #include "core/napi/v8/v8_try_catch.h"
 #include "core/scope.h"
@@ -49,10 +52,12 @@ void InvokePropertyCallback(v8::Local<v8::Name> property, const v8::PropertyCall
   auto context = isolate->GetCurrentContext();
   v8::Context::Scope context_scope(context);
 
+  // receiver and arguments stay local handles unless a module keeps them beyond this callback
+  V8LocalValueScope local_values(isolate, 2);
   CallbackInfo cb_info;
   cb_info.SetSlot(context->GetAlignedPointerFromEmbedderData(kScopeWrapperIndex));
-  cb_info.SetReceiver(std::make_shared<V8CtxValue>(isolate, info.This()));
-  auto name = std::make_shared<V8CtxValue>(isolate, property);
+  cb_info.SetReceiver(local_values.Create(info.This()));
+  auto name = local_values.Create(property);
   cb_info.AddValue(name);
   auto data = info.Data().As<v8::External>();
   TDF_BASE_CHECK(!data.IsEmpty());
@@ -61,8 +66,7 @@ void InvokePropertyCallback(v8::Local<v8::Name> property, const v8::PropertyCall
   (func_wrapper->cb)(cb_info, func_wrapper->data);
   auto exception = std::static_pointer_cast<V8CtxValue>(cb_info.GetExceptionValue()->Get());
   if (exception) {
-    const auto& global_value = exception->global_value_;
-    auto handle_value = v8::Local<v8::Value>::New(isolate, global_value);
+    auto handle_value = exception->Get(isolate);
     isolate->ThrowException(handle_value);
     info.GetReturnValue().SetUndefined();
     return;
@@ -74,7 +78,7 @@ void InvokePropertyCallback(v8::Local<v8::Name> property, const v8::PropertyCall
     return;
   }
 
-  info.GetReturnValue().Set(ret_value->global_value_);
+  info.GetReturnValue().Set(ret_value->Get(isolate));
 }
 
 static void InvokeJsCallback(const v8::FunctionCallbackInfo<v8::Value>& info) {
@@ -83,11 +87,13 @@ static void InvokeJsCallback(const v8::FunctionCallbackInfo<v8::Value>& info) {
   auto context = isolate->GetCurrentContext();
   v8::Context::Scope context_scope(context);
 
+  // receiver and arguments stay local handles unless a module keeps them beyond this callback
+  V8LocalValueScope local_values(isolate, static_cast<size_t>(info.Length()) + 1);
   CallbackInfo cb_info;
   cb_info.SetSlot(context->GetAlignedPointerFromEmbedderData(kScopeWrapperIndex));
-  cb_info.SetReceiver(std::make_shared<V8CtxValue>(isolate, info.This()));
+  cb_info.SetReceiver(local_values.Create(info.This()));
   for (int i = 0; i < info.Length(); i++) {
-    cb_info.AddValue(std::make_shared<V8CtxValue>(isolate, info[i]));
+    cb_info.AddValue(local_values.Create(info[i]));
   }
   auto data = info.Data().As<v8::External>();
   TDF_BASE_CHECK(!data.IsEmpty());
@@ -96,8 +102,7 @@ static void InvokeJsCallback(const v8::FunctionCallbackInfo<v8::Value>& info) {
   js_cb(cb_info, js_cb_address);
   auto exception = std::static_pointer_cast<V8CtxValue>(cb_info.GetExceptionValue()->Get());
   if (exception) {
-    const auto& global_value = exception->global_value_;
-    auto handle_value = v8::Local<v8::Value>::New(isolate, global_value);
+    auto handle_value = exception->Get(isolate);
     isolate->ThrowException(handle_value);
     info.GetReturnValue().SetUndefined();
     return;
@@ -109,7 +114,7 @@ static void InvokeJsCallback(const v8::FunctionCallbackInfo<v8::Value>& info) {
     return;
   }
 
-  info.GetReturnValue().Set(ret_value->global_value_);
+  info.GetReturnValue().Set(ret_value->Get(isolate));
 }
 
 v8::Local<v8::FunctionTemplate> V8Ctx::CreateTemplate(const std::unique_ptr<FuncWrapper>& wrapper) const {
@@ -283,7 +288,7 @@ std::string V8Ctx::GetSerializationBuffer(const std::shared_ptr<CtxValue>& value
   v8::Local<v8::Context> context = context_persistent_.Get(isolate_);
   v8::Context::Scope context_scope(context);
   std::shared_ptr<V8CtxValue> ctx_value = std::static_pointer_cast<V8CtxValue>(value);
-  v8::Local<v8::Value> handle_value = v8::Local<v8::Value>::New(isolate_, ctx_value->global_value_);
+  v8::Local<v8::Value> handle_value = ctx_value->Get(isolate_);
 
   Serializer serializer(isolate_, context, reused_buffer);
   serializer.WriteHeader();
@@ -321,10 +326,10 @@ std::shared_ptr<CtxValue> V8Ctx::GetProperty(
   v8::Context::Scope context_scope(context);
 
   auto v8_object = std::static_pointer_cast<V8CtxValue>(object);
-  auto v8_object_handle = v8::Local<v8::Value>::New(isolate_, v8_object->global_value_);
+  auto v8_object_handle = v8_object->Get(isolate_);
 
   auto v8_key = std::static_pointer_cast<V8CtxValue>(key);
-  auto v8_key_handle = v8::Local<v8::Value>::New(isolate_, v8_key->global_value_);
+  auto v8_key_handle = v8_key->Get(isolate_);
 
   auto value = v8::Local<v8::Object>::Cast(v8_object_handle)->Get(context, v8_key_handle).ToLocalChecked();
   return std::make_shared<V8CtxValue>(isolate_, value);
@@ -378,14 +383,11 @@ std::shared_ptr<CtxValue> V8Ctx::RunScript(const unicode_string_view& str_view,
       break;
     }
     case unicode_string_view::Encoding::Utf32: {
-      const std::u32string& str = str_view.utf32_value();
-      std::wstring_convert<std::codecvt_utf8<char32_t>, char32_t> convert;
-      std::string bytes = convert.to_bytes(str);
-      std::u16string two_byte(reinterpret_cast<const char16_t*>(bytes.c_str()),
-                              bytes.length() / sizeof(char16_t));
+      std::u16string two_byte = StringViewUtils::Convert(
+          str_view, unicode_string_view::Encoding::Utf16).utf16_value();
       source = v8::String::NewFromTwoByte(
-          isolate_, reinterpret_cast<const uint16_t*>(str.c_str()),
-          v8::NewStringType::kNormal, hippy::base::checked_numeric_cast<size_t, int>(str.length()));
+          isolate_, reinterpret_cast<const uint16_t*>(two_byte.c_str()),
+          v8::NewStringType::kNormal, hippy::base::checked_numeric_cast<size_t, int>(two_byte.length()));
       break;
     }
     case unicode_string_view::Encoding::Utf8: {
@@ -415,25 +417,41 @@ void V8Ctx::SetDefaultContext(const std::shared_ptr<v8::SnapshotCreator>& creato
   creator->SetDefaultContext(context);
 }
 
-std::shared_ptr<CtxValue> V8Ctx::InternalRunScript(
-    v8::Local<v8::Context> context,
-    v8::Local<v8::String> source,
-    const unicode_string_view& file_name,
-    bool is_use_code_cache,
-    unicode_string_view* cache) {
+size_t V8Ctx::AddContext(const std::shared_ptr<v8::SnapshotCreator>& creator) {
+  TDF_BASE_CHECK(creator);
+  v8::HandleScope handle_scope(isolate_);
+  auto context = context_persistent_.Get(isolate_);
+  return creator->AddContext(context);
+}
+
+v8::ScriptOrigin V8Ctx::CreateScriptOrigin(const unicode_string_view& file_name) {
   v8::Local<v8::String> v8_file_name = CreateV8String(file_name);
 #if (V8_MAJOR_VERSION == 8 && V8_MINOR_VERSION == 9 && \
      V8_BUILD_NUMBER >= 45) ||                         \
     (V8_MAJOR_VERSION == 8 && V8_MINOR_VERSION > 9) || (V8_MAJOR_VERSION > 8)
-  v8::ScriptOrigin origin(isolate_, v8_file_name);
+  return v8::ScriptOrigin(isolate_, v8_file_name);
 #else
-  v8::ScriptOrigin origin(v8_file_name);
+  return v8::ScriptOrigin(v8_file_name);
 #endif
+}
+
+std::shared_ptr<CtxValue> V8Ctx::InternalRunScript(
+    v8::Local<v8::Context> context,
+    v8::Local<v8::String> source,
+    const unicode_string_view& file_name,
+    bool is_use_code_cache,
+    unicode_string_view* cache) {
+  // compiling takes what the nested run span leaves
+  HIPPY_TRACE_EVENT("v8", "V8Ctx::RunScript");
+  v8::ScriptOrigin origin = CreateScriptOrigin(file_name);
   v8::MaybeLocal<v8::Script> script;
+  CodeCacheInfo info;
+  auto compile_begin = std::chrono::steady_clock::now();
   if (is_use_code_cache && cache && !StringViewUtils::IsEmpty(*cache)) {
     unicode_string_view::Encoding encoding = cache->encoding();
     if (encoding == unicode_string_view::Encoding::Utf8) {
       const unicode_string_view::u8string& str = cache->utf8_value();
+      // owned by script_source
       auto* cached_data =
           new v8::ScriptCompiler::CachedData(
               str.c_str(), hippy::base::checked_numeric_cast<size_t, int>(str.length()),
@@ -441,6 +459,8 @@ std::shared_ptr<CtxValue> V8Ctx::InternalRunScript(
       v8::ScriptCompiler::Source script_source(source, origin, cached_data);
       script = v8::ScriptCompiler::Compile(
           context, &script_source, v8::ScriptCompiler::kConsumeCodeCache);
+      info.is_cache_consumed = !cached_data->rejected;
+      info.cache_size = str.length();
     } else {
       TDF_BASE_UNREACHABLE();
     }
@@ -451,12 +471,13 @@ std::shared_ptr<CtxValue> V8Ctx::InternalRunScript(
       if (script.IsEmpty()) {
         return nullptr;
       }
-      const v8::ScriptCompiler::CachedData* cached_data =
+      std::unique_ptr<v8::ScriptCompiler::CachedData> cached_data(
           v8::ScriptCompiler::CreateCodeCache(
-              script.ToLocalChecked()->GetUnboundScript());
+              script.ToLocalChecked()->GetUnboundScript()));
       *cache = unicode_string_view(cached_data->data,
                                    hippy::base::checked_numeric_cast<int,
                                                                      size_t>(cached_data->length));
+      info.cache_size = hippy::base::checked_numeric_cast<int, size_t>(cached_data->length);
     } else {
       script = v8::Script::Compile(context, source, &origin);
     }
@@ -466,6 +487,29 @@ std::shared_ptr<CtxValue> V8Ctx::InternalRunScript(
     return nullptr;
   }
 
+  if (is_use_code_cache && cache) {
+    info.compile_time_in_us = hippy::base::checked_numeric_cast<int64_t, uint64_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - compile_begin).count());
+    auto it = code_cache_map_.find(file_name);
+    if (it == code_cache_map_.end()) {
+      if (code_cache_map_.size() >= kMaxCodeCacheEntryCount) {
+        code_cache_map_.erase(code_cache_order_.front());
+        code_cache_order_.pop_front();
+      }
+      code_cache_order_.push_back(file_name);
+      it = code_cache_map_.emplace(file_name, CodeCacheEntry()).first;
+    }
+    auto& entry = it->second;
+    entry.info = info;
+    if (info.is_cache_consumed) {
+      entry.script.Reset();
+    } else {
+      entry.script.Reset(isolate_, script.ToLocalChecked()->GetUnboundScript());
+    }
+  }
+
+  HIPPY_TRACE_EVENT("v8", "V8Ctx::RunTopLevel");
   v8::MaybeLocal<v8::Value> v8_maybe_value = script.ToLocalChecked()->Run(context);
   if (v8_maybe_value.IsEmpty()) {
     return nullptr;
@@ -474,14 +518,84 @@ std::shared_ptr<CtxValue> V8Ctx::InternalRunScript(
   return std::make_shared<V8CtxValue>(isolate_, v8_value);
 }
 
+bool V8Ctx::CreateWarmCodeCache(const unicode_string_view& file_name, unicode_string_view* cache) {
+  auto it = code_cache_map_.find(file_name);
+  if (it == code_cache_map_.end() || it->second.script.IsEmpty()) {
+    return false;
+  }
+  v8::HandleScope handle_scope(isolate_);
+  std::unique_ptr<v8::ScriptCompiler::CachedData> cached_data(
+      v8::ScriptCompiler::CreateCodeCache(it->second.script.Get(isolate_)));
+  it->second.script.Reset();
+  if (!cached_data) {
+    return false;
+  }
+  *cache = unicode_string_view(cached_data->data,
+                               hippy::base::checked_numeric_cast<int, size_t>(cached_data->length));
+  it->second.info.warm_cache_size = hippy::base::checked_numeric_cast<int, size_t>(cached_data->length);
+  return true;
+}
+
+bool V8Ctx::GetCodeCacheInfo(const unicode_string_view& file_name, CodeCacheInfo& info) {
+  auto it = code_cache_map_.find(file_name);
+  if (it == code_cache_map_.end()) {
+    return false;
+  }
+  info = it->second.info;
+  return true;
+}
+
+size_t V8Ctx::PurgeCodeCache() {
+  v8::HeapStatistics before;
+  isolate_->GetHeapStatistics(&before);
+  size_t count = 0;
+  for (auto& item : code_cache_map_) {
+    if (!item.second.script.IsEmpty()) {
+      item.second.script.Reset();
+      ++count;
+    }
+  }
+  if (!count) {
+    return 0;
+  }
+  isolate_->LowMemoryNotification();
+  v8::HeapStatistics after;
+  isolate_->GetHeapStatistics(&after);
+  TDF_BASE_DLOG(INFO) << "PurgeCodeCache count = " << count;
+  return before.used_heap_size() > after.used_heap_size() ? before.used_heap_size() - after.used_heap_size() : 0;
+}
+
+bool V8Ctx::CreateCodeCache(const unicode_string_view& data,
+                            const unicode_string_view& file_name,
+                            unicode_string_view* cache) {
+  v8::HandleScope handle_scope(isolate_);
+  v8::Local<v8::Context> context = context_persistent_.Get(isolate_);
+  v8::Context::Scope context_scope(context);
+  // a script that does not compile reports its error when it is run
+  v8::TryCatch try_catch(isolate_);
+  v8::ScriptCompiler::Source script_source(CreateV8String(data), CreateScriptOrigin(file_name));
+  v8::MaybeLocal<v8::UnboundScript> script =
+      v8::ScriptCompiler::CompileUnboundScript(isolate_, &script_source);
+  if (script.IsEmpty()) {
+    return false;
+  }
+  std::unique_ptr<v8::ScriptCompiler::CachedData> cached_data(
+      v8::ScriptCompiler::CreateCodeCache(script.ToLocalChecked()));
+  if (!cached_data) {
+    return false;
+  }
+  *cache = unicode_string_view(cached_data->data,
+                               hippy::base::checked_numeric_cast<int, size_t>(cached_data->length));
+  return true;
+}
+
 void V8Ctx::ThrowException(const std::shared_ptr<CtxValue> &exception) {
   std::shared_ptr<V8CtxValue> ctx_value = std::static_pointer_cast<V8CtxValue>(exception);
   v8::HandleScope handle_scope(isolate_);
   v8::Local<v8::Context> context = context_persistent_.Get(isolate_);
   v8::Context::Scope context_scope(context);
 
-  const v8::Global<v8::Value>& global_value = ctx_value->global_value_;
-  v8::Local<v8::Value> handle_value = v8::Local<v8::Value>::New(isolate_, global_value);
+  v8::Local<v8::Value> handle_value = ctx_value->Get(isolate_);
   isolate_->ThrowException(handle_value);
 }
 
@@ -492,7 +606,7 @@ void V8Ctx::ThrowException(const unicode_string_view &exception) {
 void V8Ctx::HandleUncaughtException(const std::shared_ptr<CtxValue>& exception) {
   auto global_object = GetGlobalObject();
   unicode_string_view error_handle_name(kHippyErrorHandlerName);
-  auto error_handle_key = CreateString(error_handle_name);
+  auto error_handle_key = GetPropertyKey(error_handle_name);
   auto exception_handler = GetProperty(global_object, error_handle_key);
   if (!IsFunction(exception_handler)) {
     const auto& source_code = hippy::GetNativeSourceCode(kErrorHandlerJSName);
@@ -537,7 +651,7 @@ std::shared_ptr<CtxValue> V8Ctx::CallFunction(
   std::shared_ptr<V8CtxValue> ctx_value =
       std::static_pointer_cast<V8CtxValue>(function);
   v8::Local<v8::Value> handle_value =
-      v8::Local<v8::Value>::New(isolate_, ctx_value->global_value_);
+      ctx_value->Get(isolate_);
   if (!handle_value->IsFunction()) {
     TDF_BASE_LOG(WARNING) << "CallFunction handle_value is not a function";
     return nullptr;
@@ -549,7 +663,7 @@ std::shared_ptr<CtxValue> V8Ctx::CallFunction(
     std::shared_ptr<V8CtxValue> argument =
         std::static_pointer_cast<V8CtxValue>(arguments[i]);
     if (argument) {
-      args[i] = v8::Local<v8::Value>::New(isolate_, argument->global_value_);
+      args[i] = argument->Get(isolate_);
     } else {
       TDF_BASE_LOG(WARNING) << "CallFunction argument error, i = " << i;
       return nullptr;
@@ -597,6 +711,22 @@ std::shared_ptr<CtxValue> V8Ctx::CreateString(
   return std::make_shared<V8CtxValue>(isolate_, v8_string);
 }
 
+PropertyKey V8Ctx::GetPropertyKey(const unicode_string_view& name) {
+  auto it = property_key_map_.find(name);
+  if (it != property_key_map_.end()) {
+    return it->second;
+  }
+  if (name.encoding() == unicode_string_view::Encoding::Unknown) {
+    return nullptr;
+  }
+  v8::HandleScope handle_scope(isolate_);
+
+  v8::Local<v8::String> v8_string = CreateV8String(name, v8::NewStringType::kInternalized);
+  auto key = std::make_shared<V8CtxValue>(isolate_, v8_string);
+  property_key_map_[name] = key;
+  return key;
+}
+
 std::shared_ptr<CtxValue> V8Ctx::CreateUndefined() {
   v8::HandleScope isolate_scope(isolate_);
 
@@ -618,8 +748,9 @@ std::shared_ptr<CtxValue> V8Ctx::CreateNull() {
 }
 
 v8::Local<v8::String> V8Ctx::CreateV8String(
-    const unicode_string_view& str_view) const {
-  return V8VM::CreateV8String(isolate_, str_view);
+    const unicode_string_view& str_view,
+    v8::NewStringType type) const {
+  return V8VM::CreateV8String(isolate_, str_view, type);
 }
 
 std::shared_ptr<JSValueWrapper> V8Ctx::ToJsValueWrapper(
@@ -629,44 +760,47 @@ std::shared_ptr<JSValueWrapper> V8Ctx::ToJsValueWrapper(
   v8::Context::Scope context_scope(context);
   std::shared_ptr<V8CtxValue> ctx_value =
       std::static_pointer_cast<V8CtxValue>(value);
-  const v8::Global<v8::Value>& global_value = ctx_value->global_value_;
-  v8::Local<v8::Value> handle_value =
-      v8::Local<v8::Value>::New(isolate_, global_value);
+  auto result = std::make_shared<JSValueWrapper>();
+  if (!ToJsValueWrapper(context, ctx_value->Get(isolate_), *result)) {
+    return nullptr;
+  }
+  return result;
+}
+
+// Converts in a single pass over the v8 handles: children are built in place and moved into
+// their parent, no intermediate CtxValue or shared_ptr is created per element.
+bool V8Ctx::ToJsValueWrapper(const v8::Local<v8::Context>& context,
+                             const v8::Local<v8::Value>& handle_value,
+                             JSValueWrapper& result) {
   if (handle_value->IsUndefined()) {
-    return std::make_shared<JSValueWrapper>(JSValueWrapper::Undefined());
+    result = JSValueWrapper::Undefined();
+    return true;
   } else if (handle_value->IsNull()) {
-    return std::make_shared<JSValueWrapper>(JSValueWrapper::Null());
+    result = JSValueWrapper::Null();
+    return true;
   } else if (handle_value->IsBoolean()) {
-    bool v8_value = handle_value->ToBoolean(isolate_)->Value();
-    return std::make_shared<JSValueWrapper>(v8_value);
+    result = handle_value->ToBoolean(isolate_)->Value();
+    return true;
   } else if (handle_value->IsString()) {
-    return std::make_shared<JSValueWrapper>(
-        *v8::String::Utf8Value(isolate_, handle_value));
+    v8::String::Utf8Value utf8_value(isolate_, handle_value);
+    result = JSValueWrapper(*utf8_value, static_cast<size_t>(utf8_value.length()));
+    return true;
   } else if (handle_value->IsNumber()) {
-    double v8_value = handle_value->ToNumber(context).ToLocalChecked()->Value();
-    return std::make_shared<JSValueWrapper>(v8_value);
+    result = handle_value->ToNumber(context).ToLocalChecked()->Value();
+    return true;
   } else if (handle_value->IsArray()) {
-    v8::Local<v8::Object> v8_value =
-        handle_value->ToObject(context).ToLocalChecked();
-    // v8::NewStringType::kInternalized
-    v8::Local<v8::Array>::Cast(handle_value);
-    v8::Local<v8::String> len_str =
-        v8::String::NewFromOneByte(isolate_,
-                                   reinterpret_cast<const uint8_t*>("length"),
-                                   v8::NewStringType::kInternalized)
-            .ToLocalChecked();
-    uint32_t len = v8_value->Get(context, len_str)
-        .ToLocalChecked()
-        ->Uint32Value(context)
-        .FromMaybe(0);
-    JSValueWrapper::JSArrayType ret;
+    auto v8_array = v8::Local<v8::Array>::Cast(handle_value);
+    uint32_t len = v8_array->Length();
+    JSValueWrapper::JSArrayType ret(len);
     for (uint32_t i = 0; i < len; i++) {
-      v8::Local<v8::Value> element = v8_value->Get(context, i).ToLocalChecked();
-      std::shared_ptr<JSValueWrapper> value_obj =
-          ToJsValueWrapper(std::make_shared<V8CtxValue>(isolate_, element));
-      ret.push_back(*value_obj);
+      v8::Local<v8::Value> element;
+      if (!v8_array->Get(context, i).ToLocal(&element) ||
+          !ToJsValueWrapper(context, element, ret[i])) {
+        return false;
+      }
     }
-    return std::make_shared<JSValueWrapper>(std::move(ret));
+    result = JSValueWrapper(std::move(ret));
+    return true;
   } else if (handle_value->IsObject()) {
     v8::Local<v8::Object> v8_value =
         handle_value->ToObject(context).ToLocalChecked();
@@ -675,86 +809,97 @@ std::shared_ptr<JSValueWrapper> V8Ctx::ToJsValueWrapper(
         v8_value->GetOwnPropertyNames(context);
     if (!maybe_props.IsEmpty()) {
       v8::Local<v8::Array> props = maybe_props.ToLocalChecked();
-      for (uint32_t i = 0; i < props->Length(); i++) {
+      uint32_t len = props->Length();
+      ret.reserve(len);
+      for (uint32_t i = 0; i < len; i++) {
         v8::Local<v8::Value> props_key =
             props->Get(context, i).ToLocalChecked();
-        v8::Local<v8::Value> props_value =
-            v8_value->Get(context, props_key).ToLocalChecked();
-
-        std::string key_obj;
-        if (props_key->IsString()) {
-          key_obj = *v8::String::Utf8Value(isolate_, props_key);
-        } else {
+        if (!props_key->IsString()) {
           TDF_BASE_LOG(ERROR)
               << "ToJsValueWrapper parse v8::Object err, props_key illegal";
-          return nullptr;
+          return false;
+        }
+        v8::Local<v8::Value> props_value =
+            v8_value->Get(context, props_key).ToLocalChecked();
+        v8::String::Utf8Value key_obj(isolate_, props_key);
+        auto& value_obj = ret[std::string(*key_obj, static_cast<size_t>(key_obj.length()))];
+        if (!ToJsValueWrapper(context, props_value, value_obj)) {
+          return false;
         }
-
-        std::shared_ptr<JSValueWrapper> value_obj = ToJsValueWrapper(
-            std::make_shared<V8CtxValue>(isolate_, props_value));
-        ret[key_obj] = *value_obj;
       }
     }
-    return std::make_shared<JSValueWrapper>(std::move(ret));
+    result = JSValueWrapper(std::move(ret));
+    return true;
   }
 
   // TDF_BASE_UNIMPLEMENTED();
-  return nullptr;
+  return false;
 }
 
 std::shared_ptr<CtxValue> V8Ctx::CreateCtxValue(
     const std::shared_ptr<JSValueWrapper>& wrapper) {
   TDF_BASE_DCHECK(wrapper);
-  if (wrapper->IsUndefined()) {
-    return CreateUndefined();
-  } else if (wrapper->IsNull()) {
-    return CreateNull();
-  } else if (wrapper->IsString()) {
-    std::string str = wrapper->StringValue();
+  v8::HandleScope handle_scope(isolate_);
+  v8::Local<v8::Context> context = context_persistent_.Get(isolate_);
+  v8::Context::Scope context_scope(context);
+
+  auto handle_value = CreateV8Value(context, *wrapper);
+  if (handle_value.IsEmpty()) {
+    return nullptr;
+  }
+  return std::make_shared<V8CtxValue>(isolate_, handle_value);
+}
+
+// Must be called inside a HandleScope; builds the whole graph with local handles only.
+v8::Local<v8::Value> V8Ctx::CreateV8Value(const v8::Local<v8::Context>& context,
+                                          const JSValueWrapper& wrapper) {
+  if (wrapper.IsUndefined()) {
+    return v8::Undefined(isolate_);
+  } else if (wrapper.IsNull()) {
+    return v8::Null(isolate_);
+  } else if (wrapper.IsString()) {
+    const std::string& str = wrapper.StringValue();
     unicode_string_view str_view(StringViewUtils::ToU8Pointer(str.c_str()),
                                  str.length());
-    return CreateString(str_view);
-  } else if (wrapper->IsInt32()) {
-    return CreateNumber(wrapper->Int32Value());
-  } else if (wrapper->IsDouble()) {
-    return CreateNumber(wrapper->DoubleValue());
-  } else if (wrapper->IsBoolean()) {
-    return CreateBoolean(wrapper->BooleanValue());
-  } else if (wrapper->IsArray()) {
-    auto arr = wrapper->ArrayValue();
-    std::shared_ptr<CtxValue> args[arr.size()];
+    return CreateV8String(str_view);
+  } else if (wrapper.IsInt32()) {
+    return v8::Int32::New(isolate_, wrapper.Int32Value());
+  } else if (wrapper.IsUInt32()) {
+    return v8::Integer::NewFromUnsigned(isolate_, wrapper.UInt32Value());
+  } else if (wrapper.IsDouble()) {
+    return v8::Number::New(isolate_, wrapper.DoubleValue());
+  } else if (wrapper.IsBoolean()) {
+    return v8::Boolean::New(isolate_, wrapper.BooleanValue());
+  } else if (wrapper.IsArray()) {
+    const auto& arr = wrapper.ArrayValue();
+    auto v8_array = v8::Array::New(isolate_, hippy::base::checked_numeric_cast<size_t, int>(arr.size()));
     for (size_t i = 0; i < arr.size(); ++i) {
-      args[i] = CreateCtxValue(std::make_shared<JSValueWrapper>(arr[i]));
+      auto element = CreateV8Value(context, arr[i]);
+      if (element.IsEmpty()) {
+        return v8::Local<v8::Value>();
+      }
+      v8_array->Set(context, hippy::base::checked_numeric_cast<size_t, uint32_t>(i), element).ToChecked();
     }
-    return CreateArray(arr.size(), args);
-  } else if (wrapper->IsObject()) {
-    auto obj = wrapper->ObjectValue();
-
-    v8::HandleScope handle_scope(isolate_);
-    v8::Local<v8::Context> context = context_persistent_.Get(isolate_);
-    v8::Context::Scope context_scope(context);
-
+    return v8_array;
+  } else if (wrapper.IsObject()) {
     v8::Local<v8::Object> v8_obj = v8::Object::New(isolate_);
-    for (const auto& p : obj) {
-      auto obj_key = p.first;
-      auto obj_value = p.second;
+    for (const auto& p : wrapper.ObjectValue()) {
+      const auto& obj_key = p.first;
       unicode_string_view obj_key_view(
           StringViewUtils::ToU8Pointer(obj_key.c_str()), obj_key.length());
       v8::Local<v8::String> key = CreateV8String(obj_key_view);
-      std::shared_ptr<V8CtxValue> ctx_value =
-          std::static_pointer_cast<V8CtxValue>(
-              CreateCtxValue(std::make_shared<JSValueWrapper>(obj_value)));
-      const v8::Global<v8::Value>& global_value = ctx_value->global_value_;
-      TDF_BASE_DCHECK(!global_value.IsEmpty());
-      v8::Local<v8::Value> handle_value =
-          v8::Local<v8::Value>::New(isolate_, global_value);
+      auto handle_value = CreateV8Value(context, p.second);
+      TDF_BASE_DCHECK(!handle_value.IsEmpty());
+      if (handle_value.IsEmpty()) {
+        return v8::Local<v8::Value>();
+      }
       v8_obj->Set(context, key, handle_value).ToChecked();
     }
-    return std::make_shared<V8CtxValue>(isolate_, v8_obj);
+    return v8_obj;
   }
 
   TDF_BASE_UNIMPLEMENTED();
-  return nullptr;
+  return v8::Local<v8::Value>();
 }
 
 unicode_string_view V8Ctx::ToStringView(v8::Local<v8::String> str) const {
@@ -782,9 +927,9 @@ std::shared_ptr<CtxValue> V8Ctx::CreateObject(const std::unordered_map<
   v8::Local<v8::Object> obj = v8::Object::New(isolate_);
   for (const auto& it : object) {
     auto key_ctx_value = std::static_pointer_cast<V8CtxValue>(it.first);
-    auto key_handle_value =  v8::Local<v8::Value>::New(isolate_, key_ctx_value->global_value_);
+    auto key_handle_value =  key_ctx_value->Get(isolate_);
     auto value_ctx_value = std::static_pointer_cast<V8CtxValue>(it.second);
-    auto value_handle_value = v8::Local<v8::Value>::New(isolate_, value_ctx_value->global_value_);
+    auto value_handle_value = value_ctx_value->Get(isolate_);
     obj->Set(context, key_handle_value, value_handle_value).ToChecked();
   }
   return std::make_shared<V8CtxValue>(isolate_, obj);
@@ -807,7 +952,7 @@ std::shared_ptr<CtxValue> V8Ctx::CreateArray(
     v8::Local<v8::Value> handle_value;
     std::shared_ptr<V8CtxValue> ctx_value = std::static_pointer_cast<V8CtxValue>(value[i]);
     if (ctx_value) {
-      handle_value = v8::Local<v8::Value>::New(isolate_, ctx_value->global_value_);
+      handle_value = ctx_value->Get(isolate_);
     } else {
       TDF_BASE_LOG(ERROR) << "array item error";
       return nullptr;
@@ -831,9 +976,9 @@ std::shared_ptr<CtxValue> V8Ctx::CreateMap(const std::map<
   v8::Local<v8::Map> js_map = v8::Map::New(isolate_);
   for (auto & it : map) {
     auto key_ctx_value = std::static_pointer_cast<V8CtxValue>(it.first);
-    auto key_handle_value =  v8::Local<v8::Value>::New(isolate_, key_ctx_value->global_value_);
+    auto key_handle_value =  key_ctx_value->Get(isolate_);
     auto value_ctx_value = std::static_pointer_cast<V8CtxValue>(it.second);
-    auto value_handle_value = v8::Local<v8::Value>::New(isolate_, value_ctx_value->global_value_);
+    auto value_handle_value = value_ctx_value->Get(isolate_);
     js_map->Set(context, key_handle_value, value_handle_value).ToLocalChecked();
   }
   return std::make_shared<V8CtxValue>(isolate_, js_map);
@@ -861,7 +1006,7 @@ bool V8Ctx::GetValueNumber(const std::shared_ptr<CtxValue>& value, double* resul
   v8::Local<v8::Context> context = context_persistent_.Get(isolate_);
   v8::Context::Scope context_scope(context);
   std::shared_ptr<V8CtxValue> ctx_value = std::static_pointer_cast<V8CtxValue>(value);
-  v8::Local<v8::Value> handle_value = v8::Local<v8::Value>::New(isolate_, ctx_value->global_value_);
+  v8::Local<v8::Value> handle_value = ctx_value->Get(isolate_);
 
   if (handle_value.IsEmpty() || !handle_value->IsNumber()) {
     return false;
@@ -885,9 +1030,7 @@ bool V8Ctx::GetValueNumber(const std::shared_ptr<CtxValue>& value, int32_t* resu
   v8::Context::Scope context_scope(context);
   std::shared_ptr<V8CtxValue> ctx_value =
       std::static_pointer_cast<V8CtxValue>(value);
-  const v8::Global<v8::Value>& global_value = ctx_value->global_value_;
-  v8::Local<v8::Value> handle_value =
-      v8::Local<v8::Value>::New(isolate_, global_value);
+  v8::Local<v8::Value> handle_value = ctx_value->Get(isolate_);
 
   if (handle_value.IsEmpty() || !handle_value->IsInt32()) {
     return false;
@@ -907,9 +1050,7 @@ bool V8Ctx::GetValueBoolean(const std::shared_ptr<CtxValue>& value, bool* result
   v8::Context::Scope context_scope(context);
   std::shared_ptr<V8CtxValue> ctx_value =
       std::static_pointer_cast<V8CtxValue>(value);
-  const v8::Global<v8::Value>& global_value = ctx_value->global_value_;
-  v8::Local<v8::Value> handle_value =
-      v8::Local<v8::Value>::New(isolate_, global_value);
+  v8::Local<v8::Value> handle_value = ctx_value->Get(isolate_);
 
   if (handle_value.IsEmpty() ||
       (!handle_value->IsBoolean() && !handle_value->IsBooleanObject())) {
@@ -930,8 +1071,7 @@ bool V8Ctx::GetValueString(const std::shared_ptr<CtxValue>& value,
   v8::HandleScope handle_scope(isolate_);
   v8::Local<v8::Context> context = context_persistent_.Get(isolate_);
   v8::Context::Scope context_scope(context);
-  const v8::Global<v8::Value>& global_value = ctx_value->global_value_;
-  v8::Local<v8::Value> handle_value = v8::Local<v8::Value>::New(isolate_, global_value);
+  v8::Local<v8::Value> handle_value = ctx_value->Get(isolate_);
   if (handle_value.IsEmpty()) {
     return false;
   }
@@ -953,9 +1093,7 @@ bool V8Ctx::GetValueJson(const std::shared_ptr<CtxValue>& value,
   v8::Context::Scope context_scope(context);
   std::shared_ptr<V8CtxValue> ctx_value =
       std::static_pointer_cast<V8CtxValue>(value);
-  const v8::Global<v8::Value>& global_value = ctx_value->global_value_;
-  v8::Local<v8::Value> handle_value =
-      v8::Local<v8::Value>::New(isolate_, global_value);
+  v8::Local<v8::Value> handle_value = ctx_value->Get(isolate_);
   if (handle_value.IsEmpty() || !handle_value->IsObject()) {
     return false;
   }
@@ -981,9 +1119,7 @@ bool V8Ctx::IsMap(const std::shared_ptr<CtxValue>& value) {
   v8::Context::Scope context_scope(context);
   std::shared_ptr<V8CtxValue> ctx_value =
       std::static_pointer_cast<V8CtxValue>(value);
-  const v8::Global<v8::Value>& persistent_value = ctx_value->global_value_;
-  v8::Local<v8::Value> handle_value =
-      v8::Local<v8::Value>::New(isolate_, persistent_value);
+  v8::Local<v8::Value> handle_value = ctx_value->Get(isolate_);
 
   if (handle_value.IsEmpty()) {
     return false;
@@ -1001,9 +1137,7 @@ bool V8Ctx::IsNullOrUndefined(const std::shared_ptr<CtxValue>& value) {
   v8::Context::Scope context_scope(context);
   std::shared_ptr<V8CtxValue> ctx_value =
       std::static_pointer_cast<V8CtxValue>(value);
-  const v8::Global<v8::Value>& persistent_value = ctx_value->global_value_;
-  v8::Local<v8::Value> handle_value =
-      v8::Local<v8::Value>::New(isolate_, persistent_value);
+  v8::Local<v8::Value> handle_value = ctx_value->Get(isolate_);
 
   if (handle_value.IsEmpty()) {
     return false;
@@ -1022,9 +1156,7 @@ bool V8Ctx::IsArray(const std::shared_ptr<CtxValue>& value) {
   v8::Context::Scope context_scope(context);
   std::shared_ptr<V8CtxValue> ctx_value =
       std::static_pointer_cast<V8CtxValue>(value);
-  const v8::Global<v8::Value>& global_value = ctx_value->global_value_;
-  v8::Local<v8::Value> handle_value =
-      v8::Local<v8::Value>::New(isolate_, global_value);
+  v8::Local<v8::Value> handle_value = ctx_value->Get(isolate_);
 
   if (handle_value.IsEmpty()) {
     return false;
@@ -1041,9 +1173,7 @@ uint32_t V8Ctx::GetArrayLength(const std::shared_ptr<CtxValue>& value) {
   v8::Context::Scope context_scope(context);
   std::shared_ptr<V8CtxValue> ctx_value =
       std::static_pointer_cast<V8CtxValue>(value);
-  const v8::Global<v8::Value>& global_value = ctx_value->global_value_;
-  v8::Local<v8::Value> handle_value =
-      v8::Local<v8::Value>::New(isolate_, global_value);
+  v8::Local<v8::Value> handle_value = ctx_value->Get(isolate_);
 
   if (handle_value.IsEmpty()) {
     return 0;
@@ -1068,9 +1198,7 @@ std::shared_ptr<CtxValue> V8Ctx::CopyArrayElement(
   v8::Context::Scope context_scope(context);
   std::shared_ptr<V8CtxValue> ctx_value =
       std::static_pointer_cast<V8CtxValue>(value);
-  const v8::Global<v8::Value>& global_value = ctx_value->global_value_;
-  v8::Local<v8::Value> handle_value =
-      v8::Local<v8::Value>::New(isolate_, global_value);
+  v8::Local<v8::Value> handle_value = ctx_value->Get(isolate_);
 
   if (handle_value.IsEmpty()) {
     return nullptr;
@@ -1098,9 +1226,7 @@ size_t V8Ctx::GetMapLength(std::shared_ptr<CtxValue>& value) {
   v8::Context::Scope context_scope(context);
   std::shared_ptr<V8CtxValue> ctx_value =
       std::static_pointer_cast<V8CtxValue>(value);
-  const v8::Global<v8::Value>& persistent_value = ctx_value->global_value_;
-  v8::Local<v8::Value> handle_value =
-      v8::Local<v8::Value>::New(isolate_, persistent_value);
+  v8::Local<v8::Value> handle_value = ctx_value->Get(isolate_);
 
   if (handle_value.IsEmpty()) {
     return 0;
@@ -1124,9 +1250,7 @@ std::shared_ptr<CtxValue> V8Ctx::ConvertMapToArray(
   v8::Context::Scope context_scope(context);
   std::shared_ptr<V8CtxValue> ctx_value =
       std::static_pointer_cast<V8CtxValue>(value);
-  const v8::Global<v8::Value>& persistent_value = ctx_value->global_value_;
-  v8::Local<v8::Value> handle_value =
-      v8::Local<v8::Value>::New(isolate_, persistent_value);
+  v8::Local<v8::Value> handle_value = ctx_value->Get(isolate_);
 
   if (handle_value.IsEmpty()) {
     return nullptr;
@@ -1153,9 +1277,7 @@ bool V8Ctx::HasNamedProperty(const std::shared_ptr<CtxValue>& value,
   v8::Context::Scope context_scope(context);
   std::shared_ptr<V8CtxValue> ctx_value =
       std::static_pointer_cast<V8CtxValue>(value);
-  const v8::Global<v8::Value>& global_value = ctx_value->global_value_;
-  v8::Local<v8::Value> handle_value =
-      v8::Local<v8::Value>::New(isolate_, global_value);
+  v8::Local<v8::Value> handle_value = ctx_value->Get(isolate_);
 
   if (handle_value.IsEmpty()) {
     return false;
@@ -1185,9 +1307,7 @@ std::shared_ptr<CtxValue> V8Ctx::CopyNamedProperty(
   v8::Context::Scope context_scope(context);
   std::shared_ptr<V8CtxValue> ctx_value =
       std::static_pointer_cast<V8CtxValue>(value);
-  const v8::Global<v8::Value>& global_value = ctx_value->global_value_;
-  v8::Local<v8::Value> handle_value =
-      v8::Local<v8::Value>::New(isolate_, global_value);
+  v8::Local<v8::Value> handle_value = ctx_value->Get(isolate_);
 
   if (handle_value.IsEmpty()) {
     return nullptr;
@@ -1222,8 +1342,7 @@ bool V8Ctx::IsString(const std::shared_ptr<CtxValue>& value) {
   v8::Local<v8::Context> context = context_persistent_.Get(isolate_);
   v8::Context::Scope context_scope(context);
 
-  const auto& global_value = ctx_value->global_value_;
-  auto handle_value = v8::Local<v8::Value>::New(isolate_, global_value);
+  auto handle_value = ctx_value->Get(isolate_);
   return handle_value->IsString();
 }
 
@@ -1235,8 +1354,7 @@ bool V8Ctx::IsFunction(const std::shared_ptr<CtxValue>& value) {
   v8::Local<v8::Context> context = context_persistent_.Get(isolate_);
   v8::Context::Scope context_scope(context);
   std::shared_ptr<V8CtxValue> ctx_value = std::static_pointer_cast<V8CtxValue>(value);
-  const v8::Global<v8::Value>& global_value = ctx_value->global_value_;
-  v8::Local<v8::Value> handle_value = v8::Local<v8::Value>::New(isolate_, global_value);
+  v8::Local<v8::Value> handle_value = ctx_value->Get(isolate_);
 
   if (handle_value.IsEmpty()) {
     return false;
@@ -1254,8 +1372,7 @@ bool V8Ctx::IsObject(const std::shared_ptr<CtxValue>& value) {
   v8::Local<v8::Context> context = context_persistent_.Get(isolate_);
   v8::Context::Scope context_scope(context);
   std::shared_ptr<V8CtxValue> ctx_value = std::static_pointer_cast<V8CtxValue>(value);
-  const v8::Global<v8::Value>& global_value = ctx_value->global_value_;
-  v8::Local<v8::Value> handle_value = v8::Local<v8::Value>::New(isolate_, global_value);
+  v8::Local<v8::Value> handle_value = ctx_value->Get(isolate_);
 
   if (handle_value.IsEmpty()) {
     return false;
@@ -1274,9 +1391,7 @@ unicode_string_view V8Ctx::CopyFunctionName(
   v8::Context::Scope context_scope(context);
   std::shared_ptr<V8CtxValue> ctx_value =
       std::static_pointer_cast<V8CtxValue>(function);
-  const v8::Global<v8::Value>& global_value = ctx_value->global_value_;
-  v8::Local<v8::Value> handle_value =
-      v8::Local<v8::Value>::New(isolate_, global_value);
+  v8::Local<v8::Value> handle_value = ctx_value->Get(isolate_);
 
   unicode_string_view result;
   if (handle_value->IsFunction()) {
@@ -1295,11 +1410,11 @@ bool V8Ctx::SetProperty(std::shared_ptr<CtxValue> object,
   auto context = context_persistent_.Get(isolate_);
   v8::Context::Scope context_scope(context);
   auto v8_object = std::static_pointer_cast<V8CtxValue>(object);
-  auto handle_v8_object = v8::Local<v8::Value>::New(isolate_, v8_object->global_value_);
+  auto handle_v8_object = v8_object->Get(isolate_);
   auto v8_key = std::static_pointer_cast<V8CtxValue>(key);
-  auto handle_v8_key = v8::Local<v8::Value>::New(isolate_, v8_key->global_value_);
+  auto handle_v8_key = v8_key->Get(isolate_);
   auto v8_value = std::static_pointer_cast<V8CtxValue>(value);
-  auto handle_v8_value = v8::Local<v8::Value>::New(isolate_, v8_value->global_value_);
+  auto handle_v8_value = v8_value->Get(isolate_);
 
   auto handle_object =  v8::Local<v8::Object>::Cast(handle_v8_object);
   return handle_object->Set(context, handle_v8_key, handle_v8_value).FromMaybe(false);
@@ -1316,11 +1431,11 @@ bool V8Ctx::SetProperty(std::shared_ptr<CtxValue> object,
   auto context = context_persistent_.Get(isolate_);
   v8::Context::Scope context_scope(context);
   auto v8_object = std::static_pointer_cast<V8CtxValue>(object);
-  auto handle_v8_object = v8::Local<v8::Value>::New(isolate_, v8_object->global_value_);
+  auto handle_v8_object = v8_object->Get(isolate_);
   auto v8_key = std::static_pointer_cast<V8CtxValue>(key);
-  auto handle_v8_key = v8::Local<v8::Value>::New(isolate_, v8_key->global_value_);
+  auto handle_v8_key = v8_key->Get(isolate_);
   auto v8_value = std::static_pointer_cast<V8CtxValue>(value);
-  auto handle_v8_value = v8::Local<v8::Value>::New(isolate_, v8_value->global_value_);
+  auto handle_v8_value = v8_value->Get(isolate_);
 
   auto handle_object =  v8::Local<v8::Object>::Cast(handle_v8_object);
   auto v8_attr = v8::PropertyAttribute(attr);
@@ -1346,14 +1461,14 @@ std::shared_ptr<CtxValue> V8Ctx::NewInstance(const std::shared_ptr<CtxValue>& cl
   v8::Context::Scope context_scope(context);
 
   auto v8_cls = std::static_pointer_cast<V8CtxValue>(cls);
-  auto cls_handle_value = v8::Local<v8::Value>::New(isolate_, v8_cls->global_value_);
+  auto cls_handle_value = v8_cls->Get(isolate_);
   auto func = v8::Local<v8::Function>::Cast(cls_handle_value);
   v8::Local<v8::Object> instance;
   if (argc > 0 && argv) {
     v8::Local<v8::Value> v8_argv[argc];
     for (auto i = 0; i < argc; ++i) {
       auto v8_value = std::static_pointer_cast<V8CtxValue>(argv[i]);
-      v8_argv[i] = v8::Local<v8::Value>::New(isolate_, v8_value->global_value_);
+      v8_argv[i] = v8_value->Get(isolate_);
     }
     instance = func->NewInstance(context, argc, v8_argv).ToLocalChecked();
   } else {
@@ -1369,7 +1484,7 @@ void* V8Ctx::GetExternal(const std::shared_ptr<CtxValue>& object) {
   v8::Context::Scope context_scope(context);
 
   auto v8_object = std::static_pointer_cast<V8CtxValue>(object);
-  auto handle_value = v8::Local<v8::Value>::New(isolate_, v8_object->global_value_);
+  auto handle_value = v8_object->Get(isolate_);
   auto handle_object = v8::Local<v8::Object>::Cast(handle_value);
   return handle_object->GetAlignedPointerFromInternalField(kInternalIndex);
 }
@@ -1405,7 +1520,7 @@ std::shared_ptr<CtxValue> V8Ctx::DefineClass(unicode_string_view name,
     const auto& prop_desc = properties[i];
     auto v8_attr = v8::PropertyAttribute(prop_desc->attr);
     auto prop_name = std::static_pointer_cast<V8CtxValue>(prop_desc->name);
-    auto property_name = v8::Local<v8::Value>::New(isolate_, prop_name->global_value_);
+    auto property_name = prop_name->Get(isolate_);
     auto v8_prop_name = v8::Local<v8::Name>::Cast(property_name);
     if (prop_desc->has_getter || prop_desc->has_setter) {
       v8::Local<v8::FunctionTemplate> getter_tpl;
@@ -1427,7 +1542,7 @@ std::shared_ptr<CtxValue> V8Ctx::DefineClass(unicode_string_view name,
       tpl->PrototypeTemplate()->Set(v8_prop_name, method, v8_attr);
     } else {
       auto v8_ctx = std::static_pointer_cast<V8CtxValue>(prop_desc->value);
-      auto handle_value = v8::Local<v8::Value>::New(isolate_, v8_ctx->global_value_);
+      auto handle_value = v8_ctx->Get(isolate_);
       tpl->PrototypeTemplate()->Set(v8_prop_name, handle_value, v8_attr);
     }
   }
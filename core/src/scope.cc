@@ -29,6 +29,7 @@
 #include <vector>
 
 #include "base/logging.h"
+#include "core/base/trace_event.h"
 #include "core/modules/console_module.h"
 #include "core/modules/timer_module.h"
 #include "core/modules/contextify_module.h"
@@ -39,6 +40,7 @@
 #include "core/napi/v8/v8_ctx.h"
 #include "core/vm/v8/memory_module.h"
 #include "core/vm/v8/snapshot_collector.h"
+#include "core/vm/v8/v8_vm.h"
 #endif
 
 using unicode_string_view = tdf::base::unicode_string_view;
@@ -49,6 +51,7 @@ using CtxValue = hippy::napi::CtxValue;
 
 constexpr char kDeallocFuncName[] = "HippyDealloc";
 constexpr char kHippyBootstrapJSName[] = "bootstrap.js";
+constexpr char kCodeCachePurgeHandlerName[] = "code_cache";
 
 static void InternalBindingCallback(const hippy::napi::CallbackInfo& info, void* data) {
   auto scope_wrapper = reinterpret_cast<ScopeWrapper*>(std::any_cast<void*>(info.GetSlot()));
@@ -84,46 +87,63 @@ Scope::Scope(std::weak_ptr<Engine> engine,
 
 Scope::~Scope() {
   TDF_BASE_DLOG(INFO) << "~Scope";
+  auto engine = engine_.lock();
+  if (engine && purge_handler_id_) {
+    engine->RemovePurgeHandler(*purge_handler_id_);
+  }
+}
+
+static void RunWillExit(const std::weak_ptr<hippy::napi::Ctx>& weak_context,
+                        const std::vector<std::function<void()>>& will_exit_cbs) {
+  TDF_BASE_LOG(INFO) << "run js WillExit begin";
+  auto context = weak_context.lock();
+  if (context) {
+    auto global_object = context->GetGlobalObject();
+    auto func_name = context->GetPropertyKey(kDeallocFuncName);
+    auto fn = context->GetProperty(global_object, func_name);
+    bool is_fn = context->IsFunction(fn);
+    if (is_fn) {
+      context->CallFunction(fn, 0, nullptr);
+    }
+  }
+  for (const auto& will_exit_cb: will_exit_cbs) {
+    will_exit_cb();
+  }
 }
 
 void Scope::WillExit() {
   TDF_BASE_DLOG(INFO) << "WillExit begin";
-  std::promise<std::shared_ptr<CtxValue>> promise;
-  auto future = promise.get_future();
-  std::weak_ptr<Ctx> weak_context = context_;
-  auto cb = hippy::base::MakeCopyable(
-      [weak_context, will_exit_cbs = will_exit_cbs_, p = std::move(promise)]() mutable {
-        TDF_BASE_LOG(INFO) << "run js WillExit begin";
-        std::shared_ptr<CtxValue> rst = nullptr;
-        auto context = weak_context.lock();
-        if (context) {
-          auto global_object = context->GetGlobalObject();
-          auto func_name = context->CreateString(kDeallocFuncName);
-          auto fn = context->GetProperty(global_object, func_name);
-          bool is_fn = context->IsFunction(fn);
-          if (is_fn) {
-            context->CallFunction(fn, 0, nullptr);
-          }
-        }
-        for (const auto& will_exit_cb: will_exit_cbs) {
-          will_exit_cb();
-        }
-        p.set_value(rst);
-      });
   auto runner = GetTaskRunner();
   if (runner->IsJsThread()) {
-    cb();
-  } else {
-    std::shared_ptr<JavaScriptTask> task = std::make_shared<JavaScriptTask>();
-    task->callback = cb;
-    runner->PostTask(task);
+    RunWillExit(context_, will_exit_cbs_);
+    TDF_BASE_DLOG(INFO) << "ExitCtx end";
+    return;
   }
 
+  std::promise<void> promise;
+  auto future = promise.get_future();
+  AsyncWillExit([&promise] {
+    promise.set_value();
+  });
   future.get();
   TDF_BASE_DLOG(INFO) << "ExitCtx end";
 }
 
+void Scope::AsyncWillExit(std::function<void()> cb) {
+  TDF_BASE_DLOG(INFO) << "AsyncWillExit begin";
+  std::weak_ptr<Ctx> weak_context = context_;
+  auto task = std::make_shared<JavaScriptTask>();
+  task->callback = [weak_context, will_exit_cbs = will_exit_cbs_, cb] {
+    RunWillExit(weak_context, will_exit_cbs);
+    if (cb) {
+      cb();
+    }
+  };
+  GetTaskRunner()->PostTask(std::move(task));
+}
+
 void Scope::Init(bool use_snapshot) {
+  HIPPY_TRACE_EVENT("scope", "Scope::Init");
   CreateContext();
   BindModule();
   if (!use_snapshot) {
@@ -132,12 +152,61 @@ void Scope::Init(bool use_snapshot) {
   InvokeCallback();
 }
 
+void Scope::Prepare() {
+  HIPPY_TRACE_EVENT("scope", "Scope::Prepare");
+  CreateContext();
+  BindModule();
+}
+
+void Scope::Activate(std::unique_ptr<RegisterMap> map, bool use_snapshot) {
+  HIPPY_TRACE_EVENT("scope", "Scope::Activate");
+  map_ = std::move(map);
+  // the VM was created before the owner was known, its VM callback runs now
+  if (map_) {
+    auto it = map_->find(hippy::base::kVMCreateCBKey);
+    if (it != map_->end()) {
+      auto engine = engine_.lock();
+      if (it->second && engine) {
+        it->second(engine->GetVM().get());
+      }
+      map_->erase(it);
+    }
+  }
+  InvokeContextCreatedCallback();
+  if (!use_snapshot) {
+    Bootstrap();
+  }
+  InvokeCallback();
+}
+
 void Scope::CreateContext() {
+  HIPPY_TRACE_EVENT("scope", "Scope::CreateContext");
   auto engine = engine_.lock();
   TDF_BASE_CHECK(engine);
+#ifdef JS_V8
+  if (!snapshot_context_.empty()) {
+    auto vm = std::static_pointer_cast<hippy::vm::V8VM>(engine->GetVM());
+    context_ = vm->CreateContext(snapshot_context_);
+  } else {
+    context_ = engine->GetVM()->CreateContext();
+  }
+#else
   context_ = engine->GetVM()->CreateContext();
+#endif
   TDF_BASE_CHECK(context_);
   context_->SetExternalData(GetScopeWrapperPointer());
+#ifdef JS_V8
+  // the scripts are only kept to make their code cache warmer
+  std::weak_ptr<hippy::napi::V8Ctx> weak_context = std::static_pointer_cast<hippy::napi::V8Ctx>(context_);
+  purge_handler_id_ = engine->AddPurgeHandler(kCodeCachePurgeHandlerName, [weak_context](Engine::MemoryPressureLevel) {
+    auto context = weak_context.lock();
+    return context ? context->PurgeCodeCache() : static_cast<size_t>(0);
+  });
+#endif
+  InvokeContextCreatedCallback();
+}
+
+void Scope::InvokeContextCreatedCallback() {
   if (map_) {
     auto it = map_->find(hippy::base::kContextCreatedCBKey);
     if (it != map_->end()) {
@@ -152,6 +221,7 @@ void Scope::CreateContext() {
 
 
 void Scope::BindModule() {
+  HIPPY_TRACE_EVENT("scope", "Scope::BindModule");
   module_object_map_["ConsoleModule"] = std::make_shared<ConsoleModule>();
   module_object_map_["TimerModule"] = std::make_shared<TimerModule>();
   module_object_map_["ContextifyModule"] = std::make_shared<ContextifyModule>();
@@ -161,6 +231,7 @@ void Scope::BindModule() {
 }
 
 void Scope::Bootstrap() {
+  HIPPY_TRACE_EVENT("scope", "Scope::Bootstrap");
   TDF_BASE_LOG(INFO) << "Bootstrap begin";
   auto source_code = hippy::GetNativeSourceCode(kHippyBootstrapJSName);
   TDF_BASE_DCHECK(source_code.data_ && source_code.length_);
@@ -216,7 +287,7 @@ void Scope::RunJS(const unicode_string_view& data,
     callback();
   } else {
     std::shared_ptr<JavaScriptTask> task = std::make_shared<JavaScriptTask>();
-    task->callback = callback;
+    task->callback = std::move(callback);
     runner->PostTask(task);
   }
 }
@@ -224,36 +295,52 @@ void Scope::RunJS(const unicode_string_view& data,
 std::shared_ptr<CtxValue> Scope::RunJSSync(const unicode_string_view& data,
                                            const unicode_string_view& name,
                                            bool is_copy) {
-  std::promise<std::shared_ptr<CtxValue>> promise;
-  std::future<std::shared_ptr<CtxValue>> future = promise.get_future();
+  auto runner = GetTaskRunner();
+  if (runner->IsJsThread()) {
+    if (!context_) {
+      return nullptr;
+    }
+#ifdef JS_V8
+    return std::static_pointer_cast<hippy::napi::V8Ctx>(context_)->RunScript(data, name, false, nullptr, is_copy);
+#else
+    return context_->RunScript(data, name);
+#endif
+  }
+  auto result = RunJSAsync(data, name, is_copy).Get();
+  return result ? *result : nullptr;
+}
+
+TaskFuture<std::shared_ptr<CtxValue>> Scope::RunJSAsync(const unicode_string_view& data,
+                                                        const unicode_string_view& name,
+                                                        bool is_copy) {
   std::weak_ptr<Ctx> weak_context = context_;
-  JavaScriptTask::Function cb = hippy::base::MakeCopyable(
-      [data, name, is_copy, weak_context, p = std::move(promise)]() mutable {
-        std::shared_ptr<CtxValue> rst = nullptr;
+  return RunAsync(GetTaskRunner(), [data, name, is_copy, weak_context]() -> std::shared_ptr<CtxValue> {
 #ifdef JS_V8
-        auto context = std::static_pointer_cast<hippy::napi::V8Ctx>(weak_context.lock());
-        if (context) {
-          rst = context->RunScript(data, name, false, nullptr, is_copy);
-        }
+    auto context = std::static_pointer_cast<hippy::napi::V8Ctx>(weak_context.lock());
+    if (context) {
+      return context->RunScript(data, name, false, nullptr, is_copy);
+    }
 #else
-        auto context = weak_context.lock();
-        if (context) {
-          rst = context->RunScript(data, name);
-        }
+    auto context = weak_context.lock();
+    if (context) {
+      return context->RunScript(data, name);
+    }
 #endif
-        p.set_value(rst);
-      });
+    return nullptr;
+  });
+}
 
-  auto runner = GetTaskRunner();
-  if (runner->IsJsThread()) {
-    cb();
-  } else {
-    std::shared_ptr<JavaScriptTask> task = std::make_shared<JavaScriptTask>();
-    task->callback = cb;
-    runner->PostTask(task);
-  }
-  std::shared_ptr<CtxValue> ret = future.get();
-  return ret;
+TaskFuture<std::optional<Scope::u8string>> Scope::LoadAsync(const unicode_string_view& uri) {
+  std::weak_ptr<UriLoader> weak_loader = loader_;
+  return RunAsync(GetWorkerTaskRunner(), [uri, weak_loader]() -> std::optional<u8string> {
+    auto loader = weak_loader.lock();
+    u8string content;
+    if (!loader || !loader->RequestUntrustedContent(uri, content)) {
+      TDF_BASE_DLOG(WARNING) << "LoadAsync failed, uri = " << uri;
+      return std::nullopt;
+    }
+    return content;
+  });
 }
 
 
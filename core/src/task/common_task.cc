@@ -22,6 +22,16 @@
 
 #include "core/task/common_task.h"
 
+#include "core/base/task_pool.h"
+
 void CommonTask::Run() {
   func_();
 }
+
+void* CommonTask::operator new(size_t size) {
+  return hippy::base::TaskPool::GetDefault().Allocate(size);
+}
+
+void CommonTask::operator delete(void* block, size_t size) {
+  hippy::base::TaskPool::GetDefault().Deallocate(block, size);
+}
@@ -23,7 +23,7 @@
 #include "core/task/javascript_task.h"
 
 bool JavaScriptTask::isPriorityTask() {
-  return false;
+  return priority_ == Priority::kInput;
 }
 
 void JavaScriptTask::Run() {
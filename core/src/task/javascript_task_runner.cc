@@ -22,12 +22,57 @@
 
 #include "core/task/javascript_task_runner.h"
 
+#include <algorithm>
 #include <memory>
 
+#include "base/logging.h"
+#include "core/base/base_time.h"
 #include "core/base/task.h"
 
-JavaScriptTaskRunner::JavaScriptTaskRunner() {
-  SetName("hippy.js");
+using Task = hippy::base::Task;
+
+const JavaScriptTaskRunner::DelayedTimeInMs JavaScriptTaskRunner::kDefaultIdleSliceInMs = 5;
+
+JavaScriptTaskRunner::JavaScriptTaskRunner() : JavaScriptTaskRunner(Options(kDefaultThreadName)) {}
+
+JavaScriptTaskRunner::JavaScriptTaskRunner(const Options& options) : TaskRunner(options) {}
+
+// when update this code, please update
+// JavaScriptTaskRunner::PauseThreadForInspector at the same time
+void JavaScriptTaskRunner::Run() {
+  while (true) {
+    std::shared_ptr<Task> task;
+    if (idle_handler_ && !is_idle_work_done_) {
+      // the window counts from the last real work, timers running meanwhile don't restart it
+      DelayedTimeInMs now = hippy::base::MonotonicallyIncreasingTime();
+      DelayedTimeInMs idle_time = last_busy_time_ + idle_window_in_ms_;
+      bool is_timeout = false;
+      task = GetNext(idle_time > now ? idle_time - now : 0, is_timeout);
+      if (is_timeout) {
+        RunIdleHandler();
+        continue;
+      }
+    } else {
+      task = GetNext();
+    }
+    if (task == nullptr) {
+      return;
+    }
+
+    bool is_cancel;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      is_cancel = task->canceled_;
+    }
+    if (!is_cancel) {
+      task->Run();
+      // timers and idle tasks don't create garbage worth another idle period
+      if (task->priority_ == Task::Priority::kInput || task->priority_ == Task::Priority::kNormal) {
+        is_idle_work_done_ = false;
+        last_busy_time_ = hippy::base::MonotonicallyIncreasingTime();
+      }
+    }
+  }
 }
 
 bool JavaScriptTaskRunner::IsJsThread() {
@@ -52,3 +97,58 @@ void JavaScriptTaskRunner::PauseThreadForInspector() {
 void JavaScriptTaskRunner::ResumeThreadForInspector() {
   is_inspector_call_pause_ = false;
 }
+
+void JavaScriptTaskRunner::SetIdleHandler(IdleHandler handler,
+                                          DelayedTimeInMs idle_window_in_ms,
+                                          DelayedTimeInMs slice_in_ms) {
+  TDF_BASE_DCHECK(IsJsThread());
+  idle_handler_ = std::move(handler);
+  idle_window_in_ms_ = idle_window_in_ms;
+  idle_slice_in_ms_ = slice_in_ms;
+  is_idle_work_done_ = false;
+  last_busy_time_ = hippy::base::MonotonicallyIncreasingTime();
+}
+
+JavaScriptTaskRunner::IdleStats JavaScriptTaskRunner::GetIdleStats() {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  return idle_stats_;
+}
+
+bool JavaScriptTaskRunner::HasRunnableTask() {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  if (is_terminated_ || PendingTaskCountNoLock()) {
+    return true;
+  }
+  return !delayed_task_queue_.empty() &&
+      delayed_task_queue_.top().first <= hippy::base::MonotonicallyIncreasingTime();
+}
+
+void JavaScriptTaskRunner::RunIdleHandler() {
+  DelayedTimeInMs begin = hippy::base::MonotonicallyIncreasingTime();
+  uint64_t slice_count = 0;
+  DelayedTimeInMs max_slice_time = 0;
+  bool is_interrupted = false;
+  while (!is_idle_work_done_) {
+    // back off as soon as there is real work
+    if (HasRunnableTask()) {
+      is_interrupted = true;
+      break;
+    }
+    DelayedTimeInMs slice_begin = hippy::base::MonotonicallyIncreasingTime();
+    is_idle_work_done_ = idle_handler_(slice_begin + idle_slice_in_ms_);
+    DelayedTimeInMs slice_end = hippy::base::MonotonicallyIncreasingTime();
+    max_slice_time = std::max(max_slice_time, slice_end - slice_begin);
+    ++slice_count;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  ++idle_stats_.idle_count;
+  idle_stats_.slice_count += slice_count;
+  idle_stats_.total_idle_time_in_ms += hippy::base::MonotonicallyIncreasingTime() - begin;
+  idle_stats_.max_slice_time_in_ms = std::max(idle_stats_.max_slice_time_in_ms, max_slice_time);
+  if (is_interrupted) {
+    ++idle_stats_.interrupted_count;
+  }
+}
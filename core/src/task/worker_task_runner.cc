@@ -28,9 +28,10 @@ const uint32_t WorkerTaskRunner::kDefaultTaskPriority = 10000;
 const uint32_t WorkerTaskRunner::kHighPriorityTaskPriority = 5000;
 const uint32_t WorkerTaskRunner::kLowPriorityTaskPriority = 15000;
 
-WorkerTaskRunner::WorkerTaskRunner(uint32_t pool_size) : pool_size_(pool_size) {
+WorkerTaskRunner::WorkerTaskRunner(uint32_t pool_size, const hippy::base::Thread::Options& options)
+    : pool_size_(pool_size) {
   for (uint32_t i = 0; i < pool_size_; ++i) {
-    thread_pool_.push_back(std::make_unique<WorkerThread>(this));
+    thread_pool_.push_back(std::make_unique<WorkerThread>(this, options));
   }
 }
 
@@ -87,8 +88,8 @@ void WorkerTaskRunner::Terminate() {
   TDF_BASE_DLOG(INFO) << "WorkerTaskRunner::Terminate end";
 }
 
-WorkerTaskRunner::WorkerThread::WorkerThread(WorkerTaskRunner* runner)
-    : Thread(Options("Hippy WorkerTaskRunner WorkerThread")), runner_(runner) {
+WorkerTaskRunner::WorkerThread::WorkerThread(WorkerTaskRunner* runner, const Options& options)
+    : Thread(options), runner_(runner) {
   TDF_BASE_DLOG(INFO) << "WorkerThread create";
   Start();
 }
@@ -0,0 +1,110 @@
+/*
+ *
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2022 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#include "core/vm/cpu_profile.h"
+
+#include <cstdio>
+
+namespace hippy {
+namespace vm {
+
+static void AppendJsonString(std::string& out, const std::string& str) {
+  out += '"';
+  for (char c : str) {
+    switch (c) {
+      case '"': out += "\\\""; break;
+      case '\\': out += "\\\\"; break;
+      case '\n': out += "\\n"; break;
+      case '\r': out += "\\r"; break;
+      case '\t': out += "\\t"; break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20) {
+          char escaped[8];
+          snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+          out += escaped;
+        } else {
+          out += c;
+        }
+    }
+  }
+  out += '"';
+}
+
+std::string CpuProfile::ToJson() const {
+  std::string out;
+  // roughly 100 bytes a node and 10 a sample
+  out.reserve(nodes.size() * 100 + samples.size() * 10 + 64);
+  out += "{\"nodes\":[";
+  for (size_t i = 0; i < nodes.size(); ++i) {
+    const auto& node = nodes[i];
+    out += i ? ",{\"id\":" : "{\"id\":";
+    out += std::to_string(node.id);
+    out += ",\"callFrame\":{\"functionName\":";
+    AppendJsonString(out, node.function_name);
+    out += ",\"scriptId\":\"";
+    out += std::to_string(node.script_id);
+    out += "\",\"url\":";
+    AppendJsonString(out, node.url);
+    out += ",\"lineNumber\":";
+    out += std::to_string(node.line_number);
+    out += ",\"columnNumber\":";
+    out += std::to_string(node.column_number);
+    out += "},\"hitCount\":";
+    out += std::to_string(node.hit_count);
+    if (!node.children.empty()) {
+      out += ",\"children\":[";
+      for (size_t j = 0; j < node.children.size(); ++j) {
+        if (j) {
+          out += ',';
+        }
+        out += std::to_string(node.children[j]);
+      }
+      out += ']';
+    }
+    out += '}';
+  }
+  out += "],\"startTime\":";
+  out += std::to_string(start_time);
+  out += ",\"endTime\":";
+  out += std::to_string(end_time);
+  out += ",\"samples\":[";
+  for (size_t i = 0; i < samples.size(); ++i) {
+    if (i) {
+      out += ',';
+    }
+    out += std::to_string(samples[i]);
+  }
+  // deltas keep the file small, the first one is relative to the start time
+  out += "],\"timeDeltas\":[";
+  int64_t last_time = start_time;
+  for (size_t i = 0; i < timestamps.size(); ++i) {
+    if (i) {
+      out += ',';
+    }
+    out += std::to_string(timestamps[i] - last_time);
+    last_time = timestamps[i];
+  }
+  out += "]}";
+  return out;
+}
+
+}  // namespace vm
+}  // namespace hippy
@@ -29,7 +29,7 @@ namespace {
   const uint8_t k_hippy[] = { 40,102,117,110,99,116,105,111,110,40,101,120,112,111,114,116,115,44,32,114,101,113,117,105,114,101,44,32,105,110,116,101,114,110,97,108,66,105,110,100,105,110,103,41,32,123,34,117,115,101,32,115,116,114,105,99,116,34,59,10,10,114,101,113,117,105,114,101,40,39,46,46,47,46,46,47,103,108,111,98,97,108,47,79,116,104,101,114,115,46,106,115,39,41,59,10,10,114,101,113,117,105,114,101,40,39,46,46,47,46,46,47,103,108,111,98,97,108,47,68,121,110,97,109,105,99,76,111,97,100,46,106,115,39,41,59,10,10,114,101,113,117,105,114,101,40,39,46,46,47,46,46,47,103,108,111,98,97,108,47,80,108,97,116,102,111,114,109,46,106,115,39,41,59,10,10,114,101,113,117,105,114,101,40,39,46,46,47,46,46,47,98,114,105,100,103,101,47,105,111,115,47,106,115,50,110,97,116,105,118,101,46,106,115,39,41,59,10,10,114,101,113,117,105,114,101,40,39,46,46,47,46,46,47,103,108,111,98,97,108,47,84,105,109,101,114,77,111,100,117,108,101,46,106,115,39,41,59,10,10,114,101,113,117,105,114,101,40,39,46,46,47,46,46,47,103,108,111,98,97,108,47,105,111,115,47,112,114,111,109,105,115,101,46,106,115,39,41,59,10,10,114,101,113,117,105,114,101,40,39,46,46,47,46,46,47,103,108,111,98,97,108,47,67,111,110,115,111,108,101,77,111,100,117,108,101,46,106,115,39,41,59,10,10,114,101,113,117,105,114,101,40,39,46,46,47,46,46,47,103,108,111,98,97,108,47,85,73,77,97,110,97,103,101,114,77,111,100,117,108,101,46,106,115,39,41,59,10,10,114,101,113,117,105,114,101,40,39,46,46,47,46,46,47,103,108,111,98,97,108,47,78,101,116,119,111,114,107,46,106,115,39,41,59,10,10,114,101,113,117,105,114,101,40,39,46,46,47,46,46,47,103,108,111,98,97,108,47,83,116,111,114,97,103,101,46,106,115,39,41,59,10,10,114,101,113,117,105,114,101,40,39,46,46,47,46,46,47,103,108,111,98,97,108,47,69,118,101,110,116,46,106,115,39,41,59,10,10,114,101,113,117,105,114,101,40,39,46,46,47,46,46,47,103,108,111,98,97,108,47,68,105,109,101,110,115,105,111,110,115,46,106,115,39,41,59,10,10,114,101,113,117,105,114,101,40,39,46,46,47,46,46,47,103,108,111,98,97,108,47,85,116,105,108,115,77,111,100,117,108,101,46,106,115,39,41,59,10,10,114,101,113,117,105,114,101,40,39,46,46,47,46,46,47,103,108,111,98,97,108,47,105,111,115,47,103,108,111,98,97,108,46,106,115,39,41,59,10,10,114,101,113,117,105,114,101,40,39,46,46,47,46,46,47,109,111,100,117,108,101,115,47,105,111,115,47,106,115,84,105,109,101,114,115,69,120,101,99,117,116,105,111,110,46,106,115,39,41,59,10,10,114,101,113,117,105,114,101,40,39,46,46,47,46,46,47,98,114,105,100,103,101,47,105,111,115,47,110,97,116,105,118,101,50,106,115,46,106,115,39,41,59,10,10,114,101,113,117,105,114,101,40,39,46,46,47,46,46,47,103,108,111,98,97,108,47,105,111,115,47,114,101,113,117,101,115,116,65,110,105,109,97,116,105,111,110,70,114,97,109,101,46,106,115,39,41,59,10,10,114,101,113,117,105,114,101,40,39,46,46,47,46,46,47,103,108,111,98,97,108,47,105,111,115,47,84,117,114,98,111,46,106,115,39,41,59,10,10,114,101,113,117,105,114,101,40,39,46,46,47,46,46,47,103,108,111,98,97,108,47,80,101,114,102,111,114,109,97,110,99,101,46,106,115,39,41,59,10,10,103,108,111,98,97,108,46,108,111,99,97,108,83,116,111,114,97,103,101,32,61,32,72,105,112,112,121,46,97,115,121,110,99,83,116,111,114,97,103,101,59,10,103,108,111,98,97,108,46,116,117,114,98,111,80,114,111,109,105,115,101,32,61,32,72,105,112,112,121,46,116,117,114,98,111,80,114,111,109,105,115,101,59,125,41,59,0 };  // NOLINT
   const uint8_t k_ExceptionHandle[] = { 34,117,115,101,32,115,116,114,105,99,116,34,59,10,10,40,102,117,110,99,116,105,111,110,32,101,120,99,101,112,116,105,111,110,72,97,110,100,108,101,114,40,101,118,101,110,116,78,97,109,101,44,32,101,114,114,41,32,123,10,32,32,105,102,32,40,103,108,111,98,97,108,46,72,105,112,112,121,41,32,123,10,32,32,32,32,103,108,111,98,97,108,46,72,105,112,112,121,46,101,109,105,116,40,39,117,110,99,97,117,103,104,116,69,120,99,101,112,116,105,111,110,39,44,32,101,114,114,41,59,10,32,32,125,32,101,108,115,101,32,123,10,32,32,32,32,99,111,110,115,111,108,101,46,101,114,114,111,114,40,101,118,101,110,116,78,97,109,101,44,32,101,114,114,41,59,10,32,32,125,10,125,41,59,0 };  // NOLINT
   const uint8_t k_Others[] = { 40,102,117,110,99,116,105,111,110,40,101,120,112,111,114,116,115,44,32,114,101,113,117,105,114,101,44,32,105,110,116,101,114,110,97,108,66,105,110,100,105,110,103,41,32,123,34,117,115,101,32,115,116,114,105,99,116,34,59,10,10,103,108,111,98,97,108,46,95,95,73,83,72,73,80,80,89,95,95,32,61,32,116,114,117,101,59,10,103,108,111,98,97,108,46,95,95,71,76,79,66,65,76,95,95,32,61,32,123,10,32,32,103,108,111,98,97,108,69,118,101,110,116,72,97,110,100,108,101,58,32,123,125,10,125,59,10,10,102,117,110,99,116,105,111,110,32,104,105,112,112,121,82,101,103,105,115,116,101,114,40,97,112,112,78,97,109,101,44,32,101,110,116,114,121,70,117,110,99,41,32,123,10,32,32,105,102,32,40,103,108,111,98,97,108,46,95,95,72,73,80,80,89,78,65,84,73,86,69,71,76,79,66,65,76,95,95,46,79,83,32,61,61,61,32,39,105,111,115,39,41,32,123,10,32,32,32,32,72,105,112,112,121,46,98,114,105,100,103,101,46,99,97,108,108,78,97,116,105,118,101,40,39,74,83,67,69,120,101,99,117,116,111,114,39,44,32,39,115,101,116,67,111,110,116,101,120,116,78,97,109,101,39,44,32,34,72,105,112,112,121,67,111,110,116,101,120,116,58,32,34,46,99,111,110,99,97,116,40,97,112,112,78,97,109,101,41,41,59,10,32,32,125,10,10,32,32,95,95,71,76,79,66,65,76,95,95,46,97,112,112,82,101,103,105,115,116,101,114,91,97,112,112,78,97,109,101,93,32,61,32,123,10,32,32,32,32,114,117,110,58,32,101,110,116,114,121,70,117,110,99,10,32,32,125,59,10,125,10,10,102,117,110,99,116,105,111,110,32,111,110,40,101,118,101,110,116,78,97,109,101,44,32,108,105,115,116,101,110,101,114,41,32,123,10,32,32,105,102,32,40,116,121,112,101,111,102,32,101,118,101,110,116,78,97,109,101,32,33,61,61,32,39,115,116,114,105,110,103,39,32,124,124,32,116,121,112,101,111,102,32,108,105,115,116,101,110,101,114,32,33,61,61,32,39,102,117,110,99,116,105,111,110,39,41,32,123,10,32,32,32,32,116,104,114,111,119,32,110,101,119,32,84,121,112,101,69,114,114,111,114,40,39,72,105,112,112,121,46,111,110,40,41,32,111,110,108,121,32,97,99,99,101,112,116,32,97,32,115,116,114,105,110,103,32,97,115,32,101,118,101,110,116,32,110,97,109,101,32,97,110,100,32,97,32,102,117,110,99,116,105,111,110,32,97,115,32,108,105,115,116,101,110,101,114,39,41,59,10,32,32,125,10,10,32,32,118,97,114,32,101,118,101,110,116,76,105,115,116,101,110,101,114,115,32,61,32,95,95,71,76,79,66,65,76,95,95,46,103,108,111,98,97,108,69,118,101,110,116,72,97,110,100,108,101,91,101,118,101,110,116,78,97,109,101,93,59,10,10,32,32,105,102,32,40,33,40,101,118,101,110,116,76,105,115,116,101,110,101,114,115,32,105,110,115,116,97,110,99,101,111,102,32,83,101,116,41,41,32,123,10,32,32,32,32,95,95,71,76,79,66,65,76,95,95,46,103,108,111,98,97,108,69,118,101,110,116,72,97,110,100,108,101,91,101,118,101,110,116,78,97,109,101,93,32,61,32,110,101,119,32,83,101,116,40,41,59,10,32,32,32,32,101,118,101,110,116,76,105,115,116,101,110,101,114,115,32,61,32,95,95,71,76,79,66,65,76,95,95,46,103,108,111,98,97,108,69,118,101,110,116,72,97,110,100,108,101,91,101,118,101,110,116,78,97,109,101,93,59,10,32,32,125,10,10,32,32,101,118,101,110,116,76,105,115,116,101,110,101,114,115,46,97,100,100,40,108,105,115,116,101,110,101,114,41,59,10,32,32,114,101,116,117,114,110,32,101,118,101,110,116,76,105,115,116,101,110,101,114,115,59,10,125,10,10,102,117,110,99,116,105,111,110,32,111,102,102,40,101,118,101,110,116,78,97,109,101,44,32,108,105,115,116,101,110,101,114,41,32,123,10,32,32,105,102,32,40,116,121,112,101,111,102,32,101,118,101,110,116,78,97,109,101,32,33,61,61,32,39,115,116,114,105,110,103,39,41,32,123,10,32,32,32,32,116,104,114,111,119,32,110,101,119,32,84,121,112,101,69,114,114,111,114,40,39,72,105,112,112,121,46,111,102,102,40,41,32,111,110,108,121,32,97,99,99,101,112,116,32,97,32,115,116,114,105,110,103,32,97,115,32,101,118,101,110,116,32,110,97,109,101,39,41,59,10,32,32,125,10,10,32,32,118,97,114,32,101,118,101,110,116,76,105,115,116,101,110,101,114,115,32,61,32,95,95,71,76,79,66,65,76,95,95,46,103,108,111,98,97,108,69,118,101,110,116,72,97,110,100,108,101,91,101,118,101,110,116,78,97,109,101,93,59,10,10,32,32,105,102,32,40,33,40,101,118,101,110,116,76,105,115,116,101,110,101,114,115,32,105,110,115,116,97,110,99,101,111,102,32,83,101,116,41,41,32,123,10,32,32,32,32,114,101,116,117,114,110,32,110,117,108,108,59,10,32,32,125,10,10,32,32,105,102,32,40,108,105,115,116,101,110,101,114,41,32,123,10,32,32,32,32,101,118,101,110,116,76,105,115,116,101,110,101,114,115,46,100,101,108,101,116,101,40,108,105,115,116,101,110,101,114,41,59,10,32,32,32,32,114,101,116,117,114,110,32,101,118,101,110,116,76,105,115,116,101,110,101,114,115,59,10,32,32,125,10,10,32,32,101,118,101,110,116,76,105,115,116,101,110,101,114,115,46,99,108,101,97,114,40,41,59,10,32,32,114,101,116,117,114,110,32,110,117,108,108,59,10,125,10,10,102,117,110,99,116,105,111,110,32,101,109,105,116,40,101,118,101,110,116,78,97,109,101,41,32,123,10,32,32,102,111,114,32,40,118,97,114,32,95,108,101,110,32,61,32,97,114,103,117,109,101,110,116,115,46,108,101,110,103,116,104,44,32,97,114,103,115,32,61,32,110,101,119,32,65,114,114,97,121,40,95,108,101,110,32,62,32,49,32,63,32,95,108,101,110,32,45,32,49,32,58,32,48,41,44,32,95,107,101,121,32,61,32,49,59,32,95,107,101,121,32,60,32,95,108,101,110,59,32,95,107,101,121,43,43,41,32,123,10,32,32,32,32,97,114,103,115,91,95,107,101,121,32,45,32,49,93,32,61,32,97,114,103,117,109,101,110,116,115,91,95,107,101,121,93,59,10,32,32,125,10,10,32,32,105,102,32,40,116,121,112,101,111,102,32,101,118,101,110,116,78,97,109,101,32,33,61,61,32,39,115,116,114,105,110,103,39,41,32,123,10,32,32,32,32,116,104,114,111,119,32,110,101,119,32,84,121,112,101,69,114,114,111,114,40,39,72,105,112,112,121,46,101,109,105,116,40,41,32,111,110,108,121,32,97,99,99,101,112,116,32,97,32,115,116,114,105,110,103,32,97,115,32,101,118,101,110,116,32,110,97,109,101,39,41,59,10,32,32,125,10,10,32,32,118,97,114,32,101,118,101,110,116,76,105,115,116,101,110,101,114,115,32,61,32,95,95,71,76,79,66,65,76,95,95,46,103,108,111,98,97,108,69,118,101,110,116,72,97,110,100,108,101,91,101,118,101,110,116,78,97,109,101,93,59,10,10,32,32,105,102,32,40,33,101,118,101,110,116,76,105,115,116,101,110,101,114,115,41,32,123,10,32,32,32,32,105,102,32,40,101,118,101,110,116,78,97,109,101,32,61,61,61,32,39,117,110,99,97,117,103,104,116,69,120,99,101,112,116,105,111,110,39,32,38,38,32,97,114,103,115,91,48,93,41,32,123,10,32,32,32,32,32,32,99,111,110,115,111,108,101,46,101,114,114,111,114,40,97,114,103,115,91,48,93,46,116,111,83,116,114,105,110,103,40,41,41,59,10,32,32,32,32,125,10,10,32,32,32,32,114,101,116,117,114,110,59,10,32,32,125,10,10,32,32,116,114,121,32,123,10,32,32,32,32,101,118,101,110,116,76,105,115,116,101,110,101,114,115,46,102,111,114,69,97,99,104,40,102,117,110,99,116,105,111,110,32,40,108,105,115,116,101,110,101,114,41,32,123,10,32,32,32,32,32,32,114,101,116,117,114,110,32,108,105,115,116,101,110,101,114,46,97,112,112,108,121,40,118,111,105,100,32,48,44,32,97,114,103,115,41,59,10,32,32,32,32,125,41,59,10,32,32,125,32,99,97,116,99,104,32,40,101,114,114,41,32,123,10,32,32,32,32,99,111,110,115,111,108,101,46,101,114,114,111,114,40,101,114,114,41,59,10,32,32,125,10,125,10,10,72,105,112,112,121,46,100,101,118,105,99,101,32,61,32,123,125,59,10,72,105,112,112,121,46,98,114,105,100,103,101,32,61,32,123,125,59,10,72,105,112,112,121,46,114,101,103,105,115,116,101,114,32,61,32,123,10,32,32,114,101,103,105,115,116,58,32,104,105,112,112,121,82,101,103,105,115,116,101,114,10,125,59,10,72,105,112,112,121,46,111,110,32,61,32,111,110,59,10,72,105,112,112,121,46,111,102,102,32,61,32,111,102,102,59,10,72,105,112,112,121,46,101,109,105,116,32,61,32,101,109,105,116,59,125,41,59,0 };  // NOLINT
-  const uint8_t k_DynamicLoad[] = { 40,102,117,110,99,116,105,111,110,40,101,120,112,111,114,116,115,44,32,114,101,113,117,105,114,101,44,32,105,110,116,101,114,110,97,108,66,105,110,100,105,110,103,41,32,123,34,117,115,101,32,115,116,114,105,99,116,34,59,10,10,118,97,114,32,67,111,110,116,101,120,116,105,102,121,77,111,100,117,108,101,32,61,32,105,110,116,101,114,110,97,108,66,105,110,100,105,110,103,40,39,67,111,110,116,101,120,116,105,102,121,77,111,100,117,108,101,39,41,59,10,10,103,108,111,98,97,108,46,100,121,110,97,109,105,99,76,111,97,100,32,61,32,102,117,110,99,116,105,111,110,32,40,112,97,116,104,44,32,101,110,99,111,100,101,44,32,99,98,41,32,123,10,32,32,118,97,114,32,114,101,113,117,101,115,116,80,97,116,104,32,61,32,112,97,116,104,32,124,124,32,39,39,59,10,32,32,118,97,114,32,105,115,83,99,104,101,109,97,32,61,32,47,94,40,46,43,58,92,47,92,47,41,124,94,40,92,47,92,47,41,47,46,116,101,115,116,40,112,97,116,104,41,59,10,10,32,32,105,102,32,40,33,105,115,83,99,104,101,109,97,41,32,123,10,32,32,32,32,114,101,113,117,101,115,116,80,97,116,104,32,61,32,103,108,111,98,97,108,46,95,95,72,73,80,80,89,67,85,82,68,73,82,95,95,32,43,32,112,97,116,104,59,10,32,32,125,10,10,32,32,67,111,110,116,101,120,116,105,102,121,77,111,100,117,108,101,46,76,111,97,100,85,110,116,114,117,115,116,101,100,67,111,110,116,101,110,116,40,114,101,113,117,101,115,116,80,97,116,104,44,32,101,110,99,111,100,101,44,32,99,98,41,59,10,125,59,125,41,59,0 };  // NOLINT
+  const uint8_t k_DynamicLoad[] = { 40,102,117,110,99,116,105,111,110,40,101,120,112,111,114,116,115,44,32,114,101,113,117,105,114,101,44,32,105,110,116,101,114,110,97,108,66,105,110,100,105,110,103,41,32,123,34,117,115,101,32,115,116,114,105,99,116,34,59,10,10,118,97,114,32,67,111,110,116,101,120,116,105,102,121,77,111,100,117,108,101,32,61,32,105,110,116,101,114,110,97,108,66,105,110,100,105,110,103,40,39,67,111,110,116,101,120,116,105,102,121,77,111,100,117,108,101,39,41,59,10,10,103,108,111,98,97,108,46,100,121,110,97,109,105,99,76,111,97,100,32,61,32,102,117,110,99,116,105,111,110,32,40,112,97,116,104,44,32,101,110,99,111,100,101,44,32,99,98,41,32,123,10,32,32,118,97,114,32,114,101,113,117,101,115,116,80,97,116,104,32,61,32,112,97,116,104,32,124,124,32,39,39,59,10,32,32,118,97,114,32,105,115,83,99,104,101,109,97,32,61,32,47,94,40,46,43,58,92,47,92,47,41,124,94,40,92,47,92,47,41,47,46,116,101,115,116,40,112,97,116,104,41,59,10,10,32,32,105,102,32,40,33,105,115,83,99,104,101,109,97,41,32,123,10,32,32,32,32,114,101,113,117,101,115,116,80,97,116,104,32,61,32,103,108,111,98,97,108,46,95,95,72,73,80,80,89,67,85,82,68,73,82,95,95,32,43,32,112,97,116,104,59,10,32,32,125,10,10,32,32,67,111,110,116,101,120,116,105,102,121,77,111,100,117,108,101,46,76,111,97,100,85,110,116,114,117,115,116,101,100,67,111,110,116,101,110,116,40,114,101,113,117,101,115,116,80,97,116,104,44,32,101,110,99,111,100,101,44,32,99,98,41,59,10,125,59,10,10,103,108,111,98,97,108,46,115,101,116,67,104,117,110,107,77,97,110,105,102,101,115,116,32,61,32,102,117,110,99,116,105,111,110,32,40,109,97,110,105,102,101,115,116,41,32,123,10,32,32,118,97,114,32,116,111,85,114,105,32,61,32,102,117,110,99,116,105,111,110,32,116,111,85,114,105,40,112,97,116,104,41,32,123,10,32,32,32,32,114,101,116,117,114,110,32,47,94,40,46,43,58,92,47,92,47,41,124,94,40,92,47,92,47,41,47,46,116,101,115,116,40,112,97,116,104,41,32,63,32,112,97,116,104,32,58,32,103,108,111,98,97,108,46,95,95,72,73,80,80,89,67,85,82,68,73,82,95,95,32,43,32,112,97,116,104,59,10,32,32,125,59,10,10,32,32,118,97,114,32,99,104,117,110,107,115,32,61,32,109,97,110,105,102,101,115,116,32,124,124,32,123,125,59,10,32,32,67,111,110,116,101,120,116,105,102,121,77,111,100,117,108,101,46,83,101,116,67,104,117,110,107,77,97,110,105,102,101,115,116,40,79,98,106,101,99,116,46,107,101,121,115,40,99,104,117,110,107,115,41,46,109,97,112,40,102,117,110,99,116,105,111,110,32,40,99,104,117,110,107,41,32,123,10,32,32,32,32,114,101,116,117,114,110,32,91,116,111,85,114,105,40,99,104,117,110,107,41,44,32,40,99,104,117,110,107,115,91,99,104,117,110,107,93,32,124,124,32,91,93,41,46,109,97,112,40,116,111,85,114,105,41,93,59,10,32,32,125,41,41,59,10,125,59,125,41,59,0 };  // NOLINT
   const uint8_t k_Platform[] = { 40,102,117,110,99,116,105,111,110,40,101,120,112,111,114,116,115,44,32,114,101,113,117,105,114,101,44,32,105,110,116,101,114,110,97,108,66,105,110,100,105,110,103,41,32,123,34,117,115,101,32,115,116,114,105,99,116,34,59,10,10,72,105,112,112,121,46,100,101,118,105,99,101,46,112,108,97,116,102,111,114,109,32,61,32,123,125,59,10,10,105,102,32,40,116,121,112,101,111,102,32,95,95,72,73,80,80,89,78,65,84,73,86,69,71,76,79,66,65,76,95,95,32,33,61,61,32,39,117,110,100,101,102,105,110,101,100,39,41,32,123,10,32,32,118,97,114,32,76,111,99,97,108,105,122,97,116,105,111,110,32,61,32,123,10,32,32,32,32,99,111,117,110,116,114,121,58,32,39,39,44,10,32,32,32,32,108,97,110,103,117,97,103,101,58,32,39,39,44,10,32,32,32,32,100,105,114,101,99,116,105,111,110,58,32,48,10,32,32,125,59,10,10,32,32,105,102,32,40,95,95,72,73,80,80,89,78,65,84,73,86,69,71,76,79,66,65,76,95,95,46,79,83,32,61,61,61,32,39,105,111,115,39,41,32,123,10,32,32,32,32,72,105,112,112,121,46,100,101,118,105,99,101,46,112,108,97,116,102,111,114,109,46,79,83,32,61,32,95,95,72,73,80,80,89,78,65,84,73,86,69,71,76,79,66,65,76,95,95,46,79,83,59,10,32,32,32,32,72,105,112,112,121,46,100,101,118,105,99,101,46,112,108,97,116,102,111,114,109,46,68,101,118,105,99,101,32,61,32,95,95,72,73,80,80,89,78,65,84,73,86,69,71,76,79,66,65,76,95,95,46,68,101,118,105,99,101,59,10,32,32,32,32,72,105,112,112,121,46,100,101,118,105,99,101,46,112,108,97,116,102,111,114,109,46,79,83,86,101,114,115,105,111,110,32,61,32,95,95,72,73,80,80,89,78,65,84,73,86,69,71,76,79,66,65,76,95,95,46,79,83,86,101,114,115,105,111,110,59,10,32,32,32,32,72,105,112,112,121,46,100,101,118,105,99,101,46,112,108,97,116,102,111,114,109,46,83,68,75,86,101,114,115,105,111,110,32,61,32,95,95,72,73,80,80,89,78,65,84,73,86,69,71,76,79,66,65,76,95,95,46,83,68,75,86,101,114,115,105,111,110,59,10,32,32,32,32,72,105,112,112,121,46,100,101,118,105,99,101,46,112,108,97,116,102,111,114,109,46,76,111,99,97,108,105,122,97,116,105,111,110,32,61,32,95,95,72,73,80,80,89,78,65,84,73,86,69,71,76,79,66,65,76,95,95,46,76,111,99,97,108,105,122,97,116,105,111,110,32,124,124,32,76,111,99,97,108,105,122,97,116,105,111,110,59,10,32,32,125,32,101,108,115,101,32,123,10,32,32,32,32,72,105,112,112,121,46,100,101,118,105,99,101,46,112,108,97,116,102,111,114,109,46,79,83,32,61,32,95,95,72,73,80,80,89,78,65,84,73,86,69,71,76,79,66,65,76,95,95,46,80,108,97,116,102,111,114,109,46,79,83,59,10,32,32,32,32,72,105,112,112,121,46,100,101,118,105,99,101,46,112,108,97,116,102,111,114,109,46,65,80,73,76,101,118,101,108,32,61,32,95,95,72,73,80,80,89,78,65,84,73,86,69,71,76,79,66,65,76,95,95,46,80,108,97,116,102,111,114,109,46,65,80,73,76,101,118,101,108,59,10,32,32,32,32,72,105,112,112,121,46,100,101,118,105,99,101,46,112,108,97,116,102,111,114,109,46,83,68,75,86,101,114,115,105,111,110,32,61,32,95,95,72,73,80,80,89,78,65,84,73,86,69,71,76,79,66,65,76,95,95,46,80,108,97,116,102,111,114,109,46,83,68,75,86,101,114,115,105,111,110,59,10,32,32,32,32,72,105,112,112,121,46,100,101,118,105,99,101,46,112,108,97,116,102,111,114,109,46,76,111,99,97,108,105,122,97,116,105,111,110,32,61,32,95,95,72,73,80,80,89,78,65,84,73,86,69,71,76,79,66,65,76,95,95,46,80,108,97,116,102,111,114,109,46,76,111,99,97,108,105,122,97,116,105,111,110,32,124,124,32,76,111,99,97,108,105,122,97,116,105,111,110,59,10,32,32,125,10,125,125,41,59,0 };  // NOLINT
   const uint8_t k_js2native[] = { 40,102,117,110,99,116,105,111,110,40,101,120,112,111,114,116,115,44,32,114,101,113,117,105,114,101,44,32,105,110,116,101,114,110,97,108,66,105,110,100,105,110,103,41,32,123,34,117,115,101,32,115,116,114,105,99,116,34,59,10,10,102,117,110,99,116,105,111,110,32,95,116,111,67,111,110,115,117,109,97,98,108,101,65,114,114,97,121,40,97,114,114,41,32,123,32,114,101,116,117,114,110,32,95,97,114,114,97,121,87,105,116,104,111,117,116,72,111,108,101,115,40,97,114,114,41,32,124,124,32,95,105,116,101,114,97,98,108,101,84,111,65,114,114,97,121,40,97,114,114,41,32,124,124,32,95,117,110,115,117,112,112,111,114,116,101,100,73,116,101,114,97,98,108,101,84,111,65,114,114,97,121,40,97,114,114,41,32,124,124,32,95,110,111,110,73,116,101,114,97,98,108,101,83,112,114,101,97,100,40,41,59,32,125,10,10,102,117,110,99,116,105,111,110,32,95,110,111,110,73,116,101,114,97,98,108,101,83,112,114,101,97,100,40,41,32,123,32,116,104,114,111,119,32,110,101,119,32,84,121,112,101,69,114,114,111,114,40,34,73,110,118,97,108,105,100,32,97,116,116,101,109,112,116,32,116,111,32,115,112,114,101,97,100,32,110,111,110,45,105,116,101,114,97,98,108,101,32,105,110,115,116,97,110,99,101,46,92,110,73,110,32,111,114,100,101,114,32,116,111,32,98,101,32,105,116,101,114,97,98,108,101,44,32,110,111,110,45,97,114,114,97,121,32,111,98,106,101,99,116,115,32,109,117,115,116,32,104,97,118,101,32,97,32,91,83,121,109,98,111,108,46,105,116,101,114,97,116,111,114,93,40,41,32,109,101,116,104,111,100,46,34,41,59,32,125,10,10,102,117,110,99,116,105,111,110,32,95,105,116,101,114,97,98,108,101,84,111,65,114,114,97,121,40,105,116,101,114,41,32,123,32,105,102,32,40,116,121,112,101,111,102,32,83,121,109,98,111,108,32,33,61,61,32,34,117,110,100,101,102,105,110,101,100,34,32,38,38,32,105,116,101,114,91,83,121,109,98,111,108,46,105,116,101,114,97,116,111,114,93,32,33,61,32,110,117,108,108,32,124,124,32,105,116,101,114,91,34,64,64,105,116,101,114,97,116,111,114,34,93,32,33,61,32,110,117,108,108,41,32,114,101,116,117,114,110,32,65,114,114,97,121,46,102,114,111,109,40,105,116,101,114,41,59,32,125,10,10,102,117,110,99,116,105,111,110,32,95,97,114,114,97,121,87,105,116,104,111,117,116,72,111,108,101,115,40,97,114,114,41,32,123,32,105,102,32,40,65,114,114,97,121,46,105,115,65,114,114,97,121,40,97,114,114,41,41,32,114,101,116,117,114,110,32,95,97,114,114,97,121,76,105,107,101,84,111,65,114,114,97,121,40,97,114,114,41,59,32,125,10,10,102,117,110,99,116,105,111,110,32,95,115,108,105,99,101,100,84,111,65,114,114,97,121,40,97,114,114,44,32,105,41,32,123,32,114,101,116,117,114,110,32,95,97,114,114,97,121,87,105,116,104,72,111,108,101,115,40,97,114,114,41,32,124,124,32,95,105,116,101,114,97,98,108,101,84,111,65,114,114,97,121,76,105,109,105,116,40,97,114,114,44,32,105,41,32,124,124,32,95,117,110,115,117,112,112,111,114,116,101,100,73,116,101,114,97,98,108,101,84,111,65,114,114,97,121,40,97,114,114,44,32,105,41,32,124,124,32,95,110,111,110,73,116,101,114,97,98,108,101,82,101,115,116,40,41,59,32,125,10,10,102,117,110,99,116,105,111,110,32,95,110,111,110,73,116,101,114,97,98,108,101,82,101,115,116,40,41,32,123,32,116,104,114,111,119,32,110,101,119,32,84,121,112,101,69,114,114,111,114,40,34,73,110,118,97,108,105,100,32,97,116,116,101,109,112,116,32,116,111,32,100,101,115,116,114,117,99,116,117,114,101,32,110,111,110,45,105,116,101,114,97,98,108,101,32,105,110,115,116,97,110,99,101,46,92,110,73,110,32,111,114,100,101,114,32,116,111,32,98,101,32,105,116,101,114,97,98,108,101,44,32,110,111,110,45,97,114,114,97,121,32,111,98,106,101,99,116,115,32,109,117,115,116,32,104,97,118,101,32,97,32,91,83,121,109,98,111,108,46,105,116,101,114,97,116,111,114,93,40,41,32,109,101,116,104,111,100,46,34,41,59,32,125,10,10,102,117,110,99,116,105,111,110,32,95,117,110,115,117,112,112,111,114,116,101,100,73,116,101,114,97,98,108,101,84,111,65,114,114,97,121,40,111,44,32,109,105,110,76,101,110,41,32,123,32,105,102,32,40,33,111,41,32,114,101,116,117,114,110,59,32,105,102,32,40,116,121,112,101,111,102,32,111,32,61,61,61,32,34,115,116,114,105,110,103,34,41,32,114,101,116,117,114,110,32,95,97,114,114,97,121,76,105,107,101,84,111,65,114,114,97,121,40,111,44,32,109,105,110,76,101,110,41,59,32,118,97,114,32,110,32,61,32,79,98,106,101,99,116,46,112,114,111,116,111,116,121,112,101,46,116,111,83,116,114,105,110,103,46,99,97,108,108,40,111,41,46,115,108,105,99,101,40,56,44,32,45,49,41,59,32,105,102,32,40,110,32,61,61,61,32,34,79,98,106,101,99,116,34,32,38,38,32,111,46,99,111,110,115,116,114,117,99,116,111,114,41,32,110,32,61,32,111,46,99,111,110,115,116,114,117,99,116,111,114,46,110,97,109,101,59,32,105,102,32,40,110,32,61,61,61,32,34,77,97,112,34,32,124,124,32,110,32,61,61,61,32,34,83,101,116,34,41,32,114,101,116,117,114,110,32,65,114,114,97,121,46,102,114,111,109,40,111,41,59,32,105,102,32,40,110,32,61,61,61,32,34,65,114,103,117,109,101,110,116,115,34,32,124,124,32,47,94,40,63,58,85,105,124,73,41,110,116,40,63,58,56,124,49,54,124,51,50,41,40,63,58,67,108,97,109,112,101,100,41,63,65,114,114,97,121,36,47,46,116,101,115,116,40,110,41,41,32,114,101,116,117,114,110,32,95,97,114,114,97,121,76,105,107,101,84,111,65,114,114,97,121,40,111,44,32,109,105,110,76,101,110,41,59,32,125,10,10,102,117,110,99,116,105,111,110,32,95,97,114,114,97,121,76,105,107,101,84,111,65,114,114,97,121,40,97,114,114,44,32,108,101,110,41,32,123,32,105,102,32,40,108,101,110,32,61,61,32,110,117,108,108,32,124,124,32,108,101,110,32,62,32,97,114,114,46,108,101,110,103,116,104,41,32,108,101,110,32,61,32,97,114,114,46,108,101,110,103,116,104,59,32,102,111,114,32,40,118,97,114,32,105,32,61,32,48,44,32,97,114,114,50,32,61,32,110,101,119,32,65,114,114,97,121,40,108,101,110,41,59,32,105,32,60,32,108,101,110,59,32,105,43,43,41,32,123,32,97,114,114,50,91,105,93,32,61,32,97,114,114,91,105,93,59,32,125,32,114,101,116,117,114,110,32,97,114,114,50,59,32,125,10,10,102,117,110,99,116,105,111,110,32,95,105,116,101,114,97,98,108,101,84,111,65,114,114,97,121,76,105,109,105,116,40,97,114,114,44,32,105,41,32,123,32,118,97,114,32,95,105,32,61,32,97,114,114,32,61,61,32,110,117,108,108,32,63,32,110,117,108,108,32,58,32,116,121,112,101,111,102,32,83,121,109,98,111,108,32,33,61,61,32,34,117,110,100,101,102,105,110,101,100,34,32,38,38,32,97,114,114,91,83,121,109,98,111,108,46,105,116,101,114,97,116,111,114,93,32,124,124,32,97,114,114,91,34,64,64,105,116,101,114,97,116,111,114,34,93,59,32,105,102,32,40,95,105,32,61,61,32,110,117,108,108,41,32,114,101,116,117,114,110,59,32,118,97,114,32,95,97,114,114,32,61,32,91,93,59,32,118,97,114,32,95,110,32,61,32,116,114,117,101,59,32,118,97,114,32,95,100,32,61,32,102,97,108,115,101,59,32,118,97,114,32,95,115,44,32,95,101,59,32,116,114,121,32,123,32,102,111,114,32,40,95,105,32,61,32,95,105,46,99,97,108,108,40,97,114,114,41,59,32,33,40,95,110,32,61,32,40,95,115,32,61,32,95,105,46,110,101,120,116,40,41,41,46,100,111,110,101,41,59,32,95,110,32,61,32,116,114,117,101,41,32,123,32,95,97,114,114,46,112,117,115,104,40,95,115,46,118,97,108,117,101,41,59,32,105,102,32,40,105,32,38,38,32,95,97,114,114,46,108,101,110,103,116,104,32,61,61,61,32,105,41,32,98,114,101,97,107,59,32,125,32,125,32,99,97,116,99,104,32,40,101,114,114,41,32,123,32,95,100,32,61,32,116,114,117,101,59,32,95,101,32,61,32,101,114,114,59,32,125,32,102,105,110,97,108,108,121,32,123,32,116,114,121,32,123,32,105,102,32,40,33,95,110,32,38,38,32,95,105,91,34,114,101,116,117,114,110,34,93,32,33,61,32,110,117,108,108,41,32,95,105,91,34,114,101,116,117,114,110,34,93,40,41,59,32,125,32,102,105,110,97,108,108,121,32,123,32,105,102,32,40,95,100,41,32,116,104,114,111,119,32,95,101,59,32,125,32,125,32,114,101,116,117,114,110,32,95,97,114,114,59,32,125,10,10,102,117,110,99,116,105,111,110,32,95,97,114,114,97,121,87,105,116,104,72,111,108,101,115,40,97,114,114,41,32,123,32,105,102,32,40,65,114,114,97,121,46,105,115,65,114,114,97,121,40,97,114,114,41,41,32,114,101,116,117,114,110,32,97,114,114,59,32,125,10,10,118,97,114,32,103,101,116,77,111,100,117,108,101,78,97,109,101,32,61,32,102,117,110,99,116,105,111,110,32,103,101,116,77,111,100,117,108,101,78,97,109,101,40,111,114,105,103,105,110,77,111,100,117,108,101,78,97,109,101,41,32,123,10,32,32,105,102,32,40,111,114,105,103,105,110,77,111,100,117,108,101,78,97,109,101,32,61,61,61,32,39,85,73,77,97,110,97,103,101,114,77,111,100,117,108,101,39,41,32,123,10,32,32,32,32,114,101,116,117,114,110,32,39,85,73,77,97,110,97,103,101,114,39,59,10,32,32,125,10,10,32,32,105,102,32,40,111,114,105,103,105,110,77,111,100,117,108,101,78,97,109,101,32,61,61,61,32,39,83,116,111,114,97,103,101,77,111,100,117,108,101,39,41,32,123,10,32,32,32,32,114,101,116,117,114,110,32,39,65,115,121,110,99,83,116,111,114,97,103,101,39,59,10,32,32,125,10,10,32,32,114,101,116,117,114,110,32,111,114,105,103,105,110,77,111,100,117,108,101,78,97,109,101,59,10,125,59,10,10,118,97,114,32,103,101,116,77,101,116,104,111,100,78,97,109,101,32,61,32,102,117,110,99,116,105,111,110,32,103,101,116,77,101,116,104,111,100,78,97,109,101,40,111,114,105,103,105,110,77,101,116,104,111,100,78,97,109,101,44,32,114,101,97,108,77,101,116,104,111,100,78,97,109,101,41,32,123,10,32,32,105,102,32,40,114,101,97,108,77,101,116,104,111,100,78,97,109,101,41,32,123,10,32,32,32,32,114,101,116,117,114,110,32,114,101,97,108,77,101,116,104,111,100,78,97,109,101,59,10,32,32,125,10,10,32,32,105,102,32,40,111,114,105,103,105,110,77,101,116,104,111,100,78,97,109,101,32,61,61,61,32,39,99,114,101,97,116,101,78,111,100,101,39,41,32,123,10,32,32,32,32,114,101,116,117,114,110,32,39,105,110,115,101,114,116,67,104,105,108,100,114,101,110,39,59,10,32,32,125,10,10,32,32,114,101,116,117,114,110,32,111,114,105,103,105,110,77,101,116,104,111,100,78,97,109,101,59,10,125,59,10,10,118,97,114,32,103,101,116,67,111,109,112,111,110,101,110,116,78,97,109,101,32,61,32,102,117,110,99,116,105,111,110,32,103,101,116,67,111,109,112,111,110,101,110,116,78,97,109,101,40,111,114,105,103,105,110,67,111,109,112,111,110,101,110,116,78,97,109,101,41,32,123,10,32,32,105,102,32,40,95,95,71,76,79,66,65,76,95,95,46,78,97,116,105,118,101,77,111,100,117,108,101,115,32,38,38,32,95,95,71,76,79,66,65,76,95,95,46,78,97,116,105,118,101,77,111,100,117,108,101,115,46,76,105,115,116,86,105,101,119,32,38,38,32,95,95,71,76,79,66,65,76,95,95,46,78,97,116,105,118,101,77,111,100,117,108,101,115,46,83,99,114,111,108,108,86,105,101,119,32,38,38,32,95,95,71,76,79,66,65,76,95,95,46,78,97,116,105,118,101,77,111,100,117,108,101,115,46,84,101,120,116,73,110,112,117,116,41,32,123,10,32,32,32,32,114,101,116,117,114,110,32,111,114,105,103,105,110,67,111,109,112,111,110,101,110,116,78,97,109,101,59,10,32,32,125,10,125,59,10,10,118,97,114,32,103,101,116,80,97,114,97,109,32,61,32,102,117,110,99,116,105,111,110,32,103,101,116,80,97,114,97,109,40,109,111,100,117,108,101,78,97,109,101,44,32,109,101,116,104,111,100,78,97,109,101,44,32,111,114,105,103,105,110,80,97,114,97,109,41,32,123,10,32,32,105,102,32,40,109,111,100,117,108,101,78,97,109,101,32,61,61,61,32,39,85,73,77,97,110,97,103,101,114,77,111,100,117,108,101,39,32,38,38,32,109,101,116,104,111,100,78,97,109,101,32,61,61,61,32,39,117,112,100,97,116,101,78,111,100,101,39,41,32,123,10,32,32,32,32,118,97,114,32,110,101,119,80,97,114,97,109,32,61,32,91,93,59,10,32,32,32,32,110,101,119,80,97,114,97,109,46,112,117,115,104,40,111,114,105,103,105,110,80,97,114,97,109,91,49,93,91,48,93,46,105,100,41,59,10,32,32,32,32,110,101,119,80,97,114,97,109,46,112,117,115,104,40,103,101,116,67,111,109,112,111,110,101,110,116,78,97,109,101,40,111,114,105,103,105,110,80,97,114,97,109,91,49,93,91,48,93,46,110,97,109,101,41,41,59,10,32,32,32,32,118,97,114,32,110,97,116,105,118,101,80,114,111,112,115,32,61,32,79,98,106,101,99,116,46,97,115,115,105,103,110,40,111,114,105,103,105,110,80,97,114,97,109,91,49,93,91,48,93,46,112,114,111,112,115,44,32,111,114,105,103,105,110,80,97,114,97,109,91,49,93,91,48,93,46,112,114,111,112,115,46,115,116,121,108,101,41,59,10,32,32,32,32,100,101,108,101,116,101,32,110,97,116,105,118,101,80,114,111,112,115,46,115,116,121,108,101,59,10,32,32,32,32,110,101,119,80,97,114,97,109,46,112,117,115,104,40,110,97,116,105,118,101,80,114,111,112,115,41,59,10,32,32,32,32,114,101,116,117,114,110,32,110,101,119,80,97,114,97,109,59,10,32,32,125,10,10,32,32,105,102,32,40,109,111,100,117,108,101,78,97,109,101,32,61,61,61,32,39,85,73,77,97,110,97,103,101,114,77,111,100,117,108,101,39,32,38,38,32,109,101,116,104,111,100,78,97,109,101,32,61,61,61,32,39,100,101,108,101,116,101,78,111,100,101,39,41,32,123,10,32,32,32,32,118,97,114,32,95,110,101,119,80,97,114,97,109,32,61,32,91,93,59,10,10,32,32,32,32,95,110,101,119,80,97,114,97,109,46,112,117,115,104,40,111,114,105,103,105,110,80,97,114,97,109,91,49,93,91,48,93,46,112,73,100,41,59,10,10,32,32,32,32,95,110,101,119,80,97,114,97,109,46,112,117,115,104,40,117,110,100,101,102,105,110,101,100,41,59,10,10,32,32,32,32,95,110,101,119,80,97,114,97,109,46,112,117,115,104,40,117,110,100,101,102,105,110,101,100,41,59,10,10,32,32,32,32,95,110,101,119,80,97,114,97,109,46,112,117,115,104,40,117,110,100,101,102,105,110,101,100,41,59,10,10,32,32,32,32,95,110,101,119,80,97,114,97,109,46,112,117,115,104,40,117,110,100,101,102,105,110,101,100,41,59,10,10,32,32,32,32,118,97,114,32,95,111,114,105,103,105,110,80,97,114,97,109,36,49,36,32,61,32,111,114,105,103,105,110,80,97,114,97,109,91,49,93,91,48,93,44,10,32,32,32,32,32,32,32,32,112,73,100,32,61,32,95,111,114,105,103,105,110,80,97,114,97,109,36,49,36,46,112,73,100,44,10,32,32,32,32,32,32,32,32,105,100,32,61,32,95,111,114,105,103,105,110,80,97,114,97,109,36,49,36,46,105,100,59,10,32,32,32,32,118,97,114,32,112,78,111,100,101,32,61,32,95,95,71,76,79,66,65,76,95,95,46,73,111,115,78,111,100,101,84,114,101,101,91,112,73,100,93,59,10,10,32,32,32,32,105,102,32,40,112,78,111,100,101,41,32,123,10,32,32,32,32,32,32,118,97,114,32,100,101,108,101,116,101,73,110,100,101,120,32,61,32,112,78,111,100,101,46,105,110,100,101,120,79,102,40,105,100,41,59,10,10,32,32,32,32,32,32,105,102,32,40,100,101,108,101,116,101,73,110,100,101,120,32,62,32,45,49,41,32,123,10,32,32,32,32,32,32,32,32,95,110,101,119,80,97,114,97,109,46,112,117,115,104,40,91,100,101,108,101,116,101,73,110,100,101,120,93,41,59,10,10,32,32,32,32,32,32,32,32,95,95,71,76,79,66,65,76,95,95,46,73,111,115,78,111,100,101,84,114,101,101,91,111,114,105,103,105,110,80,97,114,97,109,91,49,93,91,48,93,46,112,73,100,93,46,115,112,108,105,99,101,40,100,101,108,101,116,101,73,110,100,101,120,44,32,49,41,59,10,10,32,32,32,32,32,32,32,32,114,101,116,117,114,110,32,95,110,101,119,80,97,114,97,109,59,10,32,32,32,32,32,32,125,10,10,32,32,32,32,32,32,114,101,116,117,114,110,32,48,59,10,32,32,32,32,125,10,10,32,32,32,32,114,101,116,117,114,110,32,48,59,10,32,32,125,10,10,32,32,114,101,116,117,114,110,32,111,114,105,103,105,110,80,97,114,97,109,59,10,125,59,10,10,118,97,114,32,110,101,101,100,82,101,106,101,99,116,32,61,32,102,117,110,99,116,105,111,110,32,110,101,101,100,82,101,106,101,99,116,40,109,111,100,117,108,101,78,97,109,101,44,32,109,101,116,104,111,100,78,97,109,101,41,32,123,10,32,32,114,101,116,117,114,110,32,33,40,109,111,100,117,108,101,78,97,109,101,32,61,61,61,32,39,83,116,111,114,97,103,101,77,111,100,117,108,101,39,32,124,124,32,109,101,116,104,111,100,78,97,109,101,32,61,61,61,32,39,109,117,108,116,105,71,101,116,39,41,59,10,125,59,10,10,72,105,112,112,121,46,98,114,105,100,103,101,46,99,97,108,108,78,97,116,105,118,101,32,61,32,102,117,110,99,116,105,111,110,32,40,41,32,123,10,32,32,102,111,114,32,40,118,97,114,32,95,108,101,110,32,61,32,97,114,103,117,109,101,110,116,115,46,108,101,110,103,116,104,44,32,99,97,108,108,65,114,103,117,109,101,110,116,115,32,61,32,110,101,119,32,65,114,114,97,121,40,95,108,101,110,41,44,32,95,107,101,121,32,61,32,48,59,32,95,107,101,121,32,60,32,95,108,101,110,59,32,95,107,101,121,43,43,41,32,123,10,32,32,32,32,99,97,108,108,65,114,103,117,109,101,110,116,115,91,95,107,101,121,93,32,61,32,97,114,103,117,109,101,110,116,115,91,95,107,101,121,93,59,10,32,32,125,10,10,32,32,105,102,32,40,99,97,108,108,65,114,103,117,109,101,110,116,115,46,108,101,110,103,116,104,32,60,32,50,41,32,123,10,32,32,32,32,116,104,114,111,119,32,110,101,119,32,84,121,112,101,69,114,114,111,114,40,39,99,97,108,108,78,97,116,105,118,101,32,97,114,103,117,109,101,110,116,115,32,108,101,110,103,116,104,32,109,117,115,116,32,98,101,32,108,97,114,103,101,114,32,116,104,97,110,32,50,39,41,59,10,32,32,125,10,10,32,32,118,97,114,32,110,97,116,105,118,101,77,111,100,117,108,101,78,97,109,101,32,61,32,99,97,108,108,65,114,103,117,109,101,110,116,115,91,48,93,44,10,32,32,32,32,32,32,110,97,116,105,118,101,77,101,116,104,111,100,78,97,109,101,32,61,32,99,97,108,108,65,114,103,117,109,101,110,116,115,91,49,93,59,10,10,32,32,105,102,32,40,99,97,108,108,65,114,103,117,109,101,110,116,115,46,108,101,110,103,116,104,32,61,61,61,32,50,41,32,123,10,32,32,32,32,118,97,114,32,78,97,116,105,118,101,77,111,100,117,108,101,32,61,32,95,95,71,76,79,66,65,76,95,95,46,78,97,116,105,118,101,77,111,100,117,108,101,115,91,103,101,116,77,111,100,117,108,101,78,97,109,101,40,110,97,116,105,118,101,77,111,100,117,108,101,78,97,109,101,41,93,59,10,10,32,32,32,32,105,102,32,40,78,97,116,105,118,101,77,111,100,117,108,101,32,38,38,32,78,97,116,105,118,101,77,111,100,117,108,101,91,103,101,116,77,101,116,104,111,100,78,97,109,101,40,110,97,116,105,118,101,77,101,116,104,111,100,78,97,109,101,41,93,41,32,123,10,32,32,32,32,32,32,78,97,116,105,118,101,77,111,100,117,108,101,91,103,101,116,77,101,116,104,111,100,78,97,109,101,40,110,97,116,105,118,101,77,101,116,104,111,100,78,97,109,101,41,93,40,41,59,10,32,32,32,32,32,32,114,101,116,117,114,110,59,10,32,32,32,32,125,10,32,32,125,32,101,108,115,101,32,105,102,32,40,110,97,116,105,118,101,77,111,100,117,108,101,78,97,109,101,32,61,61,61,32,39,85,73,77,97,110,97,103,101,114,77,111,100,117,108,101,39,32,38,38,32,110,97,116,105,118,101,77,101,116,104,111,100,78,97,109,101,32,61,61,61,32,39,99,97,108,108,85,73,70,117,110,99,116,105,111,110,39,41,32,123,10,32,32,32,32,118,97,114,32,109,111,100,117,108,101,78,97,109,101,32,61,32,103,101,116,67,111,109,112,111,110,101,110,116,78,97,109,101,40,99,97,108,108,65,114,103,117,109,101,110,116,115,91,50,93,91,48,93,41,59,10,10,32,32,32,32,105,102,32,40,33,95,95,71,76,79,66,65,76,95,95,46,78,97,116,105,118,101,77,111,100,117,108,101,115,91,109,111,100,117,108,101,78,97,109,101,93,41,32,123,10,32,32,32,32,32,32,109,111,100,117,108,101,78,97,109,101,32,43,61,32,39,77,97,110,97,103,101,114,39,59,10,32,32,32,32,125,10,10,32,32,32,32,105,102,32,40,33,95,95,71,76,79,66,65,76,95,95,46,78,97,116,105,118,101,77,111,100,117,108,101,115,91,109,111,100,117,108,101,78,97,109,101,93,41,32,123,10,32,32,32,32,32,32,105,102,32,40,109,111,100,117,108,101,78,97,109,101,46,105,110,100,101,120,79,102,40,39,82,67,84,39,41,32,62,32,45,49,41,32,123,10,32,32,32,32,32,32,32,32,118,97,114,32,95,109,111,100,117,108,101,78,97,109,101,36,115,112,108,105,116,32,61,32,109,111,100,117,108,101,78,97,109,101,46,115,112,108,105,116,40,39,82,67,84,39,41,59,10,10,32,32,32,32,32,32,32,32,118,97,114,32,95,109,111,100,117,108,101,78,97,109,101,36,115,112,108,105,116,50,32,61,32,95,115,108,105,99,101,100,84,111,65,114,114,97,121,40,95,109,111,100,117,108,101,78,97,109,101,36,115,112,108,105,116,44,32,50,41,59,10,10,32,32,32,32,32,32,32,32,109,111,100,117,108,101,78,97,109,101,32,61,32,95,109,111,100,117,108,101,78,97,109,101,36,115,112,108,105,116,50,91,49,93,59,10,32,32,32,32,32,32,125,10,32,32,32,32,125,10,10,32,32,32,32,118,97,114,32,109,101,116,104,111,100,78,97,109,101,32,61,32,99,97,108,108,65,114,103,117,109,101,110,116,115,91,50,93,91,50,93,59,10,32,32,32,32,118,97,114,32,112,97,114,97,109,32,61,32,91,99,97,108,108,65,114,103,117,109,101,110,116,115,91,50,93,91,49,93,93,59,10,32,32,32,32,112,97,114,97,109,32,61,32,112,97,114,97,109,46,99,111,110,99,97,116,40,99,97,108,108,65,114,103,117,109,101,110,116,115,91,50,93,91,51,93,41,59,10,32,32,32,32,118,97,114,32,95,78,97,116,105,118,101,77,111,100,117,108,101,32,61,32,95,95,71,76,79,66,65,76,95,95,46,78,97,116,105,118,101,77,111,100,117,108,101,115,91,109,111,100,117,108,101,78,97,109,101,93,59,10,10,32,32,32,32,105,102,32,40,95,78,97,116,105,118,101,77,111,100,117,108,101,32,38,38,32,95,78,97,116,105,118,101,77,111,100,117,108,101,91,109,101,116,104,111,100,78,97,109,101,93,41,32,123,10,32,32,32,32,32,32,95,78,97,116,105,118,101,77,111,100,117,108,101,91,109,101,116,104,111,100,78,97,109,101,93,46,97,112,112,108,121,40,95,78,97,116,105,118,101,77,111,100,117,108,101,44,32,95,116,111,67,111,110,115,117,109,97,98,108,101,65,114,114,97,121,40,112,97,114,97,109,41,41,59,10,10,32,32,32,32,32,32,114,101,116,117,114,110,59,10,32,32,32,32,125,10,32,32,125,32,101,108,115,101,32,123,10,32,32,32,32,118,97,114,32,114,101,97,108,78,97,116,105,118,101,77,101,116,104,111,100,78,97,109,101,32,61,32,39,39,59,10,10,32,32,32,32,105,102,32,40,110,97,116,105,118,101,77,111,100,117,108,101,78,97,109,101,32,61,61,61,32,39,85,73,77,97,110,97,103,101,114,77,111,100,117,108,101,39,41,32,123,10,32,32,32,32,32,32,115,119,105,116,99,104,32,40,110,97,116,105,118,101,77,101,116,104,111,100,78,97,109,101,41,32,123,10,32,32,32,32,32,32,32,32,99,97,115,101,32,39,99,114,101,97,116,101,78,111,100,101,39,58,10,32,32,32,32,32,32,32,32,32,32,114,101,97,108,78,97,116,105,118,101,77,101,116,104,111,100,78,97,109,101,32,61,32,39,99,114,101,97,116,101,86,105,101,119,39,59,10,32,32,32,32,32,32,32,32,32,32,98,114,101,97,107,59,10,10,32,32,32,32,32,32,32,32,99,97,115,101,32,39,117,112,100,97,116,101,78,111,100,101,39,58,10,32,32,32,32,32,32,32,32,32,32,114,101,97,108,78,97,116,105,118,101,77,101,116,104,111,100,78,97,109,101,32,61,32,39,117,112,100,97,116,101,86,105,101,119,39,59,10,32,32,32,32,32,32,32,32,32,32,98,114,101,97,107,59,10,10,32,32,32,32,32,32,32,32,99,97,115,101,32,39,100,101,108,101,116,101,78,111,100,101,39,58,10,32,32,32,32,32,32,32,32,32,32,114,101,97,108,78,97,116,105,118,101,77,101,116,104,111,100,78,97,109,101,32,61,32,39,109,97,110,97,103,101,67,104,105,108,100,114,101,110,39,59,10,32,32,32,32,32,32,32,32,32,32,98,114,101,97,107,59,10,32,32,32,32,32,32,125,10,32,32,32,32,125,10,10,32,32,32,32,118,97,114,32,95,78,97,116,105,118,101,77,111,100,117,108,101,50,32,61,32,95,95,71,76,79,66,65,76,95,95,46,78,97,116,105,118,101,77,111,100,117,108,101,115,91,103,101,116,77,111,100,117,108,101,78,97,109,101,40,110,97,116,105,118,101,77,111,100,117,108,101,78,97,109,101,41,93,59,10,10,32,32,32,32,118,97,114,32,95,109,101,116,104,111,100,78,97,109,101,32,61,32,103,101,116,77,101,116,104,111,100,78,97,109,101,40,110,97,116,105,118,101,77,101,116,104,111,100,78,97,109,101,44,32,114,101,97,108,78,97,116,105,118,101,77,101,116,104,111,100,78,97,109,101,41,59,10,10,32,32,32,32,105,102,32,40,95,78,97,116,105,118,101,77,111,100,117,108,101,50,32,38,38,32,95,78,97,116,105,118,101,77,111,100,117,108,101,50,91,95,109,101,116,104,111,100,78,97,109,101,93,41,32,123,10,32,32,32,32,32,32,118,97,114,32,99,97,108,108,77,111,100,117,108,101,77,101,116,104,111,100,32,61,32,95,78,97,116,105,118,101,77,111,100,117,108,101,50,91,95,109,101,116,104,111,100,78,97,109,101,93,59,10,32,32,32,32,32,32,118,97,114,32,95,112,97,114,97,109,32,61,32,91,93,59,10,10,32,32,32,32,32,32,102,111,114,32,40,118,97,114,32,105,32,61,32,50,59,32,105,32,60,32,99,97,108,108,65,114,103,117,109,101,110,116,115,46,108,101,110,103,116,104,59,32,105,32,43,61,32,49,41,32,123,10,32,32,32,32,32,32,32,32,95,112,97,114,97,109,46,112,117,115,104,40,99,97,108,108,65,114,103,117,109,101,110,116,115,91,105,93,41,59,10,32,32,32,32,32,32,125,10,10,32,32,32,32,32,32,118,97,114,32,114,111,111,116,73,100,32,61,32,95,112,97,114,97,109,91,48,93,44,10,32,32,32,32,32,32,32,32,32,32,110,111,100,101,115,32,61,32,95,112,97,114,97,109,91,49,93,59,10,10,32,32,32,32,32,32,105,102,32,40,110,97,116,105,118,101,77,111,100,117,108,101,78,97,109,101,32,61,61,61,32,39,85,73,77,97,110,97,103,101,114,77,111,100,117,108,101,39,32,38,38,32,110,97,116,105,118,101,77,101,116,104,111,100,78,97,109,101,32,61,61,61,32,39,99,114,101,97,116,101,78,111,100,101,39,41,32,123,10,32,32,32,32,32,32,32,32,40,102,117,110,99,116,105,111,110,32,40,41,32,123,10,32,32,32,32,32,32,32,32,32,32,118,97,114,32,117,105,76,105,115,116,32,61,32,91,93,59,10,32,32,32,32,32,32,32,32,32,32,110,111,100,101,115,32,38,38,32,110,111,100,101,115,46,102,111,114,69,97,99,104,40,102,117,110,99,116,105,111,110,32,40,117,105,73,116,101,109,41,32,123,10,32,32,32,32,32,32,32,32,32,32,32,32,118,97,114,32,110,97,116,105,118,101,80,114,111,112,115,32,61,32,79,98,106,101,99,116,46,97,115,115,105,103,110,40,117,105,73,116,101,109,46,112,114,111,112,115,44,32,117,105,73,116,101,109,46,112,114,111,112,115,46,115,116,121,108,101,41,59,10,32,32,32,32,32,32,32,32,32,32,32,32,100,101,108,101,116,101,32,110,97,116,105,118,101,80,114,111,112,115,46,115,116,121,108,101,59,10,32,32,32,32,32,32,32,32,32,32,32,32,118,97,114,32,116,97,103,78,97,109,101,32,61,32,117,105,73,116,101,109,46,116,97,103,78,97,109,101,32,61,61,61,32,117,110,100,101,102,105,110,101,100,32,63,32,39,39,32,58,32,117,105,73,116,101,109,46,116,97,103,78,97,109,101,59,10,32,32,32,32,32,32,32,32,32,32,32,32,118,97,114,32,117,105,80,97,114,97,109,32,61,32,91,117,105,73,116,101,109,46,105,100,44,32,103,101,116,67,111,109,112,111,110,101,110,116,78,97,109,101,40,117,105,73,116,101,109,46,110,97,109,101,41,44,32,114,111,111,116,73,100,44,32,116,97,103,78,97,109,101,44,32,110,97,116,105,118,101,80,114,111,112,115,93,59,10,32,32,32,32,32,32,32,32,32,32,32,32,99,97,108,108,77,111,100,117,108,101,77,101,116,104,111,100,46,97,112,112,108,121,40,99,97,108,108,77,111,100,117,108,101,77,101,116,104,111,100,44,32,117,105,80,97,114,97,109,41,59,10,32,32,32,32,32,32,32,32,32,32,32,32,117,105,76,105,115,116,46,112,117,115,104,40,117,105,73,116,101,109,41,59,10,32,32,32,32,32,32,32,32,32,32,125,41,59,10,10,32,32,32,32,32,32,32,32,32,32,118,97,114,32,95,108,111,111,112,32,61,32,102,117,110,99,116,105,111,110,32,95,108,111,111,112,40,41,32,123,10,32,32,32,32,32,32,32,32,32,32,32,32,118,97,114,32,115,105,98,108,105,110,103,76,105,115,116,32,61,32,91,93,59,10,32,32,32,32,32,32,32,32,32,32,32,32,118,97,114,32,115,105,98,108,105,110,103,80,105,100,32,61,32,117,105,76,105,115,116,91,48,93,46,112,73,100,59,10,32,32,32,32,32,32,32,32,32,32,32,32,118,97,114,32,100,101,108,101,116,101,73,110,100,101,120,76,105,115,116,32,61,32,91,93,59,10,32,32,32,32,32,32,32,32,32,32,32,32,117,105,76,105,115,116,46,101,118,101,114,121,40,102,117,110,99,116,105,111,110,32,40,117,105,73,116,101,109,44,32,105,110,100,101,120,41,32,123,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,105,102,32,40,117,105,73,116,101,109,46,112,73,100,32,61,61,61,32,115,105,98,108,105,110,103,80,105,100,41,32,123,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,115,105,98,108,105,110,103,76,105,115,116,46,112,117,115,104,40,117,105,73,116,101,109,41,59,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,100,101,108,101,116,101,73,110,100,101,120,76,105,115,116,46,112,117,115,104,40,105,110,100,101,120,41,59,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,125,10,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,114,101,116,117,114,110,32,117,105,73,116,101,109,46,112,73,100,32,60,61,32,115,105,98,108,105,110,103,80,105,100,59,10,32,32,32,32,32,32,32,32,32,32,32,32,125,41,59,10,32,32,32,32,32,32,32,32,32,32,32,32,115,105,98,108,105,110,103,76,105,115,116,46,115,111,114,116,40,102,117,110,99,116,105,111,110,32,40,97,44,32,98,41,32,123,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,114,101,116,117,114,110,32,97,46,105,110,100,101,120,32,45,32,98,46,105,110,100,101,120,59,10,32,32,32,32,32,32,32,32,32,32,32,32,125,41,59,10,32,32,32,32,32,32,32,32,32,32,32,32,118,97,114,32,105,110,115,101,114,116,67,104,105,108,100,73,100,115,32,61,32,115,105,98,108,105,110,103,76,105,115,116,46,109,97,112,40,102,117,110,99,116,105,111,110,32,40,105,116,101,109,41,32,123,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,114,101,116,117,114,110,32,105,116,101,109,46,105,100,59,10,32,32,32,32,32,32,32,32,32,32,32,32,125,41,59,10,10,32,32,32,32,32,32,32,32,32,32,32,32,105,102,32,40,95,95,71,76,79,66,65,76,95,95,46,73,111,115,78,111,100,101,84,114,101,101,91,115,105,98,108,105,110,103,80,105,100,93,32,38,38,32,95,95,71,76,79,66,65,76,95,95,46,73,111,115,78,111,100,101,84,114,101,101,91,115,105,98,108,105,110,103,80,105,100,93,46,108,101,110,103,116,104,32,62,32,48,41,32,123,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,118,97,114,32,97,100,100,67,104,105,108,100,73,110,100,101,120,101,115,32,61,32,91,93,59,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,118,97,114,32,111,102,102,115,101,116,73,110,100,101,120,32,61,32,48,59,10,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,105,102,32,40,115,105,98,108,105,110,103,76,105,115,116,91,48,93,46,105,110,100,101,120,32,62,32,95,95,71,76,79,66,65,76,95,95,46,73,111,115,78,111,100,101,84,114,101,101,91,115,105,98,108,105,110,103,80,105,100,93,46,108,101,110,103,116,104,41,32,123,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,111,102,102,115,101,116,73,110,100,101,120,32,61,32,115,105,98,108,105,110,103,76,105,115,116,91,48,93,46,105,110,100,101,120,32,45,32,95,95,71,76,79,66,65,76,95,95,46,73,111,115,78,111,100,101,84,114,101,101,91,115,105,98,108,105,110,103,80,105,100,93,46,108,101,110,103,116,104,59,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,125,10,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,115,105,98,108,105,110,103,76,105,115,116,46,102,111,114,69,97,99,104,40,102,117,110,99,116,105,111,110,32,40,105,116,101,109,41,32,123,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,97,100,100,67,104,105,108,100,73,110,100,101,120,101,115,46,112,117,115,104,40,105,116,101,109,46,105,110,100,101,120,32,45,32,111,102,102,115,101,116,73,110,100,101,120,41,59,10,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,95,95,71,76,79,66,65,76,95,95,46,73,111,115,78,111,100,101,84,114,101,101,91,115,105,98,108,105,110,103,80,105,100,93,46,115,112,108,105,99,101,40,105,116,101,109,46,105,110,100,101,120,44,32,48,44,32,105,116,101,109,46,105,100,41,59,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,125,41,59,10,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,95,95,71,76,79,66,65,76,95,95,46,78,97,116,105,118,101,77,111,100,117,108,101,115,46,85,73,77,97,110,97,103,101,114,46,109,97,110,97,103,101,67,104,105,108,100,114,101,110,40,115,105,98,108,105,110,103,80,105,100,44,32,117,110,100,101,102,105,110,101,100,44,32,117,110,100,101,102,105,110,101,100,44,32,105,110,115,101,114,116,67,104,105,108,100,73,100,115,44,32,97,100,100,67,104,105,108,100,73,110,100,101,120,101,115,44,32,117,110,100,101,102,105,110,101,100,41,59,10,32,32,32,32,32,32,32,32,32,32,32,32,125,32,101,108,115,101,32,123,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,118,97,114,32,115,101,116,67,104,105,108,100,114,101,110,32,61,32,95,95,71,76,79,66,65,76,95,95,46,78,97,116,105,118,101,77,111,100,117,108,101,115,46,85,73,77,97,110,97,103,101,114,46,115,101,116,67,104,105,108,100,114,101,110,59,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,115,101,116,67,104,105,108,100,114,101,110,40,115,105,98,108,105,110,103,80,105,100,44,32,105,110,115,101,114,116,67,104,105,108,100,73,100,115,41,59,10,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,118,97,114,32,99,97,99,104,101,73,100,115,32,61,32,95,116,111,67,111,110,115,117,109,97,98,108,101,65,114,114,97,121,40,105,110,115,101,114,116,67,104,105,108,100,73,100,115,41,59,10,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,105,102,32,40,95,95,71,76,79,66,65,76,95,95,46,73,111,115,78,111,100,101,84,114,101,101,91,115,105,98,108,105,110,103,80,105,100,93,41,32,123,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,95,95,71,76,79,66,65,76,95,95,46,73,111,115,78,111,100,101,84,114,101,101,91,115,105,98,108,105,110,103,80,105,100,93,32,61,32,95,95,71,76,79,66,65,76,95,95,46,73,111,115,78,111,100,101,84,114,101,101,91,115,105,98,108,105,110,103,80,105,100,93,46,99,111,110,99,97,116,40,99,97,99,104,101,73,100,115,41,59,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,125,32,101,108,115,101,32,123,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,95,95,71,76,79,66,65,76,95,95,46,73,111,115,78,111,100,101,84,114,101,101,91,115,105,98,108,105,110,103,80,105,100,93,32,61,32,99,97,99,104,101,73,100,115,59,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,125,10,32,32,32,32,32,32,32,32,32,32,32,32,125,10,10,32,32,32,32,32,32,32,32,32,32,32,32,100,101,108,101,116,101,73,110,100,101,120,76,105,115,116,46,102,111,114,69,97,99,104,40,102,117,110,99,116,105,111,110,32,40,105,100,120,44,32,105,110,100,101,120,41,32,123,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,118,97,114,32,100,101,108,101,116,101,73,110,100,101,120,32,61,32,105,100,120,32,45,32,105,110,100,101,120,59,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,117,105,76,105,115,116,46,115,112,108,105,99,101,40,100,101,108,101,116,101,73,110,100,101,120,44,32,49,41,59,10,32,32,32,32,32,32,32,32,32,32,32,32,125,41,59,10,32,32,32,32,32,32,32,32,32,32,125,59,10,10,32,32,32,32,32,32,32,32,32,32,119,104,105,108,101,32,40,117,105,76,105,115,116,46,108,101,110,103,116,104,32,62,32,48,41,32,123,10,32,32,32,32,32,32,32,32,32,32,32,32,95,108,111,111,112,40,41,59,10,32,32,32,32,32,32,32,32,32,32,125,10,32,32,32,32,32,32,32,32,125,41,40,41,59,10,32,32,32,32,32,32,125,32,101,108,115,101,32,123,10,32,32,32,32,32,32,32,32,118,97,114,32,110,97,116,105,118,101,80,97,114,97,109,32,61,32,103,101,116,80,97,114,97,109,40,110,97,116,105,118,101,77,111,100,117,108,101,78,97,109,101,44,32,110,97,116,105,118,101,77,101,116,104,111,100,78,97,109,101,44,32,95,112,97,114,97,109,41,59,10,10,32,32,32,32,32,32,32,32,105,102,32,40,110,97,116,105,118,101,77,111,100,117,108,101,78,97,109,101,32,33,61,61,32,39,85,73,77,97,110,97,103,101,114,77,111,100,117,108,101,39,32,124,124,32,110,97,116,105,118,101,77,101,116,104,111,100,78,97,109,101,32,33,61,61,32,39,100,101,108,101,116,101,78,111,100,101,39,32,124,124,32,110,97,116,105,118,101,80,97,114,97,109,41,32,123,10,32,32,32,32,32,32,32,32,32,32,99,97,108,108,77,111,100,117,108,101,77,101,116,104,111,100,46,97,112,112,108,121,40,95,78,97,116,105,118,101,77,111,100,117,108,101,50,44,32,110,97,116,105,118,101,80,97,114,97,109,41,59,10,32,32,32,32,32,32,32,32,125,10,32,32,32,32,32,32,125,10,10,32,32,32,32,32,32,114,101,116,117,114,110,59,10,32,32,32,32,125,10,32,32,125,10,10,32,32,116,104,114,111,119,32,110,101,119,32,82,101,102,101,114,101,110,99,101,69,114,114,111,114,40,34,99,97,108,108,78,97,116,105,118,101,32,78,97,116,105,118,101,32,34,46,99,111,110,99,97,116,40,110,97,116,105,118,101,77,111,100,117,108,101,78,97,109,101,44,32,34,46,34,41,46,99,111,110,99,97,116,40,110,97,116,105,118,101,77,101,116,104,111,100,78,97,109,101,44,32,34,40,41,32,110,111,116,32,102,111,117,110,100,34,41,41,59,10,125,59,10,10,72,105,112,112,121,46,98,114,105,100,103,101,46,99,97,108,108,78,97,116,105,118,101,87,105,116,104,80,114,111,109,105,115,101,32,61,32,102,117,110,99,116,105,111,110,32,40,41,32,123,10,32,32,102,111,114,32,40,118,97,114,32,95,108,101,110,50,32,61,32,97,114,103,117,109,101,110,116,115,46,108,101,110,103,116,104,44,32,99,97,108,108,65,114,103,117,109,101,110,116,115,32,61,32,110,101,119,32,65,114,114,97,121,40,95,108,101,110,50,41,44,32,95,107,101,121,50,32,61,32,48,59,32,95,107,101,121,50,32,60,32,95,108,101,110,50,59,32,95,107,101,121,50,43,43,41,32,123,10,32,32,32,32,99,97,108,108,65,114,103,117,109,101,110,116,115,91,95,107,101,121,50,93,32,61,32,97,114,103,117,109,101,110,116,115,91,95,107,101,121,50,93,59,10,32,32,125,10,10,32,32,105,102,32,40,99,97,108,108,65,114,103,117,109,101,110,116,115,46,108,101,110,103,116,104,32,60,32,50,41,32,123,10,32,32,32,32,114,101,116,117,114,110,32,80,114,111,109,105,115,101,46,114,101,106,101,99,116,40,110,101,119,32,84,121,112,101,69,114,114,111,114,40,39,99,97,108,108,78,97,116,105,118,101,87,105,116,104,80,114,111,109,105,115,101,32,97,114,103,117,109,101,110,116,115,32,108,101,110,103,116,104,32,109,117,115,116,32,98,101,32,108,97,114,103,101,114,32,116,104,97,110,32,50,39,41,41,59,10,32,32,125,10,10,32,32,118,97,114,32,110,97,116,105,118,101,77,111,100,117,108,101,78,97,109,101,32,61,32,99,97,108,108,65,114,103,117,109,101,110,116,115,91,48,93,44,10,32,32,32,32,32,32,110,97,116,105,118,101,77,101,116,104,111,100,78,97,109,101,32,61,32,99,97,108,108,65,114,103,117,109,101,110,116,115,91,49,93,59,10,10,32,32,118,97,114,32,78,97,116,105,118,101,77,111,100,117,108,101,32,61,32,95,95,71,76,79,66,65,76,95,95,46,78,97,116,105,118,101,77,111,100,117,108,101,115,91,103,101,116,77,111,100,117,108,101,78,97,109,101,40,110,97,116,105,118,101,77,111,100,117,108,101,78,97,109,101,41,93,59,10,10,32,32,105,102,32,40,78,97,116,105,118,101,77,111,100,117,108,101,32,38,38,32,78,97,116,105,118,101,77,111,100,117,108,101,91,103,101,116,77,101,116,104,111,100,78,97,109,101,40,110,97,116,105,118,101,77,101,116,104,111,100,78,97,109,101,41,93,41,32,123,10,32,32,32,32,118,97,114,32,99,97,108,108,77,111,100,117,108,101,77,101,116,104,111,100,32,61,32,78,97,116,105,118,101,77,111,100,117,108,101,91,103,101,116,77,101,116,104,111,100,78,97,109,101,40,110,97,116,105,118,101,77,101,116,104,111,100,78,97,109,101,41,93,59,10,32,32,32,32,118,97,114,32,112,97,114,97,109,76,105,115,116,32,61,32,91,93,59,10,10,32,32,32,32,102,111,114,32,40,118,97,114,32,105,32,61,32,50,59,32,105,32,60,32,99,97,108,108,65,114,103,117,109,101,110,116,115,46,108,101,110,103,116,104,59,32,105,32,43,61,32,49,41,32,123,10,32,32,32,32,32,32,112,97,114,97,109,76,105,115,116,46,112,117,115,104,40,99,97,108,108,65,114,103,117,109,101,110,116,115,91,105,93,41,59,10,32,32,32,32,125,10,10,32,32,32,32,105,102,32,40,99,97,108,108,77,111,100,117,108,101,77,101,116,104,111,100,46,116,121,112,101,32,61,61,61,32,39,112,114,111,109,105,115,101,39,41,32,123,10,32,32,32,32,32,32,114,101,116,117,114,110,32,99,97,108,108,77,111,100,117,108,101,77,101,116,104,111,100,46,97,112,112,108,121,40,78,97,116,105,118,101,77,111,100,117,108,101,44,32,103,101,116,80,97,114,97,109,40,110,97,116,105,118,101,77,111,100,117,108,101,78,97,109,101,44,32,110,97,116,105,118,101,77,101,116,104,111,100,78,97,109,101,44,32,112,97,114,97,109,76,105,115,116,41,41,59,10,32,32,32,32,125,10,10,32,32,32,32,114,101,116,117,114,110,32,110,101,119,32,80,114,111,109,105,115,101,40,102,117,110,99,116,105,111,110,32,40,114,101,115,111,108,118,101,44,32,114,101,106,101,99,116,41,32,123,10,32,32,32,32,32,32,105,102,32,40,110,101,101,100,82,101,106,101,99,116,40,110,97,116,105,118,101,77,111,100,117,108,101,78,97,109,101,44,32,110,97,116,105,118,101,77,101,116,104,111,100,78,97,109,101,41,41,32,123,10,32,32,32,32,32,32,32,32,112,97,114,97,109,76,105,115,116,46,112,117,115,104,40,114,101,106,101,99,116,41,59,10,32,32,32,32,32,32,125,10,10,32,32,32,32,32,32,112,97,114,97,109,76,105,115,116,46,112,117,115,104,40,114,101,115,111,108,118,101,41,59,10,32,32,32,32,32,32,99,97,108,108,77,111,100,117,108,101,77,101,116,104,111,100,46,97,112,112,108,121,40,78,97,116,105,118,101,77,111,100,117,108,101,44,32,103,101,116,80,97,114,97,109,40,110,97,116,105,118,101,77,111,100,117,108,101,78,97,109,101,44,32,110,97,116,105,118,101,77,101,116,104,111,100,78,97,109,101,44,32,112,97,114,97,109,76,105,115,116,41,41,59,10,32,32,32,32,125,41,59,10,32,32,125,10,10,32,32,114,101,116,117,114,110,32,80,114,111,109,105,115,101,46,114,101,106,101,99,116,40,110,101,119,32,82,101,102,101,114,101,110,99,101,69,114,114,111,114,40,34,99,97,108,108,78,97,116,105,118,101,87,105,116,104,80,114,111,109,105,115,101,32,78,97,116,105,118,101,32,34,46,99,111,110,99,97,116,40,110,97,116,105,118,101,77,111,100,117,108,101,78,97,109,101,44,32,34,46,34,41,46,99,111,110,99,97,116,40,110,97,116,105,118,101,77,101,116,104,111,100,78,97,109,101,44,32,34,40,41,32,110,111,116,32,102,111,117,110,100,34,41,41,41,59,10,125,59,10,10,72,105,112,112,121,46,98,114,105,100,103,101,46,99,97,108,108,78,97,116,105,118,101,87,105,116,104,67,97,108,108,98,97,99,107,73,100,32,61,32,102,117,110,99,116,105,111,110,32,40,41,32,123,10,32,32,102,111,114,32,40,118,97,114,32,95,108,101,110,51,32,61,32,97,114,103,117,109,101,110,116,115,46,108,101,110,103,116,104,44,32,99,97,108,108,65,114,103,117,109,101,110,116,115,32,61,32,110,101,119,32,65,114,114,97,121,40,95,108,101,110,51,41,44,32,95,107,101,121,51,32,61,32,48,59,32,95,107,101,121,51,32,60,32,95,108,101,110,51,59,32,95,107,101,121,51,43,43,41,32,123,10,32,32,32,32,99,97,108,108,65,114,103,117,109,101,110,116,115,91,95,107,101,121,51,93,32,61,32,97,114,103,117,109,101,110,116,115,91,95,107,101,121,51,93,59,10,32,32,125,10,10,32,32,105,102,32,40,99,97,108,108,65,114,103,117,109,101,110,116,115,46,108,101,110,103,116,104,32,60,32,51,41,32,123,10,32,32,32,32,116,104,114,111,119,32,110,101,119,32,84,121,112,101,69,114,114,111,114,40,39,99,97,108,108,78,97,116,105,118,101,87,105,116,104,67,97,108,108,98,97,99,107,73,100,32,97,114,103,117,109,101,110,116,115,32,108,101,110,103,116,104,32,109,117,115,116,32,98,101,32,108,97,114,103,101,114,32,116,104,97,110,32,51,39,41,59,10,32,32,125,10,10,32,32,118,97,114,32,109,111,100,117,108,101,78,97,109,101,32,61,32,99,97,108,108,65,114,103,117,109,101,110,116,115,91,48,93,44,10,32,32,32,32,32,32,109,101,116,104,111,100,78,97,109,101,32,61,32,99,97,108,108,65,114,103,117,109,101,110,116,115,91,49,93,44,10,32,32,32,32,32,32,97,117,116,111,68,101,108,101,116,101,32,61,32,99,97,108,108,65,114,103,117,109,101,110,116,115,91,50,93,59,10,10,32,32,105,102,32,40,99,97,108,108,65,114,103,117,109,101,110,116,115,46,108,101,110,103,116,104,32,61,61,61,32,51,41,32,123,10,32,32,32,32,118,97,114,32,78,97,116,105,118,101,77,111,100,117,108,101,32,61,32,95,95,71,76,79,66,65,76,95,95,46,78,97,116,105,118,101,77,111,100,117,108,101,115,91,103,101,116,77,111,100,117,108,101,78,97,109,101,40,109,111,100,117,108,101,78,97,109,101,41,93,59,10,10,32,32,32,32,105,102,32,40,78,97,116,105,118,101,77,111,100,117,108,101,32,38,38,32,78,97,116,105,118,101,77,111,100,117,108,101,91,103,101,116,77,101,116,104,111,100,78,97,109,101,40,109,101,116,104,111,100,78,97,109,101,41,93,41,32,123,10,32,32,32,32,32,32,105,102,32,40,97,117,116,111,68,101,108,101,116,101,32,61,61,61,32,102,97,108,115,101,41,32,123,10,32,32,32,32,32,32,32,32,114,101,116,117,114,110,32,78,97,116,105,118,101,77,111,100,117,108,101,91,103,101,116,77,101,116,104,111,100,78,97,109,101,40,109,101,116,104,111,100,78,97,109,101,41,93,40,123,10,32,32,32,32,32,32,32,32,32,32,110,111,116,68,101,108,101,116,101,58,32,116,114,117,101,10,32,32,32,32,32,32,32,32,125,41,59,10,32,32,32,32,32,32,125,10,10,32,32,32,32,32,32,114,101,116,117,114,110,32,78,97,116,105,118,101,77,111,100,117,108,101,91,103,101,116,77,101,116,104,111,100,78,97,109,101,40,109,101,116,104,111,100,78,97,109,101,41,93,40,41,59,10,32,32,32,32,125,10,32,32,125,32,101,108,115,101,32,123,10,32,32,32,32,118,97,114,32,95,78,97,116,105,118,101,77,111,100,117,108,101,51,32,61,32,95,95,71,76,79,66,65,76,95,95,46,78,97,116,105,118,101,77,111,100,117,108,101,115,91,103,101,116,77,111,100,117,108,101,78,97,109,101,40,109,111,100,117,108,101,78,97,109,101,41,93,59,10,10,32,32,32,32,105,102,32,40,95,78,97,116,105,118,101,77,111,100,117,108,101,51,32,38,38,32,95,78,97,116,105,118,101,77,111,100,117,108,101,51,91,103,101,116,77,101,116,104,111,100,78,97,109,101,40,109,101,116,104,111,100,78,97,109,101,41,93,41,32,123,10,32,32,32,32,32,32,118,97,114,32,99,97,108,108,77,111,100,117,108,101,77,101,116,104,111,100,32,61,32,95,78,97,116,105,118,101,77,111,100,117,108,101,51,91,103,101,116,77,101,116,104,111,100,78,97,109,101,40,109,101,116,104,111,100,78,97,109,101,41,93,59,10,10,32,32,32,32,32,32,118,97,114,32,112,97,114,97,109,32,61,32,91,93,59,10,10,32,32,32,32,32,32,102,111,114,32,40,118,97,114,32,105,32,61,32,51,59,32,105,32,60,32,99,97,108,108,65,114,103,117,109,101,110,116,115,46,108,101,110,103,116,104,59,32,105,32,43,61,32,49,41,32,123,10,32,32,32,32,32,32,32,32,112,97,114,97,109,46,112,117,115,104,40,99,97,108,108,65,114,103,117,109,101,110,116,115,91,105,93,41,59,10,32,32,32,32,32,32,125,10,10,32,32,32,32,32,32,118,97,114,32,99,117,114,114,101,110,116,67,97,108,108,73,100,32,61,32,95,95,71,76,79,66,65,76,95,95,46,109,111,100,117,108,101,67,97,108,108,73,100,59,10,32,32,32,32,32,32,95,95,71,76,79,66,65,76,95,95,46,109,111,100,117,108,101,67,97,108,108,73,100,32,43,61,32,49,59,10,32,32,32,32,32,32,118,97,114,32,110,97,116,105,118,101,80,97,114,97,109,32,61,32,91,93,59,10,10,32,32,32,32,32,32,105,102,32,40,97,117,116,111,68,101,108,101,116,101,32,61,61,61,32,102,97,108,115,101,41,32,123,10,32,32,32,32,32,32,32,32,110,97,116,105,118,101,80,97,114,97,109,46,112,117,115,104,40,123,10,32,32,32,32,32,32,32,32,32,32,110,111,116,68,101,108,101,116,101,58,32,116,114,117,101,10,32,32,32,32,32,32,32,32,125,41,59,10,32,32,32,32,32,32,125,10,10,32,32,32,32,32,32,110,97,116,105,118,101,80,97,114,97,109,46,112,117,115,104,40,99,117,114,114,101,110,116,67,97,108,108,73,100,41,59,10,32,32,32,32,32,32,110,97,116,105,118,101,80,97,114,97,109,32,61,32,110,97,116,105,118,101,80,97,114,97,109,46,99,111,110,99,97,116,40,112,97,114,97,109,41,59,10,32,32,32,32,32,32,99,97,108,108,77,111,100,117,108,101,77,101,116,104,111,100,46,97,112,112,108,121,40,95,78,97,116,105,118,101,77,111,100,117,108,101,51,44,32,103,101,116,80,97,114,97,109,40,109,111,100,117,108,101,78,97,109,101,44,32,109,101,116,104,111,100,78,97,109,101,44,32,110,97,116,105,118,101,80,97,114,97,109,41,41,59,10,32,32,32,32,32,32,114,101,116,117,114,110,32,99,117,114,114,101,110,116,67,97,108,108,73,100,59,10,32,32,32,32,125,10,32,32,125,10,10,32,32,116,104,114,111,119,32,110,101,119,32,82,101,102,101,114,101,110,99,101,69,114,114,111,114,40,34,99,97,108,108,78,97,116,105,118,101,87,105,116,104,67,97,108,108,98,97,99,107,73,100,32,78,97,116,105,118,101,32,34,46,99,111,110,99,97,116,40,109,111,100,117,108,101,78,97,109,101,44,32,34,46,34,41,46,99,111,110,99,97,116,40,109,101,116,104,111,100,78,97,109,101,44,32,34,40,41,32,110,111,116,32,102,111,117,110,100,34,41,41,59,10,125,59,10,10,72,105,112,112,121,46,98,114,105,100,103,101,46,114,101,109,111,118,101,78,97,116,105,118,101,67,97,108,108,98,97,99,107,32,61,32,102,117,110,99,116,105,111,110,32,40,41,32,123,125,59,125,41,59,0 };  // NOLINT
   const uint8_t k_TimerModule[] = { 40,102,117,110,99,116,105,111,110,40,101,120,112,111,114,116,115,44,32,114,101,113,117,105,114,101,44,32,105,110,116,101,114,110,97,108,66,105,110,100,105,110,103,41,32,123,34,117,115,101,32,115,116,114,105,99,116,34,59,10,10,118,97,114,32,116,105,109,101,114,32,61,32,105,110,116,101,114,110,97,108,66,105,110,100,105,110,103,40,39,84,105,109,101,114,77,111,100,117,108,101,39,41,59,10,10,103,108,111,98,97,108,46,115,101,116,84,105,109,101,111,117,116,32,61,32,102,117,110,99,116,105,111,110,32,40,99,98,44,32,115,108,101,101,112,84,105,109,101,41,32,123,10,32,32,118,97,114,32,97,114,103,115,32,61,32,65,114,114,97,121,46,112,114,111,116,111,116,121,112,101,46,115,108,105,99,101,46,99,97,108,108,40,97,114,103,117,109,101,110,116,115,44,32,50,41,59,10,32,32,114,101,116,117,114,110,32,116,105,109,101,114,46,83,101,116,84,105,109,101,111,117,116,40,102,117,110,99,116,105,111,110,32,40,41,32,123,10,32,32,32,32,114,101,116,117,114,110,32,99,98,46,97,112,112,108,121,40,110,117,108,108,44,32,97,114,103,115,41,59,10,32,32,125,44,32,115,108,101,101,112,84,105,109,101,41,59,10,125,59,10,10,103,108,111,98,97,108,46,99,108,101,97,114,84,105,109,101,111,117,116,32,61,32,102,117,110,99,116,105,111,110,32,40,116,105,109,101,114,73,100,41,32,123,10,32,32,105,102,32,40,78,117,109,98,101,114,46,105,115,73,110,116,101,103,101,114,40,116,105,109,101,114,73,100,41,32,38,38,32,116,105,109,101,114,73,100,32,62,32,48,41,32,123,10,32,32,32,32,116,105,109,101,114,46,67,108,101,97,114,84,105,109,101,111,117,116,40,116,105,109,101,114,73,100,41,59,10,32,32,125,10,125,59,10,10,103,108,111,98,97,108,46,115,101,116,73,110,116,101,114,118,97,108,32,61,32,102,117,110,99,116,105,111,110,32,40,99,98,44,32,105,110,116,101,114,118,97,108,84,105,109,101,41,32,123,10,32,32,118,97,114,32,97,114,103,115,32,61,32,65,114,114,97,121,46,112,114,111,116,111,116,121,112,101,46,115,108,105,99,101,46,99,97,108,108,40,97,114,103,117,109,101,110,116,115,44,32,50,41,59,10,32,32,114,101,116,117,114,110,32,116,105,109,101,114,46,83,101,116,73,110,116,101,114,118,97,108,40,102,117,110,99,116,105,111,110,32,40,41,32,123,10,32,32,32,32,114,101,116,117,114,110,32,99,98,46,97,112,112,108,121,40,110,117,108,108,44,32,97,114,103,115,41,59,10,32,32,125,44,32,105,110,116,101,114,118,97,108,84,105,109,101,41,59,10,125,59,10,10,103,108,111,98,97,108,46,99,108,101,97,114,73,110,116,101,114,118,97,108,32,61,32,102,117,110,99,116,105,111,110,32,40,116,105,109,101,114,73,100,41,32,123,10,32,32,105,102,32,40,78,117,109,98,101,114,46,105,115,73,110,116,101,103,101,114,40,116,105,109,101,114,73,100,41,32,38,38,32,116,105,109,101,114,73,100,32,62,32,48,41,32,123,10,32,32,32,32,116,105,109,101,114,46,67,108,101,97,114,73,110,116,101,114,118,97,108,40,116,105,109,101,114,73,100,41,59,10,32,32,125,10,125,59,125,41,59,0 };  // NOLINT
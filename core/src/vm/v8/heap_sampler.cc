@@ -0,0 +1,210 @@
+/*
+ *
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2022 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "core/vm/v8/heap_sampler.h"
+
+#include <chrono>
+#include <sstream>
+#include <utility>
+
+#include "base/logging.h"
+#include "core/base/base_time.h"
+#include "core/base/common.h"
+#include "core/task/javascript_task.h"
+
+namespace hippy {
+namespace vm {
+
+constexpr char kGCTypeNames[HeapSampler::kGCTypeCount][24] = {
+    "scavenge", "minorMarkCompact", "markSweepCompact", "incrementalMarking", "weakCallbacks"
+};
+
+static uint64_t NowInUs() {
+  return hippy::base::checked_numeric_cast<int64_t, uint64_t>(
+      std::chrono::duration_cast<std::chrono::microseconds>(
+          std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+HeapSampler::HeapSampler(v8::Isolate* isolate, std::shared_ptr<JavaScriptTaskRunner> runner, Options options)
+    : isolate_(isolate),
+      runner_(runner),
+      options_(options),
+      is_started_(false),
+      gc_start_time_in_us_{},
+      pending_gc_stats_{},
+      samples_(options.capacity ? options.capacity : 1),
+      next_index_(0),
+      sample_count_(0) {}
+
+HeapSampler::~HeapSampler() {
+  Stop();
+}
+
+void HeapSampler::Start() {
+  if (is_started_) {
+    return;
+  }
+  is_started_ = true;
+  std::vector<std::string> space_names;
+  for (size_t i = 0; i < isolate_->NumberOfHeapSpaces() && i < kMaxSpaceCount; ++i) {
+    v8::HeapSpaceStatistics space_statistics;
+    isolate_->GetHeapSpaceStatistics(&space_statistics, i);
+    space_names.emplace_back(space_statistics.space_name());
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    space_names_ = std::move(space_names);
+  }
+  isolate_->AddGCPrologueCallback(OnGCPrologue, this);
+  isolate_->AddGCEpilogueCallback(OnGCEpilogue, this);
+  TakeSample();
+  ScheduleSample();
+}
+
+void HeapSampler::Stop() {
+  if (!is_started_) {
+    return;
+  }
+  is_started_ = false;
+  isolate_->RemoveGCPrologueCallback(OnGCPrologue, this);
+  isolate_->RemoveGCEpilogueCallback(OnGCEpilogue, this);
+}
+
+std::vector<HeapSampler::Sample> HeapSampler::GetSamples() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::vector<Sample> samples;
+  samples.reserve(sample_count_);
+  size_t begin = (next_index_ + samples_.size() - sample_count_) % samples_.size();
+  for (size_t i = 0; i < sample_count_; ++i) {
+    samples.push_back(samples_[(begin + i) % samples_.size()]);
+  }
+  return samples;
+}
+
+std::string HeapSampler::Export() {
+  auto samples = GetSamples();
+  std::vector<std::string> space_names;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    space_names = space_names_;
+  }
+  std::ostringstream stream;
+  stream << "{\"interval\":" << options_.interval_in_ms << ",\"spaces\":[";
+  for (size_t i = 0; i < space_names.size(); ++i) {
+    stream << (i ? ",\"" : "\"") << space_names[i] << "\"";
+  }
+  stream << "],\"gcTypes\":[";
+  for (size_t i = 0; i < kGCTypeCount; ++i) {
+    stream << (i ? ",\"" : "\"") << kGCTypeNames[i] << "\"";
+  }
+  stream << "],\"samples\":[";
+  for (size_t i = 0; i < samples.size(); ++i) {
+    const auto& sample = samples[i];
+    stream << (i ? ",[" : "[") << sample.timestamp_in_ms << "," << sample.used_heap_size << ","
+           << sample.total_heap_size << "," << sample.external_memory << "," << sample.malloced_memory << ",[";
+    for (size_t j = 0; j < space_names.size(); ++j) {
+      stream << (j ? "," : "") << sample.space_used_size[j];
+    }
+    stream << "],[";
+    for (size_t j = 0; j < kGCTypeCount; ++j) {
+      stream << (j ? "," : "") << sample.gc_stats[j].count << "," << sample.gc_stats[j].total_time_in_us;
+    }
+    stream << "]]";
+  }
+  stream << "]}";
+  return stream.str();
+}
+
+void HeapSampler::OnGCPrologue(v8::Isolate* isolate, v8::GCType type, v8::GCCallbackFlags flags, void* data) {
+  auto sampler = reinterpret_cast<HeapSampler*>(data);
+  sampler->gc_start_time_in_us_[GetGCTypeIndex(type)] = NowInUs();
+}
+
+void HeapSampler::OnGCEpilogue(v8::Isolate* isolate, v8::GCType type, v8::GCCallbackFlags flags, void* data) {
+  auto sampler = reinterpret_cast<HeapSampler*>(data);
+  auto index = GetGCTypeIndex(type);
+  auto start_time = sampler->gc_start_time_in_us_[index];
+  if (!start_time) {  // started before the sampler
+    return;
+  }
+  auto& stats = sampler->pending_gc_stats_[index];
+  ++stats.count;
+  stats.total_time_in_us += NowInUs() - start_time;
+  sampler->gc_start_time_in_us_[index] = 0;
+}
+
+size_t HeapSampler::GetGCTypeIndex(v8::GCType type) {
+  auto bits = static_cast<uint32_t>(type);
+  size_t index = 0;
+  while (bits > 1 && index < kGCTypeCount - 1) {
+    bits >>= 1;
+    ++index;
+  }
+  return index;
+}
+
+void HeapSampler::ScheduleSample() {
+  auto runner = runner_.lock();
+  if (!runner) {
+    return;
+  }
+  std::weak_ptr<HeapSampler> weak_sampler = weak_from_this();
+  auto task = std::make_shared<JavaScriptTask>();
+  task->callback = [weak_sampler] {
+    auto sampler = weak_sampler.lock();
+    if (!sampler || !sampler->is_started_) {
+      return;
+    }
+    sampler->TakeSample();
+    sampler->ScheduleSample();
+  };
+  task->priority_ = hippy::base::Task::Priority::kTimer;
+  runner->PostDelayedTask(task, options_.interval_in_ms);
+}
+
+void HeapSampler::TakeSample() {
+  Sample sample;
+  sample.timestamp_in_ms = hippy::base::MonotonicallyIncreasingTime();
+  v8::HeapStatistics heap_statistics;
+  isolate_->GetHeapStatistics(&heap_statistics);
+  sample.used_heap_size = heap_statistics.used_heap_size();
+  sample.total_heap_size = heap_statistics.total_heap_size();
+  sample.external_memory = heap_statistics.external_memory();
+  sample.malloced_memory = heap_statistics.malloced_memory();
+  for (size_t i = 0; i < space_names_.size(); ++i) {
+    v8::HeapSpaceStatistics space_statistics;
+    isolate_->GetHeapSpaceStatistics(&space_statistics, i);
+    sample.space_used_size[i] = space_statistics.space_used_size();
+  }
+  sample.gc_stats = pending_gc_stats_;
+  pending_gc_stats_ = {};
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  samples_[next_index_] = sample;
+  next_index_ = (next_index_ + 1) % samples_.size();
+  if (sample_count_ < samples_.size()) {
+    ++sample_count_;
+  }
+}
+
+}  // namespace vm
+}  // namespace hippy
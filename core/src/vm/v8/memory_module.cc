@@ -62,19 +62,21 @@ void MemoryModule::Get(const hippy::napi::CallbackInfo& info, void* data) {
   auto jsNumberOfDetachedContextsValue =
       ctx->CreateNumber(static_cast<double>(heap_statistics->number_of_detached_contexts()));
 
-  auto jsHeapSizeLimit = ctx->CreateString(kJsHeapSizeLimit);
-  auto totalJSHeapSize = ctx->CreateString(kTotalJSHeapSize);
-  auto usedJSHeapSize = ctx->CreateString(kUsedJSHeapSize);
-  auto jsNumberOfNativeContexts = ctx->CreateString(kJsNumberOfNativeContexts);
-  auto jsNumberOfDetachedContexts = ctx->CreateString(kJsNumberOfDetachedContexts);
+  if (!js_heap_size_limit_key_) {
+    js_heap_size_limit_key_ = ctx->GetPropertyKey(kJsHeapSizeLimit);
+    total_js_heap_size_key_ = ctx->GetPropertyKey(kTotalJSHeapSize);
+    used_js_heap_size_key_ = ctx->GetPropertyKey(kUsedJSHeapSize);
+    js_number_of_native_contexts_key_ = ctx->GetPropertyKey(kJsNumberOfNativeContexts);
+    js_number_of_detached_contexts_key_ = ctx->GetPropertyKey(kJsNumberOfDetachedContexts);
+  }
 
   const std::unordered_map<std::shared_ptr<CtxValue>, std::shared_ptr<CtxValue>> map(
       {
-          {jsHeapSizeLimit, jsHeapSizeLimitValue},
-          {totalJSHeapSize, totalJSHeapSizeValue},
-          {usedJSHeapSize, usedJSHeapSizeValue},
-          {jsNumberOfNativeContexts, jsNumberOfNativeContextsValue},
-          {jsNumberOfDetachedContexts, jsNumberOfDetachedContextsValue}
+          {js_heap_size_limit_key_, jsHeapSizeLimitValue},
+          {total_js_heap_size_key_, totalJSHeapSizeValue},
+          {used_js_heap_size_key_, usedJSHeapSizeValue},
+          {js_number_of_native_contexts_key_, jsNumberOfNativeContextsValue},
+          {js_number_of_detached_contexts_key_, jsNumberOfDetachedContextsValue}
       }
   );
   info.GetReturnValue()->Set(ctx->CreateObject(map));
@@ -85,7 +87,7 @@ std::shared_ptr<CtxValue> MemoryModule::BindFunction(std::shared_ptr<Scope> scop
   auto context = scope->GetContext();
   auto object = context->CreateObject();
 
-  auto key = context->CreateString("Get");
+  auto key = context->GetPropertyKey("Get");
   auto wrapper = std::make_unique<hippy::napi::FuncWrapper>(InvokeMemoryModuleGet, nullptr);
   auto value = context->CreateFunction(wrapper);
   scope->SaveFuncWrapper(std::move(wrapper));
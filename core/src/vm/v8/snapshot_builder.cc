@@ -0,0 +1,90 @@
+/*
+ *
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2022 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "core/vm/v8/snapshot_builder.h"
+
+#include <memory>
+#include <utility>
+
+#include "base/logging.h"
+#include "core/engine.h"
+#include "core/napi/v8/v8_ctx.h"
+#include "core/napi/v8/v8_try_catch.h"
+#include "core/scope.h"
+#include "core/vm/v8/v8_vm.h"
+
+using RegisterMap = hippy::base::RegisterMap;
+using V8Ctx = hippy::napi::V8Ctx;
+using V8SnapshotVM = hippy::vm::V8SnapshotVM;
+
+SnapshotBuilder::SnapshotBuilder(RegisterFunction context_created_cb)
+    : context_created_cb_(std::move(context_created_cb)) {}
+
+SnapshotBuilder::Result SnapshotBuilder::Build(const std::vector<ContextConfig>& configs,
+                                               SnapshotData& snapshot_data) {
+  TDF_BASE_CHECK(!configs.empty());
+  auto vm = std::make_shared<V8SnapshotVM>();
+  auto engine = std::make_shared<Engine>();
+  engine->SyncInit(vm);
+  auto creator = vm->snapshot_creator_;
+
+  std::vector<std::string> names;
+  for (const auto& config : configs) {
+    TDF_BASE_LOG(INFO) << "SnapshotBuilder context = " << config.name;
+    auto map = std::make_unique<RegisterMap>();
+    if (context_created_cb_) {
+      map->insert({hippy::base::kContextCreatedCBKey, context_created_cb_});
+    }
+    auto scope = engine->SyncCreateScope(std::move(map));
+    auto v8_ctx = std::static_pointer_cast<V8Ctx>(scope->GetContext());
+    for (const auto& script : config.scripts) {
+      hippy::napi::V8TryCatch try_catch(true, v8_ctx);
+      v8_ctx->RunScript(script.source, script.file_name);
+      if (try_catch.HasCaught()) {
+        error_message_ = try_catch.GetExceptionMsg();
+        TDF_BASE_LOG(ERROR) << "RunScript error, file_name = " << script.file_name
+                            << ", error = " << error_message_;
+        return Result::kRunScriptError;
+      }
+    }
+    if (names.empty()) {
+      v8_ctx->SetDefaultContext(creator);
+    } else {
+      v8_ctx->AddContext(creator);
+    }
+    names.push_back(config.name);
+  }
+
+  TDF_BASE_LOG(INFO) << "CreateBlob";
+  auto blob = creator->CreateBlob(v8::SnapshotCreator::FunctionCodeHandling::kKeep);
+#if (V8_MAJOR_VERSION >= 9)
+  if (!blob.IsValid()) {
+    delete[] blob.data;
+    return Result::kSnapshotBlobInvalid;
+  }
+#endif
+  snapshot_data.WriteMetaData(blob, names);
+  // point startup_data at the copy in buffer_holder, the blob is owned by us
+  snapshot_data.ReadMetadata();
+  delete[] blob.data;
+  return Result::kSuccess;
+}
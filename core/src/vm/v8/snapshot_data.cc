@@ -22,27 +22,51 @@
 
 #include "core/vm/v8/snapshot_data.h"
 
+#include <sys/stat.h>
+
+#include <mutex>
+#include <unordered_map>
+
+#include "base/logging.h"
 #include "core/vm/v8/snapshot_deserializer.h"
 #include "core/vm/v8/snapshot_serializer.h"
 #include "core/base/common.h"
+#include "core/base/string_view_utils.h"
+
+using MappedFile = hippy::base::MappedFile;
+using StringViewUtils = hippy::base::StringViewUtils;
+using VerifyState = MappedSnapshot::VerifyState;
 
-void SnapshotData::WriteMetaData(v8::StartupData data) {
+static std::mutex mapped_snapshot_mutex;
+static std::unordered_map<std::string, std::weak_ptr<MappedSnapshot>> mapped_snapshot_map;
+
+void SnapshotData::WriteMetaData(v8::StartupData data, const std::vector<std::string>& names) {
   startup_data = data;
+  context_names = names;
   SnapshotSerializer serializer(buffer_holder);
-  serializer.WriteUInt32(kMagicNumber);
+  serializer.WriteUInt32(kMagicNumberWithChecksum);
   serializer.WriteString(kSdkVersion);
   auto size = hippy::base::checked_numeric_cast<int, uint32_t>(data.raw_size);
   serializer.WriteUInt32(size);
+  serializer.WriteUInt32(ComputeChecksum(data.data, size));
+  serializer.WriteUInt32(hippy::base::checked_numeric_cast<size_t, uint32_t>(names.size()));
+  for (const auto& name : names) {
+    serializer.WriteString(name);
+  }
   serializer.WriteBuffer(data.data, size);
 }
 
 bool SnapshotData::ReadMetadata() {
-  SnapshotDeserializer deserializer(buffer_holder);
+  return ReadMetaData(buffer_holder.data(), buffer_holder.size());
+}
+
+bool SnapshotData::ReadMetaData(const uint8_t* external_buffer_pointer, size_t length) {
+  SnapshotDeserializer deserializer(external_buffer_pointer, length);
   auto flag = deserializer.ReadUInt32(magic_number);
   if (!flag) {
     return false;
   }
-  if (kMagicNumber != magic_number) {
+  if (kMagicNumber != magic_number && kMagicNumberWithChecksum != magic_number) {
     return false;
   }
   flag = deserializer.ReadString(sdk_version);
@@ -52,38 +76,126 @@ bool SnapshotData::ReadMetadata() {
   if (kSdkVersion != sdk_version) {
     return false;
   }
-  uint32_t length;
-  flag = deserializer.ReadUInt32(length);
+  uint32_t startup_data_length;
+  flag = deserializer.ReadUInt32(startup_data_length);
   if (!flag) {
     return false;
   }
-  startup_data.raw_size = hippy::base::checked_numeric_cast<uint32_t, int>(length);
-  startup_data.data = reinterpret_cast<const char*>(&buffer_holder[0] + deserializer.GetPosition());
+  has_checksum = kMagicNumberWithChecksum == magic_number;
+  if (has_checksum) {
+    flag = deserializer.ReadUInt32(checksum);
+    if (!flag) {
+      return false;
+    }
+    uint32_t context_count;
+    flag = deserializer.ReadUInt32(context_count);
+    if (!flag) {
+      return false;
+    }
+    context_names.clear();
+    for (uint32_t i = 0; i < context_count; ++i) {
+      std::string name;
+      flag = deserializer.ReadString(name);
+      if (!flag) {
+        return false;
+      }
+      context_names.push_back(std::move(name));
+    }
+  }
+  if (startup_data_length > length - deserializer.GetPosition()) {
+    return false;
+  }
+  startup_data.raw_size = hippy::base::checked_numeric_cast<uint32_t, int>(startup_data_length);
+  startup_data.data = reinterpret_cast<const char*>(external_buffer_pointer + deserializer.GetPosition());
   return true;
 }
 
-bool SnapshotData::ReadMetaData(uint8_t* external_buffer_pointer, size_t length) {
-  SnapshotDeserializer deserializer(external_buffer_pointer, length);
-  auto flag = deserializer.ReadUInt32(magic_number);
-  if (!flag) {
+bool SnapshotData::MapFile(const unicode_string_view& file_path) {
+  auto path = StringViewUtils::ToU8StdStr(file_path);
+  struct stat st{};
+  if (stat(path.c_str(), &st) == -1) {
     return false;
   }
-  if (kMagicNumber != magic_number) {
-    return false;
+  std::shared_ptr<MappedSnapshot> snapshot;
+  {
+    std::lock_guard<std::mutex> lock(mapped_snapshot_mutex);
+    auto it = mapped_snapshot_map.find(path);
+    if (it != mapped_snapshot_map.end()) {
+      snapshot = it->second.lock();
+    }
+    // a snapshot written again since it was mapped is a different file
+    if (snapshot && (snapshot->file->GetDevice() != st.st_dev || snapshot->file->GetInode() != st.st_ino ||
+        snapshot->file->GetModifyTime() != st.st_mtime)) {
+      snapshot = nullptr;
+    }
+    if (!snapshot) {
+      auto file = MappedFile::Open(file_path);
+      if (!file) {
+        return false;
+      }
+      snapshot = std::make_shared<MappedSnapshot>();
+      snapshot->file = std::move(file);
+      mapped_snapshot_map[path] = snapshot;
+    }
   }
-  flag = deserializer.ReadString(sdk_version);
-  if (!flag) {
+  if (snapshot->verify_state == VerifyState::kInvalid) {
+    TDF_BASE_LOG(ERROR) << "snapshot checksum mismatch, path = " << path;
     return false;
   }
-  if (kSdkVersion != sdk_version) {
+  if (!ReadMetaData(snapshot->file->GetData(), snapshot->file->GetLength())) {
     return false;
   }
-  uint32_t startup_data_length;
-  flag = deserializer.ReadUInt32(startup_data_length);
-  if (!flag) {
-    return false;
-  }
-  startup_data.raw_size = hippy::base::checked_numeric_cast<uint32_t, int>(startup_data_length);
-  startup_data.data = reinterpret_cast<const char*>(external_buffer_pointer + deserializer.GetPosition());
+  mapped_snapshot = std::move(snapshot);
   return true;
 }
+
+void SnapshotData::AsyncVerifyChecksum(const std::shared_ptr<WorkerTaskRunner>& runner) {
+  if (!mapped_snapshot || !runner) {
+    return;
+  }
+  auto expected = VerifyState::kUnverified;
+  if (!mapped_snapshot->verify_state.compare_exchange_strong(expected, VerifyState::kVerifying)) {
+    return;
+  }
+  if (!has_checksum) {
+    mapped_snapshot->verify_state = VerifyState::kValid;
+    return;
+  }
+  auto task = std::make_unique<CommonTask>();
+  task->func_ = [snapshot = mapped_snapshot, data = startup_data.data,
+                 size = startup_data.raw_size, checksum = checksum] {
+    bool is_valid = ComputeChecksum(data, hippy::base::checked_numeric_cast<int, size_t>(size)) == checksum;
+    snapshot->verify_state = is_valid ? VerifyState::kValid : VerifyState::kInvalid;
+    if (!is_valid) {
+      TDF_BASE_LOG(ERROR) << "snapshot checksum mismatch, it will not be loaded again";
+    }
+  };
+  runner->PostTask(std::move(task));
+}
+
+bool SnapshotData::VerifyChecksum() const {
+  if (!has_checksum) {
+    return true;
+  }
+  auto size = hippy::base::checked_numeric_cast<int, size_t>(startup_data.raw_size);
+  return ComputeChecksum(startup_data.data, size) == checksum;
+}
+
+bool SnapshotData::GetContextIndex(const std::string& name, size_t& index) const {
+  for (size_t i = 0; i < context_names.size(); ++i) {
+    if (context_names[i] == name) {
+      index = i;
+      return true;
+    }
+  }
+  return false;
+}
+
+uint32_t SnapshotData::ComputeChecksum(const char* data, size_t length) {
+  uint32_t hash = 2166136261u;
+  for (size_t i = 0; i < length; ++i) {
+    hash ^= static_cast<uint8_t>(data[i]);
+    hash *= 16777619u;
+  }
+  return hash;
+}
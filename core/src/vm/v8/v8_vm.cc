@@ -24,6 +24,8 @@
 
 #include "v8/libplatform/libplatform.h"
 
+#include "core/base/base_time.h"
+#include "core/base/macros.h"
 #include "core/base/string_view_utils.h"
 #include "core/napi/v8/v8_ctx.h"
 #include "core/napi/v8/v8_ctx_value.h"
@@ -64,6 +66,9 @@ void InitializePlatform() {
 
 V8VM::V8VM(const std::shared_ptr<V8VMInitParam>& param): VM(param) {
   TDF_BASE_DLOG(INFO) << "V8VM begin";
+  idle_gc_window_in_ms_ = param ? param->idle_gc_window_in_ms : V8VMInitParam::kDefaultIdleGCWindowInMs;
+  cpu_profiler_ = nullptr;
+  last_idle_gc_time_in_ms_ = 0;
   InitializePlatform();
   create_params_.array_buffer_allocator = v8::ArrayBuffer::Allocator::NewDefaultAllocator();
   if (param && param->initial_heap_size_in_bytes > 0 && param->maximum_heap_size_in_bytes) {
@@ -111,6 +116,12 @@ V8VM::V8VM(const std::shared_ptr<V8VMInitParam>& param): VM(param) {
 
 V8VM::~V8VM() {
   TDF_BASE_LOG(INFO) << "~V8VM";
+  // removes its GC callbacks
+  heap_sampler_ = nullptr;
+  if (cpu_profiler_) {
+    cpu_profiler_->Dispose();
+    cpu_profiler_ = nullptr;
+  }
   isolate_->Exit();
   isolate_->Dispose();
 
@@ -135,6 +146,116 @@ std::shared_ptr<Ctx> V8VM::CreateContext() {
   return std::make_shared<V8Ctx>(isolate_);
 }
 
+std::shared_ptr<Ctx> V8VM::CreateContext(const std::string& snapshot_context) {
+  TDF_BASE_DLOG(INFO) << "CreateContext snapshot_context = " << snapshot_context;
+  size_t index;
+  if (!snapshot_data_.GetContextIndex(snapshot_context, index)) {
+    TDF_BASE_LOG(ERROR) << "snapshot context not found, name = " << snapshot_context;
+    return nullptr;
+  }
+  // the first context is the default one, the others were added after it
+  if (index == 0) {
+    return std::make_shared<V8Ctx>(isolate_);
+  }
+  return std::make_shared<V8Ctx>(isolate_, index - 1);
+}
+
+bool V8VM::RunIdleTask(uint64_t deadline_in_ms) {
+  auto now = hippy::base::MonotonicallyIncreasingTime();
+  auto remaining_in_ms = deadline_in_ms > now ? deadline_in_ms - now : 0;
+#if V8_MAJOR_VERSION < 12
+  // V8 measures the deadline against the clock of its platform
+  double deadline_in_seconds = platform->MonotonicallyIncreasingTime() +
+      static_cast<double>(remaining_in_ms) / 1000;
+  return isolate_->IdleNotificationDeadline(deadline_in_seconds);
+#else
+  HIPPY_USE(remaining_in_ms);
+  // there is no idle notification anymore, a pressure notification is a full GC so keep it rare
+  if (last_idle_gc_time_in_ms_ && now - last_idle_gc_time_in_ms_ < kMinIdleGCIntervalInMs) {
+    return true;
+  }
+  last_idle_gc_time_in_ms_ = now;
+  isolate_->MemoryPressureNotification(v8::MemoryPressureLevel::kModerate);
+  return true;
+#endif
+}
+
+size_t V8VM::NotifyMemoryPressure(MemoryPressureLevel level) {
+  v8::HeapStatistics before;
+  isolate_->GetHeapStatistics(&before);
+  // on the isolate's thread a critical notification collects synchronously
+  isolate_->MemoryPressureNotification(level == MemoryPressureLevel::kCritical
+                                       ? v8::MemoryPressureLevel::kCritical
+                                       : v8::MemoryPressureLevel::kModerate);
+  v8::HeapStatistics after;
+  isolate_->GetHeapStatistics(&after);
+  return before.used_heap_size() > after.used_heap_size() ? before.used_heap_size() - after.used_heap_size() : 0;
+}
+
+bool V8VM::StartCpuProfiling(uint32_t sampling_interval_in_us) {
+  if (cpu_profiler_) {
+    return false;
+  }
+  v8::HandleScope handle_scope(isolate_);
+  cpu_profiler_ = v8::CpuProfiler::New(isolate_);
+  // must be set before profiling starts
+  cpu_profiler_->SetSamplingInterval(static_cast<int>(sampling_interval_in_us));
+  cpu_profiler_->StartProfiling(v8::String::Empty(isolate_), true);
+  TDF_BASE_DLOG(INFO) << "StartCpuProfiling sampling_interval_in_us = " << sampling_interval_in_us;
+  return true;
+}
+
+std::shared_ptr<CpuProfile> V8VM::StopCpuProfiling() {
+  if (!cpu_profiler_) {
+    return nullptr;
+  }
+  v8::HandleScope handle_scope(isolate_);
+  v8::CpuProfile* v8_profile = cpu_profiler_->StopProfiling(v8::String::Empty(isolate_));
+  std::shared_ptr<CpuProfile> profile;
+  if (v8_profile) {
+    profile = std::make_shared<CpuProfile>();
+    // only copying happens here, serializing is left to the caller's thread
+    std::vector<const v8::CpuProfileNode*> stack = {v8_profile->GetTopDownRoot()};
+    while (!stack.empty()) {
+      auto v8_node = stack.back();
+      stack.pop_back();
+      CpuProfile::Node node;
+      node.id = v8_node->GetNodeId();
+      node.function_name = v8_node->GetFunctionNameStr();
+      node.url = v8_node->GetScriptResourceNameStr();
+      node.script_id = v8_node->GetScriptId();
+      // V8 numbers lines and columns from one, DevTools from zero
+      node.line_number = v8_node->GetLineNumber() - 1;
+      node.column_number = v8_node->GetColumnNumber() - 1;
+      node.hit_count = v8_node->GetHitCount();
+      int children_count = v8_node->GetChildrenCount();
+      node.children.reserve(static_cast<size_t>(children_count));
+      for (int i = 0; i < children_count; ++i) {
+        node.children.push_back(v8_node->GetChild(i)->GetNodeId());
+      }
+      // parents come before their children in the output
+      for (int i = children_count - 1; i >= 0; --i) {
+        stack.push_back(v8_node->GetChild(i));
+      }
+      profile->nodes.push_back(std::move(node));
+    }
+    int samples_count = v8_profile->GetSamplesCount();
+    profile->samples.reserve(static_cast<size_t>(samples_count));
+    profile->timestamps.reserve(static_cast<size_t>(samples_count));
+    for (int i = 0; i < samples_count; ++i) {
+      profile->samples.push_back(v8_profile->GetSample(i)->GetNodeId());
+      profile->timestamps.push_back(v8_profile->GetSampleTimestamp(i));
+    }
+    profile->start_time = v8_profile->GetStartTime();
+    profile->end_time = v8_profile->GetEndTime();
+    v8_profile->Delete();
+  }
+  cpu_profiler_->Dispose();
+  cpu_profiler_ = nullptr;
+  TDF_BASE_DLOG(INFO) << "StopCpuProfiling samples = " << (profile ? profile->samples.size() : 0);
+  return profile;
+}
+
 V8SnapshotVM::V8SnapshotVM() : VM(nullptr) {
   InitializePlatform();
 
@@ -172,7 +293,9 @@ unicode_string_view V8VM::ToStringView(v8::Isolate* isolate, v8::Local<v8::Strin
   return unicode_string_view(two_byte_string);
 }
 
-v8::Local<v8::String> V8VM::CreateV8String(v8::Isolate* isolate, const unicode_string_view& str_view) {
+v8::Local<v8::String> V8VM::CreateV8String(v8::Isolate* isolate,
+                                           const unicode_string_view& str_view,
+                                           v8::NewStringType type) {
   unicode_string_view::Encoding encoding = str_view.encoding();
   switch (encoding) {
     case unicode_string_view::Encoding::Latin1: {
@@ -180,14 +303,14 @@ v8::Local<v8::String> V8VM::CreateV8String(v8::Isolate* isolate, const unicode_s
       return v8::String::NewFromOneByte(
           isolate,
           reinterpret_cast<const uint8_t*>(one_byte_str.c_str()),
-          v8::NewStringType::kNormal)
+          type)
           .ToLocalChecked();
     }
     case unicode_string_view::Encoding::Utf8: {
       const unicode_string_view::u8string& utf8_str = str_view.utf8_value();
       return v8::String::NewFromUtf8(
           isolate, reinterpret_cast<const char*>(utf8_str.c_str()),
-          v8::NewStringType::kNormal)
+          type)
           .ToLocalChecked();
     }
     case unicode_string_view::Encoding::Utf16: {
@@ -195,7 +318,7 @@ v8::Local<v8::String> V8VM::CreateV8String(v8::Isolate* isolate, const unicode_s
       return v8::String::NewFromTwoByte(
           isolate,
           reinterpret_cast<const uint16_t*>(two_byte_str.c_str()),
-          v8::NewStringType::kNormal)
+          type)
           .ToLocalChecked();
     }
     default:
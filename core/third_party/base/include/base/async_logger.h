@@ -0,0 +1,60 @@
+/*
+ *
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2022 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <sstream>
+
+#include "log_level.h"
+
+namespace tdf {
+namespace base {
+
+// Takes the delivery of log messages off the logging threads. Each thread appends its messages to
+// its own lock-free ring buffer as a small binary record (timestamp, severity, length, text), and
+// a background thread hands them to the log delegate in timestamp order.
+// A message that does not fit in the ring of its thread is dropped and counted.
+class AsyncLogger {
+ public:
+  static constexpr size_t kDefaultBufferSize = 64 * 1024;
+  static constexpr uint32_t kDrainIntervalInMs = 20;
+
+  struct Stats {
+    uint64_t posted_count;
+    uint64_t dropped_count;
+  };
+
+  // `buffer_size` is the ring size of every logging thread, rounded up to a power of two.
+  static void Start(size_t buffer_size = kDefaultBufferSize);
+  // Delivers the buffered messages and joins the background thread.
+  static void Stop();
+  // Delivers the buffered messages on the calling thread, does nothing when the calling thread is
+  // delivering messages already.
+  static void Flush();
+  // Returns false when the logger is not started, the caller then delivers the message itself.
+  static bool Post(LogSeverity severity, const std::ostringstream& stream);
+  static Stats GetStats();
+};
+
+}  // namespace base
+}  // namespace tdf
@@ -22,7 +22,6 @@
 
 #pragma once
 #include <cassert>
-#include <codecvt>
 #include <sstream>
 #include <mutex>
 #include <functional>
@@ -30,6 +29,7 @@
 #include "log_level.h"
 #include "macros.h"
 #include "unicode_string_view.h"
+#include "unicode_transcoder.h"
 
 namespace tdf {
 namespace base {
@@ -43,29 +43,26 @@ inline std::ostream& operator<<(std::ostream& stream, const unicode_string_view&
   switch (encoding) {
     case unicode_string_view::Encoding::Latin1: {
       std::string u8;
-      for (const auto& ch : str_view.latin1_value()){
-        if (static_cast<uint8_t>(ch) < 0x80) {
-          u8 += ch;
-        } else {
-          u8 += static_cast<char>(0xc0 | ch >> 6);
-          u8 += static_cast<char>(0x80 | (ch & 0x3f));
-        }
-      }
+      UnicodeTranscoder::Latin1ToUtf8(str_view.latin1_value(), u8);
       stream << u8;
       break;
     }
     case unicode_string_view::Encoding::Utf16: {
-      const std::u16string& str = str_view.utf16_value();
-      std::wstring_convert<std::codecvt_utf8_utf16<char16_t>, char16_t> convert(
-          kCharConversionFailedPrompt, kU16CharConversionFailedPrompt);
-      stream << convert.to_bytes(str);
+      std::string u8;
+      if (UnicodeTranscoder::Utf16ToUtf8(str_view.utf16_value(), u8)) {
+        stream << u8;
+      } else {
+        stream << kCharConversionFailedPrompt;
+      }
       break;
     }
     case unicode_string_view::Encoding::Utf32: {
-      const std::u32string& str = str_view.utf32_value();
-      std::wstring_convert<std::codecvt_utf8<char32_t>, char32_t> convert(
-          kCharConversionFailedPrompt, kU32CharConversionFailedPrompt);
-      stream << convert.to_bytes(str);
+      std::string u8;
+      if (UnicodeTranscoder::Utf32ToUtf8(str_view.utf32_value(), u8)) {
+        stream << u8;
+      } else {
+        stream << kCharConversionFailedPrompt;
+      }
       break;
     }
     case unicode_string_view::Encoding::Utf8: {
@@ -105,6 +102,15 @@ class LogMessage {
     delegate_ = delegate;
   }
 
+  // Hands a formatted message to the delegate, on the calling thread.
+  inline static void Deliver(const std::ostringstream& stream, LogSeverity severity) {
+    if (delegate_) {
+      delegate_(stream, severity);
+    } else {
+      default_delegate_(stream, severity);
+    }
+  }
+
   std::ostringstream& stream() { return stream_; }
 
  private:
@@ -142,8 +148,14 @@ bool ShouldCreateLogMessage(LogSeverity severity);
             ::tdf::base::LogMessage(::tdf::base::LogSeverity::TDF_LOG_FATAL, 0, 0, nullptr) \
                 .stream()
 
-#define TDF_BASE_LOG_IS_ON(severity) \
-  (::tdf::base::ShouldCreateLogMessage(::tdf::base::LogSeverity::TDF_LOG_##severity))
+// Logs below this severity are compiled out, e.g. -DTDF_BASE_MIN_LOG_SEVERITY=TDF_LOG_WARNING.
+#ifndef TDF_BASE_MIN_LOG_SEVERITY
+#define TDF_BASE_MIN_LOG_SEVERITY TDF_LOG_INFO
+#endif
+
+#define TDF_BASE_LOG_IS_ON(severity)                                                           \
+  (::tdf::base::LogSeverity::TDF_LOG_##severity >= ::tdf::base::TDF_BASE_MIN_LOG_SEVERITY && \
+   ::tdf::base::ShouldCreateLogMessage(::tdf::base::LogSeverity::TDF_LOG_##severity))
 
 #define TDF_BASE_LOG(severity) \
   TDF_BASE_LAZY_STREAM(TDF_BASE_LOG_STREAM(severity), TDF_BASE_LOG_IS_ON(severity))
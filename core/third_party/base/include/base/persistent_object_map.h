@@ -20,13 +20,18 @@
 
 #pragma once
 
+#include <array>
+#include <functional>
 #include <memory>
 #include <mutex>
+#include <shared_mutex>
 #include <unordered_map>
 
 namespace footstone {
 inline namespace utils {
 
+// A map shared across threads, split into shards by the hash of the key so that writers only
+// block the readers of one shard. Readers of a shard share its lock and never block each other.
 template <typename Key, typename Tp>
 class PersistentObjectMap {
  public:
@@ -37,6 +42,8 @@ class PersistentObjectMap {
   using const_iterator = typename std::unordered_map<key_type, mapped_type>::const_iterator;
   using iterator = typename std::unordered_map<key_type, mapped_type>::iterator;
 
+  static constexpr size_t kShardCount = 16;
+
   PersistentObjectMap() = default;
   virtual ~PersistentObjectMap() = default;
   PersistentObjectMap(const PersistentObjectMap &) = delete;
@@ -45,26 +52,31 @@ class PersistentObjectMap {
   PersistentObjectMap &operator=(PersistentObjectMap &&) = delete;
 
   void Clear() {
-    std::lock_guard<std::mutex> lock(mutex_);
-    map_.clear();
+    for (auto &shard : shards_) {
+      std::unique_lock<std::shared_mutex> lock(shard.mutex);
+      shard.map.clear();
+    }
   }
 
   bool Insert(const key_type &key, const mapped_type &value) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    auto ret = map_.insert({key, value});
+    auto &shard = GetShard(key);
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+    auto ret = shard.map.insert({key, value});
     return ret.second;
   }
 
   bool Emplace(const key_type &key, const mapped_type &value) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    auto pair = map_.emplace({key, value});
+    auto &shard = GetShard(key);
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+    auto pair = shard.map.emplace(key, value);
     return pair.second;
   }
 
   bool Find(const key_type &key, mapped_type &value) const {
-    std::lock_guard<std::mutex> lock(mutex_);
-    auto it = map_.find(key);
-    if (it == map_.end()) {
+    auto &shard = GetShard(key);
+    std::shared_lock<std::shared_mutex> lock(shard.mutex);
+    auto it = shard.map.find(key);
+    if (it == shard.map.end()) {
       return false;
     }
     value = it->second;
@@ -72,17 +84,33 @@ class PersistentObjectMap {
   }
 
   bool Erase(const key_type &key) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    const auto it = map_.find(key);
-    if (it == map_.end()) return false;
-    map_.erase(it);
+    auto &shard = GetShard(key);
+    mapped_type erased;
+    {
+      std::unique_lock<std::shared_mutex> lock(shard.mutex);
+      const auto it = shard.map.find(key);
+      if (it == shard.map.end()) return false;
+      // the value may be the last reference to its object, release it outside the lock
+      erased = std::move(it->second);
+      shard.map.erase(it);
+    }
     return true;
   }
 
  private:
-  std::unordered_map<key_type, mapped_type> map_;
-  mutable std::mutex mutex_;
+  // one cache line per shard lock, so that readers of different shards do not contend
+  struct alignas(64) Shard {
+    std::unordered_map<key_type, mapped_type> map;
+    mutable std::shared_mutex mutex;
+  };
+
+  Shard &GetShard(const key_type &key) { return shards_[std::hash<key_type>{}(key) % kShardCount]; }
+  const Shard &GetShard(const key_type &key) const {
+    return shards_[std::hash<key_type>{}(key) % kShardCount];
+  }
+
+  std::array<Shard, kShardCount> shards_;
 };
 
-}  // namespace base
-}  // namespace tdf
+}  // namespace utils
+}  // namespace footstone
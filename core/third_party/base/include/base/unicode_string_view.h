@@ -21,6 +21,7 @@
  */
 
 #pragma once
+#include <cstring>
 #include <string>
 
 #ifdef _MSC_VER
@@ -231,14 +232,15 @@ class unicode_string_view final {
 }  // namespace base
 }  // namespace tdf
 
-#ifdef __APPLE__
-#if defined(__clang__) && __clang_major__ >= 15
+// libc++ 15 and libstdc++ have no hash of strings of uint8_t
+#if (defined(__APPLE__) && defined(__clang__) && __clang_major__ >= 15) || \
+    (defined(__GLIBCXX__) && !defined(__cpp_char8_t))
+#define TDF_BASE_HASH_U8STRING
 template<>
 struct std::hash<tdf::base::unicode_string_view::u8string> {
   std::size_t operator()(const tdf::base::unicode_string_view::u8string& value) const noexcept;
 };
 #endif
-#endif
 
 template <>
 struct std::hash<tdf::base::unicode_string_view> {
@@ -247,7 +249,7 @@ struct std::hash<tdf::base::unicode_string_view> {
 
 inline namespace literals {
 inline namespace string_literals {
-[[nodiscard]] inline constexpr const tdf::base::unicode_string_view::char8_t_* operator"" _u8_ptr(
+[[nodiscard]] inline const tdf::base::unicode_string_view::char8_t_* operator"" _u8_ptr(
     const u8_type* u8, size_t) {
   return (tdf::base::unicode_string_view::char8_t_*)u8;
 }
@@ -0,0 +1,159 @@
+/*
+ *
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2022 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace tdf {
+namespace base {
+
+// Validating Latin-1/UTF-8/UTF-16/UTF-32 transcoding.
+// Every conversion first measures the output, which also validates the input, then encodes into a
+// buffer of the exact size. Runs of ASCII are scanned and copied 16 bytes at a time with SSE2 or
+// NEON when the target has them, and with a portable word-at-a-time loop otherwise.
+// Invalid input (broken UTF-8 sequences, overlong forms, lone surrogates, code points above
+// U+10FFFF) makes the conversion fail and leaves the output untouched.
+class UnicodeTranscoder {
+ public:
+  static constexpr size_t kInvalidLength = static_cast<size_t>(-1);
+
+  // Returns the index of the first unit that is not ASCII, or `length`.
+  static size_t FindFirstNonAscii(const uint8_t* data, size_t length);
+  static size_t FindFirstNonAscii(const char16_t* data, size_t length);
+
+  static bool ValidateUtf8(const uint8_t* data, size_t length);
+  static bool ValidateUtf16(const char16_t* data, size_t length);
+
+  // Output sizes in code units, kInvalidLength when the input is invalid.
+  static size_t Utf8LengthOfLatin1(const uint8_t* data, size_t length);
+  static size_t Utf8LengthOfUtf16(const char16_t* data, size_t length);
+  static size_t Utf8LengthOfUtf32(const char32_t* data, size_t length);
+  static size_t Utf16LengthOfUtf8(const uint8_t* data, size_t length);
+  static size_t Utf16LengthOfUtf32(const char32_t* data, size_t length);
+  static size_t Utf32LengthOfUtf8(const uint8_t* data, size_t length);
+  static size_t Utf32LengthOfUtf16(const char16_t* data, size_t length);
+
+  // Encoders for input that has been measured, `out` must hold the measured size.
+  // They return the number of units written.
+  static size_t EncodeLatin1ToUtf8(const uint8_t* data, size_t length, uint8_t* out);
+  static size_t EncodeLatin1ToUtf16(const uint8_t* data, size_t length, char16_t* out);
+  static size_t EncodeUtf16ToUtf8(const char16_t* data, size_t length, uint8_t* out);
+  static size_t EncodeUtf32ToUtf8(const char32_t* data, size_t length, uint8_t* out);
+  static size_t EncodeUtf8ToUtf16(const uint8_t* data, size_t length, char16_t* out);
+  static size_t EncodeUtf32ToUtf16(const char32_t* data, size_t length, char16_t* out);
+  static size_t EncodeUtf8ToUtf32(const uint8_t* data, size_t length, char32_t* out);
+  static size_t EncodeUtf16ToUtf32(const char16_t* data, size_t length, char32_t* out);
+
+  // `Utf8String` is any string of one byte units, e.g. std::string or unicode_string_view::u8string.
+  template <typename Utf8String>
+  static void Latin1ToUtf8(const std::string& str, Utf8String& out) {
+    auto data = reinterpret_cast<const uint8_t*>(str.data());
+    out.resize(Utf8LengthOfLatin1(data, str.length()));
+    EncodeLatin1ToUtf8(data, str.length(), ToBytes(out));
+  }
+
+  static std::u16string Latin1ToUtf16(const std::string& str) {
+    std::u16string out;
+    out.resize(str.length());
+    EncodeLatin1ToUtf16(reinterpret_cast<const uint8_t*>(str.data()), str.length(), &out[0]);
+    return out;
+  }
+
+  template <typename Utf8String>
+  static bool Utf16ToUtf8(const std::u16string& str, Utf8String& out) {
+    size_t size = Utf8LengthOfUtf16(str.data(), str.length());
+    if (size == kInvalidLength) {
+      return false;
+    }
+    out.resize(size);
+    EncodeUtf16ToUtf8(str.data(), str.length(), ToBytes(out));
+    return true;
+  }
+
+  template <typename Utf8String>
+  static bool Utf32ToUtf8(const std::u32string& str, Utf8String& out) {
+    size_t size = Utf8LengthOfUtf32(str.data(), str.length());
+    if (size == kInvalidLength) {
+      return false;
+    }
+    out.resize(size);
+    EncodeUtf32ToUtf8(str.data(), str.length(), ToBytes(out));
+    return true;
+  }
+
+  template <typename Utf8String>
+  static bool Utf8ToUtf16(const Utf8String& str, std::u16string& out) {
+    auto data = reinterpret_cast<const uint8_t*>(str.data());
+    size_t size = Utf16LengthOfUtf8(data, str.length());
+    if (size == kInvalidLength) {
+      return false;
+    }
+    out.resize(size);
+    EncodeUtf8ToUtf16(data, str.length(), &out[0]);
+    return true;
+  }
+
+  template <typename Utf8String>
+  static bool Utf8ToUtf32(const Utf8String& str, std::u32string& out) {
+    auto data = reinterpret_cast<const uint8_t*>(str.data());
+    size_t size = Utf32LengthOfUtf8(data, str.length());
+    if (size == kInvalidLength) {
+      return false;
+    }
+    out.resize(size);
+    EncodeUtf8ToUtf32(data, str.length(), &out[0]);
+    return true;
+  }
+
+  static bool Utf32ToUtf16(const std::u32string& str, std::u16string& out) {
+    size_t size = Utf16LengthOfUtf32(str.data(), str.length());
+    if (size == kInvalidLength) {
+      return false;
+    }
+    out.resize(size);
+    EncodeUtf32ToUtf16(str.data(), str.length(), &out[0]);
+    return true;
+  }
+
+  static bool Utf16ToUtf32(const std::u16string& str, std::u32string& out) {
+    size_t size = Utf32LengthOfUtf16(str.data(), str.length());
+    if (size == kInvalidLength) {
+      return false;
+    }
+    out.resize(size);
+    EncodeUtf16ToUtf32(str.data(), str.length(), &out[0]);
+    return true;
+  }
+
+ private:
+  template <typename Utf8String>
+  static uint8_t* ToBytes(Utf8String& str) {
+    static_assert(sizeof(typename Utf8String::value_type) == 1, "not a UTF-8 string");
+    return reinterpret_cast<uint8_t*>(&str[0]);
+  }
+};
+
+}  // namespace base
+}  // namespace tdf
@@ -0,0 +1,328 @@
+/*
+ *
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2022 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "base/async_logger.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "base/logging.h"
+
+namespace tdf {
+namespace base {
+
+namespace {
+
+struct RecordHeader {
+  uint64_t timestamp_in_us;
+  int32_t severity;
+  uint32_t length;
+};
+
+struct Record {
+  RecordHeader header;
+  std::string text;
+};
+
+// single producer (its thread), single consumer (whoever holds the drain mutex)
+class Ring {
+ public:
+  explicit Ring(size_t size)
+      : buffer_(size), mask_(size - 1), head_(0), tail_(0), posted_count_(0), dropped_count_(0),
+        is_closed_(false) {}
+
+  bool Write(const RecordHeader& header, const char* text) {
+    size_t head = head_.load(std::memory_order_relaxed);
+    size_t tail = tail_.load(std::memory_order_acquire);
+    size_t size = sizeof(RecordHeader) + header.length;
+    if (size > buffer_.size() - (head - tail)) {
+      dropped_count_.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+    CopyIn(head, &header, sizeof(RecordHeader));
+    CopyIn(head + sizeof(RecordHeader), text, header.length);
+    head_.store(head + size, std::memory_order_release);
+    posted_count_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+  }
+
+  void Read(std::vector<Record>& records) {
+    size_t tail = tail_.load(std::memory_order_relaxed);
+    size_t head = head_.load(std::memory_order_acquire);
+    while (tail != head) {
+      Record record;
+      CopyOut(tail, &record.header, sizeof(RecordHeader));
+      record.text.resize(record.header.length);
+      CopyOut(tail + sizeof(RecordHeader), &record.text[0], record.header.length);
+      tail += sizeof(RecordHeader) + record.header.length;
+      records.push_back(std::move(record));
+    }
+    tail_.store(tail, std::memory_order_release);
+  }
+
+  bool IsHalfFull() const {
+    return (head_.load(std::memory_order_relaxed) - tail_.load(std::memory_order_relaxed)) * 2 > buffer_.size();
+  }
+  bool IsEmpty() const {
+    return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_relaxed);
+  }
+  uint64_t GetPostedCount() const { return posted_count_.load(std::memory_order_relaxed); }
+  uint64_t GetDroppedCount() const { return dropped_count_.load(std::memory_order_relaxed); }
+  void Close() { is_closed_.store(true, std::memory_order_release); }
+  bool IsClosed() const { return is_closed_.load(std::memory_order_acquire); }
+
+ private:
+  void CopyIn(size_t pos, const void* data, size_t length) {
+    size_t offset = pos & mask_;
+    size_t first = std::min(length, buffer_.size() - offset);
+    memcpy(&buffer_[offset], data, first);
+    memcpy(&buffer_[0], static_cast<const char*>(data) + first, length - first);
+  }
+
+  void CopyOut(size_t pos, void* data, size_t length) const {
+    size_t offset = pos & mask_;
+    size_t first = std::min(length, buffer_.size() - offset);
+    memcpy(data, &buffer_[offset], first);
+    memcpy(static_cast<char*>(data) + first, &buffer_[0], length - first);
+  }
+
+  std::vector<char> buffer_;
+  const size_t mask_;
+  // positions grow forever, the buffer index is pos & mask_
+  std::atomic<size_t> head_;
+  std::atomic<size_t> tail_;
+  std::atomic<uint64_t> posted_count_;
+  std::atomic<uint64_t> dropped_count_;
+  std::atomic<bool> is_closed_;
+};
+
+struct State {
+  std::atomic<bool> is_started{false};
+  std::atomic<size_t> buffer_size{AsyncLogger::kDefaultBufferSize};
+
+  std::mutex ring_mutex;
+  std::vector<std::shared_ptr<Ring>> rings;
+  // counts of the rings of exited threads
+  uint64_t retired_posted_count = 0;
+  uint64_t retired_dropped_count = 0;
+
+  std::mutex drain_mutex;
+  uint64_t reported_dropped_count = 0;
+
+  std::mutex thread_mutex;
+  std::condition_variable cv;
+  std::thread thread;
+  bool is_stopping = false;
+};
+
+State& GetState() {
+  // never destroyed, static destructors may still log
+  static auto* state = new State();
+  return *state;
+}
+
+struct ThreadRing {
+  std::shared_ptr<Ring> ring;
+  ~ThreadRing();
+};
+
+// stays readable after ThreadRing is destroyed at thread exit
+thread_local bool is_thread_ring_destroyed = false;
+thread_local ThreadRing thread_ring;
+
+ThreadRing::~ThreadRing() {
+  is_thread_ring_destroyed = true;
+  if (ring) {
+    ring->Close();
+  }
+}
+
+Ring* GetThreadRing(State& state) {
+  if (is_thread_ring_destroyed) {
+    return nullptr;
+  }
+  if (!thread_ring.ring) {
+    thread_ring.ring = std::make_shared<Ring>(state.buffer_size.load(std::memory_order_relaxed));
+    std::lock_guard<std::mutex> lock(state.ring_mutex);
+    state.rings.push_back(thread_ring.ring);
+  }
+  return thread_ring.ring.get();
+}
+
+// set while the thread delivers records, a FATAL logged by the delegate must not drain again
+thread_local bool is_draining = false;
+
+// Reads the text of a stream in place, std::ostringstream::str() would copy it.
+class StreamTextReader : public std::stringbuf {
+ public:
+  static const char* GetText(const std::ostringstream& stream, size_t* length) {
+    std::stringbuf* buffer = stream.rdbuf();
+    const char* begin = (buffer->*&StreamTextReader::pbase)();
+    *length = static_cast<size_t>((buffer->*&StreamTextReader::pptr)() - begin);
+    return begin;
+  }
+};
+
+uint64_t NowInUs() {
+  return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+size_t RoundUpToPowerOfTwo(size_t size) {
+  size_t result = 1;
+  while (result < size) {
+    result <<= 1;
+  }
+  return result;
+}
+
+void Drain(State& state) {
+  if (is_draining) {
+    return;
+  }
+  std::lock_guard<std::mutex> drain_lock(state.drain_mutex);
+  is_draining = true;
+  std::vector<std::shared_ptr<Ring>> rings;
+  {
+    std::lock_guard<std::mutex> lock(state.ring_mutex);
+    rings = state.rings;
+  }
+  std::vector<Record> records;
+  for (const auto& ring : rings) {
+    // closed before reading, so nothing is written after this read
+    bool is_closed = ring->IsClosed();
+    ring->Read(records);
+    if (is_closed) {
+      std::lock_guard<std::mutex> lock(state.ring_mutex);
+      state.retired_posted_count += ring->GetPostedCount();
+      state.retired_dropped_count += ring->GetDroppedCount();
+      state.rings.erase(std::remove(state.rings.begin(), state.rings.end(), ring), state.rings.end());
+    }
+  }
+  uint64_t dropped_count = AsyncLogger::GetStats().dropped_count;
+
+  std::stable_sort(records.begin(), records.end(), [](const Record& lhs, const Record& rhs) {
+    return lhs.header.timestamp_in_us < rhs.header.timestamp_in_us;
+  });
+  for (const auto& record : records) {
+    std::ostringstream stream;
+    stream << record.text;
+    LogMessage::Deliver(stream, static_cast<LogSeverity>(record.header.severity));
+  }
+  if (dropped_count > state.reported_dropped_count) {
+    std::ostringstream stream;
+    stream << "[WARNING:async_logger] " << dropped_count - state.reported_dropped_count
+           << " messages dropped, the log buffer is full" << std::endl;
+    LogMessage::Deliver(stream, TDF_LOG_WARNING);
+    state.reported_dropped_count = dropped_count;
+  }
+  is_draining = false;
+}
+
+void Run(State& state) {
+  std::unique_lock<std::mutex> lock(state.thread_mutex);
+  while (!state.is_stopping) {
+    state.cv.wait_for(lock, std::chrono::milliseconds(AsyncLogger::kDrainIntervalInMs));
+    lock.unlock();
+    Drain(state);
+    lock.lock();
+  }
+}
+
+}  // namespace
+
+void AsyncLogger::Start(size_t buffer_size) {
+  auto& state = GetState();
+  std::lock_guard<std::mutex> lock(state.thread_mutex);
+  if (state.is_started.load(std::memory_order_relaxed)) {
+    return;
+  }
+  // applies to the threads that log for the first time
+  state.buffer_size.store(RoundUpToPowerOfTwo(std::max(buffer_size, sizeof(RecordHeader) * 2)),
+                          std::memory_order_relaxed);
+  state.is_stopping = false;
+  state.thread = std::thread(Run, std::ref(state));
+  state.is_started.store(true, std::memory_order_release);
+}
+
+void AsyncLogger::Stop() {
+  auto& state = GetState();
+  std::thread thread;
+  {
+    std::lock_guard<std::mutex> lock(state.thread_mutex);
+    if (!state.is_started.load(std::memory_order_relaxed)) {
+      return;
+    }
+    state.is_started.store(false, std::memory_order_release);
+    state.is_stopping = true;
+    thread = std::move(state.thread);
+  }
+  state.cv.notify_one();
+  thread.join();
+  Drain(state);
+}
+
+void AsyncLogger::Flush() {
+  Drain(GetState());
+}
+
+bool AsyncLogger::Post(LogSeverity severity, const std::ostringstream& stream) {
+  auto& state = GetState();
+  if (!state.is_started.load(std::memory_order_acquire)) {
+    return false;
+  }
+  auto* ring = GetThreadRing(state);
+  if (!ring) {
+    return false;
+  }
+  size_t length;
+  const char* text = StreamTextReader::GetText(stream, &length);
+  RecordHeader header{NowInUs(), static_cast<int32_t>(severity), static_cast<uint32_t>(length)};
+  ring->Write(header, text);
+  if (ring->IsHalfFull()) {
+    state.cv.notify_one();
+  }
+  return true;
+}
+
+AsyncLogger::Stats AsyncLogger::GetStats() {
+  auto& state = GetState();
+  std::lock_guard<std::mutex> lock(state.ring_mutex);
+  Stats stats{state.retired_posted_count, state.retired_dropped_count};
+  for (const auto& ring : state.rings) {
+    stats.posted_count += ring->GetPostedCount();
+    stats.dropped_count += ring->GetDroppedCount();
+  }
+  return stats;
+}
+
+}  // namespace base
+}  // namespace tdf
@@ -0,0 +1,522 @@
+/*
+ *
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2022 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "base/unicode_transcoder.h"
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define TDF_BASE_TRANSCODER_SSE2
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define TDF_BASE_TRANSCODER_NEON
+#endif
+
+namespace tdf {
+namespace base {
+
+namespace {
+
+constexpr size_t kBlockSize = 16;
+constexpr uint64_t kAsciiMask8 = 0x8080808080808080ULL;
+constexpr uint64_t kAsciiMask16 = 0xff80ff80ff80ff80ULL;
+
+// true when the 16 bytes at `p` are all ASCII
+inline bool IsAsciiBlock(const uint8_t* p) {
+#if defined(TDF_BASE_TRANSCODER_SSE2)
+  return _mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p))) == 0;
+#elif defined(TDF_BASE_TRANSCODER_NEON)
+  uint8x16_t v = vld1q_u8(p);
+  uint8x8_t folded = vorr_u8(vget_low_u8(v), vget_high_u8(v));
+  return (vget_lane_u64(vreinterpret_u64_u8(folded), 0) & kAsciiMask8) == 0;
+#else
+  uint64_t words[2];
+  memcpy(words, p, sizeof(words));
+  return ((words[0] | words[1]) & kAsciiMask8) == 0;
+#endif
+}
+
+// true when the 16 units at `p` are all ASCII
+inline bool IsAsciiBlock(const char16_t* p) {
+#if defined(TDF_BASE_TRANSCODER_SSE2)
+  __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+  __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 8));
+  __m128i v = _mm_and_si128(_mm_or_si128(lo, hi), _mm_set1_epi16(static_cast<int16_t>(0xff80)));
+  return _mm_movemask_epi8(_mm_cmpeq_epi16(v, _mm_setzero_si128())) == 0xffff;
+#elif defined(TDF_BASE_TRANSCODER_NEON)
+  auto units = reinterpret_cast<const uint16_t*>(p);
+  uint16x8_t v = vorrq_u16(vld1q_u16(units), vld1q_u16(units + 8));
+  uint16x4_t folded = vorr_u16(vget_low_u16(v), vget_high_u16(v));
+  return (vget_lane_u64(vreinterpret_u64_u16(folded), 0) & kAsciiMask16) == 0;
+#else
+  uint64_t words[4];
+  memcpy(words, p, sizeof(words));
+  return ((words[0] | words[1] | words[2] | words[3]) & kAsciiMask16) == 0;
+#endif
+}
+
+// zero-extends 16 bytes to 16 units
+inline void WidenBlock(const uint8_t* p, char16_t* out) {
+#if defined(TDF_BASE_TRANSCODER_SSE2)
+  __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+  __m128i zero = _mm_setzero_si128();
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_unpacklo_epi8(v, zero));
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 8), _mm_unpackhi_epi8(v, zero));
+#elif defined(TDF_BASE_TRANSCODER_NEON)
+  uint8x16_t v = vld1q_u8(p);
+  auto units = reinterpret_cast<uint16_t*>(out);
+  vst1q_u16(units, vmovl_u8(vget_low_u8(v)));
+  vst1q_u16(units + 8, vmovl_u8(vget_high_u8(v)));
+#else
+  for (size_t i = 0; i < kBlockSize; ++i) {
+    out[i] = p[i];
+  }
+#endif
+}
+
+// truncates 16 ASCII units to 16 bytes
+inline void NarrowBlock(const char16_t* p, uint8_t* out) {
+#if defined(TDF_BASE_TRANSCODER_SSE2)
+  __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+  __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 8));
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_packus_epi16(lo, hi));
+#elif defined(TDF_BASE_TRANSCODER_NEON)
+  auto units = reinterpret_cast<const uint16_t*>(p);
+  vst1q_u8(out, vcombine_u8(vmovn_u16(vld1q_u16(units)), vmovn_u16(vld1q_u16(units + 8))));
+#else
+  for (size_t i = 0; i < kBlockSize; ++i) {
+    out[i] = static_cast<uint8_t>(p[i]);
+  }
+#endif
+}
+
+inline bool IsContinuation(uint8_t byte) { return (byte & 0xc0) == 0x80; }
+
+inline bool IsHighSurrogate(char32_t unit) { return unit >= 0xd800 && unit <= 0xdbff; }
+
+inline bool IsLowSurrogate(char32_t unit) { return unit >= 0xdc00 && unit <= 0xdfff; }
+
+inline bool IsScalarValue(char32_t code_point) {
+  return code_point <= 0x10ffff && !(code_point >= 0xd800 && code_point <= 0xdfff);
+}
+
+// Decodes one well-formed UTF-8 sequence (Unicode table 3-7).
+// Returns its length, or 0 when the bytes at `p` are not a well-formed sequence.
+inline size_t DecodeUtf8(const uint8_t* p, size_t remaining, char32_t& code_point) {
+  uint8_t lead = p[0];
+  if (lead < 0x80) {
+    code_point = lead;
+    return 1;
+  }
+  if (lead < 0xc2) {
+    return 0;
+  }
+  if (lead < 0xe0) {
+    if (remaining < 2 || !IsContinuation(p[1])) {
+      return 0;
+    }
+    code_point = (static_cast<char32_t>(lead & 0x1f) << 6) | (p[1] & 0x3f);
+    return 2;
+  }
+  if (lead < 0xf0) {
+    if (remaining < 3 || !IsContinuation(p[1]) || !IsContinuation(p[2])) {
+      return 0;
+    }
+    if ((lead == 0xe0 && p[1] < 0xa0) || (lead == 0xed && p[1] > 0x9f)) {  // overlong or surrogate
+      return 0;
+    }
+    code_point = (static_cast<char32_t>(lead & 0x0f) << 12) | (static_cast<char32_t>(p[1] & 0x3f) << 6) |
+        (p[2] & 0x3f);
+    return 3;
+  }
+  if (lead < 0xf5) {
+    if (remaining < 4 || !IsContinuation(p[1]) || !IsContinuation(p[2]) || !IsContinuation(p[3])) {
+      return 0;
+    }
+    if ((lead == 0xf0 && p[1] < 0x90) || (lead == 0xf4 && p[1] > 0x8f)) {  // overlong or above U+10FFFF
+      return 0;
+    }
+    code_point = (static_cast<char32_t>(lead & 0x07) << 18) | (static_cast<char32_t>(p[1] & 0x3f) << 12) |
+        (static_cast<char32_t>(p[2] & 0x3f) << 6) | (p[3] & 0x3f);
+    return 4;
+  }
+  return 0;
+}
+
+// Decodes one code point from UTF-16, returns the number of units used or 0 on a lone surrogate.
+inline size_t DecodeUtf16(const char16_t* p, size_t remaining, char32_t& code_point) {
+  char32_t unit = p[0];
+  if (IsHighSurrogate(unit)) {
+    if (remaining < 2 || !IsLowSurrogate(p[1])) {
+      return 0;
+    }
+    code_point = 0x10000 + ((unit - 0xd800) << 10) + (p[1] - 0xdc00);
+    return 2;
+  }
+  if (IsLowSurrogate(unit)) {
+    return 0;
+  }
+  code_point = unit;
+  return 1;
+}
+
+inline size_t Utf8Length(char32_t code_point) {
+  if (code_point < 0x80) {
+    return 1;
+  } else if (code_point < 0x800) {
+    return 2;
+  } else if (code_point < 0x10000) {
+    return 3;
+  }
+  return 4;
+}
+
+inline size_t EncodeUtf8(char32_t code_point, uint8_t* out) {
+  if (code_point < 0x80) {
+    out[0] = static_cast<uint8_t>(code_point);
+    return 1;
+  } else if (code_point < 0x800) {
+    out[0] = static_cast<uint8_t>(0xc0 | (code_point >> 6));
+    out[1] = static_cast<uint8_t>(0x80 | (code_point & 0x3f));
+    return 2;
+  } else if (code_point < 0x10000) {
+    out[0] = static_cast<uint8_t>(0xe0 | (code_point >> 12));
+    out[1] = static_cast<uint8_t>(0x80 | ((code_point >> 6) & 0x3f));
+    out[2] = static_cast<uint8_t>(0x80 | (code_point & 0x3f));
+    return 3;
+  }
+  out[0] = static_cast<uint8_t>(0xf0 | (code_point >> 18));
+  out[1] = static_cast<uint8_t>(0x80 | ((code_point >> 12) & 0x3f));
+  out[2] = static_cast<uint8_t>(0x80 | ((code_point >> 6) & 0x3f));
+  out[3] = static_cast<uint8_t>(0x80 | (code_point & 0x3f));
+  return 4;
+}
+
+inline size_t EncodeUtf16(char32_t code_point, char16_t* out) {
+  if (code_point < 0x10000) {
+    out[0] = static_cast<char16_t>(code_point);
+    return 1;
+  }
+  code_point -= 0x10000;
+  out[0] = static_cast<char16_t>(0xd800 + (code_point >> 10));
+  out[1] = static_cast<char16_t>(0xdc00 + (code_point & 0x3ff));
+  return 2;
+}
+
+}  // namespace
+
+size_t UnicodeTranscoder::FindFirstNonAscii(const uint8_t* data, size_t length) {
+  size_t i = 0;
+  while (length - i >= kBlockSize && IsAsciiBlock(data + i)) {
+    i += kBlockSize;
+  }
+  while (i < length && data[i] < 0x80) {
+    ++i;
+  }
+  return i;
+}
+
+size_t UnicodeTranscoder::FindFirstNonAscii(const char16_t* data, size_t length) {
+  size_t i = 0;
+  while (length - i >= kBlockSize && IsAsciiBlock(data + i)) {
+    i += kBlockSize;
+  }
+  while (i < length && data[i] < 0x80) {
+    ++i;
+  }
+  return i;
+}
+
+bool UnicodeTranscoder::ValidateUtf8(const uint8_t* data, size_t length) {
+  return Utf32LengthOfUtf8(data, length) != kInvalidLength;
+}
+
+bool UnicodeTranscoder::ValidateUtf16(const char16_t* data, size_t length) {
+  return Utf32LengthOfUtf16(data, length) != kInvalidLength;
+}
+
+size_t UnicodeTranscoder::Utf8LengthOfLatin1(const uint8_t* data, size_t length) {
+  size_t size = length;
+  size_t i = 0;
+  while (i < length) {
+    if (length - i >= kBlockSize && IsAsciiBlock(data + i)) {
+      i += kBlockSize;
+      continue;
+    }
+    size_t end = std::min(length, i + kBlockSize);
+    for (; i < end; ++i) {
+      size += data[i] >> 7;
+    }
+  }
+  return size;
+}
+
+size_t UnicodeTranscoder::Utf8LengthOfUtf16(const char16_t* data, size_t length) {
+  size_t size = 0;
+  size_t i = 0;
+  while (i < length) {
+    if (length - i >= kBlockSize && IsAsciiBlock(data + i)) {
+      size += kBlockSize;
+      i += kBlockSize;
+      continue;
+    }
+    size_t end = std::min(length, i + kBlockSize);
+    while (i < end) {
+      char32_t code_point;
+      size_t count = DecodeUtf16(data + i, length - i, code_point);
+      if (!count) {
+        return kInvalidLength;
+      }
+      size += Utf8Length(code_point);
+      i += count;
+    }
+  }
+  return size;
+}
+
+size_t UnicodeTranscoder::Utf8LengthOfUtf32(const char32_t* data, size_t length) {
+  size_t size = 0;
+  for (size_t i = 0; i < length; ++i) {
+    if (!IsScalarValue(data[i])) {
+      return kInvalidLength;
+    }
+    size += Utf8Length(data[i]);
+  }
+  return size;
+}
+
+size_t UnicodeTranscoder::Utf16LengthOfUtf8(const uint8_t* data, size_t length) {
+  size_t size = 0;
+  size_t i = 0;
+  while (i < length) {
+    if (length - i >= kBlockSize && IsAsciiBlock(data + i)) {
+      size += kBlockSize;
+      i += kBlockSize;
+      continue;
+    }
+    size_t end = std::min(length, i + kBlockSize);
+    while (i < end) {
+      char32_t code_point;
+      size_t count = DecodeUtf8(data + i, length - i, code_point);
+      if (!count) {
+        return kInvalidLength;
+      }
+      size += code_point < 0x10000 ? 1 : 2;
+      i += count;
+    }
+  }
+  return size;
+}
+
+size_t UnicodeTranscoder::Utf16LengthOfUtf32(const char32_t* data, size_t length) {
+  size_t size = 0;
+  for (size_t i = 0; i < length; ++i) {
+    if (!IsScalarValue(data[i])) {
+      return kInvalidLength;
+    }
+    size += data[i] < 0x10000 ? 1 : 2;
+  }
+  return size;
+}
+
+size_t UnicodeTranscoder::Utf32LengthOfUtf8(const uint8_t* data, size_t length) {
+  size_t size = 0;
+  size_t i = 0;
+  while (i < length) {
+    if (length - i >= kBlockSize && IsAsciiBlock(data + i)) {
+      size += kBlockSize;
+      i += kBlockSize;
+      continue;
+    }
+    size_t end = std::min(length, i + kBlockSize);
+    while (i < end) {
+      char32_t code_point;
+      size_t count = DecodeUtf8(data + i, length - i, code_point);
+      if (!count) {
+        return kInvalidLength;
+      }
+      ++size;
+      i += count;
+    }
+  }
+  return size;
+}
+
+size_t UnicodeTranscoder::Utf32LengthOfUtf16(const char16_t* data, size_t length) {
+  size_t size = 0;
+  size_t i = 0;
+  while (i < length) {
+    if (length - i >= kBlockSize && IsAsciiBlock(data + i)) {
+      size += kBlockSize;
+      i += kBlockSize;
+      continue;
+    }
+    size_t end = std::min(length, i + kBlockSize);
+    while (i < end) {
+      char32_t code_point;
+      size_t count = DecodeUtf16(data + i, length - i, code_point);
+      if (!count) {
+        return kInvalidLength;
+      }
+      ++size;
+      i += count;
+    }
+  }
+  return size;
+}
+
+size_t UnicodeTranscoder::EncodeLatin1ToUtf8(const uint8_t* data, size_t length, uint8_t* out) {
+  uint8_t* begin = out;
+  size_t i = 0;
+  while (i < length) {
+    if (length - i >= kBlockSize && IsAsciiBlock(data + i)) {
+      memcpy(out, data + i, kBlockSize);
+      out += kBlockSize;
+      i += kBlockSize;
+      continue;
+    }
+    size_t end = std::min(length, i + kBlockSize);
+    for (; i < end; ++i) {
+      out += EncodeUtf8(data[i], out);
+    }
+  }
+  return static_cast<size_t>(out - begin);
+}
+
+size_t UnicodeTranscoder::EncodeLatin1ToUtf16(const uint8_t* data, size_t length, char16_t* out) {
+  size_t i = 0;
+  for (; length - i >= kBlockSize; i += kBlockSize) {
+    WidenBlock(data + i, out + i);
+  }
+  for (; i < length; ++i) {
+    out[i] = data[i];
+  }
+  return length;
+}
+
+size_t UnicodeTranscoder::EncodeUtf16ToUtf8(const char16_t* data, size_t length, uint8_t* out) {
+  uint8_t* begin = out;
+  size_t i = 0;
+  while (i < length) {
+    if (length - i >= kBlockSize && IsAsciiBlock(data + i)) {
+      NarrowBlock(data + i, out);
+      out += kBlockSize;
+      i += kBlockSize;
+      continue;
+    }
+    size_t end = std::min(length, i + kBlockSize);
+    while (i < end) {
+      char32_t code_point;
+      size_t count = DecodeUtf16(data + i, length - i, code_point);
+      if (!count) {
+        return static_cast<size_t>(out - begin);
+      }
+      i += count;
+      out += EncodeUtf8(code_point, out);
+    }
+  }
+  return static_cast<size_t>(out - begin);
+}
+
+size_t UnicodeTranscoder::EncodeUtf32ToUtf8(const char32_t* data, size_t length, uint8_t* out) {
+  uint8_t* begin = out;
+  for (size_t i = 0; i < length; ++i) {
+    out += EncodeUtf8(data[i], out);
+  }
+  return static_cast<size_t>(out - begin);
+}
+
+size_t UnicodeTranscoder::EncodeUtf8ToUtf16(const uint8_t* data, size_t length, char16_t* out) {
+  char16_t* begin = out;
+  size_t i = 0;
+  while (i < length) {
+    if (length - i >= kBlockSize && IsAsciiBlock(data + i)) {
+      WidenBlock(data + i, out);
+      out += kBlockSize;
+      i += kBlockSize;
+      continue;
+    }
+    size_t end = std::min(length, i + kBlockSize);
+    while (i < end) {
+      char32_t code_point;
+      size_t count = DecodeUtf8(data + i, length - i, code_point);
+      if (!count) {
+        return static_cast<size_t>(out - begin);
+      }
+      i += count;
+      out += EncodeUtf16(code_point, out);
+    }
+  }
+  return static_cast<size_t>(out - begin);
+}
+
+size_t UnicodeTranscoder::EncodeUtf32ToUtf16(const char32_t* data, size_t length, char16_t* out) {
+  char16_t* begin = out;
+  for (size_t i = 0; i < length; ++i) {
+    out += EncodeUtf16(data[i], out);
+  }
+  return static_cast<size_t>(out - begin);
+}
+
+size_t UnicodeTranscoder::EncodeUtf8ToUtf32(const uint8_t* data, size_t length, char32_t* out) {
+  char32_t* begin = out;
+  size_t i = 0;
+  while (i < length) {
+    if (length - i >= kBlockSize && IsAsciiBlock(data + i)) {
+      for (size_t j = 0; j < kBlockSize; ++j) {
+        out[j] = data[i + j];
+      }
+      out += kBlockSize;
+      i += kBlockSize;
+      continue;
+    }
+    size_t end = std::min(length, i + kBlockSize);
+    while (i < end) {
+      size_t count = DecodeUtf8(data + i, length - i, *out);
+      if (!count) {
+        return static_cast<size_t>(out - begin);
+      }
+      i += count;
+      ++out;
+    }
+  }
+  return static_cast<size_t>(out - begin);
+}
+
+size_t UnicodeTranscoder::EncodeUtf16ToUtf32(const char16_t* data, size_t length, char32_t* out) {
+  char32_t* begin = out;
+  size_t i = 0;
+  while (i < length) {
+    size_t count = DecodeUtf16(data + i, length - i, *out);
+    if (!count) {
+      return static_cast<size_t>(out - begin);
+    }
+    i += count;
+    ++out;
+  }
+  return static_cast<size_t>(out - begin);
+}
+
+}  // namespace base
+}  // namespace tdf
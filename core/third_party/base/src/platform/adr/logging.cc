@@ -7,6 +7,7 @@
 #include <algorithm>
 #include <iostream>
 
+#include "base/async_logger.h"
 #include "base/log_settings.h"
 
 namespace tdf {
@@ -78,13 +79,13 @@ LogMessage::~LogMessage() {
   stream_ << std::endl;
 
   if (severity_ >= TDF_LOG_FATAL) {
+    // the messages buffered before this one are not lost
+    AsyncLogger::Flush();
     abort();
   }
 
-  if (delegate_) {
-    delegate_(stream_, severity_);
-  } else {
-    default_delegate_(stream_, severity_);
+  if (!AsyncLogger::Post(severity_, stream_)) {
+    Deliver(stream_, severity_);
   }
 }
 
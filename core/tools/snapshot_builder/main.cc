@@ -0,0 +1,147 @@
+/*
+ *
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2022 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+// Host tool that builds a startup snapshot with several named contexts, for example a base
+// framework context and one context per business bundle.
+//
+// usage: hippy_snapshot_builder -o <output> [-g <global config json>] [-d <base path>]
+//            --context <name> <script>... [--context <name> <script>...]
+//
+// The first context becomes the default one. An instance picks another one with
+// hippy::base::kSnapshotContext in the init params of its scope.
+//
+// build, with a V8 built for the host (libv8_monolith and its include directory):
+//   cmake -S core -B out -DJS_ENGINE=V8 -DHIPPY_SNAPSHOT_BUILDER=ON -DV8_ROOT=<v8 dir> \
+//       -DV8_ROOT_DEFINITIONS="<defines of its args.gn>"
+//   cmake --build out --target hippy_snapshot_builder
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "base/logging.h"
+#include "core/base/file.h"
+#include "core/base/string_view_utils.h"
+#include "core/napi/js_ctx.h"
+#include "core/scope.h"
+#include "core/vm/v8/snapshot_builder.h"
+#include "core/vm/v8/v8_vm.h"
+
+using unicode_string_view = tdf::base::unicode_string_view;
+using HippyFile = hippy::base::HippyFile;
+using StringViewUtils = hippy::base::StringViewUtils;
+
+constexpr char kGlobalKey[] = "global";
+constexpr char kNativeGlobalKey[] = "__HIPPYNATIVEGLOBAL__";
+constexpr char kCurDir[] = "__HIPPYCURDIR__";
+
+static void PrintUsage(const char* name) {
+  fprintf(stderr,
+          "usage: %s -o <output> [-g <global config json>] [-d <base path>] "
+          "--context <name> <script>... [--context <name> <script>...]\n",
+          name);
+}
+
+static unicode_string_view ToStrView(const std::string& str) {
+  return StringViewUtils::ConstCharPointerToStrView(str.c_str(), str.length());
+}
+
+static bool ReadScript(const std::string& path, SnapshotBuilder::Script& script) {
+  std::string content;
+  if (!HippyFile::ReadFile(ToStrView(path), content, false)) {
+    fprintf(stderr, "can not read %s\n", path.c_str());
+    return false;
+  }
+  script.file_name = ToStrView(path);
+  script.source = ToStrView(content);
+  return true;
+}
+
+int main(int argc, char** argv) {
+  std::string output;
+  std::string global_config = "{}";
+  std::string base_path;
+  std::vector<SnapshotBuilder::ContextConfig> configs;
+  for (int i = 1; i < argc; ++i) {
+    if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+      output = argv[++i];
+    } else if (strcmp(argv[i], "-g") == 0 && i + 1 < argc) {
+      if (!HippyFile::ReadFile(ToStrView(argv[++i]), global_config, false)) {
+        fprintf(stderr, "can not read %s\n", argv[i]);
+        return 1;
+      }
+    } else if (strcmp(argv[i], "-d") == 0 && i + 1 < argc) {
+      base_path = argv[++i];
+    } else if (strcmp(argv[i], "--context") == 0 && i + 1 < argc) {
+      SnapshotBuilder::ContextConfig config;
+      config.name = argv[++i];
+      configs.push_back(std::move(config));
+    } else if (!configs.empty() && argv[i][0] != '-') {
+      SnapshotBuilder::Script script;
+      if (!ReadScript(argv[i], script)) {
+        return 1;
+      }
+      configs.back().scripts.push_back(std::move(script));
+    } else {
+      PrintUsage(argv[0]);
+      return 1;
+    }
+  }
+  if (output.empty() || configs.empty()) {
+    PrintUsage(argv[0]);
+    return 1;
+  }
+
+  auto global_config_view = ToStrView(global_config);
+  auto base_path_view = ToStrView(base_path);
+  auto context_cb = [global_config_view, base_path_view](void* wrapper) {
+    auto* scope_wrapper = reinterpret_cast<ScopeWrapper*>(wrapper);
+    TDF_BASE_CHECK(scope_wrapper);
+    auto scope = scope_wrapper->scope.lock();
+    TDF_BASE_CHECK(scope);
+    auto ctx = scope->GetContext();
+    auto global_object = ctx->GetGlobalObject();
+    ctx->SetProperty(global_object, ctx->GetPropertyKey(kGlobalKey), global_object);
+    auto global_config_object = hippy::vm::V8VM::ParseJson(ctx, global_config_view);
+    ctx->SetProperty(global_object, ctx->GetPropertyKey(kNativeGlobalKey), global_config_object);
+    ctx->SetProperty(global_object, ctx->GetPropertyKey(kCurDir), ctx->CreateString(base_path_view));
+  };
+
+  SnapshotBuilder builder(context_cb);
+  SnapshotData snapshot_data;
+  auto result = builder.Build(configs, snapshot_data);
+  if (result != SnapshotBuilder::Result::kSuccess) {
+    auto message = StringViewUtils::ToU8StdStr(builder.GetErrorMessage());
+    fprintf(stderr, "build snapshot failed, result = %d, error = %s\n", static_cast<int>(result),
+            message.c_str());
+    return 1;
+  }
+  if (!HippyFile::SaveFile(ToStrView(output), snapshot_data.buffer_holder)) {
+    fprintf(stderr, "can not write %s\n", output.c_str());
+    return 1;
+  }
+  fprintf(stdout, "%s: %zu contexts, %zu bytes\n", output.c_str(), configs.size(),
+          snapshot_data.buffer_holder.size());
+  hippy::vm::V8VM::PlatformDestroy();
+  return 0;
+}